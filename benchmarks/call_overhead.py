@@ -0,0 +1,73 @@
+# coding: utf-8
+#------------------------------------------------------------------------------------------#
+# This file is part of Pyccel which is released under MIT License. See the LICENSE file or #
+# go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details.     #
+#------------------------------------------------------------------------------------------#
+"""
+Microbenchmark of the cost of calling a function translated by Pyccel from Python.
+
+The functions do (almost) nothing so the measured time is the time spent in the
+wrapper: unpacking the arguments, checking their types, converting them to C and
+converting the result back to Python.
+
+Usage:
+    python3 benchmarks/call_overhead.py [--language {c,fortran}] [--number N]
+"""
+import argparse
+import timeit
+
+import numpy as np
+
+from pyccel.epyccel import epyccel
+
+def no_args():
+    pass
+
+def scalars(a : int, b : float, c : complex):
+    return a
+
+def one_array(x : 'float[:]'):
+    return x[0]
+
+def three_arrays(x : 'float[:,:]', y : 'float[:,:]', z : 'int32[:,:](order=F)'):
+    return x[0,0]
+
+def optional_args(x : 'float[:]', a : int = 1, b : float = 2.0):
+    return a
+
+def main():
+    """
+    Print the time per call of each function for Python and Pyccel.
+    """
+    parser = argparse.ArgumentParser(description='Measure the cost of calling functions translated by Pyccel.')
+    parser.add_argument('--language', choices=('c', 'fortran'), default='c')
+    parser.add_argument('--number', type=int, default=1000000, help='number of calls per measurement')
+    args = parser.parse_args()
+
+    x1 = np.ones(8)
+    x2 = np.ones((4, 4))
+    z2 = np.ones((4, 4), dtype=np.int32, order='F')
+
+    cases = [(no_args, ()),
+             (scalars, (1, 2.0, 3j)),
+             (one_array, (x1,)),
+             (three_arrays, (x2, x2, z2)),
+             (optional_args, (x1,))]
+
+    print(f"{'function':<20}{'python (ns)':>14}{'pyccel (ns)':>14}")
+    for func, func_args in cases:
+        pyccel_func = epyccel(func, language = args.language)
+        times = []
+        for f in (func, pyccel_func):
+            timer = timeit.Timer(lambda f=f: f(*func_args))
+            times.append(min(timer.repeat(repeat=5, number=args.number)) / args.number * 1e9)
+        print(f'{func.__name__:<20}{times[0]:>14.1f}{times[1]:>14.1f}')
+
+    # Calls with keywords use PyArg_ParseTupleAndKeywords
+    pyccel_func = epyccel(optional_args, language = args.language)
+    timer = timeit.Timer(lambda: pyccel_func(x1, b = 3.0))
+    time = min(timer.repeat(repeat=5, number=args.number)) / args.number * 1e9
+    print(f"{'optional_args(b=)':<20}{'':>14}{time:>14.1f}")
+
+if __name__ == '__main__':
+    main()
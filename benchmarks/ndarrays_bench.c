@@ -0,0 +1,350 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * Benchmarks of the primitives of the ndarrays runtime (creation, slicing,
+ * copies, reductions and element-wise kernels) and of the random number
+ * generator on square arrays of several sizes, dtypes and layouts:
+ * - C       : contiguous array in C order
+ * - F       : contiguous array in Fortran order
+ * - strided : view x[:, ::2] of a C array with twice as many columns
+ *
+ * Each case is run until it lasts at least the requested time and the best
+ * of REPEATS runs is kept. The results are printed in JSON (see
+ * benchmarks/run_benchmarks.py which compiles and runs this file).
+ *
+ * Usage:
+ *     ndarrays_bench [--quick] [--min-time SECONDS]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+# define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "ndarrays.h"
+#include "ufuncs.h"
+#include "pyc_random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPEATS 5
+
+typedef struct  s_bench
+{
+    t_ndarray   x;
+    t_ndarray   y;
+    t_ndarray   out;
+    /* arrays owning the data of the views */
+    t_ndarray   x_base;
+    t_ndarray   y_base;
+    int64_t     m;
+    t_types     type;
+}               t_bench;
+
+typedef void (*t_kernel)(t_bench *bench);
+
+/* The results of the reductions are stored here so they are not optimised away */
+static volatile double sink;
+
+static double   now(void)
+{
+    struct timespec ts;
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Function : time_kernel
+ * ----------------------
+ * Measure the time of one call to the kernel.
+ * Returns    :
+ *     The best time of REPEATS runs (in nanoseconds per call)
+ */
+static double   time_kernel(t_kernel kernel, t_bench *bench, double min_time)
+{
+    int64_t iterations = 1;
+    double  elapsed = 0;
+    double  best;
+
+    // Find a number of iterations which lasts at least min_time / REPEATS
+    while (true)
+    {
+        double start = now();
+        for (int64_t i = 0; i < iterations; i++)
+            kernel(bench);
+        elapsed = now() - start;
+        if (elapsed >= min_time / REPEATS)
+            break;
+        iterations *= elapsed > 0 ? (min_time / REPEATS / elapsed < 10 ? 2 : 10) : 10;
+    }
+    best = elapsed;
+    for (int32_t r = 1; r < REPEATS; r++)
+    {
+        double start = now();
+        for (int64_t i = 0; i < iterations; i++)
+            kernel(bench);
+        elapsed = now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best / iterations * 1e9;
+}
+
+/*
+** arrays
+*/
+
+static void     fill(t_ndarray arr)
+{
+    switch (arr.type)
+    {
+        case nd_double:
+            _array_fill_double(1.0, arr);
+            break;
+        case nd_float:
+            _array_fill_float(1.0f, arr);
+            break;
+        case nd_int64:
+            _array_fill_int64(1, arr);
+            break;
+        case nd_int32:
+            _array_fill_int32(1, arr);
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * Function : create
+ * -----------------
+ * Create an (m, m) array with the requested layout, filled with ones. For
+ * the strided layout the returned array is a view of base.
+ */
+static t_ndarray    create(int64_t m, t_types type, const char *layout, t_ndarray *base)
+{
+    int64_t     shape[2] = {m, m};
+    t_ndarray   arr;
+
+    base->shape = NULL;
+    if (strcmp(layout, "strided") == 0)
+    {
+        int64_t base_shape[2] = {m, 2 * m};
+        *base = array_create(2, base_shape, type, false, order_c);
+        fill(*base);
+        arr = array_slicing(*base, 2, new_slice(0, m, 1, RANGE), new_slice(0, 2 * m, 2, RANGE));
+    }
+    else
+    {
+        arr = array_create(2, shape, type, false, strcmp(layout, "F") == 0 ? order_f : order_c);
+        fill(arr);
+    }
+    return arr;
+}
+
+static void     release(t_ndarray *arr, t_ndarray *base)
+{
+    if (base->shape != NULL)
+    {
+        free_pointer(arr);
+        free_array(base);
+    }
+    else
+        free_array(arr);
+}
+
+/*
+** kernels
+*/
+
+static void     kernel_array_create(t_bench *b)
+{
+    int64_t     shape[2] = {b->m, b->m};
+    t_ndarray   arr = array_create(2, shape, b->type, false, order_c);
+    free_array(&arr);
+}
+
+static void     kernel_array_slicing(t_bench *b)
+{
+    t_ndarray   view = array_slicing(b->x, 2, new_slice(0, b->m, 1, RANGE), new_slice(0, b->m, 2, RANGE));
+    free_pointer(&view);
+}
+
+static void     kernel_array_fill(t_bench *b)
+{
+    _array_fill_double(2.0, b->x);
+}
+
+static void     kernel_array_copy_data(t_bench *b)
+{
+    array_copy_data(&b->out, b->x, 0);
+}
+
+static void     kernel_numpy_sum(t_bench *b)
+{
+    switch (b->type)
+    {
+        case nd_double:
+            sink = numpy_sum_float64(b->x);
+            break;
+        case nd_float:
+            sink = numpy_sum_float32(b->x);
+            break;
+        case nd_int64:
+            sink = (double)numpy_sum_int64(b->x);
+            break;
+        case nd_int32:
+            sink = (double)numpy_sum_int32(b->x);
+            break;
+        default:
+            break;
+    }
+}
+
+static void     kernel_numpy_add(t_bench *b)
+{
+    numpy_add_float64(&b->out, b->x, b->y);
+}
+
+static void     kernel_random_uniform(t_bench *b)
+{
+    pyc_random_fill_uniform(b->x);
+}
+
+static void     kernel_random_normal(t_bench *b)
+{
+    pyc_random_fill_normal(b->x, 0., 1.);
+}
+
+static void     kernel_random_integers(t_bench *b)
+{
+    pyc_random_fill_randint(b->x, 0, 100);
+}
+
+/*
+** cases
+*/
+
+typedef struct  s_case
+{
+    const char  *name;
+    t_kernel    kernel;
+    /* number of arrays of the size of the input read or written by each call */
+    int32_t     traffic;
+    /* the case needs an output array (in C order) and a second input */
+    bool        needs_out;
+    bool        needs_y;
+    /* layouts and dtypes which are measured, terminated by NULL / -1 */
+    const char  *layouts[4];
+    t_types     types[5];
+}               t_case;
+
+static const t_case cases[] = {
+    {"array_create", kernel_array_create, 0, false, false, {"C", NULL}, {nd_double, -1}},
+    {"array_slicing", kernel_array_slicing, 0, false, false, {"C", NULL}, {nd_double, -1}},
+    {"array_fill", kernel_array_fill, 1, false, false, {"C", "strided", NULL}, {nd_double, -1}},
+    {"array_copy_data", kernel_array_copy_data, 2, true, false, {"C", "F", "strided", NULL}, {nd_double, -1}},
+    {"numpy_sum", kernel_numpy_sum, 1, false, false, {"C", "F", "strided", NULL},
+            {nd_double, nd_float, nd_int64, nd_int32, -1}},
+    {"numpy_add", kernel_numpy_add, 3, true, true, {"C", "strided", NULL}, {nd_double, -1}},
+    {"random_uniform", kernel_random_uniform, 1, false, false, {"C", NULL}, {nd_double, -1}},
+    {"random_normal", kernel_random_normal, 1, false, false, {"C", NULL}, {nd_double, -1}},
+    {"random_integers", kernel_random_integers, 1, false, false, {"C", NULL}, {nd_int64, -1}},
+};
+
+static const char   *type_name(t_types type)
+{
+    switch (type)
+    {
+        case nd_double:
+            return "float64";
+        case nd_float:
+            return "float32";
+        case nd_int64:
+            return "int64";
+        case nd_int32:
+            return "int32";
+        default:
+            return "unknown";
+    }
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    const int64_t   sizes[] = {32, 256, 2048};
+    int32_t         n_sizes = 3;
+    double          min_time = 0.2;
+    bool            first = true;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+            n_sizes = 2;
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            min_time = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--min-time SECONDS]\n", argv[0]);
+            return (1);
+        }
+    }
+
+    printf("{\n\"min_time\": %g,\n\"repeats\": %d,\n\"results\": [\n", min_time, REPEATS);
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        const t_case *bench_case = &cases[c];
+        for (int32_t t = 0; bench_case->types[t] != (t_types)-1; t++)
+        {
+            for (int32_t l = 0; bench_case->layouts[l] != NULL; l++)
+            {
+                for (int32_t s = 0; s < n_sizes; s++)
+                {
+                    t_bench     b;
+                    const char  *layout = bench_case->layouts[l];
+                    int64_t     shape[2] = {sizes[s], sizes[s]};
+
+                    b.m = sizes[s];
+                    b.type = bench_case->types[t];
+                    b.x = create(b.m, b.type, layout, &b.x_base);
+                    b.y_base.shape = NULL;
+                    b.out.shape = NULL;
+                    if (bench_case->needs_y)
+                        b.y = create(b.m, b.type, layout, &b.y_base);
+                    if (bench_case->needs_out)
+                        b.out = array_create(2, shape, b.type, false, order_c);
+
+                    double  ns = time_kernel(bench_case->kernel, &b, min_time);
+                    int64_t bytes = bench_case->traffic * b.x.length * (int64_t)b.x.type_size;
+
+                    printf("%s{\"name\": \"%s\", \"dtype\": \"%s\", \"layout\": \"%s\", "
+                           "\"size\": %lld, \"ns_per_call\": %.3f, \"gb_per_s\": ",
+                           first ? "" : ",\n", bench_case->name, type_name(b.type), layout,
+                           (long long)b.x.length, ns);
+                    if (bytes > 0)
+                        printf("%.3f}", bytes / ns);
+                    else
+                        printf("null}");
+                    fflush(stdout);
+                    first = false;
+
+                    release(&b.x, &b.x_base);
+                    if (bench_case->needs_y)
+                        release(&b.y, &b.y_base);
+                    if (bench_case->needs_out)
+                        free_array(&b.out);
+                }
+            }
+        }
+    }
+    printf("\n]\n}\n");
+    release_metadata_cache();
+    return (0);
+}
@@ -0,0 +1,396 @@
+# coding: utf-8
+#------------------------------------------------------------------------------------------#
+# This file is part of Pyccel which is released under MIT License. See the LICENSE file or #
+# go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details.     #
+#------------------------------------------------------------------------------------------#
+"""
+Benchmarks of the C runtime of Pyccel (ndarrays) and of the generated wrappers.
+
+Three groups of benchmarks are run:
+
+- `runtime` : the primitives of the ndarrays library (array_create, array_slicing,
+  array_fill, array_copy_data, numpy_sum, numpy_add) and the random number
+  generator (uniform, normal and integer distributions) measured by the C program
+  ndarrays_bench.c, on square arrays of several sizes, dtypes and layouts
+  (C, F and strided views).
+- `numpy` : the equivalent NumPy operations, which are the baseline (the random
+  numbers are drawn by a `numpy.random.Generator`).
+- `wrapper` : the time of a call to functions translated by epyccel which take
+  an array (pyarray_to_ndarray) or return a new array (ndarray_to_pyarray).
+
+The results are printed as a table (time per call and throughput) and can be
+saved in a JSON file. A previous file can be given with `--compare` to report
+the cases which became slower (the exit code is then 1).
+
+Usage:
+    python3 benchmarks/run_benchmarks.py [--quick] [--output FILE] [--compare FILE]
+"""
+import argparse
+import datetime
+import json
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+import timeit
+
+import pyccel
+from pyccel.codegen.utilities import stdlib_path
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+benchmarks_path = os.path.dirname(os.path.abspath(__file__))
+
+# The number of elements the arrays' sides (the arrays are square)
+sides = (32, 256, 2048)
+
+dtypes = ('float64', 'float32', 'int64', 'int32')
+
+#==============================================================================
+def describe_machine(compiler):
+    """
+    Describe the machine and the software used for the benchmarks.
+
+    Parameters
+    ----------
+    compiler : str
+        The C compiler used to compile the runtime.
+
+    Returns
+    -------
+    dict
+        The description.
+    """
+    try:
+        cc_version = subprocess.run([compiler, '--version'], capture_output = True,
+                                    text = True, check = True).stdout.split('\n')[0]
+    except (OSError, subprocess.CalledProcessError):
+        cc_version = None
+    try:
+        commit = subprocess.run(['git', 'rev-parse', 'HEAD'], capture_output = True, text = True,
+                                check = True, cwd = benchmarks_path).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        commit = None
+    return {'date'      : datetime.datetime.now().isoformat(timespec = 'seconds'),
+            'pyccel'    : pyccel.__version__,
+            'commit'    : commit,
+            'python'    : platform.python_version(),
+            'numpy'     : np.__version__ if np else None,
+            'platform'  : platform.platform(),
+            'processor' : platform.processor() or platform.machine(),
+            'compiler'  : cc_version}
+
+#==============================================================================
+def run_runtime_benchmarks(compiler, flags, quick, min_time):
+    """
+    Compile and run the benchmarks of the ndarrays library.
+
+    Parameters
+    ----------
+    compiler : str
+        The C compiler.
+    flags : list of str
+        The flags used to compile the library.
+    quick : bool
+        Only measure the small arrays.
+    min_time : float
+        The minimum time of each measurement (in seconds).
+
+    Returns
+    -------
+    list of dict
+        The results of ndarrays_bench.c.
+    """
+    with tempfile.TemporaryDirectory() as build_dir:
+        exe = os.path.join(build_dir, 'ndarrays_bench')
+        folders = [os.path.join(stdlib_path, f) for f in ('ndarrays', 'ufuncs', 'random')]
+        cmd = [compiler, *flags, os.path.join(benchmarks_path, 'ndarrays_bench.c'),
+               os.path.join(folders[0], 'ndarrays.c'), os.path.join(folders[1], 'ufuncs.c'),
+               os.path.join(folders[2], 'pyc_random.c'),
+               *(f'-I{f}' for f in folders), '-o', exe, '-lm']
+        subprocess.run(cmd, check = True)
+        cmd = [exe, '--min-time', str(min_time)] + (['--quick'] if quick else [])
+        output = subprocess.run(cmd, capture_output = True, text = True, check = True).stdout
+
+    results = json.loads(output)['results']
+    for r in results:
+        r['implementation'] = 'pyccel'
+    return results
+
+#==============================================================================
+def best_time(func, min_time):
+    """
+    Measure the time of a call to a function.
+
+    Parameters
+    ----------
+    func : callable
+        The function called without arguments.
+    min_time : float
+        The minimum total time of the measurement (in seconds).
+
+    Returns
+    -------
+    float
+        The best time of 5 runs, in nanoseconds per call.
+    """
+    timer = timeit.Timer(func)
+    number, _ = timer.autorange()
+    number = max(1, int(number * min_time / 5 / 0.2))
+    return min(timer.repeat(repeat = 5, number = number)) / number * 1e9
+
+def create(side, dtype, layout):
+    """
+    Create a square array of ones with the requested layout.
+
+    Parameters
+    ----------
+    side : int
+        The number of elements of the sides of the array.
+    dtype : str
+        The dtype of the array.
+    layout : {'C', 'F', 'strided'}
+        The layout of the array, 'strided' is the view x[:, ::2] of a C array.
+
+    Returns
+    -------
+    numpy.ndarray
+        The array.
+    """
+    if layout == 'strided':
+        return np.ones((side, 2 * side), dtype = dtype)[:, ::2]
+    return np.ones((side, side), dtype = dtype, order = layout)
+
+def run_numpy_benchmarks(runtime_results, min_time):
+    """
+    Measure the NumPy operations equivalent to the runtime benchmarks.
+
+    Parameters
+    ----------
+    runtime_results : list of dict
+        The results of the runtime benchmarks whose cases are measured.
+    min_time : float
+        The minimum time of each measurement (in seconds).
+
+    Returns
+    -------
+    list of dict
+        The results, in the same format as the runtime benchmarks.
+    """
+    results = []
+    rng = np.random.default_rng()
+    for case in runtime_results:
+        side = int(round(case['size'] ** 0.5))
+        dtype, layout = case['dtype'], case['layout']
+        x = create(side, dtype, layout)
+        y = create(side, dtype, layout)
+        out = np.empty((side, side), dtype = dtype)
+        operations = {'array_create'    : lambda: np.empty((side, side), dtype = dtype),
+                      'array_slicing'   : lambda: x[:, ::2],
+                      'array_fill'      : lambda: x.fill(2),
+                      'array_copy_data' : lambda: np.copyto(out, x),
+                      'numpy_sum'       : lambda: np.sum(x),
+                      'numpy_add'       : lambda: np.add(x, y, out = out),
+                      'random_uniform'  : lambda: rng.random(out = x),
+                      'random_normal'   : lambda: rng.standard_normal(out = x),
+                      'random_integers' : lambda: rng.integers(0, 100, size = x.shape)}
+        ns = best_time(operations[case['name']], min_time)
+        gb_per_s = None if case['gb_per_s'] is None else case['gb_per_s'] * case['ns_per_call'] / ns
+        results.append({**case, 'implementation' : 'numpy', 'ns_per_call' : ns, 'gb_per_s' : gb_per_s})
+    return results
+
+#==============================================================================
+def take_array(x : 'float[:,:]'):
+    pass
+
+def take_array_f(x : 'float[:,:](order=F)'):
+    pass
+
+def give_array(n : int):
+    import numpy as np
+    x = np.empty((n, n))
+    return x
+
+def run_wrapper_benchmarks(language, quick, min_time):
+    """
+    Measure the calls to functions translated by epyccel.
+
+    Measure the time of a call to functions which take an array as argument
+    (the array is described by pyarray_to_ndarray) and to a function which
+    creates an array and returns it to Python (ndarray_to_pyarray).
+
+    Parameters
+    ----------
+    language : str
+        The language used by epyccel.
+    quick : bool
+        Only measure the small arrays.
+    min_time : float
+        The minimum time of each measurement (in seconds).
+
+    Returns
+    -------
+    list of dict
+        The results, in the same format as the runtime benchmarks.
+    """
+    from pyccel.epyccel import epyccel # pylint: disable=import-outside-toplevel
+
+    take = epyccel(take_array, language = language)
+    take_f = epyccel(take_array_f, language = language)
+    give = epyccel(give_array, language = language)
+
+    results = []
+    for side in sides[:2] if quick else sides:
+        for layout, func in (('C', take), ('F', take_f), ('strided', take)):
+            x = create(side, 'float64', layout)
+            # A strided view is not accepted by the wrapper, the conversion is measured
+            # until the error is raised
+            call = (lambda: func(x)) if layout != 'strided' else (lambda: _expect_error(func, x))
+            for implementation, f in (('pyccel', call), ('python', lambda: take_array(x))):
+                results.append({'name' : 'pyarray_to_ndarray', 'dtype' : 'float64', 'layout' : layout,
+                                'size' : x.size, 'ns_per_call' : best_time(f, min_time),
+                                'gb_per_s' : None, 'implementation' : implementation})
+        for implementation, f in (('pyccel', lambda: give(side)), ('numpy', lambda: np.empty((side, side)))):
+            results.append({'name' : 'ndarray_to_pyarray', 'dtype' : 'float64', 'layout' : 'C',
+                            'size' : side * side, 'ns_per_call' : best_time(f, min_time),
+                            'gb_per_s' : None, 'implementation' : implementation})
+    return results
+
+def _expect_error(func, x):
+    try:
+        func(x)
+    except TypeError:
+        pass
+
+#==============================================================================
+def key(result):
+    """
+    Get the key identifying a benchmark case.
+
+    Parameters
+    ----------
+    result : dict
+        The result of the case.
+
+    Returns
+    -------
+    tuple
+        The name, dtype, layout, size and implementation of the case.
+    """
+    return (result['name'], result['dtype'], result['layout'], result['size'], result['implementation'])
+
+def print_table(results, reference = None):
+    """
+    Print the results of the benchmarks.
+
+    Parameters
+    ----------
+    results : list of dict
+        The results.
+    reference : dict, optional
+        The results of a previous run indexed by `key`. The ratio between the
+        current and the previous times is printed.
+    """
+    baseline = {key(r)[:4] : r for r in results if r['implementation'] in ('numpy', 'python')}
+    header = f"{'benchmark':<20}{'dtype':<9}{'layout':<9}{'size':>9}{'impl':>8}{'ns/call':>14}{'GB/s':>9}{'vs numpy':>10}"
+    if reference:
+        header += f"{'vs ref':>9}"
+    print(header)
+    for r in results:
+        gbps = '' if r['gb_per_s'] is None else f"{r['gb_per_s']:.2f}"
+        base = baseline.get(key(r)[:4])
+        ratio = '' if base is None or base is r else f"{r['ns_per_call'] / base['ns_per_call']:.2f}"
+        line = (f"{r['name']:<20}{r['dtype']:<9}{r['layout']:<9}{r['size']:>9}{r['implementation']:>8}"
+                f"{r['ns_per_call']:>14.1f}{gbps:>9}{ratio:>10}")
+        if reference:
+            ref = reference.get(key(r))
+            line += f"{r['ns_per_call'] / ref['ns_per_call']:>9.2f}" if ref else f"{'':>9}"
+        print(line)
+
+def compare(results, reference, tolerance):
+    """
+    Find the cases which are slower than in a previous run.
+
+    Parameters
+    ----------
+    results : list of dict
+        The results of the current run.
+    reference : dict
+        The results of a previous run indexed by `key`.
+    tolerance : float
+        The relative slowdown which is accepted.
+
+    Returns
+    -------
+    list of tuple
+        The cases which are slower, with their (current, previous) times.
+    """
+    slower = []
+    for r in results:
+        ref = reference.get(key(r))
+        if ref and r['implementation'] == 'pyccel' and r['ns_per_call'] > ref['ns_per_call'] * (1 + tolerance):
+            slower.append((key(r), r['ns_per_call'], ref['ns_per_call']))
+    return slower
+
+#==============================================================================
+def main():
+    """
+    Run the benchmarks, print them and save or compare them if requested.
+    """
+    parser = argparse.ArgumentParser(description='Benchmark the C runtime of Pyccel and the generated wrappers.')
+    parser.add_argument('--quick', action='store_true', help='only measure the small arrays')
+    parser.add_argument('--min-time', type=float, default=0.2, help='minimum time of each measurement in seconds')
+    parser.add_argument('--compiler', default=os.environ.get('CC', 'gcc'), help='C compiler used for the runtime')
+    parser.add_argument('--flags', default='-O3 -funroll-loops', help='flags used to compile the runtime')
+    parser.add_argument('--language', choices=('c', 'fortran'), default='c', help='language of the wrapper benchmarks')
+    parser.add_argument('--groups', default='runtime,numpy,wrapper',
+                        help='comma separated groups of benchmarks (runtime, numpy, wrapper)')
+    parser.add_argument('--output', help='JSON file where the results are saved')
+    parser.add_argument('--compare', help='JSON file of a previous run to compare to')
+    parser.add_argument('--tolerance', type=float, default=0.1,
+                        help='relative slowdown reported as a regression by --compare')
+    args = parser.parse_args()
+
+    groups = args.groups.split(',')
+    compiler = shutil.which(args.compiler) or args.compiler
+    if np is None and ('numpy' in groups or 'wrapper' in groups):
+        print('NumPy is not installed, only the runtime benchmarks are run', file = sys.stderr)
+        groups = ['runtime']
+
+    results = run_runtime_benchmarks(compiler, args.flags.split(), args.quick, args.min_time)
+    runtime_results = results
+    if 'runtime' not in groups:
+        results = []
+    if 'numpy' in groups:
+        results += run_numpy_benchmarks(runtime_results, args.min_time)
+    if 'wrapper' in groups:
+        results += run_wrapper_benchmarks(args.language, args.quick, args.min_time)
+    results.sort(key = lambda r: (r['name'], r['dtype'], r['layout'], r['size']))
+
+    reference = None
+    if args.compare:
+        with open(args.compare, 'r', encoding = 'utf-8') as f:
+            reference = {key(r) : r for r in json.load(f)['results']}
+
+    print_table(results, reference)
+
+    if args.output:
+        with open(args.output, 'w', encoding = 'utf-8') as f:
+            json.dump({'machine' : describe_machine(compiler),
+                       'settings' : {'flags' : args.flags, 'min_time' : args.min_time, 'quick' : args.quick},
+                       'results' : results}, f, indent = 1)
+
+    if reference:
+        slower = compare(results, reference, args.tolerance)
+        for (name, dtype, layout, size, _), time, ref_time in slower:
+            print(f'Regression: {name} {dtype} {layout} {size}: {time:.1f} ns/call instead of {ref_time:.1f}')
+        if slower:
+            sys.exit(1)
+
+if __name__ == '__main__':
+    main()
@@ -15,7 +15,7 @@ from .core       import ClassDef, PyccelFunctionDef
 from .datatypes  import (PythonNativeBool, PythonNativeInt, PythonNativeFloat,
                          PythonNativeComplex, StringType, TupleType, CustomDataType,
                          HomogeneousListType, HomogeneousSetType)
-from .numpyext   import (NumpyShape, NumpySum, NumpyAmin, NumpyAmax,
+from .numpyext   import (NumpyShape, NumpySum, NumpyAmin, NumpyAmax, NumpyProduct,
                          NumpyImag, NumpyReal, NumpyTranspose,
                          NumpyConjugate, NumpySize, NumpyResultType, NumpyArray)
 from .numpytypes import NumpyNumericType, NumpyNDArrayType
@@ -185,6 +185,8 @@ NumpyArrayClass = ClassDef('numpy.ndarray',
                 decorators = {'numpy_wrapper': 'numpy_wrapper'}),
             PyccelFunctionDef('max', func_class = NumpyAmax,
                 decorators = {'numpy_wrapper': 'numpy_wrapper'}),
+            PyccelFunctionDef('prod', func_class = NumpyProduct,
+                decorators = {'numpy_wrapper': 'numpy_wrapper'}),
             PyccelFunctionDef('imag', func_class = NumpyImag,
                 decorators = {'property': 'property', 'numpy_wrapper': 'numpy_wrapper'}),
             PyccelFunctionDef('real', func_class = NumpyReal,
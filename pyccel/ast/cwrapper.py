@@ -24,7 +24,7 @@ from .datatypes import PrimitiveBooleanType, PrimitiveIntegerType, PrimitiveFloa
 
 from .core      import FunctionDefArgument, FunctionDefResult
 from .core      import FunctionDef, ClassDef
-from .core      import Module, Interface, Declare
+from .core      import Module, Interface, Declare, CodeBlock
 
 from .c_concepts import ObjectAddress, CNativeInt
 
@@ -50,6 +50,7 @@ __all__ = (
     'PyModule',
     'PyArgKeywords',
     'PyArg_ParseTupleNode',
+    'PyAllowThreads',
     'PyBuildValueNode',
     'PyCapsule_New',
     'PyCapsule_Import',
@@ -57,6 +58,9 @@ __all__ = (
     'PyModule_Create',
     'PyModule_AddObject',
     'PyModInitFunc',
+    'PyUFunc',
+    'PyUFuncLoop',
+    'PyUFunc_FromFuncAndDataAndSignature',
 #--------- CONSTANTS ----------
     'Py_True',
     'Py_False',
@@ -250,6 +254,38 @@ class PyArg_ParseTupleNode(PyccelAstNode):
         """
         return self._arg_names
 
+#-------------------------------------------------------------------
+class PyAllowThreads(PyccelAstNode):
+    """
+    Represents a block of code which is run without holding the GIL.
+
+    Represents a block of code surrounded by the macros `Py_BEGIN_ALLOW_THREADS`
+    and `Py_END_ALLOW_THREADS` from `Python.h`. The GIL is released at the start
+    of the block and reacquired at the end so other Python threads can run
+    while the code is executed. The code must therefore not use any Python
+    objects.
+
+    Parameters
+    ----------
+    body : iterable of PyccelAstNode
+        The code which is run without holding the GIL.
+    """
+    __slots__ = ('_body',)
+    _attribute_nodes = ('_body',)
+
+    def __init__(self, body):
+        self._body = CodeBlock(body)
+        super().__init__()
+
+    @property
+    def body(self):
+        """
+        The code which is run without holding the GIL.
+
+        The CodeBlock containing the code which is run without holding the GIL.
+        """
+        return self._body
+
 #-------------------------------------------------------------------
 class PyBuildValueNode(PyccelInternalFunction):
     """
@@ -471,6 +507,241 @@ class PyCapsule_Import(PyccelInternalFunction):
         """
         return self._capsule_name
 
+#-------------------------------------------------------------------
+class PyUFuncLoop(PyccelAstNode):
+    """
+    Represents the inner loop of a NumPy universal function.
+
+    Represents a function with the signature of a `PyUFuncGenericFunction`
+    from `numpy/ufuncobject.h`. The function loops over the elements of the
+    operands, collects the elements of the inputs into the operand variables,
+    runs the body (which calls the translated function) and saves the operand
+    variables of the outputs into the elements of the outputs. The operands
+    which are arrays describe the core dimensions of a generalised ufunc.
+    See <https://numpy.org/doc/stable/user/c-info.ufunc-tutorial.html>.
+
+    Parameters
+    ----------
+    name : str
+        The name of the function.
+
+    operands : iterable of Variable
+        The variables describing the element of each input then each output.
+
+    n_inputs : int
+        The number of inputs of the ufunc.
+
+    index : Variable
+        The index of the element in the loop.
+
+    body : iterable of PyccelAstNode
+        The code which is run for each element.
+
+    scope : Scope
+        The scope of the function.
+    """
+    __slots__ = ('_name', '_operands', '_n_inputs', '_index', '_body', '_scope')
+    _attribute_nodes = ('_operands', '_index', '_body')
+
+    def __init__(self, name, operands, n_inputs, index, body, scope):
+        self._name = name
+        self._operands = tuple(operands)
+        self._n_inputs = n_inputs
+        self._index = index
+        self._body = CodeBlock(body)
+        self._scope = scope
+        super().__init__()
+
+    @property
+    def name(self):
+        """
+        The name of the function.
+        """
+        return self._name
+
+    @property
+    def operands(self):
+        """
+        The variables describing the element of each operand.
+
+        The variables describing the element of each input then each output.
+        The variables of the inputs which are arrays are views describing the
+        core dimensions of the element.
+        """
+        return self._operands
+
+    @property
+    def index(self):
+        """
+        The index of the element in the loop.
+        """
+        return self._index
+
+    @property
+    def inputs(self):
+        """
+        The variables describing the element of each input.
+        """
+        return self._operands[:self._n_inputs]
+
+    @property
+    def outputs(self):
+        """
+        The variables describing the element of each output.
+        """
+        return self._operands[self._n_inputs:]
+
+    @property
+    def body(self):
+        """
+        The code which is run for each element.
+        """
+        return self._body
+
+    @property
+    def scope(self):
+        """
+        The scope of the function.
+        """
+        return self._scope
+
+#-------------------------------------------------------------------
+class PyUFunc(PyccelAstNode):
+    """
+    Represents a NumPy universal function.
+
+    Represents a NumPy universal function (ufunc) exposed by a module. The
+    ufunc has one inner loop per combination of types of the translated
+    function (one per function of a templated interface). The loops, and the
+    tables of loops and of types passed to NumPy, are printed in the module.
+    When some of the inputs are arrays the ufunc is a generalised ufunc (gufunc)
+    whose signature gives independent core dimensions to each array.
+
+    Parameters
+    ----------
+    name : str
+        The name used to prefix the tables of the ufunc in the module.
+
+    python_name : str
+        The name of the ufunc in Python.
+
+    loops : iterable of PyUFuncLoop
+        The inner loops of the ufunc.
+
+    types : iterable of iterable of Variable
+        The NumPy types of the operands of each loop.
+
+    signature : str, optional
+        The signature of a generalised ufunc.
+
+    docstring : str, optional
+        The docstring of the ufunc.
+    """
+    __slots__ = ('_name', '_python_name', '_loops', '_types', '_signature', '_docstring')
+    _attribute_nodes = ('_loops',)
+
+    def __init__(self, name, python_name, loops, types, signature = None, docstring = None):
+        self._name = name
+        self._python_name = python_name
+        self._loops = tuple(loops)
+        self._types = tuple(tuple(t) for t in types)
+        self._signature = signature
+        self._docstring = docstring
+        super().__init__()
+
+    @property
+    def name(self):
+        """
+        The name used to prefix the tables of the ufunc in the module.
+        """
+        return self._name
+
+    @property
+    def python_name(self):
+        """
+        The name of the ufunc in Python.
+        """
+        return self._python_name
+
+    @property
+    def loops(self):
+        """
+        The inner loops of the ufunc.
+        """
+        return self._loops
+
+    @property
+    def types(self):
+        """
+        The NumPy types of the operands of each loop.
+        """
+        return self._types
+
+    @property
+    def n_inputs(self):
+        """
+        The number of inputs of the ufunc.
+        """
+        return len(self._loops[0].inputs)
+
+    @property
+    def n_outputs(self):
+        """
+        The number of outputs of the ufunc.
+        """
+        return len(self._loops[0].outputs)
+
+    @property
+    def signature(self):
+        """
+        The signature of a generalised ufunc.
+
+        The signature describing the core dimensions of the operands of a
+        generalised ufunc (e.g. `"(n0),()->()"`), or None for a ufunc
+        which only operates on scalars.
+        """
+        return self._signature
+
+    @property
+    def docstring(self):
+        """
+        The docstring of the ufunc.
+        """
+        return self._docstring
+
+#-------------------------------------------------------------------
+class PyUFunc_FromFuncAndDataAndSignature(PyccelInternalFunction):
+    """
+    Represents a call to the function PyUFunc_FromFuncAndDataAndSignature.
+
+    The function PyUFunc_FromFuncAndDataAndSignature can be found in
+    `numpy/ufuncobject.h`. It creates the Python object of a ufunc from
+    the tables of its inner loops and of their types.
+    See <https://numpy.org/doc/stable/reference/c-api/ufunc.html>.
+
+    Parameters
+    ----------
+    ufunc : PyUFunc
+        The ufunc being created.
+    """
+    __slots__ = ('_ufunc',)
+    _attribute_nodes = ()
+    _rank = 0
+    _shape = ()
+    _order = None
+    _class_type = PyccelPyObject()
+
+    def __init__(self, ufunc):
+        self._ufunc = ufunc
+        super().__init__()
+
+    @property
+    def ufunc(self):
+        """
+        The ufunc being created.
+        """
+        return self._ufunc
+
 #-------------------------------------------------------------------
 class PyModule(Module):
     """
@@ -505,6 +776,9 @@ class PyModule(Module):
         modules.
         See: <https://docs.python.org/3/extending/extending.html>.
 
+    ufuncs : iterable of PyUFunc
+        The NumPy universal functions exposed by the module.
+
     **kwargs : dict
         See Module.
 
@@ -512,13 +786,14 @@ class PyModule(Module):
     --------
     Module : The super class from which the class inherits.
     """
-    __slots__ = ('_external_funcs', '_declarations', '_import_func')
-    _attribute_nodes = Module._attribute_nodes + ('_external_funcs', '_declarations', '_import_func')
+    __slots__ = ('_external_funcs', '_declarations', '_import_func', '_ufuncs')
+    _attribute_nodes = Module._attribute_nodes + ('_external_funcs', '_declarations', '_import_func', '_ufuncs')
 
     def __init__(self, name, *args, external_funcs = (), declarations = (), init_func = None,
-                        import_func = None, **kwargs):
+                        import_func = None, ufuncs = (), **kwargs):
         self._external_funcs = external_funcs
         self._declarations = declarations
+        self._ufuncs = tuple(ufuncs)
         if import_func is None:
             self._import_func = FunctionDef(f'{name}_import', (),
                             (FunctionDefResult(Variable(CNativeInt(), '_', is_temp=True)),), ())
@@ -564,6 +839,13 @@ class PyModule(Module):
         for d in decs:
             d.set_current_user_node(self)
 
+    @property
+    def ufuncs(self):
+        """
+        The NumPy universal functions exposed by the module.
+        """
+        return self._ufuncs
+
     @property
     def import_func(self):
         """
@@ -1023,7 +1305,7 @@ py_to_c_registry = {
     (PrimitiveComplexType(), 8)       : 'PyComplex_to_Complex128',
     }
 
-def C_to_Python(c_object):
+def C_to_Python(c_object, owns_data = False):
     """
     Create a FunctionDef responsible for casting scalar C results to Python.
 
@@ -1036,13 +1318,18 @@ def C_to_Python(c_object):
     c_object : Variable
         The variable needed for the generation of the cast_function.
 
+    owns_data : bool, default: False
+        For arrays, indicates whether the ownership of the data (allocated by
+        the C code) is transferred to the NumPy array. In this case the data
+        is not copied and it is freed when the NumPy array is deallocated.
+
     Returns
     -------
     FunctionDef
         The function which casts the C object to Python.
     """
     if c_object.rank != 0:
-        cast_function = 'ndarray_to_pyarray'
+        cast_function = 'owned_ndarray_to_pyarray' if owns_data else 'ndarray_to_pyarray'
         memory_handling = 'stack'
     else:
         try :
@@ -34,12 +34,16 @@ __all__ = (
     'PyccelPyArrayObject',
     #------- CAST FUNCTIONS ------
     'pyarray_to_ndarray',
+    'pyarray_export',
     #-------HELPERS ------
     'array_get_dim',
     'array_get_data',
     'array_get_c_step',
     'array_get_f_step',
     'PyArray_SetBaseObject',
+    #-------ERRORS--------
+    'pyc_error_occurred',
+    'pyc_raise_error',
     #-------OTHERS--------
     'get_numpy_max_acceptable_version_file',
 )
@@ -88,6 +92,14 @@ pyarray_to_ndarray = FunctionDef(
                 body      = [],
                 results   = [FunctionDefResult(Variable(NumpyNDArrayType(GenericType()), 'array'))])
 
+# array argument which is not a numpy array : function definition in pyccel/stdlib/cwrapper/cwrapper_ndarrays.c
+pyarray_export = FunctionDef(
+                name      = 'pyarray_export',
+                arguments = [FunctionDefArgument(Variable(PyccelPyObject(), 'a', memory_handling = 'alias')),
+                             FunctionDefArgument(Variable(PythonNativeBool(), 'writable'))],
+                body      = [],
+                results   = [FunctionDefResult(Variable(PyccelPyObject(), 'o', memory_handling = 'alias'))])
+
 # numpy array check elements : function definition in pyccel/stdlib/cwrapper/cwrapper_ndarrays.c
 pyarray_check = FunctionDef(
                 name      = 'pyarray_check',
@@ -111,6 +123,18 @@ is_numpy_array = FunctionDef(
                 body      = [],
                 results   = [FunctionDefResult(Variable(PythonNativeBool(), 'b'))])
 
+# errors recorded by the runtime : function definitions in pyccel/stdlib/ndarrays/ndarrays.c
+# and pyccel/stdlib/cwrapper/cwrapper_ndarrays.c
+pyc_error_occurred = FunctionDef(name = 'pyc_error_occurred',
+                           arguments = [],
+                           body      = [],
+                           results   = [FunctionDefResult(Variable(PythonNativeBool(), 'b'))])
+
+pyc_raise_error = FunctionDef(name = 'pyc_raise_error',
+                           arguments = [],
+                           body      = [],
+                           results   = [])
+
 # Return the shape of the n-th dimension : function definition in pyccel/stdlib/cwrapper/cwrapper_ndarrays.c
 array_get_dim  = FunctionDef(name    = 'nd_ndim',
                            body      = [],
@@ -144,6 +168,8 @@ PyArray_SetBaseObject = FunctionDef(name   = 'PyArray_SetBaseObject',
 
 import_array = FunctionDef('import_array', (), (), ())
 
+import_umath = FunctionDef('import_umath', (), (), ())
+
 # Basic Array Flags
 # https://numpy.org/doc/stable/reference/c-api/array.html#c.NPY_ARRAY_OWNDATA
 numpy_flag_own_data     = Variable(CNativeInt(),  name = 'NPY_ARRAY_OWNDATA')
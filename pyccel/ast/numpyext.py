@@ -20,10 +20,10 @@ from .builtins       import (PythonInt, PythonBool, PythonFloat, PythonTuple,
 
 from .core           import Module, Import, PyccelFunctionDef, FunctionCall
 
-from .datatypes      import PythonNativeBool, PythonNativeInt, PythonNativeFloat
+from .datatypes      import PythonNativeBool, PythonNativeInt, PythonNativeFloat, VoidType
 from .datatypes      import PrimitiveBooleanType, PrimitiveIntegerType, PrimitiveFloatingPointType, PrimitiveComplexType
 from .datatypes      import HomogeneousTupleType, FixedSizeNumericType, GenericType, HomogeneousContainerType
-from .datatypes      import InhomogeneousTupleType, ContainerType
+from .datatypes      import InhomogeneousTupleType, ContainerType, StringType
 
 from .internals      import PyccelInternalFunction, Slice
 from .internals      import PyccelArraySize, PyccelArrayShapeElement
@@ -35,7 +35,7 @@ from .mathext        import MathCeil
 from .numpytypes     import NumpyNumericType, NumpyInt8Type, NumpyInt16Type, NumpyInt32Type, NumpyInt64Type
 from .numpytypes     import NumpyFloat32Type, NumpyFloat64Type, NumpyFloat128Type, NumpyNDArrayType
 from .numpytypes     import NumpyComplex64Type, NumpyComplex128Type, NumpyComplex256Type, numpy_precision_map
-from .operators      import broadcast, PyccelMinus, PyccelDiv, PyccelMul, PyccelAdd
+from .operators      import broadcast, PyccelMinus, PyccelDiv, PyccelMul, PyccelAdd, PyccelUnarySub
 from .type_annotations import typenames_to_dtypes as dtype_registry
 from .variable       import Variable, Constant, IndexedElement
 
@@ -75,6 +75,7 @@ __all__ = (
     'NumpyAmin',
     'NumpyArange',
     'NumpyArray',
+    'NumpyArrayFromFile',
     'NumpySize',
     'NumpyBool',
     'NumpyCountNonZero',
@@ -89,6 +90,7 @@ __all__ = (
     'NumpyFloat32',
     'NumpyFloat64',
     'NumpyFull',
+    'NumpyGcd',
     'NumpyFullLike',
     'NumpyImag',
     'NumpyHypot',
@@ -97,8 +99,11 @@ __all__ = (
     'NumpyInt16',
     'NumpyInt32',
     'NumpyInt64',
+    'NumpyLcm',
     'NumpyLinspace',
+    'NumpyLoad',
     'NumpyMatmul',
+    'NumpyMemmap',
     'NumpyNewArray',
     'NumpyMod',
     'NumpyNonZero',
@@ -108,8 +113,11 @@ __all__ = (
     'NumpyOnes',
     'NumpyOnesLike',
     'NumpyProduct',
+    'NumpyReduction',
     'NumpyRand',
     'NumpyRandint',
+    'NumpyRandomNormal',
+    'NumpyRandomSeed',
     'NumpyReal',
     'NumpyResultType',
     'NumpyTranspose',
@@ -811,7 +819,102 @@ class NumpyArange(NumpyNewArray):
         return PyccelAdd(self.start, step, simplify=True)
 
 #==============================================================================
-class NumpySum(PyccelInternalFunction):
+class NumpyReduction(PyccelInternalFunction):
+    """
+    Base class for the NumPy functions which reduce an array.
+
+    Base class for the NumPy functions which reduce an array (e.g. sum, prod,
+    amax, amin), either to a scalar or along one of its axes. The reduction
+    of a vector along its only axis is a scalar so it is handled as the
+    reduction of the whole array.
+
+    Parameters
+    ----------
+    arg : TypedAstNode
+        The array which is reduced.
+    axis : LiteralInteger, optional
+        The axis along which the array is reduced. By default the whole array
+        is reduced to a scalar.
+    keepdims : LiteralTrue | LiteralFalse
+        Indicates if the result should have the same number of dimensions as
+        the argument (the reduced axis then has a length of 1).
+    """
+    __slots__ = ('_axis', '_keep_dims', '_shape', '_rank', '_order')
+
+    def __init__(self, arg, axis = None, keepdims = LiteralFalse()):
+        if not isinstance(arg, TypedAstNode):
+            raise TypeError('Unknown type of  %s.' % type(arg))
+        if not isinstance(keepdims, (LiteralTrue, LiteralFalse)):
+            errors.report(NON_LITERAL_KEEP_DIMS, symbol=keepdims, severity="fatal")
+        # Negative axes are counted from the end
+        if isinstance(axis, PyccelUnarySub) and isinstance(axis.args[0], LiteralInteger):
+            axis_value = -axis.args[0].python_value
+        elif isinstance(axis, LiteralInteger):
+            axis_value = axis.python_value
+        elif axis is not None:
+            errors.report(NON_LITERAL_AXIS, symbol=axis, severity="fatal")
+
+        if axis is not None:
+            if not -arg.rank <= axis_value < arg.rank:
+                errors.report(f"axis {axis_value} is out of bounds for an array of rank {arg.rank}",
+                        symbol=axis, severity="fatal")
+            axis = LiteralInteger(axis_value % arg.rank)
+            if arg.rank == 1 and not keepdims.python_value:
+                axis = None
+        elif keepdims.python_value:
+            if arg.rank > 1:
+                errors.report("keepdims is only supported for reductions along an axis",
+                        symbol=keepdims, severity="fatal")
+            axis = LiteralInteger(0)
+
+        self._axis = axis
+        self._keep_dims = keepdims
+        if axis is None:
+            self._rank  = 0
+            self._shape = None
+            self._order = None
+        else:
+            shape = list(arg.shape)
+            if keepdims.python_value:
+                shape[axis.python_value] = LiteralInteger(1)
+            else:
+                shape.pop(axis.python_value)
+            self._shape = tuple(shape)
+            self._rank  = len(shape)
+            self._order = arg.order if self._rank > 1 else None
+        super().__init__(arg)
+
+    @property
+    def arg(self):
+        """
+        The array which is reduced.
+
+        The array which is reduced.
+        """
+        return self._args[0]
+
+    @property
+    def axis(self):
+        """
+        The axis along which the array is reduced.
+
+        The axis (a positive LiteralInteger) along which the array is
+        reduced, or None if the whole array is reduced to a scalar.
+        """
+        return self._axis
+
+    @property
+    def keep_dims(self):
+        """
+        Indicates if the result has the same number of dimensions as the argument.
+
+        Indicates if the result has the same number of dimensions as the
+        argument, the reduced axis has a length of 1.
+        """
+        return self._keep_dims
+
+#==============================================================================
+class NumpySum(NumpyReduction):
     """
     Represents a call to  numpy.sum for code generation.
 
@@ -821,30 +924,26 @@ class NumpySum(PyccelInternalFunction):
     ----------
     arg : list , tuple , PythonTuple, PythonList, Variable
         The argument passed to the sum function.
+    axis : LiteralInteger, optional
+        The axis along which the sum is computed.
+    keepdims : LiteralTrue | LiteralFalse
+        Indicates if the result has the same number of dimensions as arg.
     """
     __slots__ = ('_class_type',)
     name = 'sum'
-    _rank  = 0
-    _shape = None
-    _order = None
 
-    def __init__(self, arg):
-        if not isinstance(arg, TypedAstNode):
-            raise TypeError('Unknown type of  %s.' % type(arg))
-        super().__init__(arg)
+    def __init__(self, arg, axis = None, *, keepdims = LiteralFalse()):
+        super().__init__(arg, axis, keepdims)
         lowest_possible_type = process_dtype(PythonNativeInt())
         if isinstance(arg.dtype.primitive_type, (PrimitiveBooleanType, PrimitiveIntegerType)) and \
                 arg.dtype.precision <= lowest_possible_type.precision:
-            self._class_type = lowest_possible_type
+            dtype = lowest_possible_type
         else:
-            self._class_type = process_dtype(arg.dtype)
-
-    @property
-    def arg(self):
-        return self._args[0]
+            dtype = process_dtype(arg.dtype)
+        self._class_type = NumpyNDArrayType(dtype) if self._rank else dtype
 
 #==============================================================================
-class NumpyProduct(PyccelInternalFunction):
+class NumpyProduct(NumpyReduction):
     """
     Represents a call to numpy.prod for code generation.
 
@@ -854,32 +953,42 @@ class NumpyProduct(PyccelInternalFunction):
     ----------
     arg : list , tuple , PythonTuple, PythonList, Variable
         The argument passed to the prod function.
+    axis : LiteralInteger, optional
+        The axis along which the product is computed.
+    keepdims : LiteralTrue | LiteralFalse
+        Indicates if the result has the same number of dimensions as arg.
     """
     __slots__ = ('_arg','_class_type')
     name = 'product'
-    _rank  = 0
-    _shape = None
-    _order = None
 
-    def __init__(self, arg):
-        if not isinstance(arg, TypedAstNode):
-            raise TypeError('Unknown type of  %s.' % type(arg))
-        super().__init__(arg)
+    def __init__(self, arg, axis = None, *, keepdims = LiteralFalse()):
+        super().__init__(arg, axis, keepdims)
         self._arg = PythonList(arg) if arg.rank == 0 else self._args[0]
         lowest_possible_type = process_dtype(PythonNativeInt())
         if isinstance(arg.dtype.primitive_type, (PrimitiveBooleanType, PrimitiveIntegerType)) and \
                 arg.dtype.precision <= lowest_possible_type.precision:
-            self._class_type = lowest_possible_type
+            dtype = lowest_possible_type
         else:
-            self._class_type = process_dtype(arg.dtype)
+            dtype = process_dtype(arg.dtype)
 
-        default_cast = DtypePrecisionToCastFunction[self._class_type]
-        self._arg = default_cast(self._arg) if arg.dtype != self._class_type else self._arg
+        default_cast = DtypePrecisionToCastFunction[dtype]
+        self._arg = default_cast(self._arg) if arg.dtype != dtype else self._arg
+        self._class_type = NumpyNDArrayType(dtype) if self._rank else dtype
 
     @property
     def arg(self):
         return self._arg
 
+    @property
+    def python_arg(self):
+        """
+        The argument of numpy.prod without the cast.
+
+        The argument of numpy.prod without the cast to the type of the
+        result, which is used by the C runtime.
+        """
+        return self._args[0]
+
 
 #==============================================================================
 class NumpyMatmul(PyccelInternalFunction):
@@ -1107,6 +1216,177 @@ class NumpyLinspace(NumpyNewArray):
     def is_elemental(self):
         return True
 
+#==============================================================================
+class NumpyArrayFromFile(PyccelInternalFunction):
+    """
+    Superclass for nodes representing NumPy functions which create an array from a file.
+
+    Class from which all nodes representing a NumPy function which returns an
+    array whose data is stored in a file should inherit. The data is either read
+    into memory or mapped in memory by the runtime so, unlike `NumpyNewArray`,
+    these functions do not imply a call to `Allocate`.
+
+    Parameters
+    ----------
+    filename : TypedAstNode
+        The name of the file.
+    mode : str, LiteralString, Nil, optional
+        The mode used to map the data in memory ('r', 'r+', 'w+' or 'c', see
+        `numpy.memmap`). If no mode is provided the data is read into memory.
+    dtype : PyccelType
+        The datatype of the array.
+    shape : tuple of TypedAstNode
+        The shape of the array.
+    order : str
+        The order of the array ('C' or 'F').
+    *args : tuple of TypedAstNode
+        Any other arguments of the superclass PyccelInternalFunction.
+    """
+    __slots__ = ('_mode', '_class_type', '_shape', '_rank', '_order')
+    _modes = ('r', 'r+', 'w+', 'c')
+
+    def __init__(self, filename, mode, dtype, shape, order, *args):
+        if not isinstance(filename, TypedAstNode) or filename.class_type is not StringType():
+            raise TypeError("The name of the file must be a string.")
+
+        if isinstance(mode, LiteralString):
+            mode = mode.python_value
+        elif isinstance(mode, Nil):
+            mode = None
+        if mode not in (None, *self._modes):
+            raise TypeError(f"The mode must be one of {', '.join(self._modes)}.")
+
+        self._mode = mode
+        self._class_type = NumpyNDArrayType(dtype)
+        self._shape = shape
+        self._rank = len(shape)
+        self._order = NumpyNewArray._process_order(self._rank, order)
+        super().__init__(filename, *args)
+
+    @property
+    def filename(self):
+        """
+        The name of the file where the data of the array is stored.
+
+        The name of the file where the data of the array is stored.
+        """
+        return self._args[0]
+
+    @property
+    def mode(self):
+        """
+        The mode used to map the data in memory.
+
+        The mode used to map the data in memory ('r', 'r+', 'w+' or 'c'). If
+        the data is read into memory this is `None`.
+        """
+        return self._mode
+
+#==============================================================================
+class NumpyLoad(NumpyArrayFromFile):
+    """
+    Represents a call to `numpy.load` for code generation.
+
+    Represents a call to the NumPy function `load` which reads an array
+    stored in a `.npy` file. The type, the rank and the order of the array
+    cannot be read from the file when the code is translated so they are
+    taken from the type annotation of the variable to which the result is
+    assigned (e.g. `x : 'float[:,:]' = np.load('x.npy', mmap_mode='r')`).
+    The shape is read from the header of the file when the code is run.
+
+    Parameters
+    ----------
+    file : TypedAstNode
+        The name of the file.
+    mmap_mode : str, LiteralString, Nil, optional
+        The mode used to map the data in memory ('r', 'r+' or 'c'). If no mode
+        is provided the data is read into memory.
+    allow_pickle : bool, LiteralFalse, optional
+        Indicates if pickled objects can be loaded. This is not supported.
+    annotation : VariableTypeAnnotation, optional
+        The type annotation of the variable to which the result is assigned.
+        This argument is added by the semantic stage.
+    """
+    __slots__ = ()
+    _modes = ('r', 'r+', 'c')
+    name = 'load'
+
+    def __init__(self, file, mmap_mode=None, allow_pickle=False, annotation=None):
+        if not (allow_pickle is False or isinstance(allow_pickle, LiteralFalse)):
+            raise TypeError("Pickled objects cannot be loaded.")
+        if annotation is None or not isinstance(annotation.class_type, NumpyNDArrayType):
+            raise TypeError("The type of the array returned by numpy.load must be specified "
+                            "by annotating the variable to which it is assigned "
+                            "(e.g. x : 'float[:]' = numpy.load(...)).")
+
+        rank = annotation.rank
+        order = annotation.order or 'C'
+        super().__init__(file, mmap_mode, process_dtype(annotation.class_type.element_type),
+                         (None,)*rank, order)
+
+#==============================================================================
+class NumpyMemmap(NumpyArrayFromFile):
+    """
+    Represents a call to `numpy.memmap` for code generation.
+
+    Represents a call to the NumPy function `memmap` which maps an array
+    stored in a binary file in memory. The data of the array is only read
+    from the file when it is accessed. The type and the shape of the array
+    must be provided.
+
+    Parameters
+    ----------
+    filename : TypedAstNode
+        The name of the file.
+    dtype : PythonType, PyccelFunctionDef, LiteralString, str
+        The datatype of the array.
+    mode : str, LiteralString, optional
+        The mode used to map the data in memory ('r', 'r+', 'w+' or 'c').
+    offset : TypedAstNode, int, optional
+        The offset of the data in the file (in bytes).
+    shape : TypedAstNode, iterable, optional
+        The shape of the array.
+    order : str, LiteralString, optional
+        The order of the array ('C' or 'F').
+    """
+    __slots__ = ('_init_dtype',)
+    name = 'memmap'
+
+    def __init__(self, filename, dtype=None, mode='r+', offset=0, shape=None, order='C'):
+        if dtype is None:
+            raise TypeError("The type of the array must be provided.")
+        if shape is None:
+            raise TypeError("The shape of the array must be provided.")
+        if isinstance(offset, int):
+            offset = LiteralInteger(offset)
+        if offset.rank != 0 or not isinstance(getattr(offset.dtype, 'primitive_type', None), PrimitiveIntegerType):
+            raise TypeError("The offset must be an integer.")
+        if mode is None or isinstance(mode, Nil):
+            raise TypeError("The mode must be provided.")
+
+        shape = process_shape(False, shape)
+        order = order.python_value if isinstance(order, LiteralString) else order
+        self._init_dtype = dtype
+        super().__init__(filename, mode, process_dtype(dtype), shape, order, offset, *shape)
+
+    @property
+    def init_dtype(self):
+        """
+        The dtype provided to the function when it was initialised in Python.
+
+        The dtype provided to the function when it was initialised in Python.
+        """
+        return self._init_dtype
+
+    @property
+    def offset(self):
+        """
+        The offset of the data in the file.
+
+        The offset of the data in the file (in bytes).
+        """
+        return self._args[1]
+
 #==============================================================================
 class NumpyWhere(PyccelInternalFunction):
     """
@@ -1260,6 +1540,98 @@ class NumpyRandint(PyccelInternalFunction):
         """ return low property of NumpyRandint"""
         return self._low
 
+#==============================================================================
+class NumpyRandomNormal(PyccelInternalFunction):
+    """
+    Represents a call to numpy.random.normal for code generation.
+
+    Represents a call to the NumPy function `normal` which draws numbers
+    from a normal (Gaussian) distribution.
+
+    Parameters
+    ----------
+    loc : TypedAstNode, default=0.0
+        The mean of the distribution.
+    scale : TypedAstNode, default=1.0
+        The standard deviation of the distribution.
+    size : TypedAstNode, optional
+        The shape of the array that will be generated. If no size is provided
+        a single number is generated.
+    """
+    __slots__ = ('_shape','_rank','_order','_class_type')
+    name = 'normal'
+
+    def __init__(self, loc = LiteralFloat(0.0), scale = LiteralFloat(1.0), size = None):
+        if loc.rank > 0 or scale.rank > 0:
+            raise TypeError("The parameters of numpy.random.normal must be scalars")
+        if size is not None and not hasattr(size,'__iter__'):
+            size = (size,)
+
+        self._shape = None if size is None else tuple(size)
+        self._rank  = 0 if size is None else len(self._shape)
+        self._order = None if self._rank < 2 else 'C'
+        if self._rank == 0:
+            self._class_type = PythonNativeFloat()
+        else:
+            self._class_type = NumpyNDArrayType(NumpyFloat64Type())
+        super().__init__(loc, scale)
+
+    @property
+    def loc(self):
+        """
+        The mean of the distribution.
+
+        The mean of the distribution.
+        """
+        return self._args[0]
+
+    @property
+    def scale(self):
+        """
+        The standard deviation of the distribution.
+
+        The standard deviation of the distribution.
+        """
+        return self._args[1]
+
+#==============================================================================
+class NumpyRandomSeed(PyccelInternalFunction):
+    """
+    Represents a call to numpy.random.seed for code generation.
+
+    Represents a call to the NumPy function `seed` which resets the random
+    number generator used by the other functions of numpy.random.
+
+    Parameters
+    ----------
+    seed : TypedAstNode, optional
+        The integer seed. If no seed is provided (or if it is None) the
+        generator is seeded unpredictably.
+    """
+    __slots__ = ()
+    name = 'seed'
+    _class_type = VoidType()
+    _rank  = 0
+    _shape = None
+    _order = None
+
+    def __init__(self, seed = None):
+        if isinstance(seed, Nil):
+            seed = None
+        if seed is not None and (not isinstance(seed.dtype.primitive_type, PrimitiveIntegerType) \
+                or seed.rank > 0):
+            raise TypeError("The seed of numpy.random.seed must be an integer")
+        super().__init__(*([] if seed is None else [seed]))
+
+    @property
+    def seed(self):
+        """
+        The integer seed.
+
+        The integer seed or None if the generator is seeded unpredictably.
+        """
+        return self._args[0] if self._args else None
+
 #==============================================================================
 class NumpyFull(NumpyNewArray):
     """
@@ -2051,7 +2423,47 @@ class NumpyMod(NumpyUfuncBinary):
                 arg_dtype = arg_class_type
             return process_dtype(arg_dtype)
 
-class NumpyAmin(PyccelInternalFunction):
+class NumpyGcd(NumpyMod):
+    """
+    Represent a call to the `numpy.gcd` function.
+
+    Represent a call to the gcd function in the Numpy library which
+    computes the greatest common divisor of integers element-wise.
+
+    Parameters
+    ----------
+    x1 : TypedAstNode
+        The first integer argument.
+    x2 : TypedAstNode
+        The second integer argument.
+    """
+    __slots__ = ()
+    name = 'gcd'
+
+    def __init__(self, x1, x2):
+        super().__init__(x1, x2)
+        if self.dtype.primitive_type is not PrimitiveIntegerType():
+            errors.report(f"numpy.{self.name} is only supported for integer arguments",
+                    symbol=self, severity="fatal")
+
+class NumpyLcm(NumpyGcd):
+    """
+    Represent a call to the `numpy.lcm` function.
+
+    Represent a call to the lcm function in the Numpy library which
+    computes the least common multiple of integers element-wise.
+
+    Parameters
+    ----------
+    x1 : TypedAstNode
+        The first integer argument.
+    x2 : TypedAstNode
+        The second integer argument.
+    """
+    __slots__ = ()
+    name = 'lcm'
+
+class NumpyAmin(NumpyReduction):
     """
     Represents a call to  numpy.min for code generation.
 
@@ -2061,15 +2473,16 @@ class NumpyAmin(PyccelInternalFunction):
     ----------
     arg : array_like
         The input array for which the minimum argument is calculated.
+    axis : LiteralInteger, optional
+        The axis along which the minimum is computed.
+    keepdims : LiteralTrue | LiteralFalse
+        Indicates if the result has the same number of dimensions as arg.
     """
     __slots__ = ('_class_type',)
     name = 'amin'
-    _rank = 0
-    _shape = None
-    _order = None
-    def __init__(self, arg):
-        super().__init__(arg)
-        self._class_type = arg.dtype
+    def __init__(self, arg, axis = None, *, keepdims = LiteralFalse()):
+        super().__init__(arg, axis, keepdims)
+        self._class_type = NumpyNDArrayType(arg.dtype) if self._rank else arg.dtype
 
     @property
     def arg(self):
@@ -2080,7 +2493,7 @@ class NumpyAmin(PyccelInternalFunction):
         """
         return self._args[0]
 
-class NumpyAmax(PyccelInternalFunction):
+class NumpyAmax(NumpyReduction):
     """
     Represents a call to  numpy.max for code generation.
 
@@ -2090,15 +2503,16 @@ class NumpyAmax(PyccelInternalFunction):
     ----------
     arg : array_like
         The input array for which the maximum argument is calculated.
+    axis : LiteralInteger, optional
+        The axis along which the maximum is computed.
+    keepdims : LiteralTrue | LiteralFalse
+        Indicates if the result has the same number of dimensions as arg.
     """
     __slots__ = ('_class_type',)
     name = 'amax'
-    _rank = 0
-    _shape = None
-    _order = None
-    def __init__(self, arg):
-        super().__init__(arg)
-        self._class_type = arg.dtype
+    def __init__(self, arg, axis = None, *, keepdims = LiteralFalse()):
+        super().__init__(arg, axis, keepdims)
+        self._class_type = NumpyNDArrayType(arg.dtype) if self._rank else arg.dtype
 
     @property
     def arg(self):
@@ -2570,7 +2984,9 @@ numpy_linalg_mod = Module('linalg', (),
 numpy_random_mod = Module('random', (),
     [PyccelFunctionDef('rand'   , NumpyRand),
      PyccelFunctionDef('random' , NumpyRand),
-     PyccelFunctionDef('randint', NumpyRandint)])
+     PyccelFunctionDef('randint', NumpyRandint),
+     PyccelFunctionDef('normal' , NumpyRandomNormal),
+     PyccelFunctionDef('seed'   , NumpyRandomSeed)])
 
 numpy_constants = {
         'pi': Constant(PythonNativeFloat(), 'pi', value=numpy.pi),
@@ -2601,6 +3017,8 @@ numpy_funcs = {
     'float'     : PyccelFunctionDef('float'     , NumpyFloat),
     'double'    : PyccelFunctionDef('double'    , NumpyFloat64),
     'mod'       : PyccelFunctionDef('mod'       , NumpyMod),
+    'gcd'       : PyccelFunctionDef('gcd'       , NumpyGcd),
+    'lcm'       : PyccelFunctionDef('lcm'       , NumpyLcm),
     'float32'   : PyccelFunctionDef('float32'   , NumpyFloat32),
     'float64'   : PyccelFunctionDef('float64'   , NumpyFloat64),
     'bool'      : PyccelFunctionDef('bool'      , NumpyBool),
@@ -2620,6 +3038,8 @@ numpy_funcs = {
     'prod'      : PyccelFunctionDef('prod'      , NumpyProduct),
     'product'   : PyccelFunctionDef('product'   , NumpyProduct),
     'linspace'  : PyccelFunctionDef('linspace'  , NumpyLinspace),
+    'load'      : PyccelFunctionDef('load'      , NumpyLoad),
+    'memmap'    : PyccelFunctionDef('memmap'    , NumpyMemmap),
     'where'     : PyccelFunctionDef('where'     , NumpyWhere),
     # ---
     'isnan'     : PyccelFunctionDef('isnan'     , NumpyIsNan),
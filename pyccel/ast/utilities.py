@@ -12,7 +12,7 @@ from collections import namedtuple
 import pyccel.decorators as pyccel_decorators
 from pyccel.errors.errors import Errors, PyccelError
 
-from .core          import (AsName, Import, FunctionDef, FunctionCall,
+from .core          import (AsName, Import, FunctionDef, FunctionCall, AugAssign,
                             Allocate, Duplicate, Assign, For, CodeBlock,
                             Concatenate, Module, PyccelFunctionDef)
 
@@ -22,13 +22,15 @@ from .cmathext      import cmath_mod
 from .datatypes     import HomogeneousTupleType, PythonNativeInt
 from .internals     import PyccelInternalFunction, Slice
 from .itertoolsext  import itertools_mod
-from .literals      import LiteralInteger, LiteralEllipsis, Nil
+from .literals      import LiteralInteger, LiteralEllipsis, Nil, Literal
 from .mathext       import math_mod
 from .sysext        import sys_mod
 
 from .numpyext      import (NumpyEmpty, NumpyArray, numpy_mod,
-                            NumpyTranspose, NumpyLinspace)
-from .operators     import PyccelAdd, PyccelMul, PyccelIs, PyccelArithmeticOperator
+                            NumpyTranspose, NumpyLinspace, NumpyArrayFromFile,
+                            NumpyRandint, NumpyRandomNormal, NumpyAmax, NumpyAmin)
+from .operators     import PyccelAdd, PyccelMul, PyccelMinus, PyccelIs, PyccelArithmeticOperator
+from .operators     import PyccelUnarySub
 from .scipyext      import scipy_mod
 from .typingext     import typing_mod
 from .variable      import (Variable, IndexedElement, InhomogeneousTupleVariable )
@@ -42,6 +44,8 @@ __all__ = (
     'builtin_function',
     'builtin_import',
     'builtin_import_registry',
+    'may_alias',
+    'may_fail',
     'split_positional_keyword_arguments',
 )
 
@@ -331,10 +335,15 @@ def insert_index(expr, pos, index_var):
 
         else:
             # Calculate new index to preserve slice behaviour
-            if indices[pos].step is not None:
-                index_var = PyccelMul(index_var, indices[pos].step, simplify=True)
-            if indices[pos].start is not None:
-                index_var = PyccelAdd(index_var, indices[pos].start, simplify=True)
+            start = indices[pos].start
+            step = indices[pos].step
+            if start is None and isinstance(step, PyccelUnarySub):
+                # A slice with a negative step starts from the end of the dimension
+                start = PyccelMinus(base.shape[pos], LiteralInteger(1), simplify=True)
+            if step is not None:
+                index_var = PyccelMul(index_var, step, simplify=True)
+            if start is not None:
+                index_var = PyccelAdd(index_var, start, simplify=True)
 
         indices[pos] = index_var
         return IndexedElement(base, *indices)
@@ -351,7 +360,167 @@ def insert_index(expr, pos, index_var):
 
 #==============================================================================
 
-LoopCollection = namedtuple('LoopCollection', ['body', 'length', 'modified_vars'])
+LoopCollection = namedtuple('LoopCollection', ['body', 'length', 'modified_vars', 'reversed_order',
+                                               'written', 'read'],
+                            defaults = [False, (), ()])
+
+# An array access found under a node which reads the elements of the array at other
+# positions than the ones indexed by the loop (e.g. a transpose)
+PermutedAccess = namedtuple('PermutedAccess', ['access'])
+
+# The nodes which permute the indices of the arrays which they contain
+index_permuting_nodes = (NumpyTranspose,)
+
+#==============================================================================
+def _get_full_indices(expr):
+    """
+    Get the indices of all the dimensions of the array accessed by an expression.
+
+    Get the indices of all the dimensions of the array accessed by a Variable
+    or an IndexedElement. The dimensions which are not indexed are represented
+    by an empty slice.
+
+    Parameters
+    ----------
+    expr : Variable | IndexedElement
+        The array access.
+
+    Returns
+    -------
+    list
+        The indices of each dimension of the base array.
+    """
+    if isinstance(expr, Variable):
+        return [Slice(None, None)]*expr.rank
+    indices = list(expr.indices)
+    if len(indices) == 1 and isinstance(indices[0], LiteralEllipsis):
+        return [Slice(None, None)]*expr.base.rank
+    return indices + [Slice(None, None)]*(expr.base.rank - len(indices))
+
+def _is_same_access(expr1, expr2):
+    """
+    Indicate whether two expressions access the same elements of the same array.
+
+    Indicate whether two expressions access the same elements of the same array in
+    the same order, e.g. `x` and `x[:]`, or `x[1:]` and `x[1:]`.
+
+    Parameters
+    ----------
+    expr1 : PyccelAstNode | PermutedAccess
+        The first array access.
+    expr2 : PyccelAstNode | PermutedAccess
+        The second array access.
+
+    Returns
+    -------
+    bool
+        True if the expressions are known to access the same elements.
+    """
+    if not isinstance(expr1, (Variable, IndexedElement)) or not isinstance(expr2, (Variable, IndexedElement)):
+        return False
+    base1 = expr1.base if isinstance(expr1, IndexedElement) else expr1
+    base2 = expr2.base if isinstance(expr2, IndexedElement) else expr2
+    if base1 != base2:
+        return False
+
+    def same_value(a, b):
+        return a is b or (a is not None and b is not None and (a == b or str(a) == str(b)))
+
+    def same_index(a, b):
+        if isinstance(a, Slice) and isinstance(b, Slice):
+            return all(same_value(x, y) for x, y in ((a.start, b.start), (a.stop, b.stop), (a.step, b.step)))
+        return not isinstance(a, Slice) and not isinstance(b, Slice) and same_value(a, b)
+
+    return all(same_index(a, b) for a, b in zip(_get_full_indices(expr1), _get_full_indices(expr2)))
+
+def _get_array_accesses(expr):
+    """
+    Get the array accesses found in an expression.
+
+    Get the Variables and IndexedElements found in an expression (including the
+    expression itself). The base of an IndexedElement is not returned as a
+    separate access. The accesses found under a node which permutes the indices
+    (e.g. `x.T`) are returned as PermutedAccess objects as they do not read the
+    elements at the position of the loop index.
+
+    Parameters
+    ----------
+    expr : PyccelAstNode
+        The expression being examined.
+
+    Returns
+    -------
+    list
+        The array accesses.
+    """
+    if isinstance(expr, (Variable, IndexedElement)):
+        return [expr]
+    elif isinstance(expr, index_permuting_nodes):
+        accesses = expr.get_attribute_nodes((Variable, IndexedElement))
+        permuted = []
+    else:
+        accesses = expr.get_attribute_nodes((Variable, IndexedElement),
+                                            excluded_nodes = index_permuting_nodes)
+        permuted = [a for p in expr.get_attribute_nodes(index_permuting_nodes)
+                      for a in _get_array_accesses(p)]
+    bases = [a.base for a in accesses if isinstance(a, IndexedElement)]
+    accesses = [a for a in accesses if not any(a is b for b in bases)]
+    if isinstance(expr, index_permuting_nodes):
+        return [PermutedAccess(a) for a in accesses]
+    return accesses + permuted
+
+def may_alias(expr1, expr2):
+    """
+    Indicate whether two expressions may access the memory of the same array.
+
+    Indicate whether two expressions may access the memory of the same array,
+    either because they access the same variable, or because one of them is
+    a pointer which may point at the other.
+
+    Parameters
+    ----------
+    expr1 : PyccelAstNode
+        The first array access.
+    expr2 : PyccelAstNode
+        The second array access.
+
+    Returns
+    -------
+    bool
+        True if the memory accessed by the two expressions may overlap.
+    """
+    expr1 = expr1.access if isinstance(expr1, PermutedAccess) else expr1
+    expr2 = expr2.access if isinstance(expr2, PermutedAccess) else expr2
+    base1 = expr1.base if isinstance(expr1, IndexedElement) else expr1
+    base2 = expr2.base if isinstance(expr2, IndexedElement) else expr2
+    if base1 == base2:
+        return True
+    return isinstance(base1, Variable) and isinstance(base2, Variable) \
+            and base1.rank > 0 and base2.rank > 0 and (base1.is_alias or base2.is_alias) \
+            and (base1.is_alias or base1.is_target) and (base2.is_alias or base2.is_target)
+
+def _are_independent(accesses1, accesses2):
+    """
+    Indicate whether two sets of array accesses can be carried out in the same loop.
+
+    Indicate whether the lines of code carrying out two sets of array accesses can
+    be computed in the same loop. This is the case if each pair of accesses which may
+    overlap accesses the same elements in each iteration.
+
+    Parameters
+    ----------
+    accesses1 : iterable of tuple
+        The accessed expressions and the number of loops of the line where they appear.
+    accesses2 : iterable of tuple
+        The accessed expressions and the number of loops of the line where they appear.
+
+    Returns
+    -------
+    bool
+        True if the accesses cannot interfere.
+    """
+    return all(not may_alias(a, b) or (_is_same_access(a, b) and a.rank == rank_a == rank_b)
+               for a, rank_a in accesses1 for b, rank_b in accesses2)
 
 #==============================================================================
 def collect_loops(block, indices, new_index, language_has_vectors = False, result = None):
@@ -419,6 +588,7 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
             else:
                 lhs_vars = set(line.lhs.get_attribute_nodes((Variable, IndexedElement)))
                 lhs_vars = [v.base if isinstance(v, IndexedElement) else v for v in lhs_vars]
+            lhs = line.lhs
 
             # Get all objects which affect where indices are inserted
             notable_nodes = line.get_attribute_nodes((Variable,
@@ -500,8 +670,17 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
                 result.extend(assigns)
                 current_level = 0
 
-            rank = line.lhs.rank
-            shape = line.lhs.shape
+            # The loops run over the array which is written, or over the array expression
+            # when it is accumulated into a scalar (e.g. for numpy.sum)
+            loop_expr = line.rhs if isinstance(line, AugAssign) and line.lhs.rank == 0 else line.lhs
+            rank = loop_expr.rank
+            shape = loop_expr.shape
+            # Arrays in Fortran order are traversed from their last index so the
+            # innermost loop runs over contiguous memory
+            reversed_order = not language_has_vectors and rank > 1 and loop_expr.order == 'F' \
+                                and not transposed_vars and not indexed_funcs
+            if reversed_order:
+                shape = shape[::-1]
             new_vars = variables
             handled_funcs = transposed_vars + indexed_funcs
             # Loop over indexes, inserting until the expression can be evaluated
@@ -513,8 +692,11 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
                 if rank+index >= len(indices):
                     indices.append(new_index(PythonNativeInt(),'i'))
                 index_var = indices[rank+index]
-                new_vars = [insert_index(v, index, index_var) for v in new_vars]
-                handled_funcs = [insert_index(v, index, index_var) for v in handled_funcs]
+                # When the order is reversed the index is always inserted in the
+                # last dimension which is not yet indexed
+                pos = -1 if reversed_order else index
+                new_vars = [insert_index(v, pos, index_var) for v in new_vars]
+                handled_funcs = [insert_index(v, pos, index_var) for v in handled_funcs]
                 if compatible_operation(*new_vars, *handled_funcs, language_has_vectors = language_has_vectors):
                     break
 
@@ -530,6 +712,11 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
             _ = [f.substitute(variables, new_vars) for f in elemental_func_calls]
             _ = [f.substitute(transposed_vars + indexed_funcs, handled_funcs) for f in elemental_func_calls]
 
+            # Save the array accesses to check which lines can share a loop
+            written = [(lhs, rank)]
+            read = [(v, rank) for v in variables if v is not lhs]
+            read += [(a, rank) for t in transposed_vars for a in _get_array_accesses(t)]
+
             # Recurse through result tree to save line with lines which need
             # the same set of for loops
             save_spot = result
@@ -537,8 +724,16 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
             for _ in range(min(new_level,current_level)):
                 # Select the existing loop if the shape matches the shape of the expression
                 # and the loop is not used to modify one of the variable dependencies
-                if save_spot[-1].length == shape[j] and not any(u in save_spot[-1].modified_vars for u in dependencies):
-                    save_spot[-1].modified_vars.update(lhs_vars)
+                # and the arrays modified in the loop are only accessed at the elements
+                # written in the same iteration
+                loop = save_spot[-1]
+                if loop.length == shape[j] and loop.reversed_order == reversed_order \
+                        and not any(u in loop.modified_vars for u in dependencies) \
+                        and _are_independent(written, loop.written + loop.read) \
+                        and _are_independent(read, loop.written):
+                    loop.modified_vars.update(lhs_vars)
+                    loop.written.extend(written)
+                    loop.read.extend(read)
                     save_spot = save_spot[-1].body
                     j+=1
                 else:
@@ -546,7 +741,8 @@ def collect_loops(block, indices, new_index, language_has_vectors = False, resul
 
             for k in range(j,new_level):
                 # Create new loops until we have the neccesary depth
-                save_spot.append(LoopCollection([], shape[k], set(lhs_vars)))
+                save_spot.append(LoopCollection([], shape[k], set(lhs_vars), reversed_order,
+                                                list(written), list(read)))
                 save_spot = save_spot[-1].body
 
             # Save results
@@ -711,6 +907,122 @@ def expand_inhomog_tuple_assignments(block, language_has_vectors = False):
         block.substitute(assigns, new_assigns)
         expand_inhomog_tuple_assignments(block)
 
+#==============================================================================
+def is_overlapping_assign(line, language_has_vectors = False):
+    """
+    Indicate whether an array assignment reads elements of the array which it modifies.
+
+    Indicate whether the right-hand side of an array assignment reads elements of
+    the modified array at other positions than the ones being written (e.g.
+    `x[1:] = x[:-1] + 1` or `x[:,:] = x.T`). Such an assignment cannot be computed
+    in the loop which writes the elements as some elements would be modified before
+    they are read. The right-hand side must be saved in a temporary array first.
+
+    Parameters
+    ----------
+    line : PyccelAstNode
+        A line of code from a CodeBlock.
+
+    language_has_vectors : bool, default=False
+        Indicates if the language evaluates the right-hand side of an array
+        assignment before modifying the array. In this case only the accesses
+        under a node which permutes the indices can overlap as these
+        assignments are computed in loops by `expand_to_loops`.
+
+    Returns
+    -------
+    bool
+        True if the assignment reads elements which it may already have modified.
+    """
+    if type(line) is not Assign or not isinstance(line.lhs, (Variable, IndexedElement)) \
+            or line.lhs.rank == 0:
+        return False
+
+    lhs = line.lhs
+    accesses = _get_array_accesses(line.rhs)
+    if language_has_vectors:
+        accesses = [a for a in accesses if isinstance(a, PermutedAccess)]
+    return any(may_alias(lhs, r) and not _is_same_access(lhs, r) for r in accesses)
+
+#==============================================================================
+def _literal_value(expr):
+    """
+    Get the value of an expression if it is a literal.
+
+    Get the Python value of an expression if it is a literal, None otherwise.
+
+    Parameters
+    ----------
+    expr : TypedAstNode
+        The expression being examined.
+
+    Returns
+    -------
+    int, float, bool, str or None
+        The value of the literal.
+    """
+    return expr.python_value if isinstance(expr, Literal) else None
+
+def may_fail(expr, excluded_nodes = (), visited = None):
+    """
+    Indicate whether the runtime may report an error while an expression is computed.
+
+    Indicate whether an expression contains a call to a function of the runtime
+    library which records an error instead of exiting when it fails (e.g.
+    `numpy.load` with a missing file, `numpy.random.randint` with arguments
+    which are not known to be valid, or `numpy.amax` of an array which may be
+    empty), or a call to a function whose body
+    contains such a call. The code which computes the expression must then check
+    whether an error occurred and return to its caller.
+
+    Parameters
+    ----------
+    expr : PyccelAstNode
+        The expression being examined.
+    excluded_nodes : tuple of types, optional
+        Types of the nodes which are not examined (e.g. CodeBlock to only examine
+        the current statement and not the blocks that it contains).
+    visited : set of FunctionDef, optional
+        The functions whose bodies were already examined.
+
+    Returns
+    -------
+    bool
+        True if an error may be reported while the expression is computed.
+    """
+    if isinstance(expr, NumpyArrayFromFile) or expr.get_attribute_nodes(NumpyArrayFromFile, excluded_nodes):
+        return True
+    # The arguments of the random functions are checked when the code is run unless they are literals
+    randoms = [expr] if isinstance(expr, (NumpyRandint, NumpyRandomNormal)) else \
+            expr.get_attribute_nodes((NumpyRandint, NumpyRandomNormal), excluded_nodes)
+    for r in randoms:
+        if isinstance(r, NumpyRandint):
+            low = 0 if r.low is None else _literal_value(r.low)
+            high = _literal_value(r.high)
+            if low is None or high is None or high <= low:
+                return True
+        else:
+            scale = _literal_value(r.scale)
+            if scale is None or scale < 0:
+                return True
+    # The maximum and the minimum of a whole array are an error if it is empty,
+    # which is only known when the code is run unless its shape is literal
+    extrema = [expr] if isinstance(expr, (NumpyAmax, NumpyAmin)) else \
+            expr.get_attribute_nodes((NumpyAmax, NumpyAmin), excluded_nodes)
+    for e in extrema:
+        if e.rank == 0:
+            sizes = [_literal_value(s) for s in e.arg.shape]
+            if any(s is None or s == 0 for s in sizes):
+                return True
+    visited = set() if visited is None else visited
+    calls = [expr] if isinstance(expr, FunctionCall) else expr.get_attribute_nodes(FunctionCall, excluded_nodes)
+    for func in (c.funcdef for c in calls):
+        if isinstance(func, FunctionDef) and func not in visited:
+            visited.add(func)
+            if may_fail(func.body, visited = visited):
+                return True
+    return False
+
 #==============================================================================
 def expand_to_loops(block, new_index, scope, language_has_vectors = False):
     """
@@ -40,8 +40,10 @@ class Codegen:
         Name of the generated module or program.
     language : str
         The language which the printer should print to.
+    **printer_settings : dict
+        Any additional arguments of the printer (e.g. `profile` for the C printer).
     """
-    def __init__(self, parser, name, language):
+    def __init__(self, parser, name, language, **printer_settings):
         pyccel_stage.set_stage('codegen')
         self._parser   = parser
         self._ast      = parser.ast
@@ -71,7 +73,7 @@ class Codegen:
         except KeyError as err:
             raise ValueError(f'{language} language is not available') from err
 
-        self._printer = CodePrinterSubclass(self.parser.filename)
+        self._printer = CodePrinterSubclass(self.parser.filename, **printer_settings)
 
     @property
     def parser(self):
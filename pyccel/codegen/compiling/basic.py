@@ -57,7 +57,8 @@ class CompileObj:
     compilation_in_progress = FileLock('.lock_acquisition.lock')
     __slots__ = ('_file','_folder','_module_name','_module_target','_prog_target',
                  '_lock_target','_lock_source','_flags','_includes','_libs',
-                 '_libdirs','_accelerators','_dependencies','_has_target_file')
+                 '_libdirs','_accelerators','_extra_accelerators','_dependencies',
+                 '_has_target_file')
     def __init__(self,
                  file_name,
                  folder,
@@ -98,10 +99,11 @@ class CompileObj:
         self._libs         = list(libs)
         self._libdirs      = set(libdirs)
         self._accelerators = set(accelerators)
+        self._extra_accelerators = set()
         self._dependencies = {a.module_target:a for a in dependencies}
         self._has_target_file = has_target_file
 
-    def reset_folder(self, folder):
+    def reset_folder(self, folder, accelerators = ()):
         """
         Change the folder in which the source file is saved.
 
@@ -110,13 +112,19 @@ class CompileObj:
         working with the stdlib, the `CompileObj` is created with the folder set
         to the file's location in the Pyccel install directory. When the file is
         used it is copied to the user's folder, at which point the folder of the
-        `CompileObj` must be updated.
+        `CompileObj` must be updated. The accelerators of the code which uses
+        the file (e.g. openmp) can be added at the same time.
 
         Parameters
         ----------
         folder : str
             The new folder where the source file can be found.
+
+        accelerators : iterable of str, default: ()
+            The accelerators required in addition to those specified when the
+            object was created. They replace those of any previous call.
         """
+        self._extra_accelerators = set(accelerators)
         if self.has_target_file:
             self._includes.remove(self._folder)
             self._includes.add(folder)
@@ -237,8 +245,10 @@ class CompileObj:
         self._dependencies.update({a.module_target:a for a in args})
 
     def __enter__(self):
-        self.compilation_in_progress.acquire()
-        self.acquire_lock()
+        # The global lock is only held while the locks are acquired so that
+        # objects which do not share files can be compiled at the same time
+        with self.compilation_in_progress:
+            self.acquire_lock()
 
     def acquire_lock(self):
         """
@@ -266,7 +276,6 @@ class CompileObj:
 
     def __exit__(self, exc_type, value, traceback):
         self.release_lock()
-        self.compilation_in_progress.release()
 
     def release_lock(self):
         """
@@ -304,7 +313,8 @@ class CompileObj:
         in the compiler configuration file. Examples of 'accelerators' are:
         openmp, openacc, python.
         """
-        return self._accelerators.union([da for d in self._dependencies.values() for da in d.accelerators])
+        return self._accelerators.union(self._extra_accelerators,
+                [da for d in self._dependencies.values() for da in d.accelerators])
 
     def __eq__(self, other):
         return self.module_target == other.module_target
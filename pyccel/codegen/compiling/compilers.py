@@ -7,6 +7,7 @@
 """
 Module handling everything related to the compilers used to compile the various generated files
 """
+from functools import lru_cache
 import json
 import os
 import shutil
@@ -15,6 +16,7 @@ import platform
 import warnings
 from pyccel.compilers.default_compilers import available_compilers, vendors
 from pyccel.errors.errors import Errors
+from pyccel.utilities.profiling import Profiler, peak_memory
 
 errors = Errors()
 
@@ -126,15 +128,9 @@ class Compiler:
         # Get executable
         exec_cmd = self._info['mpi_exec'] if 'mpi' in accelerators else self._info['exec']
 
-        # Clean conda paths out of the PATH variable
-        current_path = os.environ['PATH']
-        os.environ['PATH'] = self.acceptable_bin_paths
-
-        # Find the exact path of the executable
-        exec_loc = shutil.which(exec_cmd)
-
-        # Reset PATH variable
-        os.environ['PATH'] = current_path
+        # Find the exact path of the executable, ignoring the conda paths
+        # (the PATH variable is not modified as files may be compiled in threads)
+        exec_loc = shutil.which(exec_cmd, path = self.acceptable_bin_paths)
 
         if exec_loc is None:
             errors.report(f"Could not find compiler ({exec_cmd})",
@@ -312,11 +308,11 @@ class Compiler:
 
         return exec_cmd, inc_flags, libs_flags, libdirs_flags, m_code
 
-    def compile_module(self, compile_obj, output_folder, verbose = False):
+    def get_module_command(self, compile_obj, output_folder):
         """
-        Compile a module.
+        Get the command which compiles a module.
 
-        Compile a file containing a module to a .o file.
+        Get the command which compiles a file containing a module to a .o file.
 
         Parameters
         ----------
@@ -326,8 +322,10 @@ class Compiler:
         output_folder : str
             The folder where the result should be saved.
 
-        verbose : bool
-            Indicates whether additional output should be shown.
+        Returns
+        -------
+        list of str
+            The command which should be run to compile the module.
         """
         accelerators = compile_obj.accelerators
 
@@ -347,10 +345,29 @@ class Compiler:
         else:
             j_code = ()
 
-        cmd = [exec_cmd, *flags, *inc_flags,
+        return [exec_cmd, *flags, *inc_flags,
                 compile_obj.source, '-o', compile_obj.module_target,
                 *j_code]
 
+    def compile_module(self, compile_obj, output_folder, verbose = False):
+        """
+        Compile a module.
+
+        Compile a file containing a module to a .o file.
+
+        Parameters
+        ----------
+        compile_obj : CompileObj
+            Object containing all information about the object to be compiled.
+
+        output_folder : str
+            The folder where the result should be saved.
+
+        verbose : bool
+            Indicates whether additional output should be shown.
+        """
+        cmd = self.get_module_command(compile_obj, output_folder)
+
         with compile_obj:
             self.run_command(cmd, verbose)
 
@@ -401,6 +418,95 @@ class Compiler:
 
         return compile_obj.program_target
 
+    @staticmethod
+    @lru_cache
+    def _get_version(exec_loc):
+        """
+        Get the version of a compiler executable.
+
+        Get the output of the `--version` option of the executable, so that an
+        update of the compiler changes the description of the builds. The result
+        is stored as the command is run for every build description.
+
+        Parameters
+        ----------
+        exec_loc : str
+            The path of the executable.
+
+        Returns
+        -------
+        str
+            The output of the command, or an empty string if it fails.
+        """
+        try:
+            p = subprocess.run([exec_loc, '--version'], capture_output=True,
+                    universal_newlines=True, check=False)
+        except OSError:
+            return ''
+        return p.stdout.strip()
+
+    def get_build_description(self, accelerators = ()):
+        """
+        Get the executable and the flags used to compile files.
+
+        Get the executable, its version, the flags and the include directories
+        which are used to compile any file with the specified accelerators. This
+        identifies the objects which can be shared between different builds.
+
+        Parameters
+        ----------
+        accelerators : iterable of str
+            The accelerators used to compile the files.
+
+        Returns
+        -------
+        list of str
+            The executable and its version followed by the flags and the include
+            directories.
+        """
+        exec_loc = self._get_exec(accelerators)
+        return [exec_loc, self._get_version(exec_loc), *self._get_flags((), accelerators),
+                *self._get_includes((), accelerators)]
+
+    def compile_library(self, compile_obj, library, shared, verbose = False):
+        """
+        Gather compiled objects in a library.
+
+        Create a static archive or a shared library containing the objects of the
+        dependencies of the `CompileObj`.
+
+        Parameters
+        ----------
+        compile_obj : CompileObj
+            Object whose dependencies are the objects gathered in the library.
+
+        library : str
+            The path of the library which is created.
+
+        shared : bool
+            Indicates whether a shared library (rather than a static archive) is created.
+
+        verbose : bool
+            Indicates whether additional output should be shown.
+        """
+        accelerators = compile_obj.accelerators
+
+        if shared:
+            flags = self._get_flags(compile_obj.flags, accelerators)
+            exec_cmd, _, libs_flags, libdirs_flags, m_code = \
+                    self._get_compile_components(compile_obj, accelerators)
+            cmd = [exec_cmd, '-shared', *flags, *libdirs_flags, *sorted(m_code),
+                    '-o', library, *libs_flags]
+        else:
+            # gcc-ar also handles objects compiled with -flto
+            archiver = shutil.which('gcc-ar') or 'ar'
+            cmd = [archiver, 'rcs', library, *sorted(compile_obj.extra_modules)]
+
+        with compile_obj:
+            if os.path.exists(library):
+                os.remove(library)
+            self.run_command(cmd, verbose)
+
     def compile_shared_library(self, compile_obj, output_folder, verbose = False, sharedlib_modname=None):
         """
         Compile a module to a shared library.
@@ -488,9 +594,13 @@ class Compiler:
         if verbose:
             print(' '.join(cmd))
 
-        with subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
-                universal_newlines=True) as p:
-            out, err = p.communicate()
+        with Profiler().span(os.path.basename(cmd[0]), 'subprocess', command = ' '.join(cmd)) as span_args:
+            with subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                    universal_newlines=True) as p:
+                out, err = p.communicate()
+            span_args['returncode'] = p.returncode
+            # Peak memory of the largest command run so far
+            span_args['children_peak_rss_kib'] = peak_memory('children')
 
         if verbose and out:
             print(out)
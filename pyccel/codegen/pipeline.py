@@ -18,19 +18,24 @@ from pyccel.errors.errors          import PyccelSyntaxError, PyccelSemanticError
 from pyccel.errors.messages        import PYCCEL_RESTRICTION_TODO
 from pyccel.parser.parser          import Parser
 from pyccel.codegen.codegen        import Codegen
-from pyccel.codegen.utilities      import recompile_object
+from pyccel.codegen.utilities      import recompile_objects
 from pyccel.codegen.utilities      import copy_internal_library
 from pyccel.codegen.utilities      import internal_libs
+from pyccel.codegen.utilities      import internal_libs_dirpath
+from pyccel.codegen.utilities      import get_stdlib_runtime, runtime_libs
 from pyccel.codegen.python_wrapper import create_shared_library
 from pyccel.naming                 import name_clash_checkers
 from pyccel.utilities.stage        import PyccelStage
+from pyccel.utilities.profiling    import Profiler
 from pyccel.ast.utilities          import python_builtin_libs
 from pyccel.parser.scope           import Scope
+from pyccel.complexity.performance import MachineProfile, PerformanceModel
 
 from .compiling.basic     import CompileObj
 from .compiling.compilers import Compiler, get_condaless_search_path
 
 pyccel_stage = PyccelStage()
+profiler = Profiler()
 
 __all__ = ['execute_pyccel']
 
@@ -60,7 +65,12 @@ def execute_pyccel(fname, *,
                    accelerators  = (),
                    output_name   = None,
                    compiler_export_file = None,
-                   conda_warnings = 'basic'):
+                   conda_warnings = 'basic',
+                   jobs          = None,
+                   stdlib_runtime = None,
+                   timings_file  = None,
+                   timings_format = 'json',
+                   roofline      = None):
     """
     Run Pyccel on the provided code.
 
@@ -106,16 +116,37 @@ def execute_pyccel(fname, *,
         Indicates whether the file should be compiled in debug mode. Default is False.
         (Currently, this only implies that the flag -fcheck=bounds is added.).
     accelerators : iterable, optional
-        Tool used to accelerate the code (e.g., OpenMP, OpenACC).
+        Tool used to accelerate the code (e.g., OpenMP, OpenACC). The accelerator 'profile'
+        instruments the generated C code (see `CCodePrinter`) and the accelerator 'blas'
+        computes the matrix products of the C code with CBLAS.
     output_name : str, optional
         Name of the generated module. Default is the same name as the translated file.
     compiler_export_file : str, optional
         Name of the JSON file to which compiler information is exported. Default is None.
     conda_warnings : str, optional
         Specify the level of Conda warnings to display (choices: off, basic, verbose), Default is 'basic'.
+    jobs : int, optional
+        The maximum number of files compiled at the same time. Default is the number of processors.
+    stdlib_runtime : {'static', 'shared'}, optional
+        Link to a runtime library, built once for each compiler and flags, containing the
+        internal libraries which do not use Python instead of compiling them with each
+        module (see `get_stdlib_runtime`). Default is given by the environment variable
+        `PYCCEL_STDLIB_RUNTIME`, if it is not set the libraries are compiled with each module.
+    timings_file : str, optional
+        The file where the time spent in each stage, module, function and compiler command
+        (and the peak memory) is exported. Default is None (no export).
+    timings_format : {'json', 'chrome'}
+        The format of the timings file: a JSON tree of spans or the Chrome trace event format.
+        Default is 'json'.
+    roofline : str, optional
+        Print a roofline report of the functions of the module (estimated floating-point
+        operations, bytes moved, arithmetic intensity and non-unit-stride inner loops, see
+        `PerformanceModel`) for the machine profile given by its name or by a JSON file.
+        Default is None (no report).
     """
     start = time.time()
     timers = {}
+    profiler.reset()
     if fname.endswith('.pyh'):
         syntax_only = True
         if verbose:
@@ -149,6 +180,17 @@ def execute_pyccel(fname, *,
         errors.check()
         os.chdir(base_dirpath)
 
+    # Print and export the timers if requested
+    def report_timers():
+        profiler.record(module_name, 'module', start, file = pymod_filepath, language = language)
+        if show_timings:
+            print_timers(start, timers)
+        if timings_file:
+            profiler.export(timings_file, timings_format)
+
+    if timings_file:
+        timings_file = os.path.abspath(timings_file)
+
     # Identify absolute path, directory, and filename
     pymod_filepath = os.path.abspath(fname)
     pymod_dirpath, pymod_filename = os.path.split(pymod_filepath)
@@ -176,13 +218,30 @@ def execute_pyccel(fname, *,
     if conda_warnings not in ('off', 'basic', 'verbose'):
         raise ValueError("conda warnings accept {off, basic,verbose}")
 
+    if roofline:
+        roofline = MachineProfile.load(roofline)
+
     if language is None:
         language = 'fortran'
 
+    printer_settings = {}
+    if 'profile' in accelerators:
+        if language == 'c':
+            printer_settings['profile'] = True
+        else:
+            errors.report("The instrumentation of the generated code (--profile) is only available in C",
+                    filename = pymod_filepath, severity='warning')
+            accelerators = [a for a in accelerators if a != 'profile']
+    if 'openacc' in accelerators and language == 'c':
+        printer_settings['openacc'] = True
+
     # Choose Fortran compiler
     if compiler is None:
         compiler = os.environ.get('PYCCEL_DEFAULT_COMPILER', 'GNU')
 
+    if stdlib_runtime is None:
+        stdlib_runtime = os.environ.get('PYCCEL_STDLIB_RUNTIME', None) or None
+
     fflags = [] if fflags is None else fflags.split()
     wrapper_flags = [] if wrapper_flags is None else wrapper_flags.split()
 
@@ -203,7 +262,7 @@ def execute_pyccel(fname, *,
     os.chdir(folder)
 
     start_syntax = time.time()
-    timers["Initialisation"] = start_syntax-start
+    timers["Initialisation"] = profiler.record("Initialisation", 'stage', start, start_syntax)
     # Parse Python file
     try:
         parser = Parser(pymod_filepath)
@@ -220,12 +279,11 @@ def execute_pyccel(fname, *,
         handle_error('parsing (syntax)')
         raise PyccelSyntaxError('Syntax step failed')
 
-    timers["Syntactic Stage"] = time.time() - start_syntax
+    timers["Syntactic Stage"] = profiler.record("Syntactic Stage", 'stage', start_syntax)
 
     if syntax_only:
         pyccel_stage.pyccel_finished()
-        if show_timings:
-            print_timers(start, timers)
+        report_timers()
         return
 
     start_semantic = time.time()
@@ -246,12 +304,14 @@ def execute_pyccel(fname, *,
         handle_error('annotation (semantic)')
         raise PyccelSemanticError('Semantic step failed')
 
-    timers["Semantic Stage"] = time.time() - start_semantic
+    timers["Semantic Stage"] = profiler.record("Semantic Stage", 'stage', start_semantic)
+
+    if roofline:
+        print(PerformanceModel(parser.semantic_parser.ast, roofline, filename = pymod_filename).report())
 
     if semantic_only:
         pyccel_stage.pyccel_finished()
-        if show_timings:
-            print_timers(start, timers)
+        report_timers()
         return
 
     # -------------------------------------------------------------------------
@@ -260,7 +320,7 @@ def execute_pyccel(fname, *,
     start_codegen = time.time()
     # Generate .f90 file
     try:
-        codegen = Codegen(semantic_parser, module_name, language)
+        codegen = Codegen(semantic_parser, module_name, language, **printer_settings)
         fname = os.path.join(pyccel_dirpath, module_name)
         fname, prog_name = codegen.export(fname)
     except NotImplementedError as error:
@@ -277,7 +337,7 @@ def execute_pyccel(fname, *,
         handle_error('code generation')
         raise PyccelCodegenError('Code generation failed')
 
-    timers["Codegen Stage"] = time.time() - start_codegen
+    timers["Codegen Stage"] = profiler.record("Codegen Stage", 'stage', start_codegen)
 
     if language == 'python':
         output_file = (output_name + '.py') if output_name else os.path.basename(fname)
@@ -289,8 +349,7 @@ def execute_pyccel(fname, *,
         # Change working directory back to starting point
         os.chdir(base_dirpath)
         pyccel_stage.pyccel_finished()
-        if show_timings:
-            print_timers(start, timers)
+        report_timers()
         return
 
     compile_libs = [*libs, parser.metavars['libraries']] \
@@ -315,10 +374,20 @@ def execute_pyccel(fname, *,
 
     # Iterate over the internal_libs list and determine if the printer
     # requires an internal lib to be included.
+    libs_dirpath, libs_accelerators = internal_libs_dirpath(pyccel_dirpath, accelerators)
+    stdlib_objs = []
+    runtime_obj = None
     for lib_name, (stdlib_folder, stdlib) in internal_libs.items():
         if lib_name in codegen.get_printer_imports():
 
-            lib_dest_path = copy_internal_library(stdlib_folder, pyccel_dirpath)
+            if stdlib_runtime and not convert_only and lib_name in runtime_libs:
+                if runtime_obj is None:
+                    runtime_obj = get_stdlib_runtime(stdlib_runtime, src_compiler, accelerators,
+                                                     jobs = jobs, verbose = verbose)
+                    mod_obj.add_dependencies(runtime_obj)
+                continue
+
+            lib_dest_path = copy_internal_library(stdlib_folder, libs_dirpath)
 
             # stop after copying lib to __pyccel__ directory for
             # convert only
@@ -326,11 +395,8 @@ def execute_pyccel(fname, *,
                 continue
 
             # Pylint determines wrong type
-            stdlib.reset_folder(lib_dest_path) # pylint: disable=E1101
-            # get the include folder path and library files
-            recompile_object(stdlib,
-                              compiler = src_compiler,
-                              verbose  = verbose)
+            stdlib.reset_folder(lib_dest_path, libs_accelerators) # pylint: disable=E1101
+            stdlib_objs.append(stdlib)
 
             mod_obj.add_dependencies(stdlib)
 
@@ -338,8 +404,7 @@ def execute_pyccel(fname, *,
         # Change working directory back to starting point
         os.chdir(base_dirpath)
         pyccel_stage.pyccel_finished()
-        if show_timings:
-            print_timers(start, timers)
+        report_timers()
         return
 
     deps = dict()
@@ -373,11 +438,12 @@ def execute_pyccel(fname, *,
     mod_obj.add_dependencies(*deps.values())
 
     start_compile_target_language = time.time()
-    # Compile code to modules
+    # Compile code to modules (with the internal libraries, which are compiled
+    # first and concurrently). Files which have not changed are not compiled again.
     try:
-        src_compiler.compile_module(compile_obj=mod_obj,
-                output_folder=pyccel_dirpath,
-                verbose=verbose)
+        recompile_objects([*((s, src_compiler) for s in stdlib_objs), (mod_obj, src_compiler)],
+                jobs    = jobs,
+                verbose = verbose)
     except Exception:
         handle_error('Fortran compilation')
         raise
@@ -393,7 +459,7 @@ def execute_pyccel(fname, *,
                     output_folder=pyccel_dirpath,
                     verbose=verbose)
 
-        timers["Compilation without wrapper"] = time.time() - start_compile_target_language
+        timers["Compilation without wrapper"] = profiler.record("Compilation without wrapper", 'stage', start_compile_target_language)
 
         # Create shared library
         generated_filepath, shared_lib_timers = create_shared_library(codegen,
@@ -404,7 +470,9 @@ def execute_pyccel(fname, *,
                                                src_compiler,
                                                wrapper_compiler,
                                                output_name,
-                                               verbose)
+                                               verbose,
+                                               jobs,
+                                               stdlib_runtime)
     except NotImplementedError as error:
         msg = str(error)
         errors.report(msg+'\n'+PYCCEL_RESTRICTION_TODO,
@@ -451,8 +519,7 @@ def execute_pyccel(fname, *,
     os.chdir(base_dirpath)
     pyccel_stage.pyccel_finished()
 
-    if show_timings:
-        print_timers(start, timers)
+    report_timers()
 
 def print_timers(start, timers):
     """
@@ -13,7 +13,8 @@ from pyccel.ast.builtins  import PythonRange, PythonComplex
 from pyccel.ast.builtins  import PythonPrint, PythonType
 from pyccel.ast.builtins  import PythonList, PythonTuple
 
-from pyccel.ast.core      import Declare, For, CodeBlock
+from pyccel.ast.core      import Declare, For, CodeBlock, AnnotatedComment
+from pyccel.ast.core      import Return, Break, Continue
 from pyccel.ast.core      import FuncAddressDeclare, FunctionCall, FunctionCallArgument
 from pyccel.ast.core      import Allocate, Deallocate
 from pyccel.ast.core      import FunctionAddress
@@ -21,7 +22,7 @@ from pyccel.ast.core      import Assign, Import, AugAssign, AliasAssign
 from pyccel.ast.core      import SeparatorComment
 from pyccel.ast.core      import Module, AsName
 
-from pyccel.ast.operators import PyccelAdd, PyccelMul, PyccelMinus, PyccelLt, PyccelGt
+from pyccel.ast.operators import PyccelAdd, PyccelMul, PyccelMinus, PyccelLt, PyccelGt, PyccelDiv
 from pyccel.ast.operators import PyccelAssociativeParenthesis, PyccelMod
 from pyccel.ast.operators import PyccelUnarySub, IfTernaryOperator
 
@@ -31,22 +32,25 @@ from pyccel.ast.datatypes import CustomDataType, StringType, HomogeneousTupleTyp
 from pyccel.ast.datatypes import PrimitiveBooleanType, PrimitiveIntegerType, PrimitiveFloatingPointType, PrimitiveComplexType
 from pyccel.ast.datatypes import HomogeneousContainerType
 
-from pyccel.ast.internals import Slice, PrecomputedCode, PyccelArrayShapeElement
+from pyccel.ast.internals import Slice, PrecomputedCode, PyccelArrayShapeElement, PyccelInternalFunction
 
 from pyccel.ast.literals  import LiteralTrue, LiteralFalse, LiteralImaginaryUnit, LiteralFloat
 from pyccel.ast.literals  import LiteralString, LiteralInteger, Literal
-from pyccel.ast.literals  import Nil
+from pyccel.ast.literals  import Nil, convert_to_literal
 
-from pyccel.ast.mathext  import math_constants
+from pyccel.ast.mathext  import math_constants, MathGcd, MathLcm
 
-from pyccel.ast.numpyext import NumpyFull, NumpyArray
+from pyccel.ast.numpyext import NumpyFull, NumpyArray, NumpyReduction, NumpyProduct, NumpyMatmul
 from pyccel.ast.numpyext import NumpyReal, NumpyImag, NumpyFloat, NumpySize
+from pyccel.ast.numpyext import NumpyExp, NumpyLog, NumpySin, NumpyCos, NumpySqrt
+from pyccel.ast.numpyext import NumpyAbs, NumpyFabs, NumpySign, NumpyMod, NumpyGcd, NumpyLcm
+from pyccel.ast.numpyext import NumpyRand, NumpyRandint, NumpyRandomNormal
 
 from pyccel.ast.numpytypes import NumpyInt8Type, NumpyInt16Type, NumpyInt32Type, NumpyInt64Type
 from pyccel.ast.numpytypes import NumpyFloat32Type, NumpyFloat64Type, NumpyComplex64Type, NumpyComplex128Type
 from pyccel.ast.numpytypes import NumpyNDArrayType, numpy_precision_map
 
-from pyccel.ast.utilities import expand_to_loops
+from pyccel.ast.utilities import expand_to_loops, is_overlapping_assign, may_alias, may_fail
 
 from pyccel.ast.variable import IndexedElement
 from pyccel.ast.variable import Variable
@@ -225,6 +229,17 @@ c_library_headers = (
 
 import_dict = {'omp_lib' : 'omp' }
 
+# Markers around the two versions of an element access in the body of a function
+# which is specialised for arrays with a unit innermost stride (see
+# CCodePrinter._print_unit_stride_versions)
+_versions_start, _versions_sep, _versions_end = '\x1d', '\x1e', '\x1f'
+# OpenACC constructs which are followed by a structured block
+acc_block_constructs = ('parallel', 'kernels', 'data', 'host_data')
+# OpenACC clauses giving the data moved to or from the device
+acc_data_clause_regex = re.compile(r'\b(copy|copyin|copyout|create|present|delete|self|host|device)\(([^()]*)\)')
+
+_versions_regex = re.compile(f'([{_versions_start}{_versions_sep}{_versions_end}])')
+
 c_imports = {n : Import(n, Module(n, (), ())) for n in
                 ['stdlib',
                  'math',
@@ -237,7 +252,11 @@ c_imports = {n : Import(n, Module(n, (), ())) for n in
                  "inttypes",
                  'stdbool',
                  'assert',
-                 'numpy_c']}
+                 'numpy_c',
+                 'ufuncs',
+                 'linalg',
+                 'pyc_random',
+                 'pyc_profile']}
 
 class CCodePrinter(CodePrinter):
     """
@@ -253,6 +272,13 @@ class CCodePrinter(CodePrinter):
             The name of the file being pyccelised.
     prefix_module : str
             A prefix to be added to the name of the module.
+    profile : bool, default: False
+            Indicates whether the functions should be instrumented to count
+            their calls and measure the time spent in them (see pyc_profile.h).
+    openacc : bool, default: False
+            Indicates whether the code is compiled with OpenACC, in which case
+            the copies of the arrays on the device are managed by the ndarrays
+            library (see the device copies in ndarrays.h).
     """
     printmethod = "_ccode"
     language = "C"
@@ -294,18 +320,50 @@ class CCodePrinter(CodePrinter):
                       StringType()                  : '%s',
                       }
 
-    def __init__(self, filename, prefix_module = None):
+    ufunc_kernels = {NumpyExp    : 'exp',
+                     NumpyLog    : 'log',
+                     NumpySin    : 'sin',
+                     NumpyCos    : 'cos',
+                     NumpySqrt   : 'sqrt',
+                     NumpyAbs    : 'abs',
+                     NumpyFabs   : 'abs',
+                     NumpySign   : 'sign',
+                     PyccelAdd   : 'add',
+                     PyccelMinus : 'subtract',
+                     PyccelMul   : 'multiply',
+                     PyccelDiv   : 'divide',
+                     PyccelMod   : 'mod',
+                     NumpyMod    : 'mod',
+                     NumpyGcd    : 'gcd',
+                     NumpyLcm    : 'lcm'}
+
+    # The kernels of the ufuncs library which also exist for integer arrays
+    ufunc_integer_kernels = ('sign', 'mod', 'gcd', 'lcm')
+
+    def __init__(self, filename, prefix_module = None, profile = False, openacc = False):
 
         errors.set_target(filename, 'file')
 
         super().__init__()
         self.prefix_module = prefix_module
+        self._profile = profile
+        self._openacc = openacc
+        self._in_acc_managed_code = False
         self._additional_imports = {'stdlib':c_imports['stdlib']}
         self._additional_code = ''
         self._additional_args = []
         self._temporary_args = []
         self._current_module = None
         self._in_header = False
+        self._stack_buffers = {}
+        # The local arrays of the function being printed which are stored on the stack
+        # although they were not declared with the @stack_array decorator
+        self._promoted_stack_arrays = set()
+        # The array arguments of the function being printed, and those which are indexed in a loop
+        self._loop_depth = 0
+        self._array_arguments = []
+        self._indexed_arguments = set()
+        self._error_return = None
 
     def get_additional_imports(self):
         """return the additional imports collected in printing stage"""
@@ -420,7 +478,7 @@ class CCodePrinter(CodePrinter):
         if order == "F":
             # If the order is F then the data should be copied non-contiguously so a temporary
             # variable is required to pass to array_copy_data
-            temp_var = self.scope.get_temporary_variable(lhs, order='C')
+            temp_var = self.scope.get_temporary_variable(lhs, order='C', memory_handling='heap')
             operations += self._print(Allocate(temp_var, shape=lhs.shape, order="C", status="unallocated"))
             copy_to = temp_var
         else:
@@ -504,6 +562,151 @@ class CCodePrinter(CodePrinter):
                 code_init += 'array_fill({0}, {1});\n'.format(self._print(rhs.fill_value), self._print(lhs))
         return code_init
 
+    def array_reduction(self, expr):
+        """
+        Print the assignment of the reduction of an array along an axis.
+
+        Print the call to the function of the ndarrays library which reduces
+        an array along an axis (e.g. `b = np.sum(a, axis = 0)`). The result is
+        written in the array on the left-hand side, which is already allocated.
+
+        Parameters
+        ----------
+        expr : Assign
+            The Assign Node whose rhs is a NumpyReduction.
+
+        Returns
+        -------
+        str
+            Return a str that contains a call to the C function numpy_<func>_axis_<dtype>.
+        """
+        lhs = expr.lhs
+        rhs = expr.rhs
+        if not isinstance(lhs, Variable):
+            errors.report("The reduction of an array along an axis must be saved in a variable",
+                    symbol=expr, severity='fatal')
+        arg = rhs.python_arg if isinstance(rhs, NumpyProduct) else rhs.arg
+        if not isinstance(arg, (Variable, IndexedElement)):
+            errors.report(f'Expecting a Variable, given {type(arg)}', symbol=expr, severity='fatal')
+        primitive_type = arg.dtype.primitive_type
+        prec = arg.dtype.precision
+        if isinstance(primitive_type, PrimitiveIntegerType):
+            suffix = f'int{prec * 8}'
+        elif isinstance(primitive_type, PrimitiveFloatingPointType):
+            suffix = f'float{prec * 8}'
+        elif isinstance(primitive_type, PrimitiveComplexType):
+            suffix = f'complex{prec * 16}'
+        else:
+            suffix = 'bool'
+        func = 'prod' if isinstance(rhs, NumpyProduct) else rhs.name
+        out = self._print(ObjectAddress(lhs))
+        axis = self._print(rhs.axis)
+        return f'numpy_{func}_axis_{suffix}({out}, {self._print(arg)}, {axis});\n'
+
+    def array_matmul(self, expr):
+        """
+        Print the assignment of a matrix product.
+
+        Print the call to the function of the linalg library which computes
+        the matrix product of two arrays (e.g. `c = a @ b`). The result is
+        written in the array on the left-hand side, which is already allocated.
+
+        Parameters
+        ----------
+        expr : Assign
+            The Assign Node whose rhs is a NumpyMatmul.
+
+        Returns
+        -------
+        str
+            Return a str that contains a call to the C function numpy_matmul_<dtype>.
+        """
+        lhs = expr.lhs
+        rhs = expr.rhs
+        if not isinstance(lhs, Variable):
+            errors.report("The result of a matrix multiplication must be saved in a variable",
+                    symbol=expr, severity='fatal')
+        if any(may_alias(lhs, o) for o in (rhs.a, rhs.b)):
+            errors.report("The result of a matrix multiplication cannot be saved in one of its operands",
+                    symbol=expr, severity='fatal')
+        suffix = self._get_matmul_suffix(rhs)
+        out = self._print(ObjectAddress(lhs))
+        return f'numpy_matmul_{suffix}({out}, {self._print(rhs.a)}, {self._print(rhs.b)});\n'
+
+    def _get_matmul_suffix(self, expr):
+        """
+        Get the suffix of the function of the linalg library computing a matrix product.
+
+        Get the suffix describing the type of the elements of the operands of
+        a matrix product, which is used to name the functions numpy_matmul_<dtype>
+        and numpy_dot_<dtype> of the linalg library. The operands must be arrays
+        with the type of the result.
+
+        Parameters
+        ----------
+        expr : NumpyMatmul
+            The matrix product.
+
+        Returns
+        -------
+        str
+            The suffix of the C function.
+        """
+        for arg in (expr.a, expr.b):
+            if not isinstance(arg, (Variable, IndexedElement)):
+                errors.report(f'Expecting a Variable, given {type(arg)}', symbol=expr, severity='fatal')
+            if arg.dtype != expr.dtype:
+                errors.report("The operands of a matrix multiplication must have the same type in C",
+                        symbol=expr, severity='fatal')
+        self.add_import(c_imports['ndarrays'])
+        self.add_import(c_imports['linalg'])
+        primitive_type = expr.dtype.primitive_type
+        prec = expr.dtype.precision
+        if isinstance(primitive_type, PrimitiveIntegerType):
+            return f'int{prec * 8}'
+        elif isinstance(primitive_type, PrimitiveFloatingPointType):
+            return f'float{prec * 8}'
+        elif isinstance(primitive_type, PrimitiveComplexType):
+            return f'complex{prec * 16}'
+        else:
+            return 'bool'
+
+
+    def array_random(self, expr):
+        """
+        Print the assignment of an array of random numbers.
+
+        Print the call to the function of the pyc_random library which fills
+        an array with random numbers (e.g. `x = np.random.random(n)`). The
+        result is written in the array on the left-hand side, which is already
+        allocated and contiguous.
+
+        Parameters
+        ----------
+        expr : Assign
+            The Assign Node whose rhs is a NumpyRand, a NumpyRandint or a
+            NumpyRandomNormal.
+
+        Returns
+        -------
+        str
+            Return a str that contains a call to the C function pyc_random_fill_<distribution>.
+        """
+        lhs = expr.lhs
+        rhs = expr.rhs
+        if not isinstance(lhs, Variable):
+            errors.report("An array of random numbers must be assigned to a variable",
+                    symbol=expr, severity='fatal')
+        self.add_import(c_imports['ndarrays'])
+        self.add_import(c_imports['pyc_random'])
+        arr = self._print(lhs)
+        if isinstance(rhs, NumpyRandint):
+            low = self._print(rhs.low if rhs.low is not None else LiteralInteger(0))
+            return f'pyc_random_fill_randint({arr}, {low}, {self._print(rhs.high)});\n'
+        if isinstance(rhs, NumpyRandomNormal):
+            return f'pyc_random_fill_normal({arr}, {self._print(rhs.loc)}, {self._print(rhs.scale)});\n'
+        return f'pyc_random_fill_uniform({arr});\n'
+
     def _init_stack_array(self, expr):
         """
         Return a string which handles the assignment of a stack ndarray.
@@ -535,21 +738,116 @@ class CCodePrinter(CodePrinter):
             lambda x,y: PyccelMul(x,y,simplify=True), var.alloc_shape))
         declare_dtype = self.find_in_dtype_registry(NumpyInt64Type())
 
-        dummy_array_name = self.scope.get_new_name('array_dummy')
-        buffer_array = "{dtype} {name}[{size}];\n".format(
+        dummy_array_name = self._get_stack_buffer(var)
+        buffer_array = "{dtype} {name}[STACK_BUFFER_LENGTH({size}, {dtype})];\n".format(
                 dtype = dtype,
                 name  = dummy_array_name,
                 size  = tot_shape)
         shape_init = "({declare_dtype}[]){{{shape}}}".format(declare_dtype=declare_dtype, shape=shape)
         strides_init = "({declare_dtype}[{length}]){{0}}".format(declare_dtype=declare_dtype, length=len(var.shape))
+        order = "order_f" if var.order == "F" else "order_c"
         array_init = ' = (t_ndarray){{\n.{0}={1},\n .shape={2},\n .strides={3},\n '
-        array_init += '.nd={4},\n .type={0},\n .is_view={5}\n}};\n'
+        array_init += '.nd={4},\n .type={0},\n .is_view={5},\n .order={6}\n}};\n'
         array_init = array_init.format(np_dtype, dummy_array_name,
-                    shape_init, strides_init, len(var.shape), 'false')
-        array_init += 'stack_array_init(&{})'.format(self._print(var))
+                    shape_init, strides_init, len(var.shape), 'false', order)
+        array_init += 'stack_array_create(&{}, sizeof({}))'.format(self._print(var), dummy_array_name)
         self.add_import(c_imports['ndarrays'])
         return buffer_array, array_init
 
+    def _get_stack_buffer(self, var):
+        """
+        Get the name of the buffer storing the data of a stack array.
+
+        Get the name of the C array declared on the stack to store the data
+        of a stack array. The name is chosen the first time that the buffer
+        is requested (by the declaration or by the deallocation of the array).
+
+        Parameters
+        ----------
+        var : Variable
+            The stack array.
+
+        Returns
+        -------
+        str
+            The name of the buffer.
+        """
+        if var not in self._stack_buffers:
+            self._stack_buffers[var] = self.scope.get_new_name('array_dummy')
+        return self._stack_buffers[var]
+
+    def _is_stack_array(self, var):
+        """
+        Indicate whether an array is stored on the stack in the printed code.
+
+        Indicate whether an array is stored on the stack, either because it was
+        declared with the `@stack_array` decorator or because it was chosen by
+        `_get_promoted_stack_arrays` for the function being printed.
+
+        Parameters
+        ----------
+        var : TypedAstNode
+            The object being examined.
+
+        Returns
+        -------
+        bool
+            True if the data of the array is stored in a stack buffer.
+        """
+        return getattr(var, 'is_stack_array', False) or var in self._promoted_stack_arrays
+
+    def _get_promoted_stack_arrays(self, expr):
+        """
+        Get the small local arrays of a function which can be stored on the stack.
+
+        Get the local arrays of a function which are allocated on the heap in the
+        AST but which can be stored on the stack by the printed code. The data of a
+        stack array is stored in a buffer on the stack if it is smaller than
+        NDARRAY_STACK_MAX_BYTES and on the heap otherwise, so this is safe whatever
+        the size of the arrays. An array is stored on the stack if it is allocated
+        once (outside of any loop), if its shape only depends on arguments which
+        are not modified, and if it is not returned. The AST is not modified.
+
+        Parameters
+        ----------
+        expr : FunctionDef
+            The function being printed.
+
+        Returns
+        -------
+        set of Variable
+            The arrays which are stored on the stack.
+        """
+        if expr.is_recursive:
+            return set()
+        results = [r.var for r in expr.results]
+        args = {a.var: a for a in expr.arguments}
+        allocations = {}
+        for a in expr.body.get_attribute_nodes(Allocate):
+            allocations.setdefault(a.variable, []).append(a)
+
+        def known_at_entry(shape):
+            for dim in shape:
+                if isinstance(dim, (FunctionCall, PyccelInternalFunction)) and not isinstance(dim, PyccelArrayShapeElement):
+                    return False
+                calls = dim.get_attribute_nodes((FunctionCall, PyccelInternalFunction))
+                if any(not isinstance(c, PyccelArrayShapeElement) for c in calls):
+                    return False
+                variables = [dim] if isinstance(dim, Variable) else dim.get_attribute_nodes(Variable)
+                for v in variables:
+                    arg = args.get(v, None)
+                    if arg is None or v.is_optional or (v.rank == 0 and arg.inout):
+                        return False
+            return True
+
+        local_vars = set(expr.scope.variables.values())
+        return {var for var, allocs in allocations.items()
+                if isinstance(var, Variable) and not isinstance(var, DottedVariable) \
+                    and isinstance(var.class_type, NumpyNDArrayType) and var.on_heap \
+                    and var in local_vars and var not in results \
+                    and len(allocs) == 1 and allocs[0].status == 'unallocated' \
+                    and known_at_entry(allocs[0].shape)}
+
     def _handle_inline_func_call(self, expr):
         """
         Print a function call to an inline function.
@@ -802,6 +1100,9 @@ class CCodePrinter(CodePrinter):
     def _print_Module(self, expr):
         self.set_scope(expr.scope)
         self._current_module = expr.name
+        if self._profile:
+            # The ndarrays library counts the allocations in pyc_profile
+            self.add_import(c_imports['pyc_profile'])
         body    = ''.join(self._print(i) for i in expr.body)
 
         global_variables = ''.join([self._print(d) for d in expr.declarations])
@@ -1277,7 +1578,7 @@ class CCodePrinter(CodePrinter):
         declaration_type = self.get_declare_type(expr.variable)
         variable = self._print(expr.variable.name)
 
-        if expr.variable.is_stack_array:
+        if self._is_stack_array(expr.variable):
             preface, init = self._init_stack_array(expr.variable,)
         elif declaration_type == 't_ndarray' and not self._in_header:
             preface = ''
@@ -1398,8 +1699,120 @@ class CCodePrinter(CodePrinter):
             inds = [self._cast_to(i, NumpyInt64Type()).format(self._print(i)) for i in inds]
         else:
             raise NotImplementedError(expr)
+        if self._owns_aligned_data(base):
+            return "GET_ALIGNED_ELEMENT(%s, %s, %s)" % (base_name, dtype, ", ".join(inds))
+        if base in self._array_arguments:
+            if self._loop_depth:
+                self._indexed_arguments.add(base)
+            # Print the access for any strides and for a unit innermost stride
+            # where the innermost index is not multiplied by the stride
+            inner = 0 if base.order == 'F' else base.rank - 1
+            index = ' + '.join(f'({i})' if d == inner else f'INDEX({base_name}, {d}, {i})' for d, i in enumerate(inds))
+            return (f"{_versions_start}{self._array_arguments.index(base)}{_versions_sep}"
+                    f"GET_ELEMENT({base_name}, {dtype}, {', '.join(inds)}){_versions_sep}"
+                    f"{base_name}.{dtype}[{index}]{_versions_end}")
         return "GET_ELEMENT(%s, %s, %s)" % (base_name, dtype, ", ".join(inds))
 
+    def _select_element_versions(self, code, unit_stride_arrays):
+        """
+        Select the version of the element accesses printed for each array argument.
+
+        Replace the two versions of the element accesses printed for the
+        array arguments of a function (see `_print_IndexedElement`) with the
+        version for a unit innermost stride if the array is in `unit_stride_arrays`
+        and with the version for any strides otherwise.
+
+        Parameters
+        ----------
+        code : str
+            The code containing the two versions of the element accesses.
+
+        unit_stride_arrays : iterable of Variable
+            The arrays which are known to have a unit innermost stride.
+
+        Returns
+        -------
+        str
+            The code containing one version of the element accesses.
+        """
+        unit_stride_indices = [str(self._array_arguments.index(a)) for a in unit_stride_arrays]
+        # The accesses are nested if an index is an element of another array
+        code_parts = [[]]
+        indices = []
+        for token in _versions_regex.split(code):
+            if token == _versions_start:
+                indices.append(None)
+                code_parts.append([])
+            elif token == _versions_sep:
+                if indices[-1] is None:
+                    indices[-1] = ''.join(code_parts.pop())
+                code_parts.append([])
+            elif token == _versions_end:
+                unit_stride_version = ''.join(code_parts.pop())
+                general_version = ''.join(code_parts.pop())
+                index = indices.pop()
+                code_parts[-1].append(unit_stride_version if index in unit_stride_indices else general_version)
+            else:
+                code_parts[-1].append(token)
+        return ''.join(code_parts[0])
+
+    def _print_unit_stride_versions(self, body):
+        """
+        Get the body of a function specialised for arrays with a unit innermost stride.
+
+        The elements of the array arguments are accessed with `GET_ELEMENT`
+        which multiplies each index by the stride of the dimension. As the
+        compiler does not know that the innermost stride of an argument is
+        usually 1 it can neither vectorise nor simplify the loops. If the array
+        arguments are indexed in a loop, the body is therefore written twice:
+        once for any strides and once with the innermost stride of these
+        arrays (the last dimension in C order, the first in Fortran order)
+        assumed to be 1. The version is selected when the function is called.
+
+        Parameters
+        ----------
+        body : str
+            The code of the body of the function, with the two versions of
+            the element accesses of the array arguments.
+
+        Returns
+        -------
+        str
+            The code of the body of the function, which chooses between the two versions.
+        """
+        arrays = [a for a in self._array_arguments if a in self._indexed_arguments]
+        general_body = self._select_element_versions(body, ())
+        if not arrays:
+            return general_body
+
+        unit_stride_body = self._select_element_versions(body, arrays)
+        condition = ' && '.join(f'{self._print(a)}.strides[{0 if a.order == "F" else a.rank - 1}] == 1'
+                                for a in arrays)
+        return (f'if ({condition})\n{{\n{unit_stride_body}}}\n'
+                f'else\n{{\n{general_body}}}\n')
+
+    def _owns_aligned_data(self, var):
+        """
+        Indicate whether the data of an array was allocated by array_create.
+
+        The data of the arrays created by array_create is aligned on
+        NDARRAY_ALIGNMENT bytes. This is not the case for arguments, which
+        might come from NumPy, for views and for stack arrays.
+
+        Parameters
+        ----------
+        var : TypedAstNode
+            The object being indexed.
+
+        Returns
+        -------
+        bool
+            True if the data of the array is known to be aligned.
+        """
+        return isinstance(var, Variable) and not isinstance(var, DottedVariable) \
+                and isinstance(var.class_type, NumpyNDArrayType) \
+                and var.on_heap and not var.is_argument and var not in self._promoted_stack_arrays
+
 
     def _cast_to(self, expr, dtype):
         """
@@ -1517,6 +1930,9 @@ class CCodePrinter(CodePrinter):
     def _print_Allocate(self, expr):
         free_code = ''
         variable = expr.variable
+        if self._is_stack_array(variable):
+            # The data of a stack array is allocated by its declaration
+            return ''
         if variable.rank > 0:
             #free the array if its already allocated and checking if its not null if the status is unknown
             if  (expr.status == 'unknown'):
@@ -1560,6 +1976,9 @@ class CCodePrinter(CodePrinter):
         elif isinstance(expr.variable.class_type, (NumpyNDArrayType, HomogeneousContainerType)):
             if expr.variable.is_alias:
                 return f'free_pointer({variable_address});\n'
+            elif self._is_stack_array(expr.variable):
+                buffer = self._get_stack_buffer(expr.variable)
+                return f'stack_array_free({variable_address}, {buffer});\n'
             else:
                 return f'free_array({variable_address});\n'
         else:
@@ -1784,21 +2203,120 @@ class CCodePrinter(CodePrinter):
                 true = value_true, false = value_false)
         return stmt
 
-    def _print_Rand(self, expr):
-        raise NotImplementedError("Rand not implemented")
+    def _get_file_mode(self, expr):
+        """
+        Get the mode used by the runtime to access the data of an array stored in a file.
+
+        Get the t_file_mode enum value describing how the data of an array created by
+        `numpy.load` or `numpy.memmap` is accessed.
+
+        Parameters
+        ----------
+        expr : NumpyArrayFromFile
+            The function creating the array.
+
+        Returns
+        -------
+        str
+            The t_file_mode value.
+        """
+        return {None : 'file_read',
+                'r'  : 'file_map_r',
+                'r+' : 'file_map_rplus',
+                'w+' : 'file_map_wplus',
+                'c'  : 'file_map_c'}[expr.mode]
+
+    def _print_NumpyLoad(self, expr):
+        self.add_import(c_imports['ndarrays'])
+        filename = self._print(expr.filename)
+        dtype = self.find_in_ndarray_type_registry(expr.dtype)
+        order = "order_f" if expr.order == "F" else "order_c"
+        return f'array_load_npy({filename}, {self._get_file_mode(expr)}, {dtype}, {expr.rank}, {order})'
+
+    def _print_NumpyMemmap(self, expr):
+        self.add_import(c_imports['ndarrays'])
+        filename = self._print(expr.filename)
+        offset = self._print(expr.offset)
+        shape_dtype = self.find_in_dtype_registry(NumpyInt64Type())
+        shape = ", ".join(self._print(i) for i in expr.shape)
+        dtype = self.find_in_ndarray_type_registry(expr.dtype)
+        order = "order_f" if expr.order == "F" else "order_c"
+        return (f'array_memmap({filename}, {self._get_file_mode(expr)}, {offset}, {expr.rank}, '
+                f'({shape_dtype}[]){{{shape}}}, {dtype}, {order})')
+
+    def _print_NumpyRand(self, expr):
+        if expr.rank != 0:
+            errors.report("An array of random numbers must be assigned to a variable",
+                    symbol=expr, severity='fatal')
+        self.add_import(c_imports['pyc_random'])
+        return 'pyc_random_uniform()'
 
     def _print_NumpyRandint(self, expr):
-        raise NotImplementedError("Randint not implemented")
+        if expr.rank != 0:
+            errors.report("An array of random numbers must be assigned to a variable",
+                    symbol=expr, severity='fatal')
+        self.add_import(c_imports['pyc_random'])
+        low = self._print(expr.low if expr.low is not None else LiteralInteger(0))
+        return f'pyc_random_randint({low}, {self._print(expr.high)})'
+
+    def _print_NumpyRandomNormal(self, expr):
+        if expr.rank != 0:
+            errors.report("An array of random numbers must be assigned to a variable",
+                    symbol=expr, severity='fatal')
+        self.add_import(c_imports['pyc_random'])
+        return f'pyc_random_normal({self._print(expr.loc)}, {self._print(expr.scale)})'
+
+    def _print_NumpyRandomSeed(self, expr):
+        self.add_import(c_imports['pyc_random'])
+        if expr.seed is None:
+            return 'pyc_random_seed_entropy();\n'
+        return f'pyc_random_seed({self._print(expr.seed)});\n'
 
     def _print_NumpyMod(self, expr):
         return self._print(PyccelMod(*expr.args))
 
+    def _print_NumpyGcd(self, expr):
+        return self._print(MathGcd(*expr.args))
+
+    def _print_NumpyLcm(self, expr):
+        return self._print(MathLcm(*expr.args))
+
+    def _print_fused_sum(self, expr):
+        """
+        Print the sum of an element-wise array expression.
+
+        The sum of an array expression such as `np.sum(a*b + c)` is accumulated
+        in the loop which computes the elements of the expression so the
+        expression is never saved in a temporary array. The loop is added to
+        the code preceding the current statement.
+
+        Parameters
+        ----------
+        expr : NumpySum
+            The sum of an array expression which is not a variable.
+
+        Returns
+        -------
+        str
+            The variable containing the result of the sum.
+        """
+        result = self.scope.get_temporary_variable(expr.class_type, 'sum')
+        loop = CodeBlock([Assign(result, convert_to_literal(0, expr.dtype)),
+                          AugAssign(result, '+', expr.arg)])
+        # The printed loop contains any code which was already waiting to be added
+        loop_code = self._print(loop)
+        self._additional_code += loop_code
+        return self._print(result)
+
     def _print_NumpySum(self, expr):
         '''
         Convert a call to numpy.sum to the equivalent function in C.
         '''
+        if expr.rank > 0:
+            errors.report("The reduction of an array along an axis must be assigned to a variable",
+                    symbol=expr, severity='fatal')
         if not isinstance(expr.arg, (NumpyArray, Variable, IndexedElement)):
-            raise TypeError(f'Expecting a NumpyArray, given {type(expr.arg)}')
+            return self._print_fused_sum(expr)
         dtype = expr.arg.dtype
         primitive_type = dtype.primitive_type
         prec  = dtype.precision
@@ -1818,6 +2336,9 @@ class CCodePrinter(CodePrinter):
         '''
         Convert a call to numpy.max to the equivalent function in C.
         '''
+        if expr.rank > 0:
+            errors.report("The reduction of an array along an axis must be assigned to a variable",
+                    symbol=expr, severity='fatal')
         dtype = expr.arg.dtype
         primitive_type = dtype.primitive_type
         prec  = dtype.precision
@@ -1835,6 +2356,9 @@ class CCodePrinter(CodePrinter):
         '''
         Convert a call to numpy.min to the equivalent function in C.
         '''
+        if expr.rank > 0:
+            errors.report("The reduction of an array along an axis must be assigned to a variable",
+                    symbol=expr, severity='fatal')
         dtype = expr.arg.dtype
         primitive_type = dtype.primitive_type
         prec  = dtype.precision
@@ -1848,6 +2372,16 @@ class CCodePrinter(CodePrinter):
         elif isinstance(primitive_type, PrimitiveBooleanType):
             return f'numpy_amin_bool({name})'
 
+    def _print_NumpyMatmul(self, expr):
+        '''
+        Convert a product of vectors (numpy.matmul or the @ operator) to the equivalent function in C.
+        '''
+        if expr.rank > 0:
+            errors.report("The result of a matrix multiplication must be assigned to a variable",
+                    symbol=expr, severity='fatal')
+        suffix = self._get_matmul_suffix(expr)
+        return f'numpy_dot_{suffix}({self._print(expr.a)}, {self._print(expr.b)})'
+
     def _print_NumpyLinspace(self, expr):
         template = '({start} + {index}*{step})'
         if not isinstance(expr.endpoint, LiteralFalse):
@@ -1885,13 +2419,30 @@ class CCodePrinter(CodePrinter):
             return ''
 
         self.set_scope(expr.scope)
+        promoted_stack_arrays = self._promoted_stack_arrays
+        self._promoted_stack_arrays = self._get_promoted_stack_arrays(expr)
+        # The buffers of the stack arrays are named in the order of their declaration
+        stack_buffers = self._stack_buffers
+        self._stack_buffers = {}
+        for v in expr.scope.variables.values():
+            if self._is_stack_array(v):
+                self._get_stack_buffer(v)
 
         arguments = [a.var for a in expr.arguments]
         results = [r.var for r in expr.results]
         if len(expr.results) > 1:
             self._additional_args.append(results)
 
+        array_arguments, indexed_arguments = self._array_arguments, self._indexed_arguments
+        self._array_arguments = [a for a in arguments if isinstance(a.class_type, NumpyNDArrayType) \
+                                    and not a.is_optional]
+        self._indexed_arguments = set()
+        error_return = self._error_return
+        self._error_return = self._get_error_return(results)
         body  = self._print(expr.body)
+        body  = self._print_unit_stride_versions(body)
+        self._array_arguments, self._indexed_arguments = array_arguments, indexed_arguments
+        self._error_return = error_return
         decs  = [Declare(i) if isinstance(i, Variable) else FuncAddressDeclare(i) for i in expr.local_vars]
 
         if len(results) == 1 :
@@ -1911,18 +2462,58 @@ class CCodePrinter(CodePrinter):
             self.add_import(i)
         docstring = self._print(expr.docstring) if expr.docstring else ''
 
+        if self._profile:
+            self.add_import(c_imports['pyc_profile'])
+            timer_name = f'{self._current_module}.{expr.name}' if self._current_module else expr.name
+            timer = f'PYC_PROFILE_FUNCTION("{timer_name}");\n'
+        else:
+            timer = ''
+
         parts = [sep,
                  docstring,
                 '{signature}\n{{\n'.format(signature=self.function_signature(expr)),
+                 timer,
                  decs,
                  body,
                  '}\n',
                  sep]
 
+        self._stack_buffers = stack_buffers
+        self._promoted_stack_arrays = promoted_stack_arrays
         self.exit_scope()
 
         return ''.join(p for p in parts if p)
 
+    def _get_error_return(self, results):
+        """
+        Get the code which returns from a function after an error.
+
+        Get the code which returns from a function when a function of the runtime
+        library that it calls reports an error (see `may_fail`). The error is
+        left for the caller (the wrapper raises it as a Python exception) so
+        the value returned only needs to be safe to ignore.
+
+        Parameters
+        ----------
+        results : list of Variable
+            The results of the function.
+
+        Returns
+        -------
+        str
+            The code of the return statement.
+        """
+        if len(results) == 0:
+            return 'return;\n'
+        if len(results) > 1:
+            return 'return 0;\n'
+        res = results[0]
+        if isinstance(res.class_type, NumpyNDArrayType) and not self.is_c_pointer(res):
+            return 'return (t_ndarray){.shape = NULL};\n'
+        if self.is_c_pointer(res) or isinstance(res.dtype, FixedSizeNumericType):
+            return 'return 0;\n'
+        return f'return {self._print(res)};\n'
+
     def _print_FunctionCall(self, expr):
         func = expr.funcdef
         if func.is_inline:
@@ -2118,6 +2709,12 @@ class CCodePrinter(CodePrinter):
             return prefix_code+self.copy_NumpyArray_Data(expr)
         if isinstance(rhs, (NumpyFull)):
             return prefix_code+self.arrayFill(expr)
+        if isinstance(rhs, NumpyReduction) and rhs.rank > 0:
+            return prefix_code+self.array_reduction(expr)
+        if isinstance(rhs, NumpyMatmul) and rhs.rank > 0:
+            return prefix_code+self.array_matmul(expr)
+        if isinstance(rhs, (NumpyRand, NumpyRandint, NumpyRandomNormal)) and rhs.rank > 0:
+            return prefix_code+self.array_random(expr)
         lhs = self._print(expr.lhs)
         rhs = self._print(expr.rhs)
         return prefix_code+'{} = {};\n'.format(lhs, rhs)
@@ -2166,7 +2763,9 @@ class CCodePrinter(CodePrinter):
                 severity='fatal')
 
         counter    = self._print(target)
+        self._loop_depth += 1
         body       = self._print(expr.body)
+        self._loop_depth -= 1
 
         additional_assign = CodeBlock(expr.iterable.get_assigns(expr.target))
         body = self._print(additional_assign) + body
@@ -2196,8 +2795,159 @@ class CCodePrinter(CodePrinter):
         loops = ''.join(self._print(i) for i in expr.loops)
         return loops
 
+    def _get_ufunc_kernel_call(self, expr):
+        """
+        Get the call to the ufuncs library which computes an array assignment.
+
+        Element-wise operations on whole float arrays such as `y = np.exp(x)`
+        or `z = x + y` (and on whole integer arrays for `np.sign`, `%`,
+        `np.gcd` and `np.lcm`) are computed by the vectorised kernels of the
+        ufuncs library instead of an explicit loop. This function checks
+        whether the assignment can be handled by one of these kernels.
+
+        Parameters
+        ----------
+        expr : PyccelAstNode
+            A line of code from a CodeBlock.
+
+        Returns
+        -------
+        str | None
+            The code calling the kernel, or None if the line cannot be
+            computed by a kernel.
+        """
+        if not isinstance(expr, Assign):
+            return None
+        lhs = expr.lhs
+        rhs = expr.rhs
+        if isinstance(lhs, IndexedElement) and len(lhs.indices) == lhs.base.rank \
+                and all(isinstance(i, Slice) and i.start is None and i.stop is None and i.step is None \
+                        for i in lhs.indices):
+            # `z[:] = x % y` writes the result in the existing array z
+            lhs = lhs.base
+        elif not isinstance(lhs, Variable) or lhs.is_alias:
+            return None
+        func = self.ufunc_kernels.get(type(rhs), None)
+        if func is None or not isinstance(lhs, Variable) or not isinstance(lhs.class_type, NumpyNDArrayType):
+            return None
+        dtype = lhs.dtype
+        if dtype.primitive_type is PrimitiveFloatingPointType() and dtype.precision in (4, 8):
+            suffix = f'float{dtype.precision * 8}'
+        elif dtype.primitive_type is PrimitiveIntegerType() and dtype.precision in (4, 8) \
+                and func in self.ufunc_integer_kernels:
+            suffix = f'int{dtype.precision * 8}'
+        else:
+            return None
+        args = rhs.args
+        if not all(isinstance(a, Variable) and 0 < a.rank <= lhs.rank and a.dtype == dtype \
+                        and isinstance(a.class_type, NumpyNDArrayType) for a in args):
+            return None
+        self.add_import(c_imports['ndarrays'])
+        self.add_import(c_imports['ufuncs'])
+        out = self._print(ObjectAddress(lhs))
+        args_code = ', '.join(self._print(a) for a in args)
+        return f'numpy_{func}_{suffix}({out}, {args_code});\n'
+
+    def _matmul_through_temporaries(self, line):
+        """
+        Get the lines computing the matrix products of a line in temporary arrays.
+
+        The functions of the linalg library write the matrix product of two
+        arrays in an array variable which does not share its data with the
+        operands. The products which are not directly assigned to such a
+        variable (e.g. `c[:, :] = 2 * (a @ b)` or `a = a @ b`) are computed in
+        temporary arrays which replace them in the line.
+
+        Parameters
+        ----------
+        line : PyccelAstNode
+            A line of code from a CodeBlock.
+
+        Returns
+        -------
+        list of PyccelAstNode
+            The lines equivalent to the line.
+        """
+        matmuls = line.get_attribute_nodes(NumpyMatmul, excluded_nodes = (CodeBlock,))
+        if isinstance(line, Assign) and isinstance(line.lhs, IndexedElement) and line.rhs in matmuls \
+                and len(line.lhs.indices) == line.lhs.base.rank \
+                and all(isinstance(i, Slice) and i.start is None and i.stop is None and i.step is None \
+                        for i in line.lhs.indices):
+            # `c[:, :] = a @ b` writes the product in c which has the shape of the result
+            line = Assign(line.lhs.base, line.rhs)
+        # The product cannot be written directly in an array which shares its data
+        # with an operand (e.g. `y[:] = a @ y[:]` or through a pointer)
+        direct = isinstance(line, Assign) and isinstance(line.lhs, Variable) and line.rhs in matmuls \
+                and not any(may_alias(line.lhs, o) for o in (line.rhs.a, line.rhs.b))
+        # Only the operands of a product of vectors or of a product assigned
+        # to a variable are computed in temporary arrays
+        products = [o for m in matmuls for o in ((m.a, m.b) if m.rank == 0 or direct else (m,))
+                      if isinstance(o, NumpyMatmul)]
+        if not products:
+            return [line]
+        lines = []
+        tmps = []
+        for m in products:
+            tmp = self.scope.get_temporary_variable(m.class_type, 'tmp', rank = m.rank,
+                        shape = m.shape, order = m.order, memory_handling = 'heap')
+            lines.append(Allocate(tmp, shape = m.shape, order = m.order, status = 'unallocated'))
+            lines.extend(self._matmul_through_temporaries(Assign(tmp, m)))
+            tmps.append(tmp)
+        line.substitute(products, tmps)
+        return lines + [line] + [Deallocate(t) for t in tmps]
+
+    def _random_through_temporaries(self, line):
+        """
+        Get the lines drawing the arrays of random numbers of a line in temporary arrays.
+
+        The functions of the pyc_random library fill a contiguous array
+        variable. The arrays of random numbers which are not directly assigned
+        to a variable (e.g. `x[:, 0] = np.random.random(n)` or
+        `y = 2 * np.random.random(n)`) are drawn in temporary arrays which
+        replace them in the line.
+
+        Parameters
+        ----------
+        line : PyccelAstNode
+            A line of code from a CodeBlock.
+
+        Returns
+        -------
+        list of PyccelAstNode
+            The lines equivalent to the line.
+        """
+        draws = [r for r in line.get_attribute_nodes((NumpyRand, NumpyRandint, NumpyRandomNormal),
+                                                    excluded_nodes = (CodeBlock,)) if r.rank > 0]
+        if isinstance(line, Assign) and isinstance(line.lhs, Variable) and line.rhs in draws:
+            draws.remove(line.rhs)
+        if not draws:
+            return [line]
+        lines = []
+        tmps = []
+        for r in draws:
+            tmp = self.scope.get_temporary_variable(r.class_type, 'tmp', rank = r.rank,
+                        shape = r.shape, order = r.order, memory_handling = 'heap')
+            lines.append(Allocate(tmp, shape = r.shape, order = r.order, status = 'unallocated'))
+            lines.append(Assign(tmp, r))
+            tmps.append(tmp)
+        line.substitute(draws, tmps)
+        return lines + [line] + [Deallocate(t) for t in tmps]
+
     def _print_CodeBlock(self, expr):
+        if self._openacc and not self._in_acc_managed_code:
+            return self._print_acc_managed_block(expr)
         if not expr.unravelled:
+            if expr.get_attribute_nodes(NumpyMatmul, excluded_nodes = (CodeBlock,)):
+                expr = CodeBlock([l for b in expr.body for l in self._matmul_through_temporaries(b)])
+            if any(r.rank > 0 for r in expr.get_attribute_nodes((NumpyRand, NumpyRandint, NumpyRandomNormal),
+                                                               excluded_nodes = (CodeBlock,))):
+                expr = CodeBlock([l for b in expr.body for l in self._random_through_temporaries(b)])
+            if any(is_overlapping_assign(b) for b in expr.body):
+                expr = CodeBlock([l for b in expr.body for l in \
+                        (self._assign_through_temporary(b) if is_overlapping_assign(b) else [b])])
+            kernel_calls = [self._get_ufunc_kernel_call(b) for b in expr.body]
+            if any(kernel_calls):
+                expr = CodeBlock([b if k is None else PrecomputedCode(k) for b, k in zip(expr.body, kernel_calls)])
             body_exprs = expand_to_loops(expr,
                     self.scope.get_temporary_variable, self.scope,
                     language_has_vectors = False)
@@ -2208,6 +2958,10 @@ class CCodePrinter(CodePrinter):
             code = self._print(b)
             code = self._additional_code + code
             self._additional_code = ''
+            if self._error_return and not isinstance(b, Return) and \
+                    may_fail(b, excluded_nodes = (CodeBlock,)):
+                self.add_import(c_imports['ndarrays'])
+                code += f'if (pyc_error_occurred())\n{{\n{self._error_return}}}\n'
             body_stmts.append(code)
         return ''.join(self._print(b) for b in body_stmts)
 
@@ -2418,11 +3172,258 @@ class CCodePrinter(CodePrinter):
 
     def _print_Omp_End_Clause(self, expr):
         return '}\n'
+
+    #=================== ACC ==================
+
+    def _print_AnnotatedComment(self, expr):
+        words = expr.txt.split()
+        if words[0] == 'end':
+            return '}\n' if words[1] in acc_block_constructs else ''
+        code = f'#pragma acc {expr.txt}\n'
+        if words[0] in acc_block_constructs:
+            code += '{\n'
+        return code
+
+    def _print_acc_managed_block(self, expr):
+        """
+        Print a block of code whose arrays may be used in OpenACC compute regions.
+
+        Print a block of code compiled with OpenACC. The copies of the arrays on
+        the device are managed by the ndarrays library: the arrays used in a
+        compute region are mapped to the device around the region (their data
+        is only copied if it was modified on the host), and the host code
+        between the regions copies the data back when it was modified on the
+        device and flags the arrays that it modifies. The statements which
+        contain compute regions (e.g. a time loop) are printed recursively.
+
+        Parameters
+        ----------
+        expr : CodeBlock
+            The block of code.
+
+        Returns
+        -------
+        str
+            The C code of the block.
+        """
+        body = expr.body
+        code = ''
+        host_stmts = []
+        i = 0
+        while i < len(body):
+            b = body[i]
+            contains_directives = isinstance(b, AnnotatedComment) or b.get_attribute_nodes(AnnotatedComment)
+            if contains_directives:
+                code += self._print_acc_host_code(host_stmts, expr.unravelled)
+                host_stmts = []
+            if isinstance(b, AnnotatedComment) and b.txt.split()[0] in ('parallel', 'kernels'):
+                construct = b.txt.split()[0]
+                end = next((j for j in range(i+1, len(body)) if isinstance(body[j], AnnotatedComment) \
+                                and body[j].txt.split()[:2] == ['end', construct]), len(body))
+                code += self._print_acc_compute_region(b, body[i+1:end], expr.unravelled)
+                i = end
+            elif isinstance(b, AnnotatedComment):
+                code += self._print_acc_data_directive(b)
+            elif contains_directives:
+                code += self._print(b)
+            else:
+                host_stmts.append(b)
+            i += 1
+        code += self._print_acc_host_code(host_stmts, expr.unravelled)
+        return code
+
+    def _print_acc_unmanaged_code(self, block):
+        """
+        Print a block of code without managing the device copies of its arrays.
+
+        Print a block of code without managing the device copies of its arrays
+        (this is done around the block by the caller).
+
+        Parameters
+        ----------
+        block : CodeBlock
+            The block of code.
+
+        Returns
+        -------
+        str
+            The C code of the block.
+        """
+        in_managed_code = self._in_acc_managed_code
+        self._in_acc_managed_code = True
+        code = self._print(block)
+        self._in_acc_managed_code = in_managed_code
+        return code
+
+    def _get_acc_arrays(self, expr, excluded_nodes = ()):
+        """
+        Get the arrays used and modified by some code compiled with OpenACC.
+
+        Get the arrays used by some code, whose device copies are managed by the
+        ndarrays library, and those which it modifies (the arrays assigned to).
+
+        Parameters
+        ----------
+        expr : PyccelAstNode
+            The code.
+        excluded_nodes : tuple of types, optional
+            The nodes whose arguments do not use the data of the arrays.
+
+        Returns
+        -------
+        arrays : list of Variable
+            The arrays used by the code.
+        modified : list of Variable
+            The arrays modified by the code.
+        """
+        arrays = []
+        for v in expr.get_attribute_nodes(Variable, excluded_nodes = excluded_nodes):
+            if v.is_ndarray and not v.is_optional and v not in arrays:
+                arrays.append(v)
+        assigned = [a.lhs.base if isinstance(a.lhs, IndexedElement) else a.lhs \
+                        for a in expr.get_attribute_nodes((Assign, AugAssign), excluded_nodes = excluded_nodes)]
+        modified = [a for a in arrays if a in assigned]
+        return arrays, modified
+
+    def _get_acc_data_clauses(self, txt):
+        """
+        Remove the arrays from the data clauses of an OpenACC directive.
+
+        Remove the arrays from the data clauses of an OpenACC directive, as
+        their device copies are managed by the ndarrays library. The clauses
+        which no longer have any arguments are removed.
+
+        Parameters
+        ----------
+        txt : str
+            The text of the directive.
+
+        Returns
+        -------
+        txt : str
+            The text of the directive without the arrays.
+        arrays : dict
+            The arrays removed from each clause.
+        """
+        arrays = {}
+        def remove_arrays(match):
+            clause, args = match.group(1), [a.strip() for a in match.group(2).split(',')]
+            variables = [self.scope.find(a, 'variables') for a in args]
+            is_array = [v is not None and v.is_ndarray for v in variables]
+            arrays.setdefault(clause, []).extend(v for v, a in zip(variables, is_array) if a)
+            kept = [n for n, a in zip(args, is_array) if not a]
+            return f'{clause}({", ".join(kept)})' if kept else ''
+        txt = acc_data_clause_regex.sub(remove_arrays, txt)
+        return ' '.join(txt.split()), arrays
+
+    def _print_acc_host_code(self, stmts, unravelled):
+        """
+        Print host code between OpenACC compute regions.
+
+        Print statements which are executed on the host, preceded by the
+        copies back to the host of the arrays they use whose device copy was
+        modified, and followed by the flags of the arrays they modify.
+
+        Parameters
+        ----------
+        stmts : list of PyccelAstNode
+            The statements.
+        unravelled : bool
+            Indicates whether the loops in the code have already been unravelled.
+
+        Returns
+        -------
+        str
+            The C code of the statements.
+        """
+        if not stmts:
+            return ''
+        block = CodeBlock(stmts, unravelled = unravelled)
+        # The called functions manage the arrays that they use themselves
+        arrays, modified = self._get_acc_arrays(block,
+                excluded_nodes = (FunctionCall, PyccelArrayShapeElement, Deallocate))
+        code = self._print_acc_unmanaged_code(block)
+        sync = ''.join(f'array_host_sync({self._print(a)});\n' for a in arrays)
+        flags = ''.join(f'array_host_modified({self._print(a)});\n' for a in modified)
+        if block.get_attribute_nodes((Return, Break, Continue)):
+            # The end of the block may not be reached
+            sync += flags
+        return sync + code + flags
+
+    def _print_acc_compute_region(self, directive, stmts, unravelled):
+        """
+        Print an OpenACC compute region.
+
+        Print an OpenACC compute region (parallel or kernels construct), whose
+        arrays are mapped to the device before the region, are given to the
+        construct in a present clause, and are unmapped after the region.
+
+        Parameters
+        ----------
+        directive : AnnotatedComment
+            The directive starting the compute region.
+        stmts : list of PyccelAstNode
+            The statements of the compute region.
+        unravelled : bool
+            Indicates whether the loops in the code have already been unravelled.
+
+        Returns
+        -------
+        str
+            The C code of the compute region.
+        """
+        block = CodeBlock(stmts, unravelled = unravelled)
+        arrays, modified = self._get_acc_arrays(block)
+        txt, _ = self._get_acc_data_clauses(directive.txt)
+        if arrays:
+            present = ', '.join(f'{self._print(ObjectAddress(a))}[0:1]' if self.is_c_pointer(a) \
+                                    else self._print(a) for a in arrays)
+            txt += f' present({present})'
+        body = self._print_acc_unmanaged_code(block)
+        maps = ''.join(f'array_device_map({self._print(ObjectAddress(a))});\n' for a in arrays)
+        unmaps = ''.join(f'array_device_unmap({self._print(ObjectAddress(a))}, {"true" if a in modified else "false"});\n'
+                            for a in arrays)
+        return f'{maps}#pragma acc {txt}\n{{\n{body}}}\n{unmaps}'
+
+    def _print_acc_data_directive(self, expr):
+        """
+        Print an OpenACC directive found outside of the compute regions.
+
+        Print an OpenACC directive found outside of the compute regions. The
+        arrays are removed from the data constructs and directives (whose
+        directives are removed if they have no other data), and the arrays which
+        should be copied back to the host are copied if they were modified on
+        the device.
+
+        Parameters
+        ----------
+        expr : AnnotatedComment
+            The directive.
+
+        Returns
+        -------
+        str
+            The C code of the directive.
+        """
+        words = expr.txt.split()
+        if words[0] not in ('data', 'enter', 'exit', 'update'):
+            return self._print(expr)
+        txt, arrays = self._get_acc_data_clauses(expr.txt)
+        synced = [a for c in ('copyout', 'self', 'host') for a in arrays.get(c, ())]
+        code = ''.join(f'array_host_sync({self._print(a)});\n' for a in synced)
+        has_data = acc_data_clause_regex.search(txt) is not None
+        if words[0] == 'data':
+            code += f'#pragma acc {txt}\n{{\n' if has_data else '{\n'
+        elif has_data:
+            code += f'#pragma acc {txt}\n'
+        return code
     #=====================================
 
     def _print_Program(self, expr):
         self.set_scope(expr.scope)
+        self._error_return = 'pyc_print_error();\nreturn 1;\n'
         body  = self._print(expr.body)
+        self._error_return = None
         variables = self.scope.variables.values()
         decs = ''.join(self._print(Declare(v)) for v in variables)
 
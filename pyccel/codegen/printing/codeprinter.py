@@ -7,7 +7,7 @@
 
 from pyccel.ast.basic import PyccelAstNode
 
-from pyccel.ast.core      import Assign
+from pyccel.ast.core      import Assign, Allocate, Deallocate
 from pyccel.ast.internals import PyccelSymbol
 
 from pyccel.errors.errors     import Errors
@@ -89,6 +89,37 @@ class CodePrinter:
                 return obj
         return self._print_not_supported(expr)
 
+    def _assign_through_temporary(self, expr):
+        """
+        Get the lines computing an array assignment via a temporary array.
+
+        Get the lines which compute the right-hand side of an array assignment
+        in a temporary array before copying it. This is necessary when the
+        right-hand side reads elements of the modified array which would be
+        overwritten by the loop computing the assignment (see
+        `is_overlapping_assign`).
+
+        Parameters
+        ----------
+        expr : Assign
+            The array assignment.
+
+        Returns
+        -------
+        list of PyccelAstNode
+            The lines equivalent to the assignment.
+        """
+        rhs = expr.rhs
+        # The temporary array is stored in the order of the modified array so the
+        # copy does not permute the indices
+        order = expr.lhs.order
+        tmp = self.scope.get_temporary_variable(rhs.class_type, 'tmp', rank = rhs.rank,
+                    shape = rhs.shape, order = order, memory_handling = 'heap')
+        return [Allocate(tmp, shape = rhs.shape, order = order, status = 'unallocated'),
+                Assign(tmp, rhs),
+                Assign(expr.lhs, tmp),
+                Deallocate(tmp)]
+
     def _get_statement(self, codestring):
         """Formats a codestring with the proper line ending."""
         raise NotImplementedError("This function must be implemented by "
@@ -10,9 +10,9 @@ from pyccel.ast.bind_c     import BindCPointer
 from pyccel.ast.bind_c     import BindCModule, BindCFunctionDef
 from pyccel.ast.c_concepts import CStackArray
 from pyccel.ast.core       import FunctionAddress, SeparatorComment
-from pyccel.ast.core       import Import, Module, Declare
+from pyccel.ast.core       import Import, Module, Declare, Deallocate
 from pyccel.ast.cwrapper   import PyBuildValueNode, PyCapsule_New, PyCapsule_Import, PyModule_Create
-from pyccel.ast.cwrapper   import Py_None, WrapperCustomDataType
+from pyccel.ast.cwrapper   import Py_None, WrapperCustomDataType, PyUFunc_FromFuncAndDataAndSignature
 from pyccel.ast.cwrapper   import PyccelPyObject, PyccelPyTypeObject
 from pyccel.ast.literals   import LiteralString, Nil, LiteralInteger
 from pyccel.ast.numpy_wrapper import PyccelPyArrayObject
@@ -45,6 +45,9 @@ class CWrapperCodePrinter(CCodePrinter):
             The name of the file being pyccelised.
     target_language : str
             The language which the code was translated to [fortran/c].
+    profile : bool, default: False
+            Indicates whether the module gives access to the counters of the
+            code instrumented with `--profile` (see `CCodePrinter`).
     **settings : dict
             Any additional arguments which are necessary for CCodePrinter.
     """
@@ -54,9 +57,10 @@ class CWrapperCodePrinter(CCodePrinter):
                       PyccelPyTypeObject() : 'PyTypeObject',
                       BindCPointer()  : 'void'}
 
-    def __init__(self, filename, target_language, **settings):
+    def __init__(self, filename, target_language, profile = False, **settings):
         CCodePrinter.__init__(self, filename, **settings)
         self._target_language = target_language
+        self._profile_module = profile
         self._to_free_PyObject_list = []
         self._function_wrapper_names = dict()
         self._module_name = None
@@ -88,11 +92,58 @@ class CWrapperCodePrinter(CCodePrinter):
         """
         if isinstance(a.dtype, (WrapperCustomDataType, BindCPointer)):
             return True
-        elif isinstance(a, (PyBuildValueNode, PyCapsule_New, PyCapsule_Import, PyModule_Create)):
+        elif isinstance(a, (PyBuildValueNode, PyCapsule_New, PyCapsule_Import, PyModule_Create,
+                            PyUFunc_FromFuncAndDataAndSignature)):
             return True
         else:
             return CCodePrinter.is_c_pointer(self,a)
 
+    def _get_promoted_stack_arrays(self, expr):
+        """
+        Get the small local arrays of a function which can be stored on the stack.
+
+        The arrays of the wrapper functions are passed to Python so they are
+        never stored on the stack.
+
+        Parameters
+        ----------
+        expr : FunctionDef
+            The function being printed.
+
+        Returns
+        -------
+        set of Variable
+            An empty set.
+
+        See Also
+        --------
+        CCodePrinter._get_promoted_stack_arrays : The overridden function.
+        """
+        return set()
+
+    def _get_error_return(self, results):
+        """
+        Get the code which returns from a function after an error.
+
+        The wrapper functions raise the errors reported by the runtime as
+        Python exceptions themselves so no code is added to return early.
+
+        Parameters
+        ----------
+        results : list of Variable
+            The results of the function.
+
+        Returns
+        -------
+        None
+            No code is added after the calls which may fail.
+
+        See Also
+        --------
+        CCodePrinter._get_error_return : The overridden function.
+        """
+        return None
+
     def get_python_name(self, scope, obj):
         """
         Get the name of object as defined in the original python code.
@@ -215,12 +266,18 @@ class CWrapperCodePrinter(CCodePrinter):
         # All args are modified so even pointers are passed by address
         args    = ', '.join(f'&{a.name}' for a in expr.args)
 
+        # Calls with positional arguments only are unpacked without parsing the flags
+        n_args = len(expr.args)
+        n_required = flags.find('|') if '|' in flags else n_args
+        fast_path = ', '.join([f'PyArgs_UnpackPositional({pyarg}, {pykwarg}, {n_required}, {n_args}'] +
+                              [f'&{a.name}' for a in expr.args]) + ')'
+
         if expr.args:
             code = f'{name}({pyarg}, {pykwarg}, "{flags}", {expr.arg_names.name}, {args})'
         else :
             code =f'{name}({pyarg}, {pykwarg}, "", {expr.arg_names.name})'
 
-        return code
+        return f'({fast_path} || {code})'
 
     def _print_PyBuildValueNode(self, expr):
         name  = 'Py_BuildValue'
@@ -233,6 +290,67 @@ class CWrapperCodePrinter(CCodePrinter):
             code = f'(*{name}(""))'
         return code
 
+    def _print_PyAllowThreads(self, expr):
+        body = self._print(expr.body)
+        return f'Py_BEGIN_ALLOW_THREADS\n{body}Py_END_ALLOW_THREADS\n'
+
+    def _print_PyUFuncLoop(self, expr):
+        self.set_scope(expr.scope)
+        operands = expr.operands
+        n_operands = len(operands)
+        index = self._print(expr.index)
+
+        decs = ''.join(self._print(Declare(v)) for v in self.scope.variables.values())
+
+        # Create the views describing the core dimensions of the array operands
+        views = ''
+        core_offset = 0
+        for k, v in enumerate(operands):
+            if v.rank:
+                name = self._print(v)
+                type_tag = self.find_in_ndarray_type_registry(v.dtype)
+                c_type = self.find_in_dtype_registry(v.dtype)
+                order = 'order_f' if v.order == 'F' else 'order_c'
+                views += (f'{name} = ufunc_core_to_ndarray({v.rank}, dimensions + {1 + core_offset}, '
+                          f'steps + {n_operands + core_offset}, {type_tag}, sizeof({c_type}), {order});\n')
+                core_offset += v.rank
+
+        element = lambda k: f'args[{k}] + {index} * steps[{k}]'
+        collect = ''.join(f'{self._print(v)}.raw_data = {element(k)};\n' if v.rank
+                    else f'{self._print(v)} = *({self.find_in_dtype_registry(v.dtype)}*)({element(k)});\n'
+                    for k, v in enumerate(expr.inputs))
+        body = self._print(expr.body)
+        save = ''.join(f'*({self.find_in_dtype_registry(v.dtype)}*)({element(k)}) = {self._print(v)};\n'
+                    for k, v in enumerate(expr.outputs, start = len(expr.inputs)))
+        free_views = ''.join(self._print(Deallocate(v)) for v in operands if v.rank)
+
+        self.exit_scope()
+
+        return (f'static void {expr.name}(char **args, npy_intp const *dimensions, npy_intp const *steps, void *data)\n{{\n'
+                f'{decs}{views}'
+                f'for ({index} = 0; {index} < dimensions[0]; {index}++)\n{{\n'
+                f'{collect}{body}{save}'
+                f'}}\n{free_views}}}\n')
+
+    def _print_PyUFunc(self, expr):
+        loops = '\n'.join(self._print(l) for l in expr.loops)
+        funcs = ', '.join(f'(PyUFuncGenericFunction){l.name}' for l in expr.loops)
+        data = ', '.join('NULL' for _ in expr.loops)
+        types = ',\n'.join(', '.join(self._print(t) for t in loop_types) for loop_types in expr.types)
+        return (f'{loops}\n'
+                f'static PyUFuncGenericFunction {expr.name}_funcs[] = {{{funcs}}};\n'
+                f'static void *{expr.name}_data[] = {{{data}}};\n'
+                f'static char {expr.name}_types[] = {{\n{types}\n}};\n')
+
+    def _print_PyUFunc_FromFuncAndDataAndSignature(self, expr):
+        ufunc = expr.ufunc
+        name = ufunc.name
+        docstring = self._print(LiteralString(ufunc.docstring)) if ufunc.docstring else '""'
+        signature = self._print(LiteralString(ufunc.signature)) if ufunc.signature else 'NULL'
+        return (f'PyUFunc_FromFuncAndDataAndSignature({name}_funcs, {name}_data, {name}_types, '
+                f'{len(ufunc.loops)}, {ufunc.n_inputs}, {ufunc.n_outputs}, PyUFunc_None, '
+                f'"{ufunc.python_name}", {docstring}, 0, {signature})')
+
     def _print_PyArgKeywords(self, expr):
         arg_names = ',\n'.join([f'"{a}"' for a in expr.arg_names] + [self._print(Nil())])
         return (f'static char *{expr.name}[] = {{\n'
@@ -334,6 +452,10 @@ class CWrapperCodePrinter(CCodePrinter):
 
         function_defs = '\n'.join(self._print(f) for f in funcs)
 
+        if expr.ufuncs:
+            self.add_import(Import('numpy/ufuncobject', Module('numpy/ufuncobject', (), ())))
+            function_defs += f'\n{sep}\n' + '\n'.join(self._print(u) for u in expr.ufuncs)
+
         class_defs = f"\n{sep}\n".join(self._print(c) for c in expr.classes)
 
         method_def_func = ''.join(('{{\n'
@@ -348,6 +470,22 @@ class CWrapperCodePrinter(CCodePrinter):
                                                         if f.docstring else '""')
                                      for f in funcs if not getattr(f, 'is_header', False))
 
+        if self._profile_module:
+            # Give access to the counters of the instrumented code
+            self.add_import(Import('cwrapper_profile', Module('cwrapper_profile', (), ())))
+            method_def_func += ('{\n'
+                                '"_pyccel_profile",\n'
+                                '(PyCFunction)pyc_profile_stats_to_python,\n'
+                                'METH_NOARGS,\n'
+                                '"Get the calls and the time of the functions and the allocations of the arrays."\n'
+                                '},\n'
+                                '{\n'
+                                '"_pyccel_profile_reset",\n'
+                                '(PyCFunction)pyc_profile_reset_from_python,\n'
+                                'METH_NOARGS,\n'
+                                '"Reset the counters returned by _pyccel_profile."\n'
+                                '},\n')
+
         method_def_name = self.scope.get_new_name('{}_methods'.format(expr.name))
         method_def = (f'static PyMethodDef {method_def_name}[] = {{\n'
                         f'{method_def_func}'
@@ -47,7 +47,7 @@ from pyccel.ast.literals  import LiteralInteger, LiteralFloat, Literal, LiteralE
 from pyccel.ast.literals  import LiteralTrue, LiteralFalse, LiteralString
 from pyccel.ast.literals  import Nil
 
-from pyccel.ast.mathext  import math_constants
+from pyccel.ast.mathext  import math_constants, MathGcd, MathLcm
 
 from pyccel.ast.numpyext import NumpyEmpty, NumpyInt32
 from pyccel.ast.numpyext import NumpyFloat, NumpyBool
@@ -63,7 +63,7 @@ from pyccel.ast.operators import PyccelMod, PyccelNot, PyccelAssociativeParenthe
 from pyccel.ast.operators import PyccelUnarySub, PyccelLt, PyccelGt, IfTernaryOperator
 
 from pyccel.ast.utilities import builtin_import_registry as pyccel_builtin_import_registry
-from pyccel.ast.utilities import expand_to_loops
+from pyccel.ast.utilities import expand_to_loops, is_overlapping_assign
 
 from pyccel.ast.variable import Variable, IndexedElement, InhomogeneousTupleVariable, DottedName
 
@@ -1002,19 +1002,60 @@ class FCodePrinter(CodePrinter):
 
     #========================== Numpy Elements ===============================#
 
+    def _print_reduction(self, expr, func, arg_code):
+        """
+        Print the call to a Fortran function which reduces an array.
+
+        Print the call to a Fortran intrinsic function which reduces an array
+        (e.g. sum, maxval), passing the dimension corresponding to the axis of
+        the NumPy reduction if there is one. The result is reshaped if the
+        reduction keeps the dimensions of the array.
+
+        Parameters
+        ----------
+        expr : NumpyReduction
+            The NumPy reduction.
+        func : str
+            The name of the Fortran function.
+        arg_code : str
+            The code of the array which is reduced.
+
+        Returns
+        -------
+        str
+            The code of the reduction.
+        """
+        if expr.axis is None:
+            return f'{func}({arg_code})'
+
+        array = expr.arg
+        if array.order == 'C':
+            f_dim = PyccelMinus(LiteralInteger(array.rank), expr.axis, simplify=True)
+        else:
+            f_dim = PyccelAdd(expr.axis, LiteralInteger(1), simplify=True)
+        code = f'{func}({arg_code}, dim = {self._print(f_dim)})'
+
+        if expr.keep_dims.python_value:
+            if expr.order == 'C':
+                shape = ', '.join(self._print(i) for i in reversed(expr.shape))
+            else:
+                shape = ', '.join(self._print(i) for i in expr.shape)
+            code = f'reshape([{code}], [{shape}])'
+        return code
+
     def _print_NumpySum(self, expr):
         """Fortran print."""
         rhs_code = self._print(expr.arg)
         dtype = expr.arg.dtype.primitive_type
         if isinstance(dtype, PrimitiveBooleanType):
-            return 'count({0})'.format(rhs_code)
-        return 'sum({0})'.format(rhs_code)
+            return self._print_reduction(expr, 'count', rhs_code)
+        return self._print_reduction(expr, 'sum', rhs_code)
 
     def _print_NumpyProduct(self, expr):
         """Fortran print."""
 
         rhs_code = self._print(expr.arg)
-        return 'product({0})'.format(rhs_code)
+        return self._print_reduction(expr, 'product', rhs_code)
 
     def _print_NumpyMatmul(self, expr):
         """Fortran print."""
@@ -1258,6 +1299,12 @@ class FCodePrinter(CodePrinter):
     def _print_NumpyMod(self, expr):
         return self._print(PyccelMod(*expr.args))
 
+    def _print_NumpyGcd(self, expr):
+        return self._print(MathGcd(*expr.args))
+
+    def _print_NumpyLcm(self, expr):
+        return self._print(MathLcm(*expr.args))
+
     # ======================================================================= #
     def _print_PyccelArraySize(self, expr):
         init_value = self._print(expr.arg)
@@ -1366,10 +1413,13 @@ class FCodePrinter(CodePrinter):
             arg_code = self._print(array_arg)
 
         if isinstance(array_arg.dtype.primitive_type, PrimitiveComplexType):
+            if expr.axis is not None:
+                errors.report("The maximum of a complex array along an axis is not supported in Fortran",
+                        symbol=expr, severity='fatal')
             self._additional_imports.add(Import('pyc_math_f90', Module('pyc_math_f90',(),())))
             return f'amax({array_arg})'
         else:
-            return f'maxval({arg_code})'
+            return self._print_reduction(expr, 'maxval', arg_code)
     
     def _print_NumpyAmin(self, expr):
         array_arg = expr.arg
@@ -1379,10 +1429,13 @@ class FCodePrinter(CodePrinter):
             arg_code = self._print(array_arg)
 
         if isinstance(array_arg.dtype.primitive_type, PrimitiveComplexType):
+            if expr.axis is not None:
+                errors.report("The minimum of a complex array along an axis is not supported in Fortran",
+                        symbol=expr, severity='fatal')
             self._additional_imports.add(Import('pyc_math_f90', Module('pyc_math_f90',(),())))
             return f'amin({array_arg})'
         else:
-            return f'minval({arg_code})'
+            return self._print_reduction(expr, 'minval', arg_code)
         
     def _print_PythonMin(self, expr):
         args = expr.args
@@ -1637,6 +1690,10 @@ class FCodePrinter(CodePrinter):
 
     def _print_CodeBlock(self, expr):
         if not expr.unravelled:
+            if any(is_overlapping_assign(b, language_has_vectors = True) for b in expr.body):
+                expr = CodeBlock([l for b in expr.body for l in \
+                        (self._assign_through_temporary(b) \
+                         if is_overlapping_assign(b, language_has_vectors = True) else [b])])
             body_exprs = expand_to_loops(expr,
                     self.scope.get_temporary_variable, self.scope,
                     language_has_vectors = True)
@@ -1809,7 +1866,7 @@ class FCodePrinter(CodePrinter):
             Pyccel_del_args = [FunctionCallArgument(var)]
             return self._print(FunctionCall(Pyccel__del, Pyccel_del_args))
 
-        if var.is_alias:
+        if var.is_alias or var.is_stack_array:
             return ''
         else:
             var_code = self._print(var)
@@ -154,7 +154,7 @@ class PythonCodePrinter(CodePrinter):
                 raise NotImplementedError("Type {} not handled in a FunctionalFor".format(type(body)))
         return body, iterables
 
-    def _get_numpy_name(self, expr):
+    def _get_numpy_name(self, expr, module = 'numpy'):
         """
         Get the name of a NumPy function and ensure it is imported.
 
@@ -169,6 +169,9 @@ class PythonCodePrinter(CodePrinter):
         expr : PyccelInternalFunction
             A Pyccel node describing a NumPy function.
 
+        module : str, default='numpy'
+            The NumPy module containing the function (e.g. 'numpy.random').
+
         Returns
         -------
         str
@@ -182,7 +185,7 @@ class PythonCodePrinter(CodePrinter):
         name = self._aliases.get(cls, type_name)
         if name == type_name and cls not in (PythonBool, PythonInt, PythonFloat, PythonComplex):
             self.insert_new_import(
-                    source = 'numpy',
+                    source = module,
                     target = AsName(cls, name))
         return name
 
@@ -758,6 +761,24 @@ class PythonCodePrinter(CodePrinter):
         args = ', '.join(a for a in [start, stop, num, endpoint, dtype] if a != '')
         return f"{name}({args})"
 
+    def _print_NumpyLoad(self, expr):
+        name = self._aliases.get(type(expr), expr.name)
+        filename = self._print(expr.filename)
+        mmap_mode = f"mmap_mode = '{expr.mode}'" if expr.mode else ''
+        args = ', '.join(a for a in [filename, mmap_mode] if a != '')
+        return f"{name}({args})"
+
+    def _print_NumpyMemmap(self, expr):
+        name = self._aliases.get(type(expr), expr.name)
+        filename = self._print(expr.filename)
+        dtype = self._print_dtype_argument(expr, expr.init_dtype)
+        mode = f"mode = '{expr.mode}'"
+        offset = "offset = " + self._print(expr.offset)
+        shape = "shape = " + self._print(expr.shape)
+        order = f"order = '{expr.order}'" if expr.order else ''
+        args = ', '.join(a for a in [filename, dtype, mode, offset, shape, order] if a != '')
+        return f"{name}({args})"
+
     def _print_NumpyMatmul(self, expr):
         name = self._aliases.get(type(expr), expr.name)
         return "{0}({1}, {2})".format(
@@ -790,6 +811,15 @@ class PythonCodePrinter(CodePrinter):
         args = ', '.join(self._print(a) for a in expr.args)
         return "{}({})".format(name, args)
 
+    def _print_NumpyReduction(self, expr):
+        name = self._aliases.get(type(expr),expr.name)
+        args = [self._print(expr.args[0])]
+        if expr.axis is not None:
+            args.append(f'axis = {self._print(expr.axis)}')
+        if expr.keep_dims.python_value:
+            args.append('keepdims = True')
+        return f"{name}({', '.join(args)})"
+
     def _print_NumpyResultType(self, expr):
         args = expr.args
         if len(args) == 1 and args[0].rank > 1:
@@ -801,8 +831,13 @@ class PythonCodePrinter(CodePrinter):
             args = ', '.join(self._print(a) for a in expr.args)
             return f"{name}({args})"
 
+    def _print_NumpyRand(self, expr):
+        name = self._get_numpy_name(expr, 'numpy.random')
+        args = ', '.join(self._print(a) for a in expr.args)
+        return f"{name}({args})"
+
     def _print_NumpyRandint(self, expr):
-        name = self._aliases.get(type(expr), expr.name)
+        name = self._get_numpy_name(expr, 'numpy.random')
         if expr.low:
             args = "{}, ".format(self._print(expr.low))
         else:
@@ -813,6 +848,18 @@ class PythonCodePrinter(CodePrinter):
             args += ", size = {}".format(size)
         return "{}({})".format(name, args)
 
+    def _print_NumpyRandomNormal(self, expr):
+        name = self._get_numpy_name(expr, 'numpy.random')
+        args = f"{self._print(expr.loc)}, {self._print(expr.scale)}"
+        if expr.rank != 0:
+            args += f", size = {self._print(expr.shape)}"
+        return f"{name}({args})"
+
+    def _print_NumpyRandomSeed(self, expr):
+        name = self._get_numpy_name(expr, 'numpy.random')
+        seed = self._print(expr.seed) if expr.seed is not None else ''
+        return f"{name}({seed})\n"
+
     def _print_NumpyNorm(self, expr):
         name = self._aliases.get(type(expr), expr.name)
         axis = self._print(expr.axis) if expr.axis else None
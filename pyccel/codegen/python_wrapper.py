@@ -13,12 +13,15 @@ from pyccel.codegen.printing.cwrappercode        import CWrapperCodePrinter
 from pyccel.codegen.printing.fcode               import FCodePrinter
 from pyccel.codegen.wrapper.fortran_to_c_wrapper import FortranToCWrapper
 from pyccel.codegen.wrapper.c_to_python_wrapper  import CToPythonWrapper
-from pyccel.codegen.utilities                    import recompile_object
+from pyccel.codegen.utilities                    import recompile_objects
 from pyccel.codegen.utilities                    import copy_internal_library
 from pyccel.codegen.utilities                    import internal_libs
+from pyccel.codegen.utilities                    import internal_libs_dirpath
+from pyccel.codegen.utilities                    import get_stdlib_runtime, runtime_libs
 from pyccel.naming                               import name_clash_checkers
 from pyccel.parser.scope                         import Scope
 from pyccel.utilities.stage                      import PyccelStage
+from pyccel.utilities.profiling                  import Profiler
 from .compiling.basic                            import CompileObj
 
 from pyccel.errors.errors import Errors
@@ -26,6 +29,7 @@ from pyccel.errors.errors import Errors
 errors = Errors()
 
 pyccel_stage = PyccelStage()
+profiler = Profiler()
 
 __all__ = ['create_shared_library']
 
@@ -38,7 +42,9 @@ def create_shared_library(codegen,
                           src_compiler,
                           wrapper_compiler,
                           sharedlib_modname=None,
-                          verbose = False):
+                          verbose = False,
+                          jobs = None,
+                          stdlib_runtime = None):
     """
     Create a shared library which can be called from Pyccel.
 
@@ -86,6 +92,14 @@ def create_shared_library(codegen,
         Indicates if the compiling should be done with verbosity to show the
         compiler commands.
 
+    jobs : int, optional
+        The maximum number of files compiled at the same time. The default is
+        the number of processors.
+
+    stdlib_runtime : {'static', 'shared'}, optional
+        Link to the runtime library containing ndarrays (see `get_stdlib_runtime`)
+        instead of compiling it with the wrapper.
+
     Returns
     -------
     sharedlib_filepath : str
@@ -117,13 +131,15 @@ def create_shared_library(codegen,
             flags        = wrapper_flags,
             dependencies = (main_obj,),
             accelerators = ('python',))
+    # The files which are compiled (concurrently) once the wrapper is printed
+    to_compile = []
 
     if language == 'fortran':
         start_bind_c_wrapping = time.time()
         # Construct static interface for passing array shapes and write it to file bind_c_MOD.f90
         wrapper = FortranToCWrapper()
         bind_c_mod = wrapper.wrap(codegen.ast)
-        timings['Bind C wrapping'] = time.time() - start_bind_c_wrapping
+        timings['Bind C wrapping'] = profiler.record('Bind C wrapping', 'stage', start_bind_c_wrapping)
 
         start_bind_c_printing = time.time()
         bind_c_code = FCodePrinter(bind_c_mod.name).doprint(bind_c_mod)
@@ -131,38 +147,28 @@ def create_shared_library(codegen,
 
         with open(bind_c_filename, 'w') as f:
             f.writelines(bind_c_code)
-        timings['Bind C printing'] = time.time() - start_bind_c_printing
+        timings['Bind C printing'] = profiler.record('Bind C printing', 'stage', start_bind_c_printing)
 
-        start_bind_c_compiling = time.time()
         bind_c_obj=CompileObj(file_name = bind_c_filename,
                 folder = pyccel_dirpath,
                 flags  = main_obj.flags,
                 dependencies = (main_obj,))
         wrapper_compile_obj.add_dependencies(bind_c_obj)
-        src_compiler.compile_module(compile_obj=bind_c_obj,
-                output_folder=pyccel_dirpath,
-                verbose=verbose)
-        timings['Bind C wrapping'] = time.time() - start_bind_c_compiling
+        to_compile.append((bind_c_obj, src_compiler))
         c_ast = bind_c_mod
     else:
         c_ast = codegen.ast
 
     #---------------------------------------
-    #     Compile cwrapper from stdlib
+    #     Copy cwrapper from stdlib
     #---------------------------------------
-    start_compile_libs = time.time()
     cwrapper_lib_dest_path = copy_internal_library('cwrapper', pyccel_dirpath,
                                 extra_files = {'numpy_version.h' :
                                                 get_numpy_max_acceptable_version_file()})
 
     cwrapper_lib = internal_libs["cwrapper"][1]
     cwrapper_lib.reset_folder(cwrapper_lib_dest_path)
-
-    # get the include folder path and library files
-    recompile_object(cwrapper_lib,
-                      compiler = wrapper_compiler,
-                      verbose  = verbose)
-    timings['Dependency compilation'] = time.time() - start_compile_libs
+    to_compile.append((cwrapper_lib, wrapper_compiler))
 
     wrapper_compile_obj.add_dependencies(cwrapper_lib)
 
@@ -171,13 +177,14 @@ def create_shared_library(codegen,
     #---------------------------------------
     module_old_name = codegen.ast.name
     codegen.ast.set_name(sharedlib_modname)
-    wrapper_codegen = CWrapperCodePrinter(codegen.parser.filename, language)
+    wrapper_codegen = CWrapperCodePrinter(codegen.parser.filename, language,
+                                          profile = 'profile' in main_obj.accelerators)
     Scope.name_clash_checker = name_clash_checkers['c']
     wrapper = CToPythonWrapper(base_dirpath)
 
     start_wrapper_creation = time.time()
     cwrap_ast = wrapper.wrap(c_ast)
-    timings['Wrapper creation'] = time.time() - start_wrapper_creation
+    timings['Wrapper creation'] = profiler.record('Wrapper creation', 'stage', start_wrapper_creation)
 
     start_print_cwrapper = time.time()
     wrapper_code = wrapper_codegen.doprint(cwrap_ast)
@@ -189,7 +196,7 @@ def create_shared_library(codegen,
 
     with open(wrapper_filename, 'w', encoding="utf-8") as f:
         f.writelines(wrapper_code)
-    timings['Wrapper printing'] = time.time() - start_print_cwrapper
+    timings['Wrapper printing'] = profiler.record('Wrapper printing', 'stage', start_print_cwrapper)
 
     wrapper_header_code = wrapper_codegen.doprint(ModuleHeader(cwrap_ast))
 
@@ -197,38 +204,51 @@ def create_shared_library(codegen,
         f.writelines(wrapper_header_code)
 
     #--------------------------------------------------------
-    #  Compile cwrapper_ndarrays from stdlib (if necessary)
+    #  Copy cwrapper_ndarrays from stdlib (if necessary)
     #--------------------------------------------------------
-    start_compile_libs = time.time()
-    for lib_name in ("ndarrays", "cwrapper_ndarrays"):
+    wrapper_libs = ("ndarrays", "cwrapper_ndarrays", "cwrapper_profile")
+    libs_dirpath, libs_accelerators = internal_libs_dirpath(pyccel_dirpath, main_obj.accelerators)
+    runtime_obj = None
+    if stdlib_runtime and any(l in wrapper_codegen.get_additional_imports() for l in wrapper_libs):
+        runtime_obj = get_stdlib_runtime(stdlib_runtime, wrapper_compiler, main_obj.accelerators,
+                                         jobs = jobs, verbose = verbose)
+        wrapper_compile_obj.add_dependencies(runtime_obj)
+
+    for lib_name in wrapper_libs:
         if lib_name in wrapper_codegen.get_additional_imports():
             stdlib_folder, stdlib = internal_libs[lib_name]
 
-            lib_dest_path = copy_internal_library(stdlib_folder, pyccel_dirpath)
+            if runtime_obj is not None and lib_name in runtime_libs:
+                continue
+
+            lib_dest_path = copy_internal_library(stdlib_folder, libs_dirpath)
 
-            # Pylint determines wrong type
-            stdlib.reset_folder(lib_dest_path) # pylint: disable=E1101
-            # get the include folder path and library files
-            recompile_object(stdlib,
-                              compiler = wrapper_compiler,
-                              verbose  = verbose)
+            if runtime_obj is not None:
+                # Use the runtime library rather than the objects of ndarrays and pyc_profile
+                stdlib = CompileObj(os.path.basename(stdlib.source), lib_dest_path,
+                                    accelerators = ('python', *libs_accelerators),
+                                    dependencies = (runtime_obj, cwrapper_lib))
+            else:
+                # Pylint determines wrong type
+                stdlib.reset_folder(lib_dest_path, libs_accelerators) # pylint: disable=E1101
+            to_compile.append((stdlib, wrapper_compiler))
 
             wrapper_compile_obj.add_dependencies(stdlib)
-    timings['Dependency compilation'] += (time.time() - start_compile_libs)
 
     #---------------------------------------
     #         Compile code
     #---------------------------------------
     start_compile_wrapper = time.time()
-    wrapper_compiler.compile_module(wrapper_compile_obj,
-                                output_folder = pyccel_dirpath,
-                                verbose = verbose)
+    to_compile.append((wrapper_compile_obj, wrapper_compiler))
+    recompile_objects(to_compile, jobs = jobs, verbose = verbose)
+    timings['Wrapper compilation'] = profiler.record('Wrapper compilation', 'stage', start_compile_wrapper)
 
+    start_link = time.time()
     sharedlib_filepath = src_compiler.compile_shared_library(wrapper_compile_obj,
                                                     output_folder = pyccel_dirpath,
                                                     sharedlib_modname = sharedlib_modname,
                                                     verbose = verbose)
-    timings['Wrapper compilation'] = time.time() - start_compile_wrapper
+    timings['Shared library linking'] = profiler.record('Shared library linking', 'stage', start_link)
 
     # Change working directory back to starting point
     os.chdir(base_dirpath)
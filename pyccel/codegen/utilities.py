@@ -8,17 +8,24 @@
 This file contains some useful functions to compile the generated fortran code
 """
 
+import hashlib
+import json
 import os
 import shutil
+import sys
+from concurrent.futures import ThreadPoolExecutor, wait, FIRST_COMPLETED
 from filelock import FileLock
 import pyccel.stdlib as stdlib_folder
+from pyccel.utilities.profiling import Profiler
+from pyccel.version import __version__
 
 from .compiling.basic     import CompileObj
 
 # get path to pyccel/stdlib/lib_name
 stdlib_path = os.path.dirname(stdlib_folder.__file__)
 
-__all__ = ['copy_internal_library','recompile_object']
+__all__ = ['copy_internal_library','get_stdlib_runtime','internal_libs_dirpath','recompile_object',
+           'recompile_objects']
 
 #==============================================================================
 language_extension = {'fortran':'f90', 'c':'c', 'python':'py'}
@@ -33,11 +40,74 @@ internal_libs = {
     "cwrapper"     : ("cwrapper", CompileObj("cwrapper.c",folder="cwrapper", accelerators=('python',))),
     "numpy_f90"    : ("numpy", CompileObj("numpy_f90.f90",folder="numpy")),
     "numpy_c"      : ("numpy", CompileObj("numpy_c.c",folder="numpy")),
+    "pyc_profile"  : ("ndarrays", CompileObj("pyc_profile.c",folder="ndarrays")),
 }
 internal_libs["cwrapper_ndarrays"] = ("cwrapper_ndarrays", CompileObj("cwrapper_ndarrays.c",folder="cwrapper_ndarrays",
                                                              accelerators = ('python',),
                                                              dependencies = (internal_libs["ndarrays"][1],
                                                                              internal_libs["cwrapper"][1])))
+internal_libs["cwrapper_profile"] = ("cwrapper_ndarrays", CompileObj("cwrapper_profile.c",folder="cwrapper_ndarrays",
+                                                             accelerators = ('python',),
+                                                             dependencies = (internal_libs["pyc_profile"][1],)))
+internal_libs["ufuncs"] = ("ufuncs", CompileObj("ufuncs.c",folder="ufuncs",
+                                                 dependencies = (internal_libs["ndarrays"][1],)))
+internal_libs["linalg"] = ("linalg", CompileObj("linalg.c",folder="linalg",
+                                                 dependencies = (internal_libs["ndarrays"][1],)))
+internal_libs["pyc_random"] = ("random", CompileObj("pyc_random.c",folder="random",
+                                                     dependencies = (internal_libs["ndarrays"][1],)))
+internal_libs["pyc_distributed"] = ("distributed", CompileObj("pyc_distributed.c",folder="distributed",
+                                                               accelerators = ('mpi',),
+                                                               dependencies = (internal_libs["ndarrays"][1],)))
+internal_libs["pyc_hdf5"] = ("hdf5", CompileObj("pyc_hdf5.c",folder="hdf5",
+                                                 libs = ('hdf5',),
+                                                 dependencies = (internal_libs["ndarrays"][1],)))
+
+# accelerators which the internal libraries are compiled with when the translated code uses them
+# ('profile' counts the allocations of ndarrays and times the conversions of the arrays,
+# 'blas' computes the matrix products of the linalg library with CBLAS,
+# 'openacc' keeps copies of the data of the ndarrays on the device)
+internal_libs_accelerators = ('openmp', 'profile', 'blas', 'openacc')
+
+# internal libraries which do not use Python, MPI or HDF5 and can be gathered in the runtime library
+runtime_libs = ('ndarrays', 'pyc_math_c', 'numpy_c', 'ufuncs', 'linalg', 'pyc_random', 'pyc_profile')
+
+shared_library_extension = {'darwin' : '.dylib', 'win32' : '.dll'}.get(sys.platform, '.so')
+
+#==============================================================================
+def internal_libs_dirpath(pyccel_dirpath, accelerators):
+    """
+    Get the folder where the internal libraries should be compiled.
+
+    Get the folder where the internal libraries should be copied and compiled
+    for code which uses the specified accelerators. The libraries used by code
+    compiled with OpenMP are compiled with OpenMP too (so that the array
+    primitives can use several threads), and those used by code compiled with
+    `--profile` count the allocations. They are saved in a sub-folder so that
+    they do not replace the default objects.
+
+    Parameters
+    ----------
+    pyccel_dirpath : str
+        The `__pyccel__` folder of the translated code.
+
+    accelerators : iterable of str
+        The accelerators used by the translated code.
+
+    Returns
+    -------
+    dirpath : str
+        The folder where the internal libraries should be copied.
+
+    lib_accelerators : tuple of str
+        The accelerators which the internal libraries should be compiled with.
+    """
+    lib_accelerators = tuple(a for a in internal_libs_accelerators if a in accelerators)
+    if lib_accelerators:
+        dirpath = os.path.join(pyccel_dirpath, '_'.join(lib_accelerators))
+        os.makedirs(dirpath, exist_ok = True)
+    else:
+        dirpath = pyccel_dirpath
+    return dirpath, lib_accelerators
 
 #==============================================================================
 
@@ -164,6 +234,51 @@ def copy_internal_library(lib_folder, pyccel_dirpath, extra_files = None):
                 l.release()
     return lib_dest_path
 
+#==============================================================================
+def get_build_hash(compile_obj, compiler):
+    """
+    Get a hash describing everything which is used to compile an object.
+
+    Get a hash of the contents of the source file, of the headers found in its
+    folder and in the folders of its dependencies, of the command which compiles
+    it, and of the modification times of the objects it depends on (which change
+    each time that they are compiled again).
+
+    Parameters
+    ----------
+    compile_obj : CompileObj
+        The object to compile.
+
+    compiler : Compiler
+        The compiler used.
+
+    Returns
+    -------
+    str
+        The hexadecimal hash.
+    """
+    build_hash = hashlib.sha256()
+    with open(compile_obj.source, 'rb') as f:
+        build_hash.update(f.read())
+
+    cmd = compiler.get_module_command(compile_obj, compile_obj.source_folder)
+    build_hash.update('\0'.join(cmd).encode())
+
+    folders = sorted({compile_obj.source_folder, *(d.source_folder for d in compile_obj.dependencies)})
+    for folder in folders:
+        headers = sorted(f for f in os.listdir(folder) if f.endswith('.h')) \
+                    if os.path.isdir(folder) else ()
+        for h in headers:
+            build_hash.update(h.encode())
+            with open(os.path.join(folder, h), 'rb') as f:
+                build_hash.update(f.read())
+
+    for dep in sorted(compile_obj.extra_modules):
+        if os.path.exists(dep):
+            build_hash.update(f'{dep}:{os.stat(dep).st_mtime_ns}'.encode())
+
+    return build_hash.hexdigest()
+
 #==============================================================================
 def recompile_object(compile_obj,
                    compiler,
@@ -171,8 +286,10 @@ def recompile_object(compile_obj,
     """
     Compile the provided file if necessary.
 
-    Check if the file has already been compiled, if it hasn't or if the source has
-    been modified then compile the file.
+    Check if the file has already been compiled, if it hasn't or if anything used
+    to compile it has changed since then (see `get_build_hash`) then compile the
+    file. The hash of the last compilation is saved next to the object in a
+    `.hash` file.
 
     Parameters
     ----------
@@ -185,17 +302,154 @@ def recompile_object(compile_obj,
     verbose : bool
         Indicates whether additional information should be printed.
     """
+    hash_file = compile_obj.module_target + '.hash'
 
-    # compile library source files
-    with compile_obj:
-        if os.path.exists(compile_obj.module_target):
-            # Check if source file has changed since last compile
-            o_file_age   = os.path.getmtime(compile_obj.module_target)
-            src_file_age = os.path.getmtime(compile_obj.source)
-            outdated     = o_file_age < src_file_age
-        else:
-            outdated = True
-    if outdated:
-        compiler.compile_module(compile_obj=compile_obj,
-                output_folder=compile_obj.source_folder,
-                verbose=verbose)
+    with Profiler().span(os.path.basename(compile_obj.source), 'compile') as span_args:
+        # compile library source files
+        with compile_obj:
+            build_hash = get_build_hash(compile_obj, compiler)
+            try:
+                with open(hash_file, 'r', encoding='utf-8') as f:
+                    outdated = f.read() != build_hash or not os.path.exists(compile_obj.module_target)
+            except FileNotFoundError:
+                outdated = True
+        if outdated:
+            compiler.compile_module(compile_obj=compile_obj,
+                    output_folder=compile_obj.source_folder,
+                    verbose=verbose)
+            with compile_obj:
+                with open(hash_file, 'w', encoding='utf-8') as f:
+                    f.write(build_hash)
+        elif verbose:
+            print(f'> {compile_obj.module_target} is up to date')
+        span_args['up_to_date'] = not outdated
+
+#==============================================================================
+def recompile_objects(targets, jobs = None, verbose = False):
+    """
+    Compile several files concurrently if necessary.
+
+    Compile the files (each one with `recompile_object`) using a pool of
+    threads. A file is only compiled once the files of the list which it
+    depends on have been compiled.
+
+    Parameters
+    ----------
+    targets : iterable of tuple of (CompileObj, Compiler)
+        The objects to compile and the compiler which should be used for each one.
+
+    jobs : int, optional
+        The maximum number of files compiled at the same time. The default is
+        the number of processors.
+
+    verbose : bool
+        Indicates whether additional information should be printed.
+    """
+    targets = dict(targets)
+    remaining = {obj : {d for d in obj.dependencies if d in targets} for obj in targets}
+
+    with ThreadPoolExecutor(max_workers = jobs or os.cpu_count()) as pool:
+        running = {}
+        while remaining or running:
+            ready = [obj for obj, deps in remaining.items() if not deps]
+            for obj in ready:
+                del remaining[obj]
+                running[pool.submit(recompile_object, obj, targets[obj], verbose)] = obj
+            if not running:
+                raise RuntimeError('Circular dependencies between the compiled files')
+
+            done, _ = wait(running, return_when = FIRST_COMPLETED)
+            for future in done:
+                obj = running.pop(future)
+                # Raise the compilation errors
+                future.result()
+                for deps in remaining.values():
+                    deps.discard(obj)
+
+#==============================================================================
+def get_stdlib_runtime(mode, compiler, accelerators, jobs = None, verbose = False):
+    """
+    Get the runtime library containing the internal libraries.
+
+    Get a library containing the internal libraries which do not use Python
+    (see `runtime_libs`), so that all the translated modules can link to it
+    instead of compiling and linking their own copies. The library is built once
+    for each version of Pyccel and each compiler, flags and accelerators, in the
+    folder `PYCCEL_RUNTIME_DIR` (default: `~/.cache/pyccel`). The libraries
+    which use Python are always compiled with each module as they use the NumPy
+    API table of the module.
+
+    Parameters
+    ----------
+    mode : {'static', 'shared'}
+        Indicates whether the translated modules link to a static archive or to
+        a shared library (shared by all the modules loaded in a process).
+
+    compiler : Compiler
+        The compiler used.
+
+    accelerators : iterable of str
+        The accelerators used by the translated code.
+
+    jobs : int, optional
+        The maximum number of files compiled at the same time.
+
+    verbose : bool
+        Indicates whether additional information should be printed.
+
+    Returns
+    -------
+    CompileObj
+        An object without a target file which describes the include directories,
+        the library and the library directory of the runtime.
+    """
+    if mode not in ('static', 'shared'):
+        raise ValueError(f"Unknown runtime library mode : {mode}")
+
+    lib_accelerators = tuple(a for a in internal_libs_accelerators if a in accelerators)
+
+    # The runtime is identified by the sources and by the way they are compiled
+    description = hashlib.sha256(json.dumps({'pyccel' : __version__,
+                                             'mode'   : mode,
+                                             'build'  : compiler.get_build_description(lib_accelerators)}).encode())
+    for lib in runtime_libs:
+        lib_path = os.path.join(stdlib_path, internal_libs[lib][0])
+        for f in sorted(os.listdir(lib_path)):
+            if f.endswith(('.c', '.h')):
+                with open(os.path.join(lib_path, f), 'rb') as src:
+                    description.update(src.read())
+    key = description.hexdigest()[:16]
+
+    cache_dirpath = os.environ.get('PYCCEL_RUNTIME_DIR',
+            os.path.join(os.environ.get('XDG_CACHE_HOME', os.path.join(os.path.expanduser('~'), '.cache')), 'pyccel'))
+    runtime_dirpath = os.path.join(cache_dirpath, f'runtime_{key}')
+    os.makedirs(runtime_dirpath, exist_ok = True)
+
+    lib_objs = []
+    for lib in runtime_libs:
+        stdlib_folder, stdlib = internal_libs[lib]
+        lib_dest_path = copy_internal_library(stdlib_folder, runtime_dirpath)
+        # Pylint determines wrong type
+        stdlib.reset_folder(lib_dest_path, lib_accelerators) # pylint: disable=E1101
+        lib_objs.append(stdlib)
+
+    recompile_objects([(o, compiler) for o in lib_objs], jobs = jobs, verbose = verbose)
+
+    lib_name = f'pyccel_stdlib_{key}'
+    library = os.path.join(runtime_dirpath, f'lib{lib_name}' + \
+                    (shared_library_extension if mode == 'shared' else '.a'))
+    library_obj = CompileObj(lib_name, runtime_dirpath,
+                        dependencies = lib_objs,
+                        accelerators = lib_accelerators)
+    with library_obj:
+        outdated = not os.path.exists(library) or \
+                any(os.path.getmtime(o.module_target) > os.path.getmtime(library) for o in lib_objs)
+        if outdated:
+            compiler.compile_library(library_obj, library, shared = (mode == 'shared'), verbose = verbose)
+
+    return CompileObj(lib_name, runtime_dirpath,
+                        includes     = [o.source_folder for o in lib_objs],
+                        libs         = (lib_name,),
+                        libdirs      = (runtime_dirpath,),
+                        accelerators = lib_accelerators,
+                        has_target_file = False)
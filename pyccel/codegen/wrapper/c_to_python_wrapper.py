@@ -22,7 +22,8 @@ from pyccel.ast.cwrapper      import PyModule, PyccelPyObject, PyArgKeywords, Py
 from pyccel.ast.cwrapper      import PyArg_ParseTupleNode, Py_None, PyClassDef, PyModInitFunc
 from pyccel.ast.cwrapper      import py_to_c_registry, check_type_registry, PyBuildValueNode
 from pyccel.ast.cwrapper      import PyErr_SetString, PyTypeError, PyNotImplementedError
-from pyccel.ast.cwrapper      import PyAttributeError
+from pyccel.ast.cwrapper      import PyAttributeError, PyAllowThreads
+from pyccel.ast.cwrapper      import PyUFunc, PyUFuncLoop, PyUFunc_FromFuncAndDataAndSignature
 from pyccel.ast.cwrapper      import C_to_Python, PyFunctionDef, PyInterface
 from pyccel.ast.cwrapper      import PyModule_AddObject, Py_DECREF, PyObject_TypeCheck
 from pyccel.ast.cwrapper      import Py_INCREF, PyType_Ready, WrapperCustomDataType
@@ -35,13 +36,16 @@ from pyccel.ast.datatypes     import FixedSizeNumericType
 from pyccel.ast.literals      import Nil, LiteralTrue, LiteralString, LiteralInteger
 from pyccel.ast.literals      import LiteralFalse
 from pyccel.ast.numpyext      import NumpyNDArrayType
-from pyccel.ast.numpy_wrapper import pyarray_to_ndarray, PyArray_SetBaseObject, import_array
+from pyccel.ast.numpytypes     import numpy_precision_map
+from pyccel.ast.numpy_wrapper import pyarray_to_ndarray, PyArray_SetBaseObject, import_array, import_umath
 from pyccel.ast.numpy_wrapper import array_get_data, array_get_dim
 from pyccel.ast.numpy_wrapper import array_get_c_step, array_get_f_step
 from pyccel.ast.numpy_wrapper import numpy_dtype_registry, numpy_flag_f_contig, numpy_flag_c_contig
-from pyccel.ast.numpy_wrapper import pyarray_check, is_numpy_array, no_order_check
+from pyccel.ast.numpy_wrapper import pyarray_check, is_numpy_array, no_order_check, pyarray_export
+from pyccel.ast.numpy_wrapper import pyc_error_occurred, pyc_raise_error
 from pyccel.ast.operators     import PyccelNot, PyccelIsNot, PyccelUnarySub, PyccelEq, PyccelIs
 from pyccel.ast.operators     import PyccelLt, IfTernaryOperator
+from pyccel.ast.utilities     import may_fail
 from pyccel.ast.variable      import Variable, DottedVariable, IndexedElement
 from pyccel.parser.scope      import Scope
 from pyccel.errors.errors     import Errors
@@ -72,6 +76,8 @@ class CToPythonWrapper(Wrapper):
         self._wrapping_arrays = False
         # The object that should be returned to indicate an error
         self._error_exit_code = Nil()
+        # The array arguments which must be released before returning from the current function
+        self._exported_arrays = []
 
         self._file_location = file_location
         super().__init__()
@@ -183,7 +189,7 @@ class CToPythonWrapper(Wrapper):
             "x",
             NULL
         };
-        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwlist, &x_obj))
+        if (!(PyArgs_UnpackPositional(args, kwargs, 1, 1, &x_obj) || PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwlist, &x_obj)))
         {
             return NULL;
         }
@@ -214,6 +220,49 @@ class CToPythonWrapper(Wrapper):
 
         return func_args, body
 
+    def _export_array_arguments(self, python_arg_objs, argument_lists):
+        """
+        Get the code which requests the data of the array arguments once per call.
+
+        Array arguments which are not NumPy arrays (objects exporting the buffer protocol
+        or DLPack) must be described once per call, and the buffer or the DLPack tensor
+        must be kept alive until the translated function returns. The Python objects are
+        therefore replaced by the result of `pyarray_export`, which is a new reference
+        that must be released with `Py_DECREF` after the call (or before returning an
+        error).
+
+        Parameters
+        ----------
+        python_arg_objs : list of Variable
+            The variables with datatype `PyccelPyObject` where the arguments are stored.
+
+        argument_lists : list of iterable of FunctionDefArgument
+            The arguments of each function which can be called with these objects. There
+            are several functions if the arguments are passed to an interface.
+
+        Returns
+        -------
+        body : list of pyccel.ast.basic.PyccelAstNode
+            The code which replaces the objects.
+
+        exported : list of Variable
+            The objects which must be released.
+        """
+        body = []
+        exported = []
+        for i, py_arg in enumerate(python_arg_objs):
+            arg_vars = [getattr(args[i], 'original_function_argument_variable', args[i].var) for args in argument_lists]
+            array_vars = [v for v in arg_vars if v.is_ndarray]
+            if not array_vars:
+                continue
+            writable = LiteralTrue() if any(not v.is_const for v in array_vars) else LiteralFalse()
+            body.append(AliasAssign(py_arg, FunctionCall(pyarray_export, [py_arg, writable])))
+            body.append(If(IfSection(PyccelIs(py_arg, Nil()),
+                            [FunctionCall(Py_DECREF, [o]) for o in exported] +
+                            [Return([self._error_exit_code])])))
+            exported.append(py_arg)
+        return body, exported
+
     def _get_python_result_variables(self, results):
         """
         Get a new set of `PyccelPyObject` `Variable`s representing each of the results.
@@ -575,7 +624,7 @@ class CToPythonWrapper(Wrapper):
         initialised.append(obj)
         return [if_expr, FunctionCall(Py_INCREF, (obj,))]
 
-    def _build_module_init_function(self, expr, imports):
+    def _build_module_init_function(self, expr, imports, ufuncs = ()):
         """
         Build the function that will be called when the module is first imported.
 
@@ -591,6 +640,9 @@ class CToPythonWrapper(Wrapper):
         imports : list of Import
             A list of any imports that will appear in the PyModule.
 
+        ufuncs : list of PyUFunc, optional
+            The NumPy universal functions which should be added to the module.
+
         Returns
         -------
         PyModInitFunc
@@ -637,6 +689,8 @@ class CToPythonWrapper(Wrapper):
         body.extend(self._add_object_to_mod(module_var, capsule_obj, '_C_API', initialised))
 
         body.append(FunctionCall(import_array, ()))
+        if ufuncs:
+            body.append(FunctionCall(import_umath, ()))
         import_funcs = [i.source_module.import_func for i in imports if isinstance(i.source_module, PyModule)]
         for i_func in import_funcs:
             body.append(If(IfSection(PyccelLt(FunctionCall(i_func, ()), ok_code),
@@ -646,6 +700,8 @@ class CToPythonWrapper(Wrapper):
         # Call the initialisation function
         if expr.init_func:
             body.append(FunctionCall(expr.init_func, []))
+            body.extend(self._get_runtime_error_check(expr.init_func,
+                            [FunctionCall(Py_DECREF, [i]) for i in initialised]))
 
         # Save classes to the module variable
         for i,c in enumerate(expr.classes):
@@ -661,6 +717,12 @@ class CToPythonWrapper(Wrapper):
 
             body.extend(self._add_object_to_mod(module_var, type_object, class_name, initialised))
 
+        # Save the universal functions to the module variable
+        for u in ufuncs:
+            ufunc_obj = self.get_new_PyObject(f'{u.name}_obj')
+            body.append(AliasAssign(ufunc_obj, PyUFunc_FromFuncAndDataAndSignature(u)))
+            body.extend(self._add_object_to_mod(module_var, ufunc_obj, u.python_name, initialised))
+
         # Save module variables to the module variable
         for v in expr.variables:
             if v.is_private:
@@ -894,6 +956,11 @@ class CToPythonWrapper(Wrapper):
         # Get the results of the PyFunctionDef
         python_result_variable = Variable(CNativeInt(), self.scope.get_new_name(), is_temp = True)
 
+        # Request the data of the array arguments
+        export_code, self._exported_arrays = self._export_array_arguments(
+                [self._python_object_map[a] for a in python_args], [python_args])
+        body += export_code
+
         # Get the code required to extract the C-compatible arguments from the Python arguments
         body += [l for a in python_args for l in self._wrap(a)]
 
@@ -909,14 +976,12 @@ class CToPythonWrapper(Wrapper):
         # The C equivalent is the same variable that is passed to the function unless the target language is Fortran.
         # In this case the function arguments are the data pointer and the shapes and strides, but the C equivalent
         # is an ndarray.
-        for a in original_c_args:
-            orig_var = getattr(a, 'original_function_argument_variable', a.var)
-            if orig_var.is_ndarray:
-                v = self.scope.find(orig_var.name, category='variables', raise_if_missing = True)
-                if v.is_optional:
-                    body.append(If( IfSection(PyccelIsNot(v, Nil()), [Deallocate(v)]) ))
-                else:
-                    body.append(Deallocate(v))
+        deallocs = self._deallocate_array_arguments(original_c_args)
+        release = [FunctionCall(Py_DECREF, [o]) for o in self._exported_arrays]
+        body.extend(self._get_runtime_error_check(init_function, [*deallocs, *release]))
+        body.extend(deallocs)
+        body.extend(release)
+        self._exported_arrays = []
 
         # Pack the Python compatible results of the function into one argument.
         func_results = [FunctionDefResult(python_result_variable)]
@@ -1003,6 +1068,158 @@ class CToPythonWrapper(Wrapper):
 
     #--------------------------------------------------------------------------------------------------------------------------------------------
 
+    @staticmethod
+    def _is_ufunc(func):
+        """
+        Indicate whether a function is exposed to Python as a NumPy universal function.
+
+        Indicate whether a function was decorated with `@ufunc`.
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The C-compatible function.
+
+        Returns
+        -------
+        bool
+            True if the function is exposed as a NumPy universal function.
+        """
+        return 'ufunc' in getattr(func, 'original_function', func).decorators
+
+    def _get_ufunc_loop(self, func):
+        """
+        Build the inner loop of a NumPy universal function.
+
+        Build the `PyUFuncLoop` which calls a C-compatible function for each element
+        of the operands of the ufunc. The scalar arguments and results are collected
+        from (and saved to) the elements of the operands. The array arguments are
+        views of the core dimensions of the elements. When the target language is
+        Fortran the views are unpacked into the data, shapes and strides expected by
+        the `BindCFunctionDef`.
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The C-compatible function called in the loop.
+
+        Returns
+        -------
+        loop : PyUFuncLoop
+            The inner loop.
+
+        types : list of Variable
+            The NumPy types of the operands of the loop.
+
+        signature : str
+            The signature of the operands of the loop (e.g. `"(x_0),()->()"`).
+        """
+        is_bind_c_function_def = isinstance(func, BindCFunctionDef)
+        original_func = getattr(func, 'original_function', func)
+        loop_name = self.scope.get_new_name(f'{original_func.name}_loop')
+        loop_scope = self.scope.new_child_scope(loop_name)
+        self.scope = loop_scope
+        for n in ('args', 'dimensions', 'steps', 'data'):
+            loop_scope.insert_symbol(n)
+
+        python_args = func.bind_c_arguments if is_bind_c_function_def else func.arguments
+        python_results = func.bind_c_results if is_bind_c_function_def else func.results
+
+        operands = []
+        body = []
+        call_args = {}
+        core_dims = []
+        for a, orig_arg in zip(python_args, original_func.arguments):
+            orig_var = getattr(a, 'original_function_argument_variable', a.var)
+            if orig_var.rank:
+                v = orig_var.clone(self.scope.get_new_name(orig_var.name), is_argument = False,
+                                    memory_handling='alias', new_class = Variable)
+                self._wrapping_arrays = True
+                core_dims.append('(' + ','.join(f'{orig_arg.name}_{i}' for i in range(orig_var.rank)) + ')')
+            else:
+                v = orig_var.clone(self.scope.get_new_name(orig_var.name), is_argument = False)
+                core_dims.append('()')
+            self.scope.insert_variable(v)
+            operands.append(v)
+
+            if is_bind_c_function_def and orig_var.rank:
+                if orig_var.rank > 1:
+                    errors.report("The array arguments of a ufunc translated to Fortran must have rank 1",
+                            symbol = orig_arg, severity = 'error')
+                # Unpack the view into the arguments of the Fortran function
+                data_var = a.var.clone(self.scope.get_new_name(a.var.name), is_argument = False)
+                shape_vars = [s.clone(self.scope.get_new_name(s.name), is_argument = False) for s in a.shape]
+                stride_vars = [s.clone(self.scope.get_new_name(s.name), is_argument = False) for s in a.strides]
+                for w, o in zip((data_var, *shape_vars, *stride_vars), (a.var, *a.shape, *a.strides)):
+                    self.scope.insert_variable(w)
+                    call_args[o] = w
+                step = array_get_c_step if orig_var.order == 'C' else array_get_f_step
+                body.append(AliasAssign(data_var, FunctionCall(array_get_data, [v])))
+                body.extend(Assign(s, FunctionCall(array_get_dim, [v, i])) for i,s in enumerate(shape_vars))
+                body.extend(Assign(s, FunctionCall(step, [v, i])) for i,s in enumerate(stride_vars))
+            else:
+                call_args[a.var] = v
+
+        n_inputs = len(operands)
+        for r in python_results:
+            orig_var = getattr(r, 'original_function_result_variable', r.var)
+            v = orig_var.clone(self.scope.get_new_name(orig_var.name), is_argument = False)
+            self.scope.insert_variable(v)
+            operands.append(v)
+        c_results = operands[n_inputs:]
+
+        # Call the C-compatible function
+        func_call = FunctionCall(func, [call_args[a.var] for a in func.arguments])
+        if len(c_results) == 1:
+            body.append(Assign(c_results[0], func_call))
+        else:
+            body.append(Assign(c_results, func_call))
+
+        index = Variable(PythonNativeInt(), self.scope.get_new_name('i'))
+        self.scope.insert_variable(index)
+
+        self.exit_scope()
+
+        types = [numpy_dtype_registry.get(v.dtype, None) or
+                 numpy_dtype_registry[numpy_precision_map[(v.dtype.primitive_type, v.dtype.precision)]]
+                 for v in operands]
+        signature = ','.join(core_dims) + '->' + ','.join('()' for _ in c_results)
+
+        return PyUFuncLoop(loop_name, operands, n_inputs, index, body, loop_scope), types, signature
+
+    def _build_ufunc(self, name, funcs):
+        """
+        Build a `PyUFunc` from the functions which implement it.
+
+        Build a `PyUFunc` describing a NumPy universal function whose inner loops
+        call the C-compatible functions. There is one loop per function so the
+        functions of a templated interface each handle one combination of types.
+        NumPy uses the first loop to which the inputs can be cast safely.
+
+        Parameters
+        ----------
+        name : str
+            The name of the function (or of the interface) in the module.
+
+        funcs : list of FunctionDef
+            The C-compatible functions which implement the ufunc.
+
+        Returns
+        -------
+        PyUFunc
+            The description of the universal function.
+        """
+        loops, types, signatures = zip(*[self._get_ufunc_loop(f) for f in funcs])
+        signature = signatures[0]
+        if any(s != signature for s in signatures):
+            errors.report(f"The functions of the ufunc {name} do not have the same signature ({', '.join(signatures)})",
+                    symbol = funcs[0], severity = 'error')
+        is_gufunc = any(v.rank for v in loops[0].inputs)
+        original_func = getattr(funcs[0], 'original_function', funcs[0])
+        docstring = '\n'.join(original_func.docstring.comments) if original_func.docstring else None
+        return PyUFunc(self.scope.get_new_name(f'{name}_ufunc'), self.scope.get_python_name(name),
+                       loops, types, signature if is_gufunc else None, docstring)
+
     def _wrap_Module(self, expr):
         """
         Build a `PyModule` from a `Module`.
@@ -1039,12 +1256,20 @@ class CToPythonWrapper(Wrapper):
         if removed_functions:
             funcs_to_wrap.extend(removed_functions)
 
+        # Wrap the functions which are exposed as NumPy universal functions
+        ufunc_interfaces = [i for i in expr.interfaces if self._is_ufunc(i.functions[0])]
+        ufuncs = [self._build_ufunc(i.name, i.functions) for i in ufunc_interfaces]
+        ufunc_funcs = [f for i in ufunc_interfaces for f in i.functions]
+        ufuncs += [self._build_ufunc(getattr(f, 'original_function', f).name, [f])
+                   for f in funcs_to_wrap if self._is_ufunc(f) and f not in ufunc_funcs]
+        funcs_to_wrap = [f for f in funcs_to_wrap if not self._is_ufunc(f)]
+
         funcs = [self._wrap(f) for f in funcs_to_wrap]
 
         # Wrap interfaces
-        interfaces = [self._wrap(i) for i in expr.interfaces if not i.is_inline]
+        interfaces = [self._wrap(i) for i in expr.interfaces if not i.is_inline and i not in ufunc_interfaces]
 
-        init_func = self._build_module_init_function(expr, imports)
+        init_func = self._build_module_init_function(expr, imports, ufuncs)
 
         API_var, import_func = self._build_module_import_function(expr)
 
@@ -1056,7 +1281,7 @@ class CToPythonWrapper(Wrapper):
         original_mod = getattr(expr, 'original_module', expr)
         return PyModule(original_mod.name, [API_var], funcs, imports = imports,
                         interfaces = interfaces, classes = classes, scope = mod_scope,
-                        init_func = init_func, import_func = import_func)
+                        init_func = init_func, import_func = import_func, ufuncs = ufuncs)
 
     def _wrap_BindCModule(self, expr):
         """
@@ -1169,6 +1394,14 @@ class CToPythonWrapper(Wrapper):
         type_check_func, argument_type_flags = self._get_type_check_function(type_check_name, python_arg_objs, original_funcs)
 
         self.scope = func_scope
+        # Request the data of the array arguments once for all the functions
+        export_code, exported = self._export_array_arguments(python_arg_objs,
+                [getattr(f, 'bind_c_arguments', f.arguments) for f in original_funcs])
+        body.extend(export_code)
+        release = [FunctionCall(Py_DECREF, [o]) for o in exported]
+        if exported:
+            result = self.get_new_PyObject("result")
+
         # Build the body of the function
         body.append(Assign(type_indicator, FunctionCall(type_check_func, python_arg_objs)))
 
@@ -1177,18 +1410,24 @@ class CToPythonWrapper(Wrapper):
         for func, index in argument_type_flags.items():
             # Add an IfSection calling the appropriate function if the type_indicator matches the index
             wrapped_func = self._python_object_map[func]
-            if_sections.append(IfSection(PyccelEq(type_indicator, LiteralInteger(index)),
-                                [Return([FunctionCall(wrapped_func, python_arg_objs)])]))
+            if exported:
+                call = [AliasAssign(result, FunctionCall(wrapped_func, python_arg_objs)),
+                        *release, Return([result])]
+            else:
+                call = [Return([FunctionCall(wrapped_func, python_arg_objs)])]
+            if_sections.append(IfSection(PyccelEq(type_indicator, LiteralInteger(index)), call))
             functions.append(wrapped_func)
         if_sections.append(IfSection(LiteralTrue(),
                     [FunctionCall(PyErr_SetString, [PyTypeError, "Unexpected type combination"]),
-                     Return([self._error_exit_code])]))
+                     *release, Return([self._error_exit_code])]))
         body.append(If(*if_sections))
         self.exit_scope()
 
+        if not exported:
+            result = self.get_new_PyObject("result", is_temp=True)
         interface_func = FunctionDef(func_name,
                                      [FunctionDefArgument(a) for a in func_args],
-                                     [FunctionDefResult(self.get_new_PyObject("result", is_temp=True))],
+                                     [FunctionDefResult(result)],
                                      body,
                                      scope=func_scope)
         for a in python_args:
@@ -1196,6 +1435,62 @@ class CToPythonWrapper(Wrapper):
 
         return PyInterface(func_name, functions, interface_func, type_check_func, expr)
 
+    def _deallocate_array_arguments(self, original_c_args):
+        """
+        Get the code which deallocates the C equivalent of the array arguments.
+
+        Get the code which deallocates the C equivalent of the array arguments
+        of a function once it has been called.
+
+        Parameters
+        ----------
+        original_c_args : iterable of FunctionDefArgument
+            The arguments of the C-compatible function.
+
+        Returns
+        -------
+        list of PyccelAstNode
+            The code which deallocates the arguments.
+        """
+        deallocs = []
+        for a in original_c_args:
+            orig_var = getattr(a, 'original_function_argument_variable', a.var)
+            if orig_var.is_ndarray:
+                v = self.scope.find(orig_var.name, category='variables', raise_if_missing = True)
+                if v.is_optional:
+                    deallocs.append(If( IfSection(PyccelIsNot(v, Nil()), [Deallocate(v)]) ))
+                else:
+                    deallocs.append(Deallocate(v))
+        return deallocs
+
+    def _get_runtime_error_check(self, func, release):
+        """
+        Get the code which raises the error reported by the runtime during a call.
+
+        The functions of the C runtime which may fail (e.g. `numpy.load`) record
+        the error and the translated code returns to its caller (see `may_fail`).
+        After the call to such a function the wrapper raises the error as a
+        Python exception and returns. The code translated to Fortran does not
+        use the C runtime.
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The function which was called.
+        release : list of PyccelAstNode
+            The code which releases the objects of the wrapper before returning.
+
+        Returns
+        -------
+        list of PyccelAstNode
+            The code which checks for an error (empty if the function cannot fail).
+        """
+        if isinstance(func, BindCFunctionDef) or not may_fail(func.body):
+            return []
+        self._wrapping_arrays = True
+        return [If(IfSection(FunctionCall(pyc_error_occurred, ()),
+                    [FunctionCall(pyc_raise_error, ()), *release, Return([self._error_exit_code])]))]
+
     def _wrap_FunctionDef(self, expr):
         """
         Build a `PyFunctionDef` form a `FunctionDef`.
@@ -1275,6 +1570,13 @@ class CToPythonWrapper(Wrapper):
             if isinstance(p_r.dtype, CustomDataType):
                 body.extend(self._allocate_class_instance(p_r, p_r.cls_base.scope, c_r.var.is_alias))
 
+        # Request the data of the array arguments, the objects passed to a function of an
+        # interface are handled by the interface
+        if not in_interface:
+            export_code, self._exported_arrays = self._export_array_arguments(
+                    [self._python_object_map[a] for a in python_args], [python_args])
+            body += export_code
+
         # Get the code required to extract the C-compatible arguments from the Python arguments
         body += [l for a in python_args for l in self._wrap(a)]
 
@@ -1309,30 +1611,33 @@ class CToPythonWrapper(Wrapper):
         # Call the C-compatible function
         n_c_results = len(c_results)
         if n_c_results == 0:
-            body.append(FunctionCall(expr, func_call_args))
+            call = FunctionCall(expr, func_call_args)
         elif n_c_results == 1:
             res = c_results[0]
             if original_func.results[0].var.is_alias and not is_bind_c_function_def:
                 if isinstance(res, PointerCast):
                     res = res.obj
-                body.append(AliasAssign(res, FunctionCall(expr, func_call_args)))
+                call = AliasAssign(res, FunctionCall(expr, func_call_args))
             else:
-                body.append(Assign(res, FunctionCall(expr, func_call_args)))
+                call = Assign(res, FunctionCall(expr, func_call_args))
         else:
-            body.append(Assign(c_results, FunctionCall(expr, func_call_args)))
+            call = Assign(c_results, FunctionCall(expr, func_call_args))
+
+        # The arguments have been unpacked and the results are only wrapped after the call
+        # so the GIL can be released while the translated function is running
+        if 'nogil' in original_func.decorators:
+            body.append(PyAllowThreads([call]))
+        else:
+            body.append(call)
 
         # Deallocate the C equivalent of any array arguments
         # The C equivalent is the same variable that is passed to the function unless the target language is Fortran.
         # In this case the function arguments are the data pointer and the shapes and strides, but the C equivalent
         # is an ndarray.
-        for a in original_c_args:
-            orig_var = getattr(a, 'original_function_argument_variable', a.var)
-            if orig_var.is_ndarray:
-                v = self.scope.find(orig_var.name, category='variables', raise_if_missing = True)
-                if v.is_optional:
-                    body.append(If( IfSection(PyccelIsNot(v, Nil()), [Deallocate(v)]) ))
-                else:
-                    body.append(Deallocate(v))
+        deallocs = self._deallocate_array_arguments(original_c_args)
+        body.extend(self._get_runtime_error_check(expr,
+                        [*deallocs, *(FunctionCall(Py_DECREF, [o]) for o in self._exported_arrays)]))
+        body.extend(deallocs)
         body.extend(result_wrap)
 
         for p_r, c_r in zip(python_result_variables, original_func.results):
@@ -1366,6 +1671,8 @@ class CToPythonWrapper(Wrapper):
             for r in python_result_variables:
                 body.append(FunctionCall(Py_DECREF, [r]))
             func_results = [FunctionDefResult(res)]
+        body.extend(FunctionCall(Py_DECREF, [o]) for o in self._exported_arrays)
+        self._exported_arrays = []
         body.append(Return([res]))
 
         self.exit_scope()
@@ -1479,15 +1786,16 @@ class CToPythonWrapper(Wrapper):
             cast.insert(0, AliasAssign(arg_var, memory_var))
 
         # Create any necessary type checks and errors
+        release = [FunctionCall(Py_DECREF, [o]) for o in self._exported_arrays]
         if expr.has_default:
             check_func, err = self._get_check_function(collect_arg, orig_var, False)
             body.append(If( IfSection(check_func, cast),
-                        IfSection(PyccelIsNot(collect_arg, Py_None), [*err, Return([self._error_exit_code])])
+                        IfSection(PyccelIsNot(collect_arg, Py_None), [*err, *release, Return([self._error_exit_code])])
                         ))
         elif not (in_interface or bound_argument):
             check_func, err = self._get_check_function(collect_arg, orig_var, True)
             body.append(If( IfSection(check_func, cast),
-                        IfSection(LiteralTrue(), [*err, Return([self._error_exit_code])])
+                        IfSection(LiteralTrue(), [*err, *release, Return([self._error_exit_code])])
                         ))
         else:
             body.extend(cast)
@@ -1558,7 +1866,8 @@ class CToPythonWrapper(Wrapper):
 
         The necessary steps are:
         - Create a variable to store the C-compatible result.
-        - Cast the C object to the Python object using utility functions.
+        - Cast the C object to the Python object using utility functions. The data
+          of an array allocated by the function is given to NumPy without a copy.
         - Deallocate any unused memory (e.g. shapes of a C array).
 
         Parameters
@@ -1592,14 +1901,17 @@ class CToPythonWrapper(Wrapper):
             c_res = orig_var.clone(name, is_argument = False)
         self.scope.insert_variable(c_res, orig_var.name)
 
+        # An array allocated by the function is passed to NumPy without a copy
+        owns_data = orig_var.is_ndarray and not orig_var.is_alias
+
         # Cast from C to Python
         if not isinstance(orig_var.dtype, CustomDataType):
-            body = [AliasAssign(python_res, FunctionCall(C_to_Python(c_res), [c_res]))]
+            body = [AliasAssign(python_res, FunctionCall(C_to_Python(c_res, owns_data), [c_res]))]
         else:
             body = []
 
-        # Deallocate any unused memory
-        if orig_var.rank:
+        # Deallocate any unused memory (the cast frees the shape of an array passed to NumPy)
+        if orig_var.rank and not owns_data:
             body.append(Deallocate(c_res))
 
         return body
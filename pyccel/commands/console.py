@@ -114,6 +114,10 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
 
     group.add_argument('--output', type=str, default = '',\
                        help='folder in which the output is stored.')
+    group.add_argument('-j', '--jobs', type=int, default = None,\
+                       help='maximum number of files compiled at the same time (default: number of processors).')
+    group.add_argument('--stdlib-runtime', choices=('static', 'shared'), default = None,\
+                       help='link to a runtime library containing the internal C libraries, built once for each compiler (default: $PYCCEL_STDLIB_RUNTIME).')
 
     # ...
 
@@ -125,6 +129,10 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
                        help='uses openmp')
     group.add_argument('--openacc', action='store_true', \
                        help='uses openacc')
+    group.add_argument('--profile', action='store_true', \
+                       help='counts the calls, the time and the allocations of the generated C code (see _pyccel_profile)')
+    group.add_argument('--blas', action='store_true', \
+                       help='computes the matrix products of the generated C code with CBLAS')
     # ...
 
     # ... Other options
@@ -133,6 +141,12 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
                         help='enables verbose mode.')
     group.add_argument('--time_execution', action='store_true', \
                         help='prints the time spent in each section of the exection.')
+    group.add_argument('--export-timings', type=str, default = None, metavar='FILE', \
+                        help='file to which the time spent in each module, stage, function and compiler command is exported.')
+    group.add_argument('--timings-format', choices=('json', 'chrome'), default='json', \
+                        help='format of the file given to --export-timings (json tree or Chrome trace event format).')
+    group.add_argument('--roofline', nargs='?', const='default', default=None, metavar='PROFILE', \
+                        help='prints the estimated FLOPs, bytes moved and arithmetic intensity of each function against a machine profile (a JSON file or default).')
     group.add_argument('--developer-mode', action='store_true', \
                         help='shows internal messages')
     group.add_argument('--export-compile-info', type=str, default = None, \
@@ -244,6 +258,10 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
         accelerators.append("openmp")
     if openacc:
         accelerators.append("openacc")
+    if args.profile:
+        accelerators.append("profile")
+    if args.blas:
+        accelerators.append("blas")
 
     # ...
 
@@ -269,6 +287,9 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
                        convert_only  = args.convert_only,
                        verbose       = args.verbose,
                        show_timings  = args.time_execution,
+                       timings_file  = args.export_timings,
+                       timings_format = args.timings_format,
+                       roofline      = args.roofline,
                        language      = args.language,
                        compiler      = compiler,
                        fflags        = args.flags,
@@ -281,7 +302,9 @@ def pyccel(files=None, mpi=None, openmp=None, openacc=None, output_dir=None, com
                        accelerators  = accelerators,
                        folder        = args.output,
                        compiler_export_file = compiler_export_file,
-                       conda_warnings = args.conda_warnings)
+                       conda_warnings = args.conda_warnings,
+                       jobs           = args.jobs,
+                       stdlib_runtime = args.stdlib_runtime)
     except PyccelError:
         sys.exit(1)
     finally:
@@ -30,7 +30,7 @@ gfort_info = {'exec' : 'gfortran',
                   'libs'  : ('gomp',),
                   },
               'openacc': {
-                  'flags' : ("-ta=multicore", "-Minfo=accel"),
+                  'flags' : ('-fopenacc',),
                   },
               'family': 'GNU',
               }
@@ -74,7 +74,7 @@ pgfortran_info = {'exec' : 'pgfortran',
                   'flags' : ('-mp',),
                   },
               'openacc': {
-                  'flags' : ("-acc"),
+                  'flags' : ('-acc',),
                   },
               'family': 'PGI',
               }
@@ -92,7 +92,7 @@ nvfort_info = {'exec' : 'nvfort',
                   'flags' : ('-mp',),
                   },
               'openacc': {
-                  'flags' : ("-acc"),
+                  'flags' : ('-acc',),
                   },
               'family': 'nvidia',
               }
@@ -112,7 +112,14 @@ gcc_info = {'exec' : 'gcc',
                 'libs'  : ('gomp',),
                 },
             'openacc': {
-                'flags' : ("-ta=multicore", "-Minfo=accel"),
+                'flags' : ('-fopenacc',),
+                },
+            'profile': {
+                'flags' : ('-DPYCCEL_PROFILE',),
+                },
+            'blas': {
+                'flags' : ('-DPYCCEL_USE_CBLAS',),
+                'libs'  : ('blas',),
                 },
             'family': 'GNU',
             }
@@ -149,6 +156,13 @@ icc_info = {'exec' : 'icx',
             'openacc': {
                 'flags' : ("-ta=multicore", "-Minfo=accel"),
                 },
+            'profile': {
+                'flags' : ('-DPYCCEL_PROFILE',),
+                },
+            'blas': {
+                'flags' : ('-DPYCCEL_USE_CBLAS',),
+                'libs'  : ('blas',),
+                },
             'family': 'intel',
             }
 
@@ -164,7 +178,14 @@ pgcc_info = {'exec' : 'pgcc',
                 'flags' : ('-mp',),
                 },
             'openacc': {
-                'flags' : ("-acc"),
+                'flags' : ('-acc',),
+                },
+            'profile': {
+                'flags' : ('-DPYCCEL_PROFILE',),
+                },
+            'blas': {
+                'flags' : ('-DPYCCEL_USE_CBLAS',),
+                'libs'  : ('blas',),
                 },
             'family': 'PGI',
             }
@@ -181,7 +202,14 @@ nvc_info = {'exec' : 'nvc',
                 'flags' : ('-mp',),
                 },
             'openacc': {
-                'flags' : ("-acc"),
+                'flags' : ('-acc',),
+                },
+            'profile': {
+                'flags' : ('-DPYCCEL_PROFILE',),
+                },
+            'blas': {
+                'flags' : ('-DPYCCEL_USE_CBLAS',),
+                'libs'  : ('blas',),
                 },
             'family': 'nvidia',
             }
@@ -0,0 +1,950 @@
+# coding: utf-8
+#------------------------------------------------------------------------------------------#
+# This file is part of Pyccel which is released under MIT License. See the LICENSE file or #
+# go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details.     #
+#------------------------------------------------------------------------------------------#
+
+"""
+This module provides us with a static performance model of the functions of
+a program: the number of floating-point operations, the bytes moved between
+the memory and the processor and the arithmetic intensity of each function
+are estimated from the semantic tree, and compared with the peak performance
+and the memory bandwidth of a machine (roofline model).
+
+The memory model is the one of `MemComplexity`: the scalars live in the
+registers, the elements of the arrays are read from (or written to) the
+memory. An element whose indices do not change in the innermost loops is
+only moved once for all the iterations of these loops. An element which is
+accessed with a non-unit stride in the innermost loop (e.g. a loop over the
+first index of an array in C order) moves a whole cache line; these accesses
+are listed in the report.
+
+The trip counts and the shapes which are not known at compile time (e.g. the
+shapes of the arguments) are taken as `extent`.
+
+Example
+-------
+
+With a file mxm.py containing
+```
+def mxm(a : 'float[:,:]', b : 'float[:,:]', c : 'float[:,:]'):
+    n, m = a.shape
+    p = b.shape[1]
+    for i in range(n):
+        for j in range(p):
+            for k in range(m):
+                c[i, j] += a[i, k] * b[k, j]
+```
+
+>>> from pyccel.complexity.performance import PerfComplexity
+>>> P = PerfComplexity('mxm.py')
+>>> cost = P.cost()['mxm']
+>>> print(cost.flops, cost.bytes)
+2000000000 72016000000
+>>> print(cost.strided[0])
+line 6: the loop over k iterates along the axis 0 of b[k, j], but b is stored in order C (contiguous axis 1): interchange the loops or change the order of b
+"""
+
+import json
+import math
+import os
+
+from pyccel.ast.builtins     import PythonRange, PythonSum, PythonMax, PythonMin
+from pyccel.ast.core         import Assign, AugAssign, AliasAssign, Allocate, Deallocate
+from pyccel.ast.core         import CodeBlock, For, While, If, Return
+from pyccel.ast.core         import FunctionCall, FunctionDef
+from pyccel.ast.datatypes    import PrimitiveBooleanType, PrimitiveComplexType
+from pyccel.ast.datatypes    import PrimitiveFloatingPointType
+from pyccel.ast.internals    import PyccelArrayShapeElement
+from pyccel.ast.literals     import LiteralInteger
+from pyccel.ast.mathext      import MathFunctionBase
+from pyccel.ast.numpyext     import NumpyUfuncBase, NumpyReduction, NumpyMatmul, NumpySize, NumpyShape
+from pyccel.ast.operators    import PyccelArithmeticOperator, PyccelUnarySub
+from pyccel.ast.operators    import PyccelAdd, PyccelMinus, PyccelMul, PyccelFloorDiv
+from pyccel.ast.operators    import PyccelAssociativeParenthesis
+from pyccel.ast.variable     import Variable, IndexedElement
+from pyccel.complexity.basic import Complexity
+
+__all__ = ["machine_profiles", "MachineProfile", "StridedAccess", "FunctionCost",
+           "PerformanceModel", "PerfComplexity"]
+
+# Peak performance (GFLOP/s), memory bandwidth (GB/s) and size of a cache line
+# (bytes) of the machines which can be given by name
+machine_profiles = {
+    'default' : {'name'          : 'one x86-64 core (AVX2, FMA)',
+                 'peak_gflops'   : 48.0,
+                 'bandwidth_gbs' : 16.0,
+                 'cache_line'    : 64},
+}
+
+# Trip count and length of the dimensions which are not known at compile time
+DEFAULT_EXTENT = 1000
+
+# Operations which compute one floating-point operation per element
+_elemental_types = (PyccelArithmeticOperator, PyccelUnarySub, MathFunctionBase, NumpyUfuncBase)
+# Reductions which compute one floating-point operation per element of their argument
+_reduction_types = (NumpyReduction, PythonSum, PythonMax, PythonMin)
+# Nodes whose cost is computed by _Counter.expr_cost
+_counted_types = (IndexedElement, Variable, FunctionCall, NumpyMatmul) + _elemental_types + _reduction_types
+# Nodes which do not access the data of their arguments
+_shape_types = (PyccelArrayShapeElement, NumpySize, NumpyShape)
+
+#==============================================================================
+class MachineProfile:
+    """
+    Characteristics of a machine used by the roofline model.
+
+    The peak performance and the memory bandwidth of a machine (or of the
+    part of the machine running the code, e.g. one core) which bound the
+    performance of a function, and the size of the cache lines moved by the
+    accesses with a non-unit stride.
+
+    Parameters
+    ----------
+    name : str
+        The name of the machine.
+    peak_gflops : float
+        The peak performance in GFLOP/s.
+    bandwidth_gbs : float
+        The bandwidth of the memory in GB/s.
+    cache_line : int, default=64
+        The size of a cache line in bytes.
+    """
+    __slots__ = ('_name', '_peak_gflops', '_bandwidth_gbs', '_cache_line')
+
+    def __init__(self, name, peak_gflops, bandwidth_gbs, cache_line = 64):
+        if peak_gflops <= 0 or bandwidth_gbs <= 0 or cache_line <= 0:
+            raise ValueError(f"The characteristics of the machine {name} must be positive")
+        self._name          = name
+        self._peak_gflops   = float(peak_gflops)
+        self._bandwidth_gbs = float(bandwidth_gbs)
+        self._cache_line    = int(cache_line)
+
+    @classmethod
+    def load(cls, profile):
+        """
+        Get the profile of a machine from its name or from a JSON file.
+
+        Get the profile of one of the machines of `machine_profiles` or read
+        it from a JSON file containing a dictionary with the keys `peak_gflops`,
+        `bandwidth_gbs` and optionally `name` and `cache_line`.
+
+        Parameters
+        ----------
+        profile : str | MachineProfile
+            The name of a machine of `machine_profiles` or the name of a JSON file.
+
+        Returns
+        -------
+        MachineProfile
+            The profile of the machine.
+        """
+        if isinstance(profile, MachineProfile):
+            return profile
+        if profile in machine_profiles:
+            return cls(**machine_profiles[profile])
+        if not os.path.isfile(profile):
+            raise ValueError(f"Unknown machine profile {profile} (expected one of "
+                             f"{', '.join(machine_profiles)} or a JSON file)")
+        with open(profile, 'r', encoding='utf-8') as f:
+            info = json.load(f)
+        try:
+            return cls(name          = info.get('name', os.path.basename(profile)),
+                       peak_gflops   = info['peak_gflops'],
+                       bandwidth_gbs = info['bandwidth_gbs'],
+                       cache_line    = info.get('cache_line', 64))
+        except KeyError as e:
+            raise ValueError(f"The machine profile {profile} does not define {e}") from None
+
+    @property
+    def name(self):
+        """ The name of the machine.
+        """
+        return self._name
+
+    @property
+    def peak_gflops(self):
+        """ The peak performance in GFLOP/s.
+        """
+        return self._peak_gflops
+
+    @property
+    def bandwidth_gbs(self):
+        """ The bandwidth of the memory in GB/s.
+        """
+        return self._bandwidth_gbs
+
+    @property
+    def cache_line(self):
+        """ The size of a cache line in bytes.
+        """
+        return self._cache_line
+
+    @property
+    def ridge_point(self):
+        """
+        The arithmetic intensity (FLOP/byte) above which a function is compute-bound.
+        """
+        return self._peak_gflops / self._bandwidth_gbs
+
+    def attainable_gflops(self, intensity):
+        """
+        Get the performance attainable with a given arithmetic intensity.
+
+        Get the roof of the roofline model: the performance is bounded by the
+        bandwidth below the ridge point and by the peak performance above it.
+
+        Parameters
+        ----------
+        intensity : float
+            The arithmetic intensity in FLOP/byte.
+
+        Returns
+        -------
+        float
+            The attainable performance in GFLOP/s.
+        """
+        return min(self._peak_gflops, self._bandwidth_gbs * intensity)
+
+#==============================================================================
+class StridedAccess:
+    """
+    An access to an array with a non-unit stride in an innermost loop.
+
+    Parameters
+    ----------
+    function : str
+        The name of the function containing the loop.
+    line : int | None
+        The line of the loop.
+    loop : str
+        The name of the iterator of the loop.
+    array : IndexedElement
+        The element of the array which is accessed.
+    axis : int
+        The axis of the array along which the loop iterates.
+    stride : int | None
+        The stride of the access in elements (None if it is not known at compile time).
+    """
+    __slots__ = ('_function', '_line', '_loop', '_array', '_axis', '_stride')
+
+    def __init__(self, function, line, loop, array, axis, stride):
+        self._function = function
+        self._line     = line
+        self._loop     = loop
+        self._array    = array
+        self._axis     = axis
+        self._stride   = stride
+
+    @property
+    def function(self):
+        """ The name of the function containing the loop.
+        """
+        return self._function
+
+    @property
+    def line(self):
+        """ The line of the loop.
+        """
+        return self._line
+
+    @property
+    def array(self):
+        """ The name of the array which is accessed.
+        """
+        return str(self._array.base)
+
+    @property
+    def axis(self):
+        """ The axis of the array along which the loop iterates.
+        """
+        return self._axis
+
+    @property
+    def stride(self):
+        """ The stride of the access in elements (None if it is unknown).
+        """
+        return self._stride
+
+    def __str__(self):
+        base = self._array.base
+        line = '' if self._line is None else f"line {self._line}: "
+        if base.rank > 1 and self._axis != _contiguous_axis(base):
+            return (f"{line}the loop over {self._loop} iterates along the axis {self._axis} of "
+                    f"{_code(self._array)}, but {base} is stored in order {base.order} (contiguous "
+                    f"axis {_contiguous_axis(base)}): interchange the loops or change the order of {base}")
+        return f"{line}the loop over {self._loop} accesses {_code(self._array)} with a stride of {self._stride} elements"
+
+#==============================================================================
+class FunctionCost:
+    """
+    The estimated cost of one call to a function.
+
+    Parameters
+    ----------
+    name : str
+        The name of the function.
+    flops : int
+        The number of floating-point operations.
+    bytes_read : int
+        The number of bytes read from the memory.
+    bytes_written : int
+        The number of bytes written to the memory.
+    strided : list[StridedAccess]
+        The accesses with a non-unit stride in the innermost loops.
+    assumed_extent : bool
+        Indicates if some trip counts or shapes were not known at compile time.
+    """
+    __slots__ = ('_name', '_flops', '_bytes_read', '_bytes_written', '_strided', '_assumed_extent')
+
+    def __init__(self, name, flops, bytes_read, bytes_written, strided, assumed_extent):
+        self._name           = name
+        self._flops          = flops
+        self._bytes_read     = bytes_read
+        self._bytes_written  = bytes_written
+        self._strided        = tuple(strided)
+        self._assumed_extent = assumed_extent
+
+    @property
+    def name(self):
+        """ The name of the function.
+        """
+        return self._name
+
+    @property
+    def flops(self):
+        """ The number of floating-point operations.
+        """
+        return self._flops
+
+    @property
+    def bytes_read(self):
+        """ The number of bytes read from the memory.
+        """
+        return self._bytes_read
+
+    @property
+    def bytes_written(self):
+        """ The number of bytes written to the memory.
+        """
+        return self._bytes_written
+
+    @property
+    def bytes(self):
+        """ The number of bytes moved between the memory and the processor.
+        """
+        return self._bytes_read + self._bytes_written
+
+    @property
+    def intensity(self):
+        """
+        The arithmetic intensity in FLOP/byte (infinite if no bytes are moved).
+        """
+        return self._flops / self.bytes if self.bytes else math.inf
+
+    @property
+    def strided(self):
+        """ The accesses with a non-unit stride in the innermost loops.
+        """
+        return self._strided
+
+    @property
+    def assumed_extent(self):
+        """ Indicates if some trip counts or shapes were not known at compile time.
+        """
+        return self._assumed_extent
+
+    def time(self, machine):
+        """
+        Get the lower bound of the time of one call on a machine.
+
+        Parameters
+        ----------
+        machine : MachineProfile
+            The machine running the function.
+
+        Returns
+        -------
+        float
+            The time in seconds.
+        """
+        return max(self._flops / machine.peak_gflops, self.bytes / machine.bandwidth_gbs) * 1e-9
+
+#==============================================================================
+_operators = {PyccelAdd: '+', PyccelMinus: '-', PyccelMul: '*', PyccelFloorDiv: '//'}
+
+def _code(expr):
+    """ The Python code of an element of an array (printed in the report).
+    """
+    if isinstance(expr, IndexedElement):
+        return f"{expr.base}[{', '.join(_code(i) for i in expr.indices)}]"
+    if isinstance(expr, LiteralInteger):
+        return str(expr.python_value)
+    if type(expr) in _operators:
+        a, b = expr.args
+        return f"{_code(a)} {_operators[type(expr)]} {_code(b)}"
+    if isinstance(expr, PyccelUnarySub):
+        return f"-{_code(expr.args[0])}"
+    if isinstance(expr, PyccelAssociativeParenthesis):
+        return f"({_code(expr.args[0])})"
+    return str(expr)
+
+def _contiguous_axis(array):
+    """ The axis of an array whose elements are contiguous in memory.
+    """
+    return array.rank - 1 if array.order == 'C' else 0
+
+def _itemsize(expr):
+    """ The number of bytes of an element of an object.
+    """
+    dtype = expr.dtype
+    primitive_type = getattr(dtype, 'primitive_type', None)
+    if isinstance(primitive_type, PrimitiveBooleanType):
+        return 1
+    precision = getattr(dtype, 'precision', 8)
+    return 2*precision if isinstance(primitive_type, PrimitiveComplexType) else precision
+
+def _is_floating_point(expr):
+    """ Indicates if an object holds floating-point numbers.
+    """
+    return isinstance(getattr(expr.dtype, 'primitive_type', None),
+                      (PrimitiveFloatingPointType, PrimitiveComplexType))
+
+def _variables(expr):
+    """ The variables used by an expression.
+    """
+    if isinstance(expr, Variable):
+        return {expr}
+    return set(expr.get_attribute_nodes(Variable)) if hasattr(expr, 'get_attribute_nodes') else set()
+
+def _coefficient(index, var):
+    """
+    The coefficient of a variable in an index (None if it is not affine or unknown).
+    """
+    if index is var:
+        return 1
+    if isinstance(index, PyccelAssociativeParenthesis):
+        return _coefficient(index.args[0], var)
+    if isinstance(index, PyccelUnarySub):
+        coeff = _coefficient(index.args[0], var)
+        return None if coeff is None else -coeff
+    if isinstance(index, (PyccelAdd, PyccelMinus)):
+        a, b = index.args
+        if var not in _variables(b):
+            return _coefficient(a, var)
+        coeff = _coefficient(b, var)
+        if var in _variables(a) or coeff is None:
+            return None
+        return -coeff if isinstance(index, PyccelMinus) else coeff
+    if isinstance(index, PyccelMul):
+        a, b = index.args
+        if isinstance(b, LiteralInteger):
+            a, b = b, a
+        coeff = _coefficient(b, var)
+        if isinstance(a, LiteralInteger) and coeff is not None:
+            return a.python_value * coeff
+    return None
+
+class _Loop:
+    """
+    A loop enclosing the statement whose cost is computed.
+
+    Parameters
+    ----------
+    node : For | While
+        The loop.
+    trip_count : int
+        The number of iterations of the loop.
+    dependents : set[Variable] | None
+        The variables which change at each iteration (None if every variable may change).
+    """
+    __slots__ = ('node', 'trip_count', 'dependents')
+
+    def __init__(self, node, trip_count, dependents):
+        self.node       = node
+        self.trip_count = trip_count
+        self.dependents = dependents
+
+    def changes(self, variables):
+        """ Indicates if one of the variables changes at each iteration.
+        """
+        return self.dependents is None or not self.dependents.isdisjoint(variables)
+
+class _Cost:
+    """
+    Number of floating-point operations and bytes read and written by some code.
+    """
+    __slots__ = ('flops', 'read', 'written')
+
+    def __init__(self, flops = 0, read = 0, written = 0):
+        self.flops   = flops
+        self.read    = read
+        self.written = written
+
+    def __add__(self, other):
+        return _Cost(self.flops + other.flops, self.read + other.read, self.written + other.written)
+
+    def __mul__(self, n):
+        return _Cost(self.flops * n, self.read * n, self.written * n)
+
+    def weight(self):
+        """ The value used to choose the most expensive branch of a condition.
+        """
+        return self.flops + self.read + self.written
+
+#==============================================================================
+class _Counter:
+    """
+    Visitor computing the cost of one call to a function.
+
+    Parameters
+    ----------
+    model : PerformanceModel
+        The model computing the cost of the functions which are called.
+    name : str
+        The name of the function.
+    """
+    def __init__(self, model, name):
+        self._model      = model
+        self._name       = name
+        self._loops      = []
+        self._constants  = {}
+        self._assigned   = {}
+        self._strided    = {}
+        self.assumed     = False
+
+    @property
+    def strided(self):
+        """ The accesses with a non-unit stride found in the innermost loops.
+        """
+        return list(self._strided.values())
+
+    def function_cost(self, func):
+        """ The cost of the body of a function (or of a program).
+        """
+        for a in func.body.get_attribute_nodes(Assign):
+            if isinstance(a.lhs, Variable):
+                self._assigned[a.lhs] = self._assigned.get(a.lhs, 0) + 1
+        return self.statement_cost(func.body)
+
+    #--------------------------------------------------------------------------
+    def value(self, expr):
+        """ The integer value of an expression (None if it is not known at compile time).
+        """
+        if isinstance(expr, LiteralInteger):
+            return expr.python_value
+        if isinstance(expr, Variable):
+            return self._constants.get(expr, None)
+        if isinstance(expr, PyccelAssociativeParenthesis):
+            return self.value(expr.args[0])
+        if isinstance(expr, PyccelUnarySub):
+            a = self.value(expr.args[0])
+            return None if a is None else -a
+        if isinstance(expr, (PyccelAdd, PyccelMinus, PyccelMul, PyccelFloorDiv)):
+            a, b = (self.value(a) for a in expr.args)
+            if a is None or b is None or (b == 0 and isinstance(expr, PyccelFloorDiv)):
+                return None
+            return {PyccelAdd: a + b, PyccelMinus: a - b, PyccelMul: a * b,
+                    PyccelFloorDiv: a // b}[type(expr)]
+        if isinstance(expr, PyccelArrayShapeElement):
+            index = self.value(expr.index)
+            shape = expr.arg.shape
+            if index is not None and shape is not None and 0 <= index < len(shape) \
+                    and not isinstance(shape[index], PyccelArrayShapeElement):
+                return self.value(shape[index])
+        return None
+
+    def extent(self, expr):
+        """ The value of a length, `extent` if it is not known at compile time.
+        """
+        n = self.value(expr)
+        if n is None:
+            self.assumed = True
+            return self._model.extent
+        return max(n, 0)
+
+    def size(self, expr):
+        """ The number of elements of an object.
+        """
+        if expr.rank == 0:
+            return 1
+        if expr.shape is None:
+            self.assumed = True
+            return self._model.extent ** expr.rank
+        return math.prod(self.extent(s) for s in expr.shape)
+
+    def trip_count(self, iterable):
+        """ The number of iterations of a loop over an iterable.
+        """
+        rng = iterable.iterable
+        if not isinstance(rng, PythonRange):
+            # Iteration over the first dimension of an object
+            shape = getattr(rng, 'shape', None)
+            return self.extent(shape[0]) if shape else self.extent(None)
+        start, stop, step = (self.value(a) for a in (rng.start, rng.stop, rng.step))
+        if None in (start, stop, step) or step == 0:
+            self.assumed = True
+            return self._model.extent // abs(step) if step else self._model.extent
+        return len(range(start, stop, step))
+
+    #--------------------------------------------------------------------------
+    def multiplier(self, variables = None):
+        """
+        The number of times an access is done in the loops enclosing it.
+
+        The number of times an access is done: the product of the trip counts
+        of all the enclosing loops if variables is None, otherwise the product
+        of the trip counts of the enclosing loops down to the innermost loop
+        where one of the variables changes.
+        """
+        depth = len(self._loops)
+        if variables is not None:
+            while depth and not self._loops[depth-1].changes(variables):
+                depth -= 1
+        return math.prod(l.trip_count for l in self._loops[:depth])
+
+    def element_bytes(self, expr):
+        """
+        The number of bytes moved by an access to an element of an array.
+
+        The number of bytes moved by the access: the size of the element if
+        it is contiguous to the element accessed in the previous iteration of
+        the innermost loop, otherwise the size of a cache line (the access is
+        then saved in the list of strided accesses).
+        """
+        itemsize = _itemsize(expr)
+        loop = self._loops[-1] if self._loops else None
+        if not isinstance(getattr(loop, 'node', None), For):
+            return itemsize
+        base = expr.base
+        axes = [d for d, i in enumerate(expr.indices) if loop.changes(_variables(i))]
+        if not axes:
+            return itemsize
+        contiguous = _contiguous_axis(base)
+        if any(d != contiguous for d in axes):
+            axis = next(d for d in axes if d != contiguous)
+            # Number of elements between two consecutive elements along the axis
+            shape = base.shape or ()
+            lengths = [self.value(s) for s in shape]
+            faster = lengths[axis+1:] if base.order == 'C' else lengths[:axis]
+            stride = None if None in faster else math.prod(faster)
+        else:
+            axis = contiguous
+            target = loop.node.target
+            coeff = _coefficient(expr.indices[axis], target) if isinstance(target, Variable) else 1
+            rng = loop.node.iterable.iterable
+            step = self.value(rng.step) if isinstance(rng, PythonRange) else 1
+            stride = abs((coeff or 1) * (step or 1))
+            if stride <= 1:
+                return itemsize
+        key = (id(loop.node), _code(expr))
+        if key not in self._strided:
+            python_ast = loop.node.python_ast
+            self._strided[key] = StridedAccess(self._name, getattr(python_ast, 'lineno', None),
+                    str(loop.node.target), expr, axis, stride)
+        cache_line = self._model.machine.cache_line
+        return cache_line if stride is None else min(stride * itemsize, cache_line)
+
+    def access_cost(self, expr, written = False):
+        """ The cost of the access to the data of an array (nothing for a scalar).
+        """
+        if isinstance(expr, Variable):
+            if expr.rank == 0:
+                return _Cost()
+            n = self.size(expr) * _itemsize(expr) * self.multiplier()
+        elif expr.rank == 0:
+            variables = set().union(*(_variables(i) for i in expr.indices))
+            n = self.element_bytes(expr) * self.multiplier(variables)
+        else:
+            n = self.size(expr) * _itemsize(expr) * self.multiplier()
+        return _Cost(written = n) if written else _Cost(read = n)
+
+    def children_cost(self, expr):
+        """ The cost of the expressions used by an expression.
+        """
+        if isinstance(expr, _counted_types):
+            return self.expr_cost(expr)
+        if not hasattr(expr, 'get_attribute_nodes') or isinstance(expr, _shape_types):
+            return _Cost()
+        return sum((self.expr_cost(e) for e in expr.get_attribute_nodes(_counted_types,
+                        excluded_nodes = _shape_types)), _Cost())
+
+    def expr_cost(self, expr):
+        """ The cost of the evaluation of an expression.
+        """
+        if isinstance(expr, (Variable, IndexedElement)):
+            cost = self.access_cost(expr)
+            if isinstance(expr, IndexedElement):
+                cost = sum((self.children_cost(i) for i in expr.indices), cost)
+            return cost
+
+        if isinstance(expr, FunctionCall):
+            cost = self._model.call_cost(expr.funcdef) * self.multiplier()
+            return sum((self.children_cost(a.value) for a in expr.args
+                        if not isinstance(a.value, Variable)), cost)
+
+        # Operations: the cost of the arguments and of the operation itself
+        cost = sum((self.children_cost(a) for a in expr.args), _Cost())
+
+        if _is_floating_point(expr):
+            if isinstance(expr, NumpyMatmul):
+                a = expr.args[0]
+                inner = self.extent(a.shape[-1]) if a.rank and a.shape else self._model.extent
+                flops = 2 * self.size(expr) * inner
+            elif isinstance(expr, _reduction_types):
+                flops = self.size(expr.args[0])
+            else:
+                flops = self.size(expr)
+            cost += _Cost(flops = flops * self.multiplier())
+        return cost
+
+    #--------------------------------------------------------------------------
+    def statement_cost(self, stmt):
+        """ The cost of the execution of a statement.
+        """
+        if isinstance(stmt, CodeBlock):
+            return sum((self.statement_cost(s) for s in stmt.body), _Cost())
+
+        if isinstance(stmt, Assign):
+            return self.assign_cost(stmt)
+
+        if isinstance(stmt, For):
+            iterable = stmt.iterable
+            trip_count = self.trip_count(iterable)
+            targets = stmt.target if isinstance(stmt.target, (tuple, list)) else [stmt.target]
+            loop = _Loop(stmt, trip_count, set(targets) | set(iterable.loop_counters or ()))
+            self._loops.append(loop)
+            cost = self.statement_cost(stmt.body)
+            # Each iteration over an array reads one of its elements
+            if not isinstance(iterable.iterable, PythonRange):
+                cost = sum((_Cost(read = _itemsize(v) * self.multiplier()) for v in
+                            _variables(iterable.iterable) if v.rank > 0), cost)
+            self._loops.pop()
+            return cost
+
+        if isinstance(stmt, While):
+            self.assumed = True
+            self._loops.append(_Loop(stmt, self._model.extent, None))
+            cost = self.children_cost(stmt.test) + self.statement_cost(stmt.body)
+            self._loops.pop()
+            return cost
+
+        if isinstance(stmt, If):
+            # The most expensive branch is executed
+            costs = [self.children_cost(b.condition) + self.statement_cost(b.body) for b in stmt.blocks]
+            return max(costs, key = _Cost.weight) if costs else _Cost()
+
+        if isinstance(stmt, Return):
+            # The returned expressions are computed in the statements of the return
+            return self.statement_cost(stmt.stmt) if stmt.stmt else _Cost()
+
+        if isinstance(stmt, (AliasAssign, Allocate, Deallocate)):
+            return _Cost()
+
+        return self.children_cost(stmt)
+
+    def assign_cost(self, stmt):
+        """ The cost of an assignment.
+        """
+        lhs, rhs = stmt.lhs, stmt.rhs
+        cost = self.children_cost(rhs)
+        if isinstance(lhs, (Variable, IndexedElement)):
+            cost += self.access_cost(lhs, written = True)
+            if isinstance(lhs, IndexedElement):
+                cost = sum((self.children_cost(i) for i in lhs.indices), cost)
+            if isinstance(stmt, AugAssign):
+                cost += self.access_cost(lhs)
+                if _is_floating_point(lhs):
+                    cost += _Cost(flops = self.size(lhs) * self.multiplier())
+
+        if isinstance(lhs, Variable) and lhs.rank == 0:
+            variables = _variables(rhs)
+            # The scalars computed from the iterators change with them
+            for loop in self._loops:
+                if loop.dependents is not None and (isinstance(stmt, AugAssign) or loop.changes(variables)):
+                    loop.dependents.add(lhs)
+            if self._assigned.get(lhs, 0) == 1 and not self._loops:
+                value = self.value(rhs)
+                if value is not None:
+                    self._constants[lhs] = value
+        return cost
+
+#==============================================================================
+class PerformanceModel:
+    """
+    Static performance model of the functions of a module.
+
+    Estimate the number of floating-point operations, the number of bytes
+    moved between the memory and the processor and the arithmetic intensity
+    of one call to each function of a module (see the module documentation
+    for the memory model) and compare them with the characteristics of a
+    machine in a roofline report.
+
+    Parameters
+    ----------
+    ast : Module
+        The semantic tree of the module.
+    machine : str | MachineProfile, default='default'
+        The machine running the code (see `MachineProfile.load`).
+    extent : int, default=DEFAULT_EXTENT
+        The trip count of the loops and the length of the dimensions of the
+        arrays which are not known at compile time.
+    filename : str, optional
+        The name of the file of the module, printed in the report.
+    """
+    def __init__(self, ast, machine = 'default', extent = DEFAULT_EXTENT, filename = None):
+        self._machine  = MachineProfile.load(machine)
+        self._extent   = extent
+        self._filename = filename
+        self._calls    = {}
+        self._costs    = {}
+
+        functions = [*ast.funcs, *(f for i in ast.interfaces for f in i.functions)]
+        functions += [(f'{c.name}.{m.name}', m) for c in ast.classes for m in c.methods]
+        for f in functions:
+            name, f = f if isinstance(f, tuple) else (f.name, f)
+            if not f.is_header:
+                self._costs[name] = self._function_cost(name, f)
+        if ast.program is not None:
+            self._costs[ast.program.name] = self._function_cost(ast.program.name, ast.program)
+
+    @property
+    def machine(self):
+        """ The machine running the code.
+        """
+        return self._machine
+
+    @property
+    def extent(self):
+        """ The value of the lengths which are not known at compile time.
+        """
+        return self._extent
+
+    @property
+    def costs(self):
+        """ Dictionary mapping the name of each function to its `FunctionCost`.
+        """
+        return self._costs
+
+    def _function_cost(self, name, func):
+        """ Compute the cost of a function and of the functions it calls.
+        """
+        counter = _Counter(self, name)
+        self._calls[id(func)] = None
+        cost = counter.function_cost(func)
+        self._calls[id(func)] = cost
+        return FunctionCost(name, int(cost.flops), int(cost.read), int(cost.written),
+                            counter.strided, counter.assumed)
+
+    def call_cost(self, func):
+        """
+        The cost of one call to a function.
+
+        The cost of the operations and of the data moved by one call to a
+        function (nothing for the functions which are not defined in the
+        module or which are called recursively).
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The function which is called.
+
+        Returns
+        -------
+        _Cost
+            The cost of the call.
+        """
+        if not isinstance(func, FunctionDef) or func.is_header:
+            return _Cost()
+        if id(func) not in self._calls:
+            self._function_cost(func.name, func)
+        return self._calls[id(func)] or _Cost()
+
+    def report(self):
+        """
+        Get the roofline report of the functions of the module.
+
+        Get a table giving, for one call to each function, the number of
+        floating-point operations, the bytes moved, the arithmetic intensity,
+        the attainable performance on the machine and whether the function
+        is memory-bound or compute-bound, followed by the list of the
+        accesses with a non-unit stride in the innermost loops.
+
+        Returns
+        -------
+        str
+            The report.
+        """
+        machine = self._machine
+        title = f"Roofline report{' of ' + self._filename if self._filename else ''}"
+        lines = [title,
+                 f"machine: {machine.name} (peak {machine.peak_gflops:g} GFLOP/s, "
+                 f"bandwidth {machine.bandwidth_gbs:g} GB/s, ridge point {machine.ridge_point:.3g} FLOP/B)",
+                 '']
+        width = max([len('function'), *(len(n) + 1 for n in self._costs)])
+        lines.append(f"{'function':<{width}} {'FLOP':>10} {'bytes':>10} {'FLOP/B':>8} "
+                     f"{'GFLOP/s':>8} {'time (s)':>10}  bound")
+        for name, cost in self._costs.items():
+            name = name + ('*' if cost.assumed_extent else '')
+            if cost.flops == 0 and cost.bytes == 0:
+                lines.append(f"{name:<{width}} {0:>10} {0:>10} {'-':>8} {'-':>8} {0:>10}  -")
+                continue
+            intensity = cost.intensity
+            bound = 'memory' if intensity < machine.ridge_point else 'compute'
+            lines.append(f"{name:<{width}} {cost.flops:>10.3g} {cost.bytes:>10.3g} "
+                         f"{intensity:>8.3g} {machine.attainable_gflops(intensity):>8.3g} "
+                         f"{cost.time(machine):>10.3g}  {bound}")
+        if any(c.assumed_extent for c in self._costs.values()):
+            lines += ['', f"* the lengths which are not known at compile time are taken as {self._extent}"]
+
+        strided = [s for c in self._costs.values() for s in c.strided]
+        if strided:
+            lines += ['', "Non-unit-stride accesses in the innermost loops:"]
+            lines += [f"  {s.function}: {s}" for s in strided]
+        return '\n'.join(lines)
+
+#==============================================================================
+class PerfComplexity(Complexity):
+    """
+    Class for the static performance model of a program.
+
+    Parameters
+    ----------
+    filename_or_text : str
+        Name of the file containing the code or the code as a string.
+    """
+    def cost(self, machine = 'default', extent = DEFAULT_EXTENT):
+        """
+        Computes the cost of one call to each function of the code.
+
+        Parameters
+        ----------
+        machine : str | MachineProfile, default='default'
+            The machine running the code (see `MachineProfile.load`).
+        extent : int, default=DEFAULT_EXTENT
+            The value of the lengths which are not known at compile time.
+
+        Returns
+        -------
+        dict[str, FunctionCost]
+            The cost of each function.
+        """
+        return PerformanceModel(self.ast, machine, extent).costs
+
+    def report(self, machine = 'default', extent = DEFAULT_EXTENT):
+        """
+        Get the roofline report of the code.
+
+        Parameters
+        ----------
+        machine : str | MachineProfile, default='default'
+            The machine running the code (see `MachineProfile.load`).
+        extent : int, default=DEFAULT_EXTENT
+            The value of the lengths which are not known at compile time.
+
+        Returns
+        -------
+        str
+            The report (see `PerformanceModel.report`).
+        """
+        return PerformanceModel(self.ast, machine, extent).report()
@@ -14,12 +14,14 @@ __all__ = (
     'elemental',
     'inline',
     'lambdify',
+    'nogil',
     'private',
     'pure',
     'stack_array',
     'sympy',
     'template',
     'types',
+    'ufunc',
 )
 
 def lambdify(f):
@@ -87,6 +89,16 @@ def inline(f):
     print the function body directly"""
     return f
 
+def ufunc(f):
+    """Indicates that the function should be exposed to Python as a NumPy
+    universal function which is applied element-wise to its arguments"""
+    return f
+
+def nogil(f):
+    """Indicates that the Python wrapper should release the GIL while
+    the translated function is running"""
+    return f
+
 def stack_array(f, *args):
     """
     Decorator indicates that all arrays mentioned as args should be stored
@@ -5,10 +5,13 @@
 #------------------------------------------------------------------------------------------#
 
 
+import hashlib
 import inspect
 import importlib
+import json
 import sys
 import os
+import sysconfig
 
 from filelock import FileLock, Timeout
 
@@ -16,10 +19,12 @@ from types import ModuleType, FunctionType
 from importlib.machinery import ExtensionFileLoader
 
 from pyccel.utilities.strings  import random_string
+from pyccel.version            import __version__
 from pyccel.codegen.pipeline   import execute_pyccel
+from pyccel.codegen.compiling.compilers import Compiler, get_condaless_search_path
 from pyccel.errors.errors      import ErrorsMode
 
-__all__ = ['get_source_function', 'epyccel_seq', 'epyccel']
+__all__ = ['get_source_function', 'get_cache_key', 'epyccel_seq', 'epyccel']
 
 
 #==============================================================================
@@ -90,6 +95,88 @@ def get_unique_name(prefix, path):
         return get_unique_name(prefix, path)
     return module_name, lock
 
+#==============================================================================
+def get_cache_key(code, **options):
+    """
+    Get the key identifying a module in the epyccel cache.
+
+    Get a hash of the code which is translated and of everything which changes
+    the generated shared library: the options of the translation, the compilers
+    (their executables, versions and default flags, and the contents of the file
+    for a user-defined compiler), the runtime library mode given by the
+    environment variable `PYCCEL_STDLIB_RUNTIME`, the versions of Pyccel and
+    Python.
+
+    Parameters
+    ----------
+    code : str
+        The Python code which is translated (which contains the type annotations).
+    **options : dict
+        The options passed to execute_pyccel which change the generated code.
+
+    Returns
+    -------
+    str
+        The hexadecimal hash of the code and the options.
+    """
+    # Describe the compilers chosen by execute_pyccel (the options only contain
+    # the family, whose executables may be updated or change with the PATH)
+    compiler = options.get('compiler', None) or os.environ.get('PYCCEL_DEFAULT_COMPILER', 'GNU')
+    accelerators = options.get('accelerators', ())
+    debug = options.get('debug', False)
+    Compiler.acceptable_bin_paths = get_condaless_search_path('off')
+    builds = [Compiler(compiler, options['language'], debug).get_build_description(accelerators),
+              Compiler('GNU', 'c', debug).get_build_description(accelerators)]
+
+    if compiler and os.path.isfile(compiler):
+        with open(compiler, 'r', encoding='utf-8') as f:
+            options['compiler'] = f.read()
+
+    description = json.dumps({'code'    : code,
+                              'options' : options,
+                              'builds'  : builds,
+                              'runtime' : os.environ.get('PYCCEL_STDLIB_RUNTIME', None) or None,
+                              'pyccel'  : __version__,
+                              'python'  : sys.version,
+                              'suffix'  : sysconfig.get_config_var('EXT_SUFFIX')},
+                             sort_keys = True, default = list)
+    return hashlib.sha256(description.encode('utf-8')).hexdigest()
+
+#==============================================================================
+def get_cached_name(prefix, key, path):
+    """
+    Get the name of a module in the epyccel cache.
+
+    Get a name based on the prefix and on the cache key of a module, and lock
+    it. If the module is being created by another process, wait until it is
+    created so it can be imported instead of being compiled a second time.
+
+    Parameters
+    ----------
+    prefix : str
+        The starting string of the name.
+    key : str
+        The cache key of the module (see get_cache_key).
+    path : str
+        The folder where the lock file should be saved.
+
+    Returns
+    -------
+    module_name : str
+                  The name of the module.
+    module_lock : FileLock
+                  A file lock preventing other processes
+                  from creating the module at the same time.
+    """
+    module_name = (prefix + '_' + key[:24]).split('.')[-1]
+
+    # Create new directories if not existing
+    os.makedirs(path, exist_ok=True)
+
+    lock = FileLock(os.path.join(path, module_name) + '.lock')
+    lock.acquire()
+    return module_name, lock
+
 #==============================================================================
 def epyccel_seq(function_or_module, *,
                 language      = None,
@@ -106,6 +193,7 @@ def epyccel_seq(function_or_module, *,
                 libs          = (),
                 folder        = None,
                 conda_warnings= 'basic',
+                cache         = True,
                 comm          = None,
                 root          = None,
                 bcast         = None):
@@ -149,6 +237,11 @@ def epyccel_seq(function_or_module, *,
         Output folder for the compiled code.
     conda_warnings : {off, basic, verbose}
         Specify the level of Conda warnings to display (choices: off, basic, verbose), Default is 'basic'.
+    cache : bool, default=True
+        Reuse the shared library compiled by a previous call (possibly in another
+        process) for the same code and options, instead of compiling it again.
+        The cache does not know about the files imported by the code, so it should
+        be disabled when they change.
 
     Returns
     -------
@@ -187,19 +280,38 @@ def epyccel_seq(function_or_module, *,
     if isinstance(function_or_module, (FunctionType, type)):
         pyfunc = function_or_module
         code = get_source_function(pyfunc)
-
-        module_name, module_lock = get_unique_name('mod', epyccel_dirpath)
+        prefix = 'mod'
 
     elif isinstance(function_or_module, ModuleType):
         pymod = function_or_module
         lines = inspect.getsourcelines(pymod)[0]
         code = ''.join(lines)
-
-        module_name, module_lock = get_unique_name(pymod.__name__, epyccel_dirpath)
+        prefix = pymod.__name__
 
     else:
         raise TypeError('> Expecting a FunctionType, type or a ModuleType')
 
+    # The Python files generated for language='python' are not cached
+    cache = cache and language != 'python'
+
+    if cache:
+        key = get_cache_key(code,
+                            language      = language,
+                            compiler      = compiler,
+                            fflags        = fflags,
+                            wrapper_flags = wrapper_flags,
+                            accelerators  = sorted(accelerators),
+                            debug         = debug,
+                            includes      = includes,
+                            libdirs       = libdirs,
+                            modules       = modules,
+                            libs          = libs)
+        module_name, module_lock = get_cached_name(prefix, key, epyccel_dirpath)
+        sharedlib_filepath = os.path.join(epyccel_dirpath,
+                module_name + sysconfig.get_config_var('EXT_SUFFIX'))
+    else:
+        module_name, module_lock = get_unique_name(prefix, epyccel_dirpath)
+
     # Try is necessary to ensure lock is released
     try:
         pymod_filename = '{}.py'.format(module_name)
@@ -213,27 +325,32 @@ def epyccel_seq(function_or_module, *,
         # Change working directory to '__epyccel__'
         os.chdir(epyccel_dirpath)
 
-        # Store python file in '__epyccel__' folder, so that execute_pyccel can run
-        with open(pymod_filename, 'w') as f:
-            f.writelines(code)
+        is_cached = cache and (module_name in sys.modules or os.path.isfile(sharedlib_filepath))
+        if is_cached and verbose:
+            print(f">> Using the cached module {module_name}")
 
         try:
-            # Generate shared library
-            execute_pyccel(pymod_filename,
-                           verbose       = verbose,
-                           show_timings  = time_execution,
-                           language      = language,
-                           compiler      = compiler,
-                           fflags        = fflags,
-                           wrapper_flags = wrapper_flags,
-                           includes      = includes,
-                           libdirs       = libdirs,
-                           modules       = modules,
-                           libs          = libs,
-                           debug         = debug,
-                           accelerators  = accelerators,
-                           output_name   = module_name,
-                           conda_warnings= conda_warnings)
+            if not is_cached:
+                # Store python file in '__epyccel__' folder, so that execute_pyccel can run
+                with open(pymod_filename, 'w') as f:
+                    f.writelines(code)
+
+                # Generate shared library
+                execute_pyccel(pymod_filename,
+                               verbose       = verbose,
+                               show_timings  = time_execution,
+                               language      = language,
+                               compiler      = compiler,
+                               fflags        = fflags,
+                               wrapper_flags = wrapper_flags,
+                               includes      = includes,
+                               libdirs       = libdirs,
+                               modules       = modules,
+                               libs          = libs,
+                               debug         = debug,
+                               accelerators  = accelerators,
+                               output_name   = module_name,
+                               conda_warnings= conda_warnings)
         finally:
             # Change working directory back to starting point
             os.chdir(base_dirpath)
@@ -246,8 +363,10 @@ def epyccel_seq(function_or_module, *,
         # https://docs.python.org/3/library/importlib.html#importlib.invalidate_caches
         importlib.invalidate_caches()
 
-        package = importlib.import_module(module_name)
-        sys.path.remove(epyccel_dirpath)
+        try:
+            package = importlib.import_module(module_name)
+        finally:
+            sys.path.remove(epyccel_dirpath)
 
         if language != 'python':
             # Verify that we have imported the shared library, not the Python one
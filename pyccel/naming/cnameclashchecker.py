@@ -37,7 +37,13 @@ class CNameClashChecker(LanguageNameClashChecker):
         'GET_INDEX_FUNC_H2', 'GET_INDEX_FUNC', 'GET_INDEX',
         'INDEX', 'GET_ELEMENT', 'free_array', 'free_pointer',
         'get_index', 'numpy_to_ndarray_strides',
-        'numpy_to_ndarray_shape', 'get_size', 'order_f', 'order_c', 'array_copy_data'])
+        'numpy_to_ndarray_shape', 'get_size', 'order_f', 'order_c', 'array_copy_data',
+        'allocate_metadata', 'free_metadata', 'release_metadata_cache',
+        'allocate_data', 'free_data', 'ASSUME_ALIGNED', 'GET_ALIGNED_ELEMENT',
+        'pyc_set_error', 'pyc_error_occurred', 'pyc_error_kind', 'pyc_error_message',
+        'pyc_clear_error', 'pyc_print_error', 'pyc_raise_error',
+        'PYC_PROFILE_FUNCTION', 'pyc_profile_timer', 'pyc_profile_depth',
+        'pyc_profile_scope'])
 
     def has_clash(self, name, symbols):
         """
@@ -14,6 +14,8 @@ from pyccel.parser.base      import get_filename_from_import
 from pyccel.parser.syntactic import SyntaxParser
 from pyccel.parser.semantic  import SemanticParser
 
+from pyccel.utilities.profiling import Profiler
+
 # TODO [AR, 18.11.2018] to be modified as a function
 # TODO [YG, 28.01.2020] maybe pass filename to the parse method?
 class Parser(object):
@@ -135,7 +137,8 @@ class Parser(object):
         if self._syntax_parser:
             return self._syntax_parser.ast
 
-        parser             = SyntaxParser(self._filename, **self._kwargs)
+        with Profiler().span(os.path.basename(self._filename), 'syntax'):
+            parser         = SyntaxParser(self._filename, **self._kwargs)
         self.syntax_parser = parser
         parser.ast        = parser.ast
 
@@ -157,10 +160,11 @@ class Parser(object):
         self._annotate_sons(verbose=verbose)
 
         # Create a new semantic parser and store it in object
-        parser = SemanticParser(self._syntax_parser,
-                                d_parsers=self.d_parsers,
-                                parents=self.parents,
-                                **settings)
+        with Profiler().span(os.path.basename(self._filename), 'semantic'):
+            parser = SemanticParser(self._syntax_parser,
+                                    d_parsers=self.d_parsers,
+                                    parents=self.parents,
+                                    **settings)
         self._semantic_parser = parser
 
         # Return the new semantic parser (maybe used by codegen)
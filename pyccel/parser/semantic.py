@@ -87,7 +87,8 @@ from pyccel.ast.mathext  import math_constants, MathSqrt, MathAtan2, MathSin, Ma
 from pyccel.ast.numpyext import NumpyMatmul, numpy_funcs
 from pyccel.ast.numpyext import NumpyWhere, NumpyArray
 from pyccel.ast.numpyext import NumpyTranspose, NumpyConjugate
-from pyccel.ast.numpyext import NumpyNewArray, NumpyNonZero, NumpyResultType
+from pyccel.ast.numpyext import NumpyNewArray, NumpyNonZero, NumpyResultType, NumpySum
+from pyccel.ast.numpyext import NumpyArrayFromFile, NumpyLoad
 from pyccel.ast.numpyext import process_dtype as numpy_process_dtype
 
 from pyccel.ast.numpytypes import NumpyNDArrayType
@@ -111,6 +112,7 @@ from pyccel.ast.utilities import builtin_function as pyccel_builtin_function
 from pyccel.ast.utilities import builtin_import as pyccel_builtin_import
 from pyccel.ast.utilities import builtin_import_registry as pyccel_builtin_import_registry
 from pyccel.ast.utilities import split_positional_keyword_arguments
+from pyccel.ast.utilities import compatible_operation
 from pyccel.ast.utilities import recognised_source
 
 from pyccel.ast.variable import Constant
@@ -142,12 +144,14 @@ from pyccel.parser.base      import BasicParser
 from pyccel.parser.syntactic import SyntaxParser
 
 from pyccel.utilities.stage import PyccelStage
+from pyccel.utilities.profiling import Profiler
 
 import pyccel.decorators as def_decorators
 #==============================================================================
 
 errors = Errors()
 pyccel_stage = PyccelStage()
+profiler = Profiler()
 
 #==============================================================================
 
@@ -608,6 +612,83 @@ class SemanticParser(BasicParser):
         self._allocs.pop()
         return deallocs
 
+    def _check_nogil_function(self, func, python_ast):
+        """
+        Check that a function can be run without holding the GIL.
+
+        The Python wrapper of a function decorated with `@nogil` releases the GIL
+        while the translated function is running. The translated code does not use
+        the Python C-API and the runtime does not rely on the GIL (its global state
+        is either stored per thread or protected by a mutex). A warning is raised
+        if the function modifies module variables as these may then be modified
+        by several threads simultaneously.
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The function decorated with `@nogil`.
+
+        python_ast : ast.FunctionDef
+            The Python AST of the function, used to locate the warnings.
+        """
+        bounding_box = (python_ast.lineno, python_ast.col_offset) if python_ast else None
+
+        lhs_assigns = [a.lhs for a in func.body.get_attribute_nodes(Assign, excluded_nodes = (FunctionCall,))]
+        modified = {v for a in lhs_assigns for v in
+                        (a.get_attribute_nodes(Variable) if not isinstance(a, Variable) else [a])}
+        for v in func.global_vars:
+            if v in modified:
+                errors.report(f"The @nogil function {func.name} modifies the module variable {v.name}. " +
+                        "This is not thread-safe if the function is called from several threads",
+                        symbol=v, severity='warning',
+                        bounding_box=bounding_box)
+
+    def _check_ufunc_function(self, func, python_ast, is_method):
+        """
+        Check that a function can be exposed to Python as a NumPy universal function.
+
+        The Python wrapper of a function decorated with `@ufunc` is a NumPy ufunc
+        whose inner loop calls the translated function for each element. The
+        arguments are the elements of the inputs, which must therefore be numbers,
+        or arrays of numbers (the core dimensions of a generalised ufunc, which are
+        passed as views). The results are the elements of the outputs so they must
+        be numbers. An error is raised if the function does not fit this model.
+
+        Parameters
+        ----------
+        func : FunctionDef
+            The function decorated with `@ufunc`.
+
+        python_ast : ast.FunctionDef
+            The Python AST of the function, used to locate the errors.
+
+        is_method : bool
+            True if the function is a class method.
+        """
+        bounding_box = (python_ast.lineno, python_ast.col_offset) if python_ast else None
+        problems = []
+        if is_method or func.is_inline or func.is_private:
+            problems.append("it is not exposed to Python as a function")
+        if not func.arguments:
+            problems.append("it has no arguments")
+        for a in func.arguments:
+            v = a.var
+            if a.has_default or v.is_optional:
+                problems.append(f"the argument {v.name} has a default value")
+            elif not isinstance(v.dtype, FixedSizeNumericType) or \
+                    (v.rank and not isinstance(v.class_type, NumpyNDArrayType)):
+                problems.append(f"the argument {v.name} is not a number or an array of numbers")
+            elif v.rank and a.inout:
+                problems.append(f"the array argument {v.name} is modified")
+        if not func.results:
+            problems.append("it does not return any results")
+        if any(r.var.rank or not isinstance(r.var.dtype, FixedSizeNumericType) for r in func.results):
+            problems.append("its results are not numbers")
+        for p in problems:
+            errors.report(f"The @ufunc function {func.name} cannot be a NumPy ufunc as {p}",
+                    symbol=func.name, severity='error',
+                    bounding_box=bounding_box)
+
     def _check_pointer_targets(self, exceptions = ()):
         """
         Check that all pointer targets to be deallocated are not needed beyond this scope.
@@ -988,7 +1069,7 @@ class SemanticParser(BasicParser):
             else:
                 return PythonTuple(*(val.args*length))
 
-    def _handle_function_args(self, arguments):
+    def _handle_function_args(self, arguments, keep_elementwise_args = False):
         """
         Get a list of all function arguments.
 
@@ -1003,6 +1084,11 @@ class SemanticParser(BasicParser):
         arguments : list of FunctionCallArgument
             The arguments which were passed to the function.
 
+        keep_elementwise_args : bool, default=False
+            Indicates if array expressions which are computed element-wise
+            can be passed to the function as they are. Otherwise they are
+            saved in a temporary array before the call.
+
         Returns
         -------
         list of FunctionCallArgument
@@ -1013,6 +1099,9 @@ class SemanticParser(BasicParser):
             a = self._visit(arg.value)
             if isinstance(a, FunctionDef) and not isinstance(a, PyccelFunctionDef) and not a.is_semantic:
                 self._annotate_the_called_function_def(a)
+            if keep_elementwise_args and not arg.has_keyword and self._is_elementwise_expression(a):
+                args.append(FunctionCallArgument(a))
+                continue
             a = self._visit(arg)
             if isinstance(a.value, StarredArguments):
                 args.extend([FunctionCallArgument(av) for av in a.value.args_var])
@@ -1020,6 +1109,61 @@ class SemanticParser(BasicParser):
                 args.append(a)
         return args
 
+    def _is_elementwise_expression(self, expr):
+        """
+        Indicate whether an expression is an array expression computed element-wise.
+
+        Indicate whether an expression is an array expression (e.g. `a*b + np.sin(c)`)
+        whose elements can be computed independently in a loop without creating a
+        temporary array.
+
+        Parameters
+        ----------
+        expr : TypedAstNode
+            The semantic expression.
+
+        Returns
+        -------
+        bool
+            True if the expression is an element-wise array expression.
+        """
+        if not isinstance(expr, (PyccelArithmeticOperator, PyccelInternalFunction)) or not expr.rank:
+            return False
+        if isinstance(expr, PyccelInternalFunction) and not expr.is_elemental:
+            return False
+        calls = expr.get_attribute_nodes((FunctionCall, PyccelInternalFunction))
+        if not all(f.rank == 0 or (f.funcdef.is_elemental if isinstance(f, FunctionCall) else f.is_elemental)
+                   for f in calls):
+            return False
+        # Arrays which must be broadcast are not supported by the languages with vector operations
+        return compatible_operation(*expr.get_attribute_nodes((Variable, IndexedElement)),
+                                    language_has_vectors = True)
+
+    def _is_fused_reduction(self, func, arguments):
+        """
+        Indicate whether a call is a reduction which is fused with the computation of its argument.
+
+        A call to `numpy.sum` on an element-wise array expression (e.g. `np.sum(a*b)`)
+        is computed in the loop which evaluates the expression so the expression does
+        not need to be saved in a temporary array.
+
+        Parameters
+        ----------
+        func : FunctionDef | PyccelFunctionDef | None
+            The function being called.
+
+        arguments : list of FunctionCallArgument
+            The syntactic arguments passed to the function.
+
+        Returns
+        -------
+        bool
+            True if the element-wise array expressions passed to the function should
+            not be saved in temporary arrays.
+        """
+        return isinstance(func, PyccelFunctionDef) and func.cls_name is NumpySum \
+                and len(arguments) == 1 and not arguments[0].has_keyword
+
     def get_type_description(self, var, include_rank = True):
         """
         Get a text description of the type of a variable.
@@ -1108,6 +1252,34 @@ class SemanticParser(BasicParser):
                 return False
         return True
 
+    def _get_assigned_annotation(self, expr):
+        """
+        Get the type annotation of the variable to which an expression is assigned.
+
+        Get the type annotation of the variable to which an expression is
+        assigned (e.g. `x : 'float[:]' = expr`). This is used to find the type
+        of the objects which cannot be deduced from the arguments of a call.
+
+        Parameters
+        ----------
+        expr : PyccelAstNode
+            The syntactic expression.
+
+        Returns
+        -------
+        VariableTypeAnnotation | None
+            The annotation, or None if the expression is not assigned to an
+            annotated variable.
+        """
+        assign = expr.get_direct_user_nodes(lambda x: isinstance(x, Assign) and not isinstance(x, AugAssign))
+        if not assign or not isinstance(assign[0].lhs, AnnotatedPyccelSymbol):
+            return None
+        annotation = self._visit(assign[0].lhs.annotation)
+        if len(annotation.type_list) != 1:
+            errors.report("Cannot declare variable with multiple types",
+                    symbol=expr, severity='fatal')
+        return annotation.type_list[0]
+
     def _handle_function(self, expr, func, args, is_method = False):
         """
         Create the node representing the function call.
@@ -1145,6 +1317,10 @@ class SemanticParser(BasicParser):
                 if kw not in kwargs:
                     kwargs[kw] = val
 
+            if func is NumpyLoad:
+                # The type of the loaded array is described by the annotation of the variable
+                kwargs['annotation'] = self._get_assigned_annotation(expr)
+
             try:
                 new_expr = func(*args, **kwargs)
             except TypeError as e:
@@ -1538,7 +1714,8 @@ class SemanticParser(BasicParser):
                 # ...
                 # Add memory allocation if needed
                 array_declared_in_function = (isinstance(rhs, FunctionCall) and not isinstance(rhs.funcdef, PyccelFunctionDef) \
-                                            and not getattr(rhs.funcdef, 'is_elemental', False) and not isinstance(lhs.class_type, HomogeneousTupleType)) or arr_in_multirets
+                                            and not getattr(rhs.funcdef, 'is_elemental', False) and not isinstance(lhs.class_type, HomogeneousTupleType)) \
+                                            or isinstance(rhs, NumpyArrayFromFile) or arr_in_multirets
                 if lhs.on_heap and not array_declared_in_function:
                     if self.scope.is_loop:
                         # Array defined in a loop may need reallocation at every cycle
@@ -1569,7 +1746,8 @@ class SemanticParser(BasicParser):
 
                 # ...
                 # Add memory deallocation
-                if isinstance(lhs.class_type, CustomDataType) or not lhs.on_stack:
+                # (the data of a large stack array may be stored on the heap)
+                if isinstance(lhs.class_type, CustomDataType) or not lhs.is_stack_scalar:
                     if isinstance(lhs, InhomogeneousTupleVariable):
                         args = [v for v in lhs.get_vars() if v.rank>0]
                         new_args = []
@@ -1722,6 +1900,15 @@ class SemanticParser(BasicParser):
                     bounding_box=(self.current_ast_node.lineno, self.current_ast_node.col_offset),
                     severity='error')
 
+            elif isinstance(rhs, NumpyArrayFromFile):
+                # The data is not allocated by an Allocate
+                if var.is_argument or var.is_stack_array:
+                    errors.report(INCOMPATIBLE_REDEFINITION, symbol=var.name,
+                        bounding_box=(self.current_ast_node.lineno, self.current_ast_node.col_offset),
+                        severity='error')
+                elif previous_allocations or var.get_direct_user_nodes(lambda a: isinstance(a, Assign) and a.lhs is var):
+                    new_expressions.append(Deallocate(var))
+
             elif d_var['shape'] != shape:
 
                 if var.is_argument:
@@ -2675,8 +2862,9 @@ class SemanticParser(BasicParser):
 
                 if isinstance(rhs, FunctionCall):
                     # If object is a function
-                    args  = self._handle_function_args(rhs.args)
                     func  = first[rhs_name]
+                    args  = self._handle_function_args(rhs.args,
+                                keep_elementwise_args = self._is_fused_reduction(func, rhs.args))
                     if new_name != rhs_name:
                         if hasattr(func, 'clone') and not isinstance(func, PyccelFunctionDef):
                             func  = func.clone(new_name)
@@ -3009,7 +3197,8 @@ class SemanticParser(BasicParser):
             if hasattr(self, annotation_method):
                 return getattr(self, annotation_method)(expr)
 
-        args = self._handle_function_args(expr.args)
+        args = self._handle_function_args(expr.args,
+                    keep_elementwise_args = self._is_fused_reduction(func, expr.args))
 
         # Correct keyword names if scope is available
         # The scope is only available if the function body has been parsed
@@ -3317,6 +3506,9 @@ class SemanticParser(BasicParser):
                 insert_scope.insert_variable(semantic_lhs_var)
             except RuntimeError as e:
                 errors.report(e, symbol=expr, severity='error')
+            else:
+                if insert_scope is self.scope and semantic_lhs_var.rank > 0 and not semantic_lhs_var.is_alias:
+                    self._allocs[-1].add(semantic_lhs_var)
             lhs = lhs.name
 
         if isinstance(lhs, (PyccelSymbol, DottedName)):
@@ -3940,6 +4132,29 @@ class SemanticParser(BasicParser):
             self.insert_function(expr)
             return EmptyNode()
 
+        with profiler.span(str(expr.name), 'function'):
+            return self._annotate_FunctionDef(expr, function_call_args)
+
+    def _annotate_FunctionDef(self, expr, function_call_args):
+        """
+        Annotate the FunctionDef.
+
+        Annotate the FunctionDef or the functions of the Interface which have not
+        yet been annotated. See `_visit_FunctionDef` for more details.
+
+        Parameters
+        ----------
+        expr : FunctionDef|Interface
+           The node that needs to be annotated.
+
+        function_call_args : list[FunctionCallArgument], optional
+            The list of call arguments, needed only in the case of an inlined function.
+
+        Returns
+        -------
+        EmptyNode
+            An empty node, the annotated functions are stored in the scope.
+        """
         existing_semantic_funcs = []
         if not expr.is_semantic:
             self.scope.functions.pop(expr.name, None)
@@ -4207,6 +4422,12 @@ class SemanticParser(BasicParser):
                     results,
                     body,
                     **func_kwargs)
+            if 'nogil' in decorators:
+                self._check_nogil_function(func, expr.python_ast)
+
+            if 'ufunc' in decorators:
+                self._check_ufunc_function(func, expr.python_ast, cls_name is not None)
+
             if not is_recursive:
                 recursive_func_obj.invalidate_node()
 
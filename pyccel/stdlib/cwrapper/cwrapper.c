@@ -3,6 +3,7 @@
 /* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
 /* --------------------------------------------------------------------------------------- */
 
+#include <stdarg.h>
 #include "cwrapper.h"
 
 
@@ -134,3 +135,23 @@ PyObject	*Float_to_NumpyDouble(float *d)
 {
     return PyArray_Scalar(d, PyArray_DescrFromType(NPY_FLOAT), NULL);
 }
+//--------------------------------------------------------//
+bool    PyArgs_UnpackPositional(PyObject *args, PyObject *kwargs, Py_ssize_t n_required,
+                                Py_ssize_t n_args, ...)
+{
+    if (kwargs != NULL && (!PyDict_Check(kwargs) || PyDict_GET_SIZE(kwargs) != 0))
+        return false;
+    if (!PyTuple_Check(args))
+        return false;
+
+    Py_ssize_t n = PyTuple_GET_SIZE(args);
+    if (n < n_required || n > n_args)
+        return false;
+
+    va_list va;
+    va_start(va, n_args);
+    for (Py_ssize_t i = 0; i < n; i++)
+        *va_arg(va, PyObject**) = PyTuple_GET_ITEM(args, i);
+    va_end(va);
+    return true;
+}
@@ -196,5 +196,25 @@ static inline bool    PyIs_Complex64(PyObject *o)
     return PyArray_IsScalar(o, Complex64);
 }
 
+/*
+ * Function : PyArgs_UnpackPositional
+ * ----------------------------------
+ * Fast path for the calls which only use positional arguments. The items of
+ * the tuple args are stored in the objects pointed to by the variadic
+ * arguments (borrowed references, as with PyArg_ParseTupleAndKeywords).
+ * Parameters :
+ *     args       : the tuple of the positional arguments
+ *     kwargs     : the dictionary of the keyword arguments (may be NULL)
+ *     n_required : the number of required arguments
+ *     n_args     : the total number of arguments
+ *     ...        : n_args pointers to PyObject*
+ *
+ * Returns    :
+ *     true if the arguments were unpacked, false (without raising an error)
+ *     if PyArg_ParseTupleAndKeywords must be used instead
+ */
+bool    PyArgs_UnpackPositional(PyObject *args, PyObject *kwargs, Py_ssize_t n_required,
+                                Py_ssize_t n_args, ...);
+
 
 #endif
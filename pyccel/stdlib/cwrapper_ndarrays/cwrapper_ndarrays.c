@@ -5,202 +5,137 @@
 
 #include <string.h>
 #include "cwrapper_ndarrays.h"
+#ifdef PYCCEL_PROFILE
+# include "pyc_profile.h"
+#endif
 
 /*
- * Function : _numpy_to_ndarray_strides
+ * Function : _numpy_to_ndarray_metadata
  * --------------------
- * Convert numpy strides to nd_array strides, and return it in a new array, to
- * avoid the problem of different implementations of strides in numpy and ndarray.
+ * Copy numpy shape and strides to the nd_array shape and strides, to avoid
+ * the problem of variation of system architecture because numpy shape is not
+ * saved in fixed length type, and of the different implementations of strides
+ * in numpy (bytes) and ndarray (elements).
  * Parameters :
- *     np_strides : npy_intp array
- *     type_size  : data type enum
- *     nd : size of the array
- *
- * Returns    :
- *     ndarray_strides : a new array with new strides values
+ *     a     : the numpy array
+ *     array : the ndarray whose shape and strides are filled
  */
-static int64_t	*_numpy_to_ndarray_strides(npy_intp  *np_strides, int type_size, int nd)
-{
-    int64_t *ndarray_strides;
-
-    ndarray_strides = (int64_t*)malloc(sizeof(int64_t) * nd);
-    for (int i = 0; i < nd; i++)
-        ndarray_strides[i] = (int64_t) np_strides[i] / type_size;
-
-    return ndarray_strides;
-}
-
-static npy_intp	*_ndarray_to_numpy_strides(int64_t  *nd_strides, int32_t type_size, int nd)
+static void	_numpy_to_ndarray_metadata(PyArrayObject *a, t_ndarray *array)
 {
-    npy_intp *numpy_strides;
+    npy_intp *np_shape = PyArray_SHAPE(a);
+    npy_intp *np_strides = PyArray_STRIDES(a);
 
-    numpy_strides = (npy_intp*)malloc(sizeof(npy_intp) * nd);
-    for (int i = 0; i < nd; i++)
-        numpy_strides[i] = (npy_intp) nd_strides[i] * type_size;
-
-    return numpy_strides;
+    for (int i = 0; i < array->nd; i++)
+    {
+        array->shape[i] = (int64_t) np_shape[i];
+        array->strides[i] = (int64_t) np_strides[i] / array->type_size;
+    }
 }
 
-
 /*
- * Function : _numpy_to_ndarray_shape
+ * Function : _ndarray_to_numpy_metadata
  * --------------------
- * Copy numpy shape to nd_array shape, and return it in a new array, to
- * avoid the problem of variation of system architecture because numpy shape
- * is not saved in fixed length type.
+ * Copy the nd_array shape and strides to numpy shape and strides (in bytes).
  * Parameters :
- *     np_shape : npy_intp array
- *     nd : size of the array
- *
- * Returns    :
- *     ndarray_strides : new array
-*/
-static int64_t     *_numpy_to_ndarray_shape(npy_intp  *np_shape, int nd)
-{
-    int64_t *nd_shape;
-
-    nd_shape = (int64_t*)malloc(sizeof(int64_t) * nd);
-    for (int i = 0; i < nd; i++)
-        nd_shape[i] = (int64_t) np_shape[i];
-    return nd_shape;
-}
-
-static npy_intp *_ndarray_to_numpy_shape(int64_t *nd_shape, int nd)
+ *     o          : the ndarray
+ *     np_shape   : the numpy shape (at least o.nd elements)
+ *     np_strides : the numpy strides (at least o.nd elements)
+ */
+static void	_ndarray_to_numpy_metadata(t_ndarray o, npy_intp *np_shape, npy_intp *np_strides)
 {
-    npy_intp *np_shape;
-
-    np_shape = (npy_intp*)malloc(sizeof(npy_intp) * nd);
-    for (int i = 0; i < nd; i++)
-        np_shape[i] = (npy_intp) nd_shape[i];
-    return np_shape;
+    for (int i = 0; i < o.nd; i++)
+    {
+        np_shape[i] = (npy_intp) o.shape[i];
+        np_strides[i] = (npy_intp) o.strides[i] * o.type_size;
+    }
 }
 
 /*
- * Function: _check_pyarray_dtype
+ * Function : _free_capsule_data
  * --------------------
- * Check Python Object DataType:
- *
- * 	Parameters	:
- *		a 	  : python array object
- *      dtype : desired data type enum
- * 	Returns		:
- *		return NULL if no error occurred otherwise it will return the
- *      message to be reported in a TypeError exception
- * reference of the used c/python api function
- * -------------------------------------------
- * https://numpy.org/doc/stable/reference/c-api/array.html#c.PyArray_TYPE
+ * Destructor of the capsule which owns the data of an array returned to
+ * Python by owned_ndarray_to_pyarray.
  */
-static char*	_check_pyarray_dtype(PyArrayObject *a, int dtype)
-{
-	int current_dtype;
-
-	if (dtype == NO_TYPE_CHECK)
-		return NULL;
-
-	current_dtype = PyArray_TYPE(a);
-	if (current_dtype != dtype)
-	{
-        char* error = (char *)malloc(200);
-        sprintf(error, "argument dtype must be %s, not %s",
-			dataTypes[dtype],
-			dataTypes[current_dtype]);
-		return error;
-	}
+#define NDARRAY_DATA_CAPSULE "pyccel.ndarray_data"
 
-	return NULL;
+static void	_free_capsule_data(PyObject *capsule)
+{
+    // The context of the capsule is the size of the data
+    free_data(PyCapsule_GetPointer(capsule, NDARRAY_DATA_CAPSULE),
+              (int64_t)(intptr_t)PyCapsule_GetContext(capsule));
 }
 
 /*
- * Function: _check_pyarray_rank
+ * Function: _pyarray_has_properties
  * --------------------
- * Check Python Object Rank:
+ * Check Python Object (ArrayType, DataType, Rank, Order) without building
+ * any error message, this is the path followed by every valid call:
  *
  * 	Parameters	:
- *		a 	  : python array object
- *      rank  : desired rank
+ *		o 	  : python object
+ *      dtype : desired data type enum (or NO_TYPE_CHECK)
+ *		rank  : desired rank
+ *		flag  : desired order flag (or NO_ORDER_CHECK)
  * 	Returns		:
- *		return NULL if no error occurred otherwise it will return the
- *      message to be reported in a TypeError exception
+ *		return true if the object is an array with the expected properties
  * reference of the used c/python api function
  * -------------------------------------------
- * https://numpy.org/doc/stable/reference/c-api/array.html#c.PyArray_NDIM
+ * https://numpy.org/doc/stable/reference/c-api/array.html
  */
-static char* _check_pyarray_rank(PyArrayObject *a, int rank)
+static inline bool	_pyarray_has_properties(PyObject *o, int dtype, int rank, int flag)
 {
-	int	current_rank;
+	if (!PyArray_Check(o))
+		return false;
 
-	current_rank = PyArray_NDIM(a);
-	if (current_rank != rank)
-	{
-        char* error = (char *)malloc(200);
-        sprintf(error, "argument rank must be %d, not %d",
-			rank,
-			current_rank);
-		return error;
-	}
+	PyArrayObject* a = (PyArrayObject*)o;
 
-	return NULL;
+	if (dtype != NO_TYPE_CHECK && PyArray_TYPE(a) != dtype)
+		return false;
+	if (PyArray_NDIM(a) != rank)
+		return false;
+	if (rank > 1 && flag != NO_ORDER_CHECK && !PyArray_CHKFLAGS(a, flag))
+		return false;
+	return true;
 }
 
-/*
- * Function: _check_pyarray_order
- * --------------------
- * Check Python Object Order:
- *
- * 	Parameters	:
- *		a 	  : python array object
- *      flag  : desired order
- * 	Returns		:
- *		return NULL if no error occurred otherwise it will return the
- *      message to be reported in a TypeError exception
- * reference of the used c/python api function
- * -------------------------------------------
- * https://numpy.org/doc/stable/reference/c-api/array.html#c.PyArray_CHKFLAGS
- */
-static char* _check_pyarray_order(PyArrayObject *a, int flag)
+static const char	*_dtype_name(int dtype)
 {
-
-	if (flag == NO_ORDER_CHECK)
-		return NULL;
-
-	if (!PyArray_CHKFLAGS(a, flag))
-	{
-		char order = (flag == NPY_ARRAY_C_CONTIGUOUS ? 'C' : (flag == NPY_ARRAY_F_CONTIGUOUS ? 'F' : '?'));
-        char* error = (char *)malloc(200);
-		sprintf(error, "argument does not have the expected ordering (%c)", order);
-		return error;
-	}
-
-	return NULL;
+	return (dtype >= 0 && dtype < 17) ? dataTypes[dtype] : "unknown";
 }
 
-
 /*
- * Function: _check_pyarray_type
+ * Function: _set_pyarray_error
  * --------------------
- * Check if Python Object is ArrayType:
+ * Raise a TypeError describing why an array does not have the expected
+ * properties. This is only called when a check fails.
  *
  * 	Parameters	:
- *		a 	  : python array object
- *
- * 	Returns		:
- *		return NULL if no error occurred otherwise it will return the
- *      message to be reported in a TypeError exception
- * reference of the used c/python api function
- * -------------------------------------------
- * https://numpy.org/doc/stable/reference/c-api/array.html#c.PyArray_Check
+ *		current_dtype : data type enum of the array
+ *		current_rank  : rank of the array
+ *		has_order     : true if the array has the desired order
+ *      dtype         : desired data type enum (or NO_TYPE_CHECK)
+ *		rank          : desired rank
+ *		flag          : desired order flag (or NO_ORDER_CHECK)
  */
-static char* _check_pyarray_type(PyObject *a)
+static void	_set_pyarray_error(int current_dtype, int current_rank, bool has_order,
+                               int dtype, int rank, int flag)
 {
-	if (!PyArray_Check(a))
+	char error[600];
+	int n = 0;
+
+	error[0] = '\0';
+	if (dtype != NO_TYPE_CHECK && current_dtype != dtype)
+		n += snprintf(error + n, sizeof(error) - n, "argument dtype must be %s, not %s",
+			_dtype_name(dtype), _dtype_name(current_dtype));
+	if (current_rank != rank)
+		n += snprintf(error + n, sizeof(error) - n, "argument rank must be %d, not %d",
+			rank, current_rank);
+	if (rank > 1 && flag != NO_ORDER_CHECK && !has_order)
 	{
-        char* error = (char *)malloc(200);
-        sprintf(error, "argument must be numpy.ndarray, not %s",
-			 a == Py_None ? "None" : Py_TYPE(a)->tp_name);
-        return error;
+		char order = (flag == NPY_ARRAY_C_CONTIGUOUS ? 'C' : (flag == NPY_ARRAY_F_CONTIGUOUS ? 'F' : '?'));
+		snprintf(error + n, sizeof(error) - n, "argument does not have the expected ordering (%c)", order);
 	}
-
-	return NULL;
+	PyErr_SetString(PyExc_TypeError, error);
 }
 
 enum NPY_TYPES get_numpy_type(t_ndarray o)
@@ -243,9 +178,8 @@ enum NPY_TYPES get_numpy_type(t_ndarray o)
     return npy_type;
 }
 
-enum e_types get_ndarray_type(PyArrayObject *a)
+static enum e_types	_ndarray_type_from_numpy(int npy_type)
 {
-    enum NPY_TYPES npy_type = PyArray_TYPE(a);
     enum e_types nd_type;
     switch (npy_type)
     {
@@ -283,23 +217,458 @@ enum e_types get_ndarray_type(PyArrayObject *a)
     return nd_type;
 }
 
+enum e_types get_ndarray_type(PyArrayObject *a)
+{
+    return _ndarray_type_from_numpy(PyArray_TYPE(a));
+}
+
+/*
+ * Arrays which are not numpy arrays
+ * ---------------------------------
+ * Objects exporting their data through the buffer protocol (memoryview,
+ * array.array, mmap, multiprocessing.shared_memory buffers, ...) or through
+ * DLPack (a __dlpack__ method, for data on the CPU) are described by an
+ * ndarray which uses their data without a copy and without creating a numpy
+ * array. The wrapper requests the data once with pyarray_export, which keeps
+ * the buffer (or the DLPack tensor) with the description until the wrapper
+ * releases it after the call.
+ */
+
+/* DLPack data structures (ABI of dlpack.h, version 0.8) */
+typedef struct
+{
+    int32_t     device_type;
+    int32_t     device_id;
+}               t_dl_device;
+
+typedef struct
+{
+    uint8_t     code;
+    uint8_t     bits;
+    uint16_t    lanes;
+}               t_dl_dtype;
+
+typedef struct
+{
+    void        *data;
+    t_dl_device device;
+    int32_t     ndim;
+    t_dl_dtype  dtype;
+    int64_t     *shape;
+    int64_t     *strides;
+    uint64_t    byte_offset;
+}               t_dl_tensor;
+
+typedef struct  s_dl_managed_tensor
+{
+    t_dl_tensor dl_tensor;
+    void        *manager_ctx;
+    void        (*deleter)(struct s_dl_managed_tensor *self);
+}               t_dl_managed_tensor;
+
+enum { DL_INT = 0, DL_FLOAT = 2, DL_COMPLEX = 5, DL_BOOL = 6 };
+enum { DL_CPU = 1, DL_CUDA_HOST = 3 };
+
+/* numpy type of a signed integer of the given size in bytes */
+static int	_numpy_int_type(Py_ssize_t size)
+{
+    switch (size)
+    {
+        case 1:
+            return NPY_INT8;
+        case 2:
+            return NPY_INT16;
+        case 4:
+            return NPY_INT32;
+        case 8:
+            return NPY_INT64;
+        default:
+            return -1;
+    }
+}
+
+/*
+ * Function: _buffer_numpy_type
+ * --------------------
+ * Get the numpy type of the elements of a buffer from its struct format
+ * (e.g. "d", "<i", "Zf"). Returns -1 if the type is not supported by pyccel
+ * (unsigned integers, non-native byte order, structures, ...).
+ */
+static int	_buffer_numpy_type(const char *format, Py_ssize_t itemsize)
+{
+    // A NULL format means unsigned bytes
+    if (format == NULL)
+        return -1;
+    if (*format == '@' || *format == '=')
+        format++;
+#if PY_LITTLE_ENDIAN
+    else if (*format == '<')
+        format++;
+#else
+    else if (*format == '>' || *format == '!')
+        format++;
+#endif
+    if (format[0] == 'Z' && format[1] != '\0' && format[2] == '\0')
+    {
+        if (format[1] == 'f' && itemsize == 8)
+            return NPY_CFLOAT;
+        if (format[1] == 'd' && itemsize == 16)
+            return NPY_CDOUBLE;
+        return -1;
+    }
+    if (format[0] == '\0' || format[1] != '\0')
+        return -1;
+    switch (format[0])
+    {
+        case '?':
+            return itemsize == sizeof(bool) ? NPY_BOOL : -1;
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'n':
+            return _numpy_int_type(itemsize);
+        case 'f':
+            return itemsize == 4 ? NPY_FLOAT : -1;
+        case 'd':
+            return itemsize == 8 ? NPY_DOUBLE : -1;
+        default:
+            return -1;
+    }
+}
+
+/* numpy type of the elements of a DLPack tensor, -1 if it is not supported */
+static int	_dlpack_numpy_type(t_dl_dtype dtype)
+{
+    if (dtype.lanes != 1)
+        return -1;
+    switch (dtype.code)
+    {
+        case DL_BOOL:
+            return dtype.bits == 8 ? NPY_BOOL : -1;
+        case DL_INT:
+            return dtype.bits % 8 == 0 ? _numpy_int_type(dtype.bits / 8) : -1;
+        case DL_FLOAT:
+            return dtype.bits == 32 ? NPY_FLOAT : (dtype.bits == 64 ? NPY_DOUBLE : -1);
+        case DL_COMPLEX:
+            return dtype.bits == 64 ? NPY_CFLOAT : (dtype.bits == 128 ? NPY_CDOUBLE : -1);
+        default:
+            return -1;
+    }
+}
+
+/* fill the fields of an ndarray which are deduced from its type, shape and strides */
+static void	_set_ndarray_size(t_ndarray *array)
+{
+    bool c_order = true;
+    int64_t expected = 1;
+
+    array->length = 1;
+    for (int i = 0; i < array->nd; i++)
+        array->length *= array->shape[i];
+    array->buffer_size = array->length * array->type_size;
+    for (int i = array->nd - 1; i >= 0; i--)
+    {
+        if (array->shape[i] != 1 && array->strides[i] != expected)
+            c_order = false;
+        expected *= array->shape[i];
+    }
+    array->order = c_order ? order_c : order_f;
+    array->is_view = true;
+    array->device = NULL;
+}
+
+/*
+ * Description of an object which is not a numpy array, created once per
+ * call by pyarray_export and held by the wrapper in a capsule until the
+ * translated function returns. The capsule keeps the buffer (or the DLPack
+ * tensor) which gives access to the data, it is released by the destructor
+ * of the capsule.
+ */
+#define FOREIGN_ARRAY_CAPSULE "pyccel.foreign_array"
+
+typedef struct
+{
+    t_ndarray           array;
+    int                 npy_type;
+    bool                has_view;
+    Py_buffer           view;
+    t_dl_managed_tensor *managed;
+}                       t_foreign_array;
+
+static void	_free_foreign_array(t_foreign_array *foreign)
+{
+    free_pointer(&foreign->array);
+    if (foreign->has_view)
+        PyBuffer_Release(&foreign->view);
+    if (foreign->managed != NULL && foreign->managed->deleter != NULL)
+        foreign->managed->deleter(foreign->managed);
+    free(foreign);
+}
+
+static void	_release_foreign_array(PyObject *capsule)
+{
+    _free_foreign_array(PyCapsule_GetPointer(capsule, FOREIGN_ARRAY_CAPSULE));
+}
+
+/*
+ * Function: _buffer_to_ndarray
+ * --------------------
+ * Describe an object exporting the buffer protocol. The buffer is kept in
+ * foreign->view until the description is released.
+ * 	Returns		:
+ *		1 if the object was described, 0 if its format is not supported and
+ *		-1 if an error was raised (the buffer is read-only but the argument
+ *		is not const)
+ */
+static int	_buffer_to_ndarray(PyObject *o, t_foreign_array *foreign, bool writable)
+{
+    Py_buffer *view = &foreign->view;
+
+    if (PyObject_GetBuffer(o, view, writable ? PyBUF_RECORDS : PyBUF_RECORDS_RO) < 0)
+    {
+        // Do not hide a read-only buffer behind a type error
+        if (writable && PyObject_GetBuffer(o, view, PyBUF_RECORDS_RO) == 0)
+        {
+            PyBuffer_Release(view);
+            PyErr_Clear();
+            PyErr_Format(PyExc_ValueError,
+                "argument of type %s is read-only, the function can only receive it as a const array",
+                Py_TYPE(o)->tp_name);
+            return -1;
+        }
+        PyErr_Clear();
+        return 0;
+    }
+    int npy_type = _buffer_numpy_type(view->format, view->itemsize);
+    bool valid = npy_type >= 0 && view->ndim <= MAX_NDIM;
+    for (int i = 0; valid && i < view->ndim; i++)
+        valid = view->strides[i] % view->itemsize == 0;
+    if (!valid)
+    {
+        PyBuffer_Release(view);
+        return 0;
+    }
+    t_ndarray *array = &foreign->array;
+    foreign->has_view = true;
+    foreign->npy_type = npy_type;
+    array->nd = view->ndim;
+    array->raw_data = view->buf;
+    array->type = _ndarray_type_from_numpy(npy_type);
+    array->type_size = view->itemsize;
+    array->shape = allocate_metadata(array->nd);
+    array->strides = array->shape + array->nd;
+    for (int i = 0; i < view->ndim; i++)
+    {
+        array->shape[i] = view->shape[i];
+        array->strides[i] = view->strides[i] / view->itemsize;
+    }
+    _set_ndarray_size(array);
+    return 1;
+}
+
+/*
+ * Function: _dlpack_to_ndarray
+ * --------------------
+ * Describe an object with a __dlpack__ method. The capsule is consumed
+ * (renamed "used_dltensor") and the tensor is kept in foreign->managed, its
+ * deleter is called when the description is released.
+ * 	Returns		:
+ *		1 if the object was described, 0 otherwise
+ */
+static int	_dlpack_to_ndarray(PyObject *o, t_foreign_array *foreign)
+{
+    if (!PyObject_HasAttrString(o, "__dlpack__"))
+        return 0;
+
+    PyObject *capsule = PyObject_CallMethod(o, "__dlpack__", NULL);
+    if (capsule == NULL)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+    t_dl_managed_tensor *managed = PyCapsule_GetPointer(capsule, "dltensor");
+    if (managed == NULL)
+    {
+        PyErr_Clear();
+        Py_DECREF(capsule);
+        return 0;
+    }
+    t_dl_tensor *tensor = &managed->dl_tensor;
+    int npy_type = _dlpack_numpy_type(tensor->dtype);
+    bool valid = npy_type >= 0 && tensor->ndim <= MAX_NDIM
+        && (tensor->device.device_type == DL_CPU || tensor->device.device_type == DL_CUDA_HOST);
+    if (!valid)
+    {
+        // The capsule has not been consumed so its destructor calls the deleter
+        Py_DECREF(capsule);
+        return 0;
+    }
+    // The tensor now belongs to the description, the capsule must not delete it
+    PyCapsule_SetName(capsule, "used_dltensor");
+    Py_DECREF(capsule);
+
+    t_ndarray *array = &foreign->array;
+    foreign->managed = managed;
+    foreign->npy_type = npy_type;
+    array->nd = tensor->ndim;
+    array->raw_data = (char *)tensor->data + tensor->byte_offset;
+    array->type = _ndarray_type_from_numpy(npy_type);
+    array->type_size = tensor->dtype.bits / 8;
+    array->shape = allocate_metadata(array->nd);
+    array->strides = array->shape + array->nd;
+    int64_t stride = 1;
+    for (int i = array->nd - 1; i >= 0; i--)
+    {
+        array->shape[i] = tensor->shape[i];
+        // NULL strides describe a tensor in C order
+        array->strides[i] = tensor->strides ? tensor->strides[i] : stride;
+        stride *= tensor->shape[i];
+    }
+    _set_ndarray_size(array);
+    return 1;
+}
+
+PyObject	*pyarray_export(PyObject *o, bool writable)
+{
+    if (PyArray_Check(o) || o == Py_None || !(PyObject_CheckBuffer(o) || PyObject_HasAttrString(o, "__dlpack__")))
+    {
+        Py_INCREF(o);
+        return o;
+    }
+
+    t_foreign_array *foreign = calloc(1, sizeof(t_foreign_array));
+    if (foreign == NULL)
+        return PyErr_NoMemory();
+    int described = PyObject_CheckBuffer(o) ? _buffer_to_ndarray(o, foreign, writable)
+                                            : _dlpack_to_ndarray(o, foreign);
+    if (described <= 0)
+    {
+        free(foreign);
+        if (described < 0)
+            return NULL;
+        // The type checks reject the object
+        Py_INCREF(o);
+        return o;
+    }
+    PyObject *capsule = PyCapsule_New(foreign, FOREIGN_ARRAY_CAPSULE, _release_foreign_array);
+    if (capsule == NULL)
+        _free_foreign_array(foreign);
+    return capsule;
+}
+
+/* the description created by pyarray_export, NULL if o is not one */
+static inline t_foreign_array	*_get_foreign_array(PyObject *o)
+{
+    if (!PyCapsule_CheckExact(o) || !PyCapsule_IsValid(o, FOREIGN_ARRAY_CAPSULE))
+        return NULL;
+    return PyCapsule_GetPointer(o, FOREIGN_ARRAY_CAPSULE);
+}
+
+/* true if the ndarray is contiguous in the order described by the numpy flag */
+static bool	_ndarray_has_order(t_ndarray array, int flag)
+{
+    int64_t expected = 1;
+
+    for (int k = 0; k < array.nd; k++)
+    {
+        int i = flag == NPY_ARRAY_C_CONTIGUOUS ? array.nd - 1 - k : k;
+        if (array.shape[i] != 1 && array.strides[i] != expected)
+            return false;
+        expected *= array.shape[i];
+    }
+    return true;
+}
+
+/*
+ * Function: _foreign_array_check
+ * --------------------
+ * Check an object which is not a numpy array (see pyarray_check) and raise
+ * a TypeError if the check fails and raise_error is true. Only the
+ * descriptions created by pyarray_export are accepted, so the data of the
+ * object is not requested again.
+ */
+static bool	_foreign_array_check(PyObject *o, int dtype, int rank, int flag, bool raise_error)
+{
+    t_foreign_array *foreign = _get_foreign_array(o);
+
+    if (foreign == NULL)
+    {
+        if (raise_error)
+            PyErr_Format(PyExc_TypeError,
+                "argument must be numpy.ndarray or an array with a supported dtype (buffer protocol or DLPack), not %s",
+                o == Py_None ? "None" : Py_TYPE(o)->tp_name);
+        return false;
+    }
+    t_ndarray array = foreign->array;
+    bool has_order = rank < 2 || flag == NO_ORDER_CHECK || _ndarray_has_order(array, flag);
+    bool valid = (dtype == NO_TYPE_CHECK || foreign->npy_type == dtype) && array.nd == rank && has_order;
+    if (!valid && raise_error)
+        _set_pyarray_error(foreign->npy_type, array.nd, has_order, dtype, rank, flag);
+    return valid;
+}
+
 /* converting numpy array to c nd array*/
 t_ndarray	pyarray_to_ndarray(PyObject *o)
 {
+#ifdef PYCCEL_PROFILE
+    PYC_PROFILE_FUNCTION("pyarray_to_ndarray");
+#endif
     PyArrayObject* a = (PyArrayObject*) o;
 	t_ndarray		array;
 
+	if (!PyArray_Check(o))
+	{
+		// The description created by pyarray_export was validated by
+		// pyarray_check or is_numpy_array, it keeps its own shape
+		t_ndarray *foreign = &_get_foreign_array(o)->array;
+		array = *foreign;
+		array.shape = allocate_metadata(array.nd);
+		array.strides = array.shape + array.nd;
+		memcpy(array.shape, foreign->shape, 2 * array.nd * sizeof(int64_t));
+		return array;
+	}
+
 	array.nd          = PyArray_NDIM(a);
 	array.raw_data    = PyArray_DATA(a);
 	array.type_size   = PyArray_ITEMSIZE(a);
 	array.type        = get_ndarray_type(a);
 	array.length      = PyArray_SIZE(a);
 	array.buffer_size = PyArray_NBYTES(a);
-	array.shape       = _numpy_to_ndarray_shape(PyArray_SHAPE(a), array.nd);
-	array.strides     = _numpy_to_ndarray_strides(PyArray_STRIDES(a), array.type_size, array.nd);
+	array.shape       = allocate_metadata(array.nd);
+	array.strides     = array.shape + array.nd;
+	_numpy_to_ndarray_metadata(a, &array);
 	array.order       = PyArray_CHKFLAGS(a, NPY_ARRAY_C_CONTIGUOUS) ? order_c : order_f;
 
 	array.is_view     = 1;
+	array.device      = NULL;
+
+	return array;
+}
+
+t_ndarray	ufunc_core_to_ndarray(int32_t nd, const npy_intp *shape, const npy_intp *strides,
+                                  t_types type, int32_t type_size, t_order order)
+{
+	t_ndarray		array;
+
+	array.nd          = nd;
+	array.raw_data    = NULL;
+	array.type_size   = type_size;
+	array.type        = type;
+	array.shape       = allocate_metadata(nd);
+	array.strides     = array.shape + nd;
+	array.length      = 1;
+	for (int i = 0; i < nd; i++)
+	{
+		array.shape[i] = (int64_t) shape[i];
+		array.strides[i] = (int64_t) strides[i] / type_size;
+		array.length *= array.shape[i];
+	}
+	array.buffer_size = array.length * type_size;
+	array.order       = order;
+	array.is_view     = 1;
+	array.device      = NULL;
 
 	return array;
 }
@@ -314,18 +683,52 @@ PyObject* ndarray_to_pyarray(t_ndarray o)
         FLAGS = NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_WRITEABLE;
     }
     else if (o.order == order_f) {
-        FLAGS = NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_WRITEABLE;
+        FLAGS = NPY_ARRAY_F_CONTIGUOUS | NPY_ARRAY_WRITEABLE;
     }
     else {
         FLAGS = NPY_ARRAY_WRITEABLE;
     }
 
     enum NPY_TYPES npy_type = get_numpy_type(o);
+    npy_intp np_shape[MAX_NDIM];
+    array_host_sync(o);
+    npy_intp np_strides[MAX_NDIM];
+    _ndarray_to_numpy_metadata(o, np_shape, np_strides);
 
     return PyArray_NewFromDescr(&PyArray_Type, PyArray_DescrFromType(npy_type),
-            o.nd, _ndarray_to_numpy_shape(o.shape, o.nd),
-            _ndarray_to_numpy_strides(o.strides, o.type_size, o.nd),
-            o.raw_data, FLAGS, NULL);
+            o.nd, np_shape, np_strides, o.raw_data, FLAGS, NULL);
+}
+
+PyObject* owned_ndarray_to_pyarray(t_ndarray o)
+{
+    PyObject *array = ndarray_to_pyarray(o);
+
+    array_device_release(&o, true);
+    free_metadata(o.shape, o.nd);
+    if (array == NULL)
+    {
+        free_data(o.raw_data, o.buffer_size);
+        return NULL;
+    }
+    if (o.raw_data == NULL)
+        return array;
+
+    PyObject *capsule = PyCapsule_New(o.raw_data, NDARRAY_DATA_CAPSULE, _free_capsule_data);
+    if (capsule == NULL)
+    {
+        free_data(o.raw_data, o.buffer_size);
+        Py_DECREF(array);
+        return NULL;
+    }
+    // Cannot fail for a valid capsule
+    PyCapsule_SetContext(capsule, (void*)(intptr_t)o.buffer_size);
+    // The reference to the capsule is stolen, even if an error is raised
+    if (PyArray_SetBaseObject((PyArrayObject*)array, capsule) < 0)
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
 }
 
 /*
@@ -343,80 +746,37 @@ PyObject* ndarray_to_pyarray(t_ndarray o)
  */
 bool	pyarray_check(PyObject *o, int dtype, int rank, int flag)
 {
-    char* array_type = _check_pyarray_type(o);
-	if (array_type != NULL) {
-		PyErr_Format(PyExc_TypeError, array_type);
-        free(array_type);
-        return false;
-    }
-
-    PyArrayObject* a = (PyArrayObject*)o;
-
-    char error[600];
-    error[0] = '\0';
-
-	// check array element type / rank / order
-    char* array_dtype = _check_pyarray_dtype(a, dtype);
-    if (array_dtype != NULL) {
-        strcat(error, array_dtype);
-        free(array_dtype);
-    }
-
-    char* array_rank = _check_pyarray_rank(a, rank);
-    if (array_rank != NULL) {
-        strcat(error, array_rank);
-        free(array_rank);
-    }
-
-    if (rank > 1) {
-        char* array_order = _check_pyarray_order(a, flag);
-        if (array_order != NULL) {
-            strcat(error, array_order);
-            free(array_order);
-        }
-    }
-
-    if (error[0] != '\0') {
-		PyErr_Format(PyExc_TypeError, error);
-        return false;
-    }
-    else {
-        return true;
-    }
+	if (_pyarray_has_properties(o, dtype, rank, flag))
+		return true;
+	if (!PyArray_Check(o))
+		return _foreign_array_check(o, dtype, rank, flag, true);
+
+	PyArrayObject* a = (PyArrayObject*)o;
+	_set_pyarray_error(PyArray_TYPE(a), PyArray_NDIM(a),
+		flag == NO_ORDER_CHECK || PyArray_CHKFLAGS(a, flag), dtype, rank, flag);
+	return false;
 }
 
 bool	is_numpy_array(PyObject *o, int dtype, int rank, int flag)
 {
-    char* array_type = _check_pyarray_type(o);
-	if (array_type != NULL) {
-        free(array_type);
-        return false;
-    }
-
-    PyArrayObject* a = (PyArrayObject*)o;
-
-	// check array element type / rank / order
-    char* array_dtype = _check_pyarray_dtype(a, dtype);
-	if(array_dtype != NULL) {
-        free(array_dtype);
-        return false;
-    }
-
-    char* array_rank = _check_pyarray_rank(a, rank);
-	if(array_rank != NULL) {
-        free(array_rank);
-        return false;
-    }
+	if (_pyarray_has_properties(o, dtype, rank, flag))
+		return true;
+	return !PyArray_Check(o) && _foreign_array_check(o, dtype, rank, flag, false);
+}
 
-    if (rank > 1) {
-        char* array_order = _check_pyarray_order(a, flag);
-        if(array_order != NULL) {
-            free(array_order);
-            return false;
-        }
-    }
+/*
+ * Function: pyc_raise_error
+ * --------------------
+ * Raise the error recorded by the ndarrays library (see pyc_set_error) as a
+ * Python exception and clear it: an OSError for the errors of the system
+ * (e.g. a missing file) and a ValueError for the invalid arguments.
+ */
+void	pyc_raise_error(void)
+{
+	PyObject	*exception = pyc_error_kind() == error_os ? PyExc_OSError : PyExc_ValueError;
 
-	return true;
+	PyErr_SetString(exception, pyc_error_message());
+	pyc_clear_error();
 }
 
 /*
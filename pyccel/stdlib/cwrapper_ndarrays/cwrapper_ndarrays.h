@@ -25,6 +25,9 @@
  * A Cast function that convert numpy array variable into ndarray variable,
  * by copying its information and data to a new variable of type ndarray struct
  * and return this variable to be used inside c code.
+ * Objects which are not numpy arrays but export their data through the
+ * buffer protocol or DLPack are described without a copy from the object
+ * returned by pyarray_export.
  * Parameters :
  *     o : python array object
  *
@@ -38,15 +41,80 @@
 enum NPY_TYPES get_numpy_type(t_ndarray o);
 enum e_types get_ndarray_type(PyArrayObject *a);
 t_ndarray	pyarray_to_ndarray(PyObject *o);
+
+/*
+ * Function: ufunc_core_to_ndarray
+ * -------------------------------
+ * Create an ndarray describing the core dimensions of an operand of a
+ * generalised ufunc, as they are passed to its inner loop. The core
+ * dimensions do not change during the loop so the view is created once and
+ * the inner loop only sets its data for each element. The view must be
+ * released with free_pointer.
+ * Parameters :
+ *     nd        : the number of core dimensions
+ *     shape     : the core dimensions
+ *     strides   : the strides of the core dimensions (in bytes)
+ *     type      : the type of the elements
+ *     type_size : the size of the elements (in bytes)
+ *     order     : the ordering expected by the translated function
+ *
+ * Returns    :
+ *     array : c ndarray whose data is NULL
+ */
+t_ndarray	ufunc_core_to_ndarray(int32_t nd, const npy_intp *shape, const npy_intp *strides,
+                                  t_types type, int32_t type_size, t_order order);
+
+/*
+ * Function: ndarray_to_pyarray
+ * ----------------------------
+ * Create a numpy array which shares the data of the ndarray. The ndarray
+ * keeps the ownership of its data and of its shape and strides.
+ *
+ * Function: owned_ndarray_to_pyarray
+ * ----------------------------------
+ * Create a numpy array which takes the data of an ndarray allocated by
+ * array_create, without a copy. The data is freed (with free_data) when the
+ * numpy array is deallocated, the shape and the strides are freed at once.
+ * The ndarray must not be used after the call.
+ */
 PyObject* ndarray_to_pyarray(t_ndarray o);
+PyObject* owned_ndarray_to_pyarray(t_ndarray o);
 PyObject* c_ndarray_to_pyarray(t_ndarray o);
 PyObject* fortran_ndarray_to_pyarray(t_ndarray o);
 
 
+/*
+ * Function: pyarray_export
+ * ------------------------
+ * Get the data of an array argument which is not a numpy array, once per
+ * call. Objects exporting the buffer protocol (memoryview, array.array, ...)
+ * or DLPack (CPU tensors) are replaced by a capsule which holds their
+ * description and keeps the buffer (or the DLPack tensor) alive, the other
+ * objects are returned unchanged. The wrapper passes the result to the
+ * checks and to pyarray_to_ndarray and releases it with Py_DECREF after the
+ * call.
+ * Parameters :
+ *     o        : python object received as an array argument
+ *     writable : true if the argument is not const, a read-only buffer is
+ *                then rejected
+ *
+ * Returns    :
+ *     a new reference, NULL if an error was raised
+ */
+PyObject	*pyarray_export(PyObject *o, bool writable);
+
 /* arrays checkers and helpers */
+/*
+ * pyarray_check raises a TypeError, is_numpy_array does not. Both accept the
+ * objects returned by pyarray_export for the buffer protocol or DLPack with
+ * the expected dtype, rank and ordering.
+ */
 bool	pyarray_check(PyObject *o, int dtype, int rank, int flag);
 bool	is_numpy_array(PyObject *o, int dtype, int rank, int flag);
 
+/* raise the error recorded by the ndarrays library as a Python exception */
+void	pyc_raise_error(void);
+
 void    *nd_data(t_ndarray *a);
 int     nd_ndim(t_ndarray *a, int n);
 int     nd_nstep_C(t_ndarray *a, int n);
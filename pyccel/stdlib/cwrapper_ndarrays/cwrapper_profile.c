@@ -0,0 +1,88 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "cwrapper_profile.h"
+#include "pyc_profile.h"
+
+/*
+ * Function : _set_item
+ * --------------------
+ * Add a value to a dictionary, stealing the reference to the value.
+ * Returns    :
+ *     true if the value was added
+ */
+static bool _set_item(PyObject *dict, const char *key, PyObject *value)
+{
+    if (value == NULL)
+        return false;
+    int status = PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+    return status == 0;
+}
+
+static PyObject *_timers_to_python(void)
+{
+    PyObject    *functions = PyDict_New();
+    double      seconds_per_tick = pyc_profile_seconds_per_tick();
+
+    if (functions == NULL)
+        return NULL;
+    for (t_pyc_timer *timer = pyc_profile_timers(); timer != NULL; timer = timer->next)
+    {
+        PyObject    *stats = PyDict_New();
+        if (!_set_item(functions, timer->name, stats)
+            || !_set_item(stats, "calls", PyLong_FromLongLong(timer->calls))
+            || !_set_item(stats, "time", PyFloat_FromDouble(timer->ticks * seconds_per_tick)))
+        {
+            Py_DECREF(functions);
+            return NULL;
+        }
+    }
+    return functions;
+}
+
+static PyObject *_allocations_to_python(void)
+{
+    t_pyc_allocation_stats  counters = pyc_profile_allocations();
+    PyObject                *stats = PyDict_New();
+
+    if (stats == NULL)
+        return NULL;
+    if (!_set_item(stats, "count", PyLong_FromLongLong(counters.allocations))
+        || !_set_item(stats, "freed", PyLong_FromLongLong(counters.deallocations))
+        || !_set_item(stats, "bytes", PyLong_FromLongLong(counters.allocated_bytes))
+        || !_set_item(stats, "live_bytes", PyLong_FromLongLong(counters.live_bytes))
+        || !_set_item(stats, "peak_bytes", PyLong_FromLongLong(counters.peak_bytes)))
+    {
+        Py_DECREF(stats);
+        return NULL;
+    }
+    return stats;
+}
+
+PyObject    *pyc_profile_stats_to_python(PyObject *self, PyObject *args)
+{
+    (void)self;
+    (void)args;
+    PyObject    *stats = PyDict_New();
+
+    if (stats == NULL)
+        return NULL;
+    if (!_set_item(stats, "functions", _timers_to_python())
+        || !_set_item(stats, "allocations", _allocations_to_python()))
+    {
+        Py_DECREF(stats);
+        return NULL;
+    }
+    return stats;
+}
+
+PyObject    *pyc_profile_reset_from_python(PyObject *self, PyObject *args)
+{
+    (void)self;
+    (void)args;
+    pyc_profile_reset();
+    Py_RETURN_NONE;
+}
@@ -0,0 +1,47 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the functions which give Python access to the counters of
+ * the code generated with `pyccel --profile` (see pyc_profile.h). They are
+ * added to the methods of the generated module.
+ */
+
+#ifndef CWRAPPER_PROFILE_H
+# define CWRAPPER_PROFILE_H
+# define PY_SSIZE_T_CLEAN
+
+# include "Python.h"
+
+/*
+ * Function : pyc_profile_stats_to_python
+ * --------------------------------------
+ * Collect the counters in a dictionary:
+ * {'functions' : {name : {'calls' : int, 'time' : float (in seconds)}},
+ *  'allocations' : {'count' : int, 'freed' : int, 'bytes' : int,
+ *                   'live_bytes' : int, 'peak_bytes' : int}}
+ * The time of a function includes the time spent in the functions that it
+ * calls.
+ * Parameters :
+ *     self : the module
+ *     args : unused
+ * Returns    :
+ *     The dictionary (new reference) or NULL if an error was raised
+ */
+PyObject    *pyc_profile_stats_to_python(PyObject *self, PyObject *args);
+
+/*
+ * Function : pyc_profile_reset_from_python
+ * ----------------------------------------
+ * Reset the counters.
+ * Parameters :
+ *     self : the module
+ *     args : unused
+ * Returns    :
+ *     None (new reference)
+ */
+PyObject    *pyc_profile_reset_from_python(PyObject *self, PyObject *args);
+
+#endif
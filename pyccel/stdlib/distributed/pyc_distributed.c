@@ -0,0 +1,351 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "pyc_distributed.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the tags of the messages exchanged with the edges and corners are the
+** indices of the offsets of the neighbours in base 3, MPI only guarantees
+** tags up to 32767 = 3^9.46 */
+#define MAX_CORNERS_NDIM 9
+
+static void     dist_error(const char *function, const char *message)
+{
+    int rank;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    fprintf(stderr, "%s (rank %d): %s\n", function, rank, message);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+}
+
+/*
+** decomposition
+*/
+
+void    cart_decomposition_create(t_cart_decomposition *decomp, MPI_Comm comm,
+        int32_t nd, const int64_t *global_shape, const int *dims,
+        const bool *periods, bool reorder)
+{
+    int size;
+    int imposed = 1;
+
+    if (nd < 1 || nd > MAX_NDIM)
+        dist_error(__func__, "unsupported number of dimensions");
+    MPI_Comm_size(comm, &size);
+    decomp->nd = nd;
+    for (int32_t i = 0; i < nd; i++)
+    {
+        decomp->dims[i] = dims ? dims[i] : 0;
+        decomp->periods[i] = periods ? periods[i] : 0;
+        if (decomp->dims[i] < 0)
+            dist_error(__func__, "negative number of processes");
+        if (decomp->dims[i] > 0)
+            imposed *= decomp->dims[i];
+    }
+    if (size % imposed != 0)
+        dist_error(__func__, "the number of processes is not a multiple of the imposed dimensions");
+    MPI_Dims_create(size, nd, decomp->dims);
+    MPI_Cart_create(comm, nd, decomp->dims, decomp->periods, reorder, &decomp->comm);
+    MPI_Comm_rank(decomp->comm, &decomp->rank);
+    MPI_Cart_coords(decomp->comm, decomp->rank, nd, decomp->coords);
+
+    /* the first n % p processes of each dimension own one more point */
+    for (int32_t i = 0; i < nd; i++)
+    {
+        int64_t base = global_shape[i] / decomp->dims[i];
+        int64_t extra = global_shape[i] % decomp->dims[i];
+        int64_t coord = decomp->coords[i];
+
+        if (base == 0)
+            dist_error(__func__, "some processes do not own any point");
+        decomp->global_shape[i] = global_shape[i];
+        decomp->starts[i] = coord * base + (coord < extra ? coord : extra);
+        decomp->local_shape[i] = base + (coord < extra);
+    }
+}
+
+void    cart_decomposition_free(t_cart_decomposition *decomp)
+{
+    if (decomp->comm != MPI_COMM_NULL)
+        MPI_Comm_free(&decomp->comm);
+}
+
+/*
+** allocation
+*/
+
+static MPI_Datatype element_datatype(t_types type)
+{
+    switch (type)
+    {
+        case nd_bool:
+            return (MPI_C_BOOL);
+        case nd_int8:
+            return (MPI_INT8_T);
+        case nd_int16:
+            return (MPI_INT16_T);
+        case nd_int32:
+            return (MPI_INT32_T);
+        case nd_int64:
+            return (MPI_INT64_T);
+        case nd_float:
+            return (MPI_FLOAT);
+        case nd_double:
+            return (MPI_DOUBLE);
+        case nd_cfloat:
+            return (MPI_C_FLOAT_COMPLEX);
+        case nd_cdouble:
+            return (MPI_C_DOUBLE_COMPLEX);
+    }
+    return (MPI_DATATYPE_NULL);
+}
+
+/* view of the block of count[i] points starting at start[i] in each dimension */
+static t_ndarray    block_view(t_ndarray arr, const int64_t *start, const int64_t *count)
+{
+    t_ndarray view;
+    int64_t offset = 0;
+
+    view.nd = arr.nd;
+    view.type = arr.type;
+    view.type_size = arr.type_size;
+    view.order = arr.order;
+    view.is_view = true;
+    view.device = arr.device;
+    view.shape = allocate_metadata(view.nd);
+    view.strides = view.shape + view.nd;
+    view.length = 1;
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        view.shape[i] = count[i];
+        view.strides[i] = arr.strides[i];
+        view.length *= count[i];
+        offset += start[i] * arr.strides[i];
+    }
+    view.raw_data = (unsigned char*)arr.raw_data + offset * arr.type_size;
+    view.buffer_size = view.length * view.type_size;
+    return (view);
+}
+
+/* rank of the neighbour at the given offset of the coordinates of the process */
+static int  neighbour_rank(const t_cart_decomposition *decomp, const int *offset)
+{
+    int coords[MAX_NDIM];
+    int rank;
+
+    for (int32_t i = 0; i < decomp->nd; i++)
+    {
+        coords[i] = decomp->coords[i] + offset[i];
+        if (coords[i] < 0 || coords[i] >= decomp->dims[i])
+        {
+            if (!decomp->periods[i])
+                return (MPI_PROC_NULL);
+            coords[i] = (coords[i] + decomp->dims[i]) % decomp->dims[i];
+        }
+    }
+    MPI_Cart_rank(decomp->comm, coords, &rank);
+    return (rank);
+}
+
+/* tag of the message sent to the neighbour at the given offset */
+static int  offset_tag(int32_t nd, const int *offset, bool corners)
+{
+    int tag = 0;
+
+    if (corners)
+    {
+        for (int32_t i = nd - 1; i >= 0; i--)
+            tag = 3 * tag + offset[i] + 1;
+        return (tag);
+    }
+    for (int32_t i = 0; i < nd; i++)
+        if (offset[i] != 0)
+            tag = 2 * i + (offset[i] > 0);
+    return (tag);
+}
+
+/* datatype of the region sent (or received) from the array to (or from) the
+** neighbour at the given offset: the owned points next to the neighbour (or
+** the halo points between the process and the neighbour) */
+static MPI_Datatype halo_datatype(const t_dist_ndarray *arr, const int *offset, bool send)
+{
+    const t_cart_decomposition *decomp = arr->decomp;
+    int sizes[MAX_NDIM];
+    int subsizes[MAX_NDIM];
+    int starts[MAX_NDIM];
+    MPI_Datatype datatype;
+
+    for (int32_t i = 0; i < decomp->nd; i++)
+    {
+        int64_t n = decomp->local_shape[i];
+        int64_t h = arr->halo[i];
+
+        sizes[i] = (int)arr->data.shape[i];
+        subsizes[i] = offset[i] == 0 ? (int)n : (int)h;
+        if (offset[i] == 0)
+            starts[i] = (int)h;
+        else if (offset[i] < 0)
+            starts[i] = send ? (int)h : 0;
+        else
+            starts[i] = send ? (int)n : (int)(h + n);
+    }
+    MPI_Type_create_subarray(decomp->nd, sizes, subsizes, starts,
+            arr->data.order == order_c ? MPI_ORDER_C : MPI_ORDER_FORTRAN,
+            element_datatype(arr->data.type), &datatype);
+    MPI_Type_commit(&datatype);
+    return (datatype);
+}
+
+t_dist_ndarray  dist_array_create(const t_cart_decomposition *decomp, const int64_t *halo,
+        t_types type, t_order order, bool corners)
+{
+    t_dist_ndarray arr;
+    int32_t nd = decomp->nd;
+    int64_t shape[MAX_NDIM];
+    int offsets[MAX_NDIM];
+    int32_t max_neighbours = 2 * nd;
+    int32_t n_offsets = 2 * nd;
+
+    if (corners && nd > MAX_CORNERS_NDIM)
+        dist_error(__func__, "too many dimensions to exchange the edges and corners");
+    arr.decomp = decomp;
+    for (int32_t i = 0; i < nd; i++)
+    {
+        /* the smallest blocks own global_shape / dims points */
+        int64_t smallest = decomp->global_shape[i] / decomp->dims[i];
+
+        if (halo[i] < 0)
+            dist_error(__func__, "negative halo width");
+        if (halo[i] > smallest && (decomp->dims[i] > 1 || decomp->periods[i]))
+            dist_error(__func__, "the halo is wider than the block owned by a neighbour");
+        arr.halo[i] = halo[i];
+        shape[i] = decomp->local_shape[i] + 2 * halo[i];
+        if (shape[i] > INT_MAX)
+            dist_error(__func__, "the local block is too large for the MPI datatypes");
+    }
+    arr.data = array_create(nd, shape, type, false, order);
+    /* the halos on the boundaries of non-periodic dimensions are never received */
+    memset(arr.data.raw_data, 0, arr.data.buffer_size);
+    arr.owned = block_view(arr.data, arr.halo, decomp->local_shape);
+
+    if (corners)
+    {
+        n_offsets = 1;
+        for (int32_t i = 0; i < nd; i++)
+            n_offsets *= 3;
+        max_neighbours = n_offsets - 1;
+    }
+    arr.requests = malloc(2 * max_neighbours * sizeof(MPI_Request));
+    arr.types = malloc(2 * max_neighbours * sizeof(MPI_Datatype));
+    arr.n_neighbours = 0;
+    arr.exchanging = false;
+    MPI_Comm_dup(decomp->comm, &arr.comm);
+
+    /* neighbours which exchange points with the process */
+    for (int32_t k = 0; k < n_offsets; k++)
+    {
+        int negated[MAX_NDIM];
+        bool empty = false;
+        bool origin = true;
+        int rank;
+
+        for (int32_t i = 0, index = k; i < nd; i++)
+        {
+            if (corners)
+            {
+                offsets[i] = index % 3 - 1;
+                index /= 3;
+            }
+            else
+                offsets[i] = (i == k / 2) ? (k % 2 ? 1 : -1) : 0;
+            negated[i] = -offsets[i];
+            empty |= offsets[i] != 0 && halo[i] == 0;
+            origin &= offsets[i] == 0;
+        }
+        if (origin || empty)
+            continue;
+        rank = neighbour_rank(decomp, offsets);
+        if (rank == MPI_PROC_NULL)
+            continue;
+        arr.types[arr.n_neighbours] = halo_datatype(&arr, offsets, false);
+        arr.types[max_neighbours + arr.n_neighbours] = halo_datatype(&arr, offsets, true);
+        /* the neighbour sends the points of this halo to its opposite offset */
+        MPI_Recv_init(arr.data.raw_data, 1, arr.types[arr.n_neighbours], rank,
+                offset_tag(nd, negated, corners), arr.comm, &arr.requests[arr.n_neighbours]);
+        MPI_Send_init(arr.data.raw_data, 1, arr.types[max_neighbours + arr.n_neighbours], rank,
+                offset_tag(nd, offsets, corners), arr.comm, &arr.requests[max_neighbours + arr.n_neighbours]);
+        arr.n_neighbours++;
+    }
+    /* store the sends right after the receives */
+    memmove(arr.requests + arr.n_neighbours, arr.requests + max_neighbours,
+            arr.n_neighbours * sizeof(MPI_Request));
+    memmove(arr.types + arr.n_neighbours, arr.types + max_neighbours,
+            arr.n_neighbours * sizeof(MPI_Datatype));
+    return (arr);
+}
+
+void    dist_array_free(t_dist_ndarray *arr)
+{
+    if (arr->requests == NULL)
+        return;
+    if (arr->exchanging)
+        halo_exchange_end(arr);
+    for (int32_t k = 0; k < 2 * arr->n_neighbours; k++)
+    {
+        MPI_Request_free(&arr->requests[k]);
+        MPI_Type_free(&arr->types[k]);
+    }
+    free(arr->requests);
+    free(arr->types);
+    arr->requests = NULL;
+    arr->types = NULL;
+    MPI_Comm_free(&arr->comm);
+    free_pointer(&arr->owned);
+    free_array(&arr->data);
+}
+
+/*
+** halo exchange
+*/
+
+void    halo_exchange_begin(t_dist_ndarray *arr)
+{
+    if (arr->exchanging)
+        dist_error(__func__, "the previous halo exchange is not finished");
+    arr->exchanging = true;
+    MPI_Startall(2 * arr->n_neighbours, arr->requests);
+}
+
+void    halo_exchange_end(t_dist_ndarray *arr)
+{
+    if (!arr->exchanging)
+        return;
+    MPI_Waitall(2 * arr->n_neighbours, arr->requests, MPI_STATUSES_IGNORE);
+    arr->exchanging = false;
+}
+
+void    halo_exchange(t_dist_ndarray *arr)
+{
+    halo_exchange_begin(arr);
+    halo_exchange_end(arr);
+}
+
+t_ndarray   dist_array_inner(const t_dist_ndarray *arr, const int64_t *width)
+{
+    int64_t start[MAX_NDIM];
+    int64_t count[MAX_NDIM];
+
+    for (int32_t i = 0; i < arr->data.nd; i++)
+    {
+        int64_t n = arr->decomp->local_shape[i] - 2 * width[i];
+
+        start[i] = arr->halo[i] + width[i];
+        count[i] = n > 0 ? n : 0;
+    }
+    return (block_view(arr->data, start, count));
+}
@@ -0,0 +1,93 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the distributed arrays: ndarrays whose global index space
+ * is split in blocks over the processes of a Cartesian MPI communicator. The
+ * local block of each process is padded with halo (ghost) points which hold
+ * copies of the points owned by its neighbours.
+ *
+ * The halo regions are described by MPI subarray datatypes created with the
+ * array, so the exchange sends and receives directly from the data of the
+ * array (without packing copies). The requests of the exchange are persistent:
+ * halo_exchange_begin only starts them, so the points which do not read the
+ * halos (see dist_array_inner) can be computed while the messages are in
+ * flight, before halo_exchange_end waits for them.
+ */
+
+#ifndef PYC_DISTRIBUTED_H
+# define PYC_DISTRIBUTED_H
+
+# include <mpi.h>
+# include <stdbool.h>
+# include <stdint.h>
+# include "ndarrays.h"
+
+/* block decomposition of a global index space over a Cartesian communicator */
+typedef struct  s_cart_decomposition
+{
+    /* Cartesian communicator (owned by the decomposition) */
+    MPI_Comm        comm;
+    /* rank of the process in comm */
+    int             rank;
+    /* number of dimensions */
+    int32_t         nd;
+    /* number of processes, periodicity and coordinates of the process in each dimension */
+    int             dims[MAX_NDIM];
+    int             periods[MAX_NDIM];
+    int             coords[MAX_NDIM];
+    /* number of points of the global index space in each dimension */
+    int64_t         global_shape[MAX_NDIM];
+    /* global index of the first point owned by the process and number of points it owns */
+    int64_t         starts[MAX_NDIM];
+    int64_t         local_shape[MAX_NDIM];
+}               t_cart_decomposition;
+
+/* local block (with halos) of a distributed array */
+typedef struct  s_dist_ndarray
+{
+    /* local block: local_shape + 2 * halo points in each dimension */
+    t_ndarray                   data;
+    /* view of the points owned by the process (data without the halos) */
+    t_ndarray                   owned;
+    /* decomposition of the global index space (not owned by the array) */
+    const t_cart_decomposition  *decomp;
+    /* number of halo points on each side of each dimension */
+    int64_t                     halo[MAX_NDIM];
+    /* duplicate of the Cartesian communicator used by the messages of the array */
+    MPI_Comm                    comm;
+    /* neighbours exchanging halos with the process (faces, or faces, edges and corners) */
+    int32_t                     n_neighbours;
+    /* persistent receives followed by persistent sends, one of each per neighbour */
+    MPI_Request                 *requests;
+    /* subarray datatypes of the regions received and sent, in the same order */
+    MPI_Datatype                *types;
+    /* true between halo_exchange_begin and halo_exchange_end */
+    bool                        exchanging;
+}               t_dist_ndarray;
+
+/* decomposition: dims may be NULL, its zeros are chosen by MPI_Dims_create */
+void            cart_decomposition_create(t_cart_decomposition *decomp, MPI_Comm comm,
+        int32_t nd, const int64_t *global_shape, const int *dims,
+        const bool *periods, bool reorder);
+void            cart_decomposition_free(t_cart_decomposition *decomp);
+
+/* allocation: the halos are exchanged with the neighbours sharing a face, or
+** with all the neighbours touching the block (edges and corners) if corners is true */
+t_dist_ndarray  dist_array_create(const t_cart_decomposition *decomp, const int64_t *halo,
+        t_types type, t_order order, bool corners);
+void            dist_array_free(t_dist_ndarray *arr);
+
+/* halo exchange */
+void            halo_exchange_begin(t_dist_ndarray *arr);
+void            halo_exchange_end(t_dist_ndarray *arr);
+void            halo_exchange(t_dist_ndarray *arr);
+
+/* view of the owned points which are at least width[i] points away from the
+** halos in dimension i (the points whose stencil of this width does not read
+** the halos), to be freed with free_pointer */
+t_ndarray       dist_array_inner(const t_dist_ndarray *arr, const int64_t *width);
+
+#endif
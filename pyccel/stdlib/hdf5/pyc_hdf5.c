@@ -0,0 +1,531 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "pyc_hdf5.h"
+#include <stdio.h>
+#include <string.h>
+
+/* record the error of a function of the library, which then returns a status
+** (the functions of the runtime never exit, see the errors in ndarrays.c) */
+static void     h5_error(t_error_kind kind, const char *function, const char *message)
+{
+    pyc_set_error(kind, "%s: %s", function, message);
+}
+
+/*
+** files
+*/
+
+static hid_t    file_open(const char *filename, t_h5_mode mode, hid_t fapl)
+{
+    hid_t file;
+
+    if (mode == h5_file_w)
+        file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    else
+        file = H5Fopen(filename, mode == h5_file_r ? H5F_ACC_RDONLY : H5F_ACC_RDWR, fapl);
+    if (file < 0)
+        pyc_set_error(error_os, "%s: the file %s cannot be opened", __func__, filename);
+    return (file);
+}
+
+hid_t   h5_file_open(const char *filename, t_h5_mode mode)
+{
+    return (file_open(filename, mode, H5P_DEFAULT));
+}
+
+#ifdef H5_HAVE_PARALLEL
+hid_t   h5_file_open_mpi(const char *filename, t_h5_mode mode, MPI_Comm comm)
+{
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    hid_t file;
+
+    H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL);
+    file = file_open(filename, mode, fapl);
+    H5Pclose(fapl);
+    return (file);
+}
+#endif
+
+void    h5_file_close(hid_t file)
+{
+    H5Fclose(file);
+}
+
+/*
+** datasets
+*/
+
+/* HDF5 type of the elements of an ndarray, complex numbers and booleans are
+** stored as by h5py (compound of the real and imaginary parts, enumeration) */
+static hid_t    memory_type(t_types type)
+{
+    hid_t   mem_type;
+    hid_t   part = -1;
+    int8_t  value;
+
+    switch (type)
+    {
+        case nd_bool:
+            mem_type = H5Tenum_create(H5T_NATIVE_INT8);
+            value = 0;
+            H5Tenum_insert(mem_type, "FALSE", &value);
+            value = 1;
+            H5Tenum_insert(mem_type, "TRUE", &value);
+            return (mem_type);
+        case nd_int8:
+            return (H5Tcopy(H5T_NATIVE_INT8));
+        case nd_int16:
+            return (H5Tcopy(H5T_NATIVE_INT16));
+        case nd_int32:
+            return (H5Tcopy(H5T_NATIVE_INT32));
+        case nd_int64:
+            return (H5Tcopy(H5T_NATIVE_INT64));
+        case nd_float:
+            return (H5Tcopy(H5T_NATIVE_FLOAT));
+        case nd_double:
+            return (H5Tcopy(H5T_NATIVE_DOUBLE));
+        case nd_cfloat:
+            part = H5T_NATIVE_FLOAT;
+            break;
+        case nd_cdouble:
+            part = H5T_NATIVE_DOUBLE;
+            break;
+    }
+    if (part < 0)
+    {
+        h5_error(error_value, __func__, "unsupported type");
+        return (-1);
+    }
+    mem_type = H5Tcreate(H5T_COMPOUND, 2 * H5Tget_size(part));
+    H5Tinsert(mem_type, "r", 0, part);
+    H5Tinsert(mem_type, "i", H5Tget_size(part), part);
+    return (mem_type);
+}
+
+/* dataset which is not open, returned when a dataset cannot be opened or created */
+static t_h5_dataset dataset_error(hid_t dataset, hid_t space)
+{
+    if (space >= 0)
+        H5Sclose(space);
+    if (dataset >= 0)
+        H5Dclose(dataset);
+    return ((t_h5_dataset){.dataset = -1, .space = -1, .mem_type = -1, .xfer = -1, .nd = 0});
+}
+
+static t_h5_dataset dataset_init(hid_t file, hid_t dataset, t_types type)
+{
+    t_h5_dataset    dset;
+    hsize_t         dims[MAX_NDIM];
+    hid_t           fapl;
+
+    if (dataset < 0)
+    {
+        h5_error(error_value, __func__, "the dataset cannot be opened or created");
+        return (dataset_error(-1, -1));
+    }
+    dset.dataset = dataset;
+    dset.space = H5Dget_space(dataset);
+    dset.nd = H5Sget_simple_extent_ndims(dset.space);
+    if (dset.nd < 1 || dset.nd > MAX_NDIM)
+    {
+        h5_error(error_value, __func__, "unsupported number of dimensions");
+        return (dataset_error(dataset, dset.space));
+    }
+    H5Sget_simple_extent_dims(dset.space, dims, NULL);
+    for (int32_t i = 0; i < dset.nd; i++)
+        dset.shape[i] = (int64_t)dims[i];
+    dset.type = type;
+    dset.mem_type = memory_type(type);
+    if (dset.mem_type < 0)
+        return (dataset_error(dataset, dset.space));
+    dset.xfer = H5Pcreate(H5P_DATASET_XFER);
+    fapl = H5Fget_access_plist(file);
+#ifdef H5_HAVE_PARALLEL
+    if (H5Pget_driver(fapl) == H5FD_MPIO)
+        H5Pset_dxpl_mpio(dset.xfer, H5FD_MPIO_COLLECTIVE);
+#endif
+    H5Pclose(fapl);
+    return (dset);
+}
+
+t_h5_dataset    h5_dataset_open(hid_t file, const char *name, t_types type)
+{
+    return (dataset_init(file, H5Dopen2(file, name, H5P_DEFAULT), type));
+}
+
+t_h5_dataset    h5_dataset_create(hid_t file, const char *name, int32_t nd,
+        const int64_t *shape, t_types type, const int64_t *chunk)
+{
+    hsize_t dims[MAX_NDIM];
+    hid_t   space;
+    hid_t   dcpl;
+    hid_t   file_type;
+    hid_t   dataset;
+
+    if (nd < 1 || nd > MAX_NDIM)
+    {
+        h5_error(error_value, __func__, "unsupported number of dimensions");
+        return (dataset_error(-1, -1));
+    }
+    file_type = memory_type(type);
+    if (file_type < 0)
+        return (dataset_error(-1, -1));
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    for (int32_t i = 0; i < nd; i++)
+        dims[i] = (hsize_t)shape[i];
+    space = H5Screate_simple(nd, dims, NULL);
+    if (chunk != NULL)
+    {
+        for (int32_t i = 0; i < nd; i++)
+            dims[i] = (hsize_t)chunk[i];
+        H5Pset_chunk(dcpl, nd, dims);
+    }
+    dataset = H5Dcreate2(file, name, file_type, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    H5Tclose(file_type);
+    H5Sclose(space);
+    H5Pclose(dcpl);
+    return (dataset_init(file, dataset, type));
+}
+
+void    h5_dataset_close(t_h5_dataset *dset)
+{
+    if (dset->dataset < 0)
+        return ;
+    H5Pclose(dset->xfer);
+    H5Tclose(dset->mem_type);
+    H5Sclose(dset->space);
+    H5Dclose(dset->dataset);
+}
+
+/*
+** blocks
+*/
+
+/*
+** Describe the elements of arr as a hyperslab of a dataspace in C order whose
+** first element is the first element of arr: the stride of each dimension must
+** be a multiple of the size of the following dimensions of the dataspace, and
+** the elements of each dimension must fit in the stride of the previous one.
+** This is the case for the views of arrays in order_c (with positive steps).
+*/
+static bool     memory_hyperslab(t_ndarray arr, hsize_t *dims, hsize_t *stride)
+{
+    int64_t inner = 1;
+
+    for (int32_t i = arr.nd - 1; i >= 0; i--)
+    {
+        if (arr.shape[i] == 1)
+            stride[i] = 1;
+        else if (arr.strides[i] > 0 && arr.strides[i] % inner == 0)
+            stride[i] = (hsize_t)(arr.strides[i] / inner);
+        else
+            return (false);
+        dims[i] = (arr.shape[i] - 1) * stride[i] + 1;
+        if (i > 0 && arr.shape[i - 1] > 1)
+        {
+            if (arr.strides[i - 1] % inner != 0 || (hsize_t)(arr.strides[i - 1] / inner) < dims[i])
+                return (false);
+            dims[i] = (hsize_t)(arr.strides[i - 1] / inner);
+        }
+        inner *= (int64_t)dims[i];
+    }
+    return (true);
+}
+
+/* check that the block of the shape of arr starting at start is in the dataset */
+static bool     check_block(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr)
+{
+    if (dset->dataset < 0)
+    {
+        h5_error(error_value, __func__, "the dataset is not open");
+        return (false);
+    }
+    if (arr.nd != dset->nd)
+    {
+        h5_error(error_value, __func__, "the array and the dataset have different numbers of dimensions");
+        return (false);
+    }
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        if ((start && start[i] < 0) || (start ? start[i] : 0) + arr.shape[i] > dset->shape[i])
+        {
+            h5_error(error_value, __func__, "the block is outside of the dataset");
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/* dataspaces of a block of the shape of arr in memory and in the file, or
+** false if arr cannot be transferred directly (it then needs a copy) */
+static bool     block_spaces(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr,
+        hid_t xfer_space[2])
+{
+    hsize_t offset[MAX_NDIM];
+    hsize_t count[MAX_NDIM];
+    hsize_t dims[MAX_NDIM];
+    hsize_t stride[MAX_NDIM];
+    hsize_t zero[MAX_NDIM] = {0};
+
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        offset[i] = start ? (hsize_t)start[i] : 0;
+        count[i] = (hsize_t)arr.shape[i];
+    }
+    if (!memory_hyperslab(arr, dims, stride))
+        return (false);
+    xfer_space[0] = H5Screate_simple(arr.nd, dims, NULL);
+    H5Sselect_hyperslab(xfer_space[0], H5S_SELECT_SET, zero, stride, count, NULL);
+    xfer_space[1] = H5Scopy(dset->space);
+    H5Sselect_hyperslab(xfer_space[1], H5S_SELECT_SET, offset, NULL, count, NULL);
+    return (true);
+}
+
+static bool     block_read(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr, hid_t xfer)
+{
+    hid_t   spaces[2];
+    herr_t  status;
+
+    if (arr.length == 0)
+        return (true);
+    if (!check_block(dset, start, arr))
+        return (false);
+    if (!block_spaces(dset, start, arr, spaces))
+    {
+        /* read through a copy in order_c */
+        t_ndarray   copy = array_create(arr.nd, arr.shape, arr.type, false, order_c);
+        bool        success = block_read(dset, start, copy, xfer);
+
+        if (success)
+            array_copy_data(&arr, copy, 0);
+        free_array(&copy);
+        return (success);
+    }
+    status = H5Dread(dset->dataset, dset->mem_type, spaces[0], spaces[1], xfer, arr.raw_data);
+    H5Sclose(spaces[0]);
+    H5Sclose(spaces[1]);
+    if (status < 0)
+    {
+        h5_error(error_os, __func__, "the block of the dataset cannot be read");
+        return (false);
+    }
+    array_host_modified(arr);
+    return (true);
+}
+
+bool    h5_read(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr)
+{
+    return (block_read(dset, start, arr, dset->xfer));
+}
+
+bool    h5_write(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr)
+{
+    hid_t   spaces[2];
+    herr_t  status;
+
+    if (arr.length == 0)
+        return (true);
+    if (!check_block(dset, start, arr))
+        return (false);
+    array_host_sync(arr);
+    if (!block_spaces(dset, start, arr, spaces))
+    {
+        /* write through a copy in order_c */
+        t_ndarray   copy = array_create(arr.nd, arr.shape, arr.type, false, order_c);
+        bool        success;
+
+        array_copy_data(&copy, arr, 0);
+        success = h5_write(dset, start, copy);
+        free_array(&copy);
+        return (success);
+    }
+    status = H5Dwrite(dset->dataset, dset->mem_type, spaces[0], spaces[1], dset->xfer, arr.raw_data);
+    H5Sclose(spaces[0]);
+    H5Sclose(spaces[1]);
+    if (status < 0)
+    {
+        h5_error(error_os, __func__, "the block of the dataset cannot be written");
+        return (false);
+    }
+    return (true);
+}
+
+t_ndarray   h5_read_array(const t_h5_dataset *dset, const int64_t *start,
+        const int64_t *shape, t_order order)
+{
+    t_ndarray arr;
+
+    if (dset->dataset < 0)
+    {
+        h5_error(error_value, __func__, "the dataset is not open");
+        return ((t_ndarray){.shape = NULL});
+    }
+    arr = array_create(dset->nd, (int64_t *)(shape ? shape : dset->shape), dset->type, false, order);
+    if (!h5_read(dset, start, arr))
+        free_array(&arr);
+    return (arr);
+}
+
+/*
+** streams
+*/
+
+/* read the rows [load_start, load_start + load_rows) in the buffer load_buffer */
+static void     *stream_load(void *arg)
+{
+    t_h5_stream *stream = arg;
+    t_ndarray   rows = stream->buffers[stream->load_buffer];
+    int64_t     shape[MAX_NDIM];
+    int64_t     start[MAX_NDIM] = {0};
+
+    memcpy(shape, rows.shape, rows.nd * sizeof(int64_t));
+    rows.length = rows.length / shape[0] * stream->load_rows;
+    shape[0] = stream->load_rows;
+    start[0] = stream->load_start;
+    rows.shape = shape;
+    rows.buffer_size = rows.length * rows.type_size;
+    /* independent transfers: each process reads its own rows */
+    if (!block_read(stream->dset, start, rows, H5P_DEFAULT))
+    {
+        /* the errors are recorded per thread: the error is kept in the stream
+        ** until h5_stream_next reports it in the thread which uses the stream */
+        stream->load_error = pyc_error_kind();
+        snprintf(stream->load_error_message, sizeof(stream->load_error_message),
+                "%s", pyc_error_message());
+        pyc_clear_error();
+    }
+    return (NULL);
+}
+
+/* start reading the next chunk in the buffer which is not used */
+static void     stream_start_load(t_h5_stream *stream)
+{
+    int64_t rows = stream->end - stream->next;
+
+    stream->load_buffer = 1 - stream->current;
+    stream->load_start = stream->next;
+    stream->load_rows = rows < stream->chunk_rows ? rows : stream->chunk_rows;
+    stream->next += stream->load_rows;
+    stream->load_error = error_none;
+#ifdef PYC_HDF5_PREFETCH
+    if (stream->prefetch && pthread_create(&stream->thread, NULL, stream_load, stream) == 0)
+    {
+        stream->pending = true;
+        return ;
+    }
+#endif
+    stream_load(stream);
+}
+
+bool    h5_stream_open(t_h5_stream *stream, const t_h5_dataset *dset,
+        int64_t first, int64_t count, int64_t chunk_rows, bool prefetch)
+{
+    int64_t shape[MAX_NDIM];
+
+    /* a stream which cannot be opened can still be closed */
+    stream->pending = false;
+    stream->chunk = (t_ndarray){.shape = NULL};
+    stream->buffers[0] = (t_ndarray){.shape = NULL};
+    stream->buffers[1] = (t_ndarray){.shape = NULL};
+    if (dset->dataset < 0)
+    {
+        h5_error(error_value, __func__, "the dataset is not open");
+        return (false);
+    }
+    if (first < 0 || count < 0 || first + count > dset->shape[0] || chunk_rows < 1)
+    {
+        h5_error(error_value, __func__, "invalid rows");
+        return (false);
+    }
+    stream->dset = dset;
+    stream->end = first + count;
+    stream->chunk_rows = chunk_rows < count ? chunk_rows : (count > 0 ? count : 1);
+    stream->next = first;
+    stream->start = first;
+    /* no chunk is read in the other buffer */
+    stream->current = 1;
+    stream->load_buffer = 1;
+    stream->load_error = error_none;
+    stream->prefetch = prefetch;
+#if defined(PYC_HDF5_PREFETCH) && defined(H5_HAVE_PARALLEL)
+    /* HDF5 calls MPI from the thread which reads the chunks */
+    int initialized;
+    int provided = MPI_THREAD_MULTIPLE;
+
+    MPI_Initialized(&initialized);
+    if (initialized)
+        MPI_Query_thread(&provided);
+    stream->prefetch &= provided == MPI_THREAD_MULTIPLE;
+#endif
+    memcpy(shape, dset->shape, dset->nd * sizeof(int64_t));
+    shape[0] = stream->chunk_rows;
+    for (int32_t i = 0; i < 2; i++)
+        stream->buffers[i] = array_create(dset->nd, shape, dset->type, false, order_c);
+    stream->chunk = stream->buffers[0];
+    stream->chunk.shape = allocate_metadata(dset->nd);
+    stream->chunk.strides = stream->chunk.shape + dset->nd;
+    memcpy(stream->chunk.shape, stream->buffers[0].shape, 2 * dset->nd * sizeof(int64_t));
+    stream->chunk.is_view = true;
+    stream->chunk.shape[0] = 0;
+    stream->chunk.length = 0;
+    stream->chunk.buffer_size = 0;
+    /* the first chunk is read while the caller prepares the computations */
+    if (stream->prefetch && stream->next < stream->end)
+        stream_start_load(stream);
+    return (true);
+}
+
+bool    h5_stream_next(t_h5_stream *stream)
+{
+    int64_t row_length = stream->buffers[0].length / stream->chunk_rows;
+
+    if (!stream->pending && stream->load_buffer == stream->current)
+    {
+        /* no chunk was read in advance */
+        if (stream->next >= stream->end)
+            return (false);
+        stream_start_load(stream);
+    }
+#ifdef PYC_HDF5_PREFETCH
+    if (stream->pending)
+    {
+        pthread_join(stream->thread, NULL);
+        stream->pending = false;
+    }
+#endif
+    if (stream->load_error != error_none)
+    {
+        pyc_set_error(stream->load_error, "%s", stream->load_error_message);
+        /* the stream stops at the chunk which cannot be read */
+        stream->load_error = error_none;
+        stream->load_buffer = stream->current;
+        stream->next = stream->end;
+        return (false);
+    }
+    stream->current = stream->load_buffer;
+    stream->start = stream->load_start;
+    stream->chunk.raw_data = stream->buffers[stream->current].raw_data;
+    stream->chunk.device = stream->buffers[stream->current].device;
+    stream->chunk.shape[0] = stream->load_rows;
+    stream->chunk.length = stream->load_rows * row_length;
+    stream->chunk.buffer_size = stream->chunk.length * stream->chunk.type_size;
+    /* the next chunk is read in the other buffer while this one is used */
+    if (stream->prefetch && stream->next < stream->end)
+        stream_start_load(stream);
+    return (true);
+}
+
+void    h5_stream_close(t_h5_stream *stream)
+{
+#ifdef PYC_HDF5_PREFETCH
+    if (stream->pending)
+        pthread_join(stream->thread, NULL);
+#endif
+    stream->pending = false;
+    free_pointer(&stream->chunk);
+    free_array(&stream->buffers[0]);
+    free_array(&stream->buffers[1]);
+}
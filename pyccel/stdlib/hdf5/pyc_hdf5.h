@@ -0,0 +1,125 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the HDF5 input/output of ndarrays. A block of a dataset
+ * (hyperslab) is read into or written from an ndarray, which may be a view
+ * (e.g. a slice or the owned points of a distributed array): the strides of
+ * the view are described by a hyperslab of the memory dataspace, so the data
+ * is transferred without copies unless the view cannot be described this way
+ * (e.g. arrays in order_f, as the datasets are stored in C order).
+ *
+ * The datasets which do not fit in memory are read chunk by chunk with a
+ * stream: a chunk is given by a number of indices of the first dimension. The
+ * stream reads the next chunk in a second buffer while the current chunk is
+ * used (with a thread, if the HDF5 library is thread-safe), so the reads are
+ * overlapped with the computations.
+ *
+ * With parallel HDF5 (H5_HAVE_PARALLEL) the files can be opened by all the
+ * processes of an MPI communicator: the blocks are then read and written with
+ * collective transfers, and the streams use independent transfers so that
+ * each process can read its own part of a dataset.
+ *
+ * The functions do not exit when they fail: they record the error (see
+ * pyc_error_occurred in ndarrays.h) and return a status, a negative
+ * identifier, a dataset which is not open (dataset < 0) or an empty array
+ * (shape == NULL).
+ */
+
+#ifndef PYC_HDF5_H
+# define PYC_HDF5_H
+
+# include <hdf5.h>
+# include <stdbool.h>
+# include <stdint.h>
+# include "ndarrays.h"
+# if !defined(_WIN32) && defined(H5_HAVE_THREADSAFE)
+#  include <pthread.h>
+#  define PYC_HDF5_PREFETCH
+# endif
+
+/* mode of an HDF5 file */
+typedef enum e_h5_mode
+{
+    h5_file_r,      /* read-only ('r') */
+    h5_file_rplus,  /* read and write an existing file ('r+') */
+    h5_file_w,      /* the file is created or overwritten ('w') */
+}               t_h5_mode;
+
+/* dataset read and written with ndarrays of the given type */
+typedef struct  s_h5_dataset
+{
+    hid_t       dataset;
+    /* dataspace of the dataset in the file */
+    hid_t       space;
+    /* type of the elements of the ndarrays (converted by HDF5 if the type of the dataset differs) */
+    t_types     type;
+    hid_t       mem_type;
+    /* transfer properties of the blocks (collective in a file opened by all the processes) */
+    hid_t       xfer;
+    /* shape of the dataset */
+    int32_t     nd;
+    int64_t     shape[MAX_NDIM];
+}               t_h5_dataset;
+
+/* stream reading the indices [first, first + count) of the first dimension of
+** a dataset chunk by chunk (the stream must not be copied once it is open) */
+typedef struct  s_h5_stream
+{
+    const t_h5_dataset  *dset;
+    /* rows (indices of the first dimension) read by the stream and in a chunk */
+    int64_t             end;
+    int64_t             chunk_rows;
+    /* first row of the next chunk to read */
+    int64_t             next;
+    /* current chunk (a view of one of the buffers) and its first row */
+    t_ndarray           chunk;
+    int64_t             start;
+    /* the chunks are read alternately in each buffer */
+    t_ndarray           buffers[2];
+    int32_t             current;
+    /* read being done in the other buffer while the current chunk is used */
+    bool                prefetch;
+    bool                pending;
+    int32_t             load_buffer;
+    int64_t             load_start;
+    int64_t             load_rows;
+    /* error of the read in the other buffer, reported by h5_stream_next */
+    t_error_kind        load_error;
+    char                load_error_message[256];
+# ifdef PYC_HDF5_PREFETCH
+    pthread_t           thread;
+# endif
+}               t_h5_stream;
+
+/* files */
+hid_t           h5_file_open(const char *filename, t_h5_mode mode);
+# ifdef H5_HAVE_PARALLEL
+hid_t           h5_file_open_mpi(const char *filename, t_h5_mode mode, MPI_Comm comm);
+# endif
+void            h5_file_close(hid_t file);
+
+/* datasets: chunk may be NULL (the data of the dataset is contiguous in the file) */
+t_h5_dataset    h5_dataset_open(hid_t file, const char *name, t_types type);
+t_h5_dataset    h5_dataset_create(hid_t file, const char *name, int32_t nd,
+        const int64_t *shape, t_types type, const int64_t *chunk);
+void            h5_dataset_close(t_h5_dataset *dset);
+
+/* blocks of the shape of arr starting at the index start (the origin if start is NULL) */
+bool            h5_read(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr);
+bool            h5_write(const t_h5_dataset *dset, const int64_t *start, t_ndarray arr);
+/* new array holding the block of the given shape (the whole dataset if shape is NULL) */
+t_ndarray       h5_read_array(const t_h5_dataset *dset, const int64_t *start,
+        const int64_t *shape, t_order order);
+
+/* streams: h5_stream_next gives the next chunk in stream->chunk (it returns false
+** after the last chunk or if a chunk cannot be read), the chunk is valid until the
+** next call */
+bool            h5_stream_open(t_h5_stream *stream, const t_h5_dataset *dset,
+        int64_t first, int64_t count, int64_t chunk_rows, bool prefetch);
+bool            h5_stream_next(t_h5_stream *stream);
+void            h5_stream_close(t_h5_stream *stream);
+
+#endif
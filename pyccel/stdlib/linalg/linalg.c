@@ -0,0 +1,409 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "linalg.h"
+#include <limits.h>
+#include <stddef.h>
+
+/*
+** CBLAS
+**
+** The prototypes are declared here so that only the library (e.g. OpenBLAS,
+** or the reference BLAS which includes CBLAS on most distributions) is needed
+** and not its headers. The enumerations have the values of cblas.h.
+*/
+#ifdef PYCCEL_USE_CBLAS
+
+enum { CblasRowMajor = 101 };
+enum { CblasNoTrans = 111, CblasTrans = 112 };
+
+void    cblas_sgemm(int layout, int trans_a, int trans_b, int m, int n, int k,
+                float alpha, const float *a, int lda, const float *b, int ldb,
+                float beta, float *c, int ldc);
+void    cblas_dgemm(int layout, int trans_a, int trans_b, int m, int n, int k,
+                double alpha, const double *a, int lda, const double *b, int ldb,
+                double beta, double *c, int ldc);
+void    cblas_cgemm(int layout, int trans_a, int trans_b, int m, int n, int k,
+                const void *alpha, const void *a, int lda, const void *b, int ldb,
+                const void *beta, void *c, int ldc);
+void    cblas_zgemm(int layout, int trans_a, int trans_b, int m, int n, int k,
+                const void *alpha, const void *a, int lda, const void *b, int ldb,
+                const void *beta, void *c, int ldc);
+
+void    cblas_sgemv(int layout, int trans, int m, int n, float alpha, const float *a,
+                int lda, const float *x, int incx, float beta, float *y, int incy);
+void    cblas_dgemv(int layout, int trans, int m, int n, double alpha, const double *a,
+                int lda, const double *x, int incx, double beta, double *y, int incy);
+void    cblas_cgemv(int layout, int trans, int m, int n, const void *alpha, const void *a,
+                int lda, const void *x, int incx, const void *beta, void *y, int incy);
+void    cblas_zgemv(int layout, int trans, int m, int n, const void *alpha, const void *a,
+                int lda, const void *x, int incx, const void *beta, void *y, int incy);
+
+float   cblas_sdot(int n, const float *x, int incx, const float *y, int incy);
+double  cblas_ddot(int n, const double *x, int incx, const double *y, int incy);
+void    cblas_cdotu_sub(int n, const void *x, int incx, const void *y, int incy, void *dotu);
+void    cblas_zdotu_sub(int n, const void *x, int incx, const void *y, int incy, void *dotu);
+
+#endif
+
+/*
+** A matrix product c = a @ b where a is m x k, b is k x n and c is m x n.
+** The vectors are seen as matrices with one row (left operand) or one column
+** (right operand), the stride of this dimension of length 1 is 0 so that it is
+** never considered contiguous. When the columns of c are contiguous but not
+** its rows (order_f) the product c^T = b^T a^T is computed instead, which
+** only swaps the strides, so that the kernels always run along the rows of c.
+*/
+typedef struct  s_matmul
+{
+    int64_t     m;
+    int64_t     n;
+    int64_t     k;
+    const void  *a;
+    int64_t     a_row_stride;
+    int64_t     a_col_stride;
+    const void  *b;
+    int64_t     b_row_stride;
+    int64_t     b_col_stride;
+    void        *c;
+    int64_t     c_row_stride;
+    int64_t     c_col_stride;
+}               t_matmul;
+
+static t_matmul get_matmul(t_ndarray *out, t_ndarray a, t_ndarray b)
+{
+    t_matmul p;
+
+    p.m = a.nd == 2 ? a.shape[0] : 1;
+    p.k = a.shape[a.nd - 1];
+    p.n = b.nd == 2 ? b.shape[1] : 1;
+    p.a = a.raw_data;
+    p.a_row_stride = a.nd == 2 ? a.strides[0] : 0;
+    p.a_col_stride = a.strides[a.nd - 1];
+    p.b = b.raw_data;
+    p.b_row_stride = b.strides[0];
+    p.b_col_stride = b.nd == 2 ? b.strides[1] : 0;
+    p.c = out->raw_data;
+    p.c_row_stride = out->nd == 2 || b.nd == 1 ? out->strides[0] : 0;
+    p.c_col_stride = out->nd == 2 ? out->strides[1] : (b.nd == 1 ? 0 : out->strides[0]);
+    if (p.c_col_stride != 1 && p.c_row_stride == 1)
+    {
+        t_matmul t = p;
+        p.m = t.n;
+        p.n = t.m;
+        p.a = t.b;
+        p.a_row_stride = t.b_col_stride;
+        p.a_col_stride = t.b_row_stride;
+        p.b = t.a;
+        p.b_row_stride = t.a_col_stride;
+        p.b_col_stride = t.a_row_stride;
+        p.c_row_stride = t.c_col_stride;
+        p.c_col_stride = t.c_row_stride;
+    }
+    return (p);
+}
+
+#ifdef PYCCEL_USE_CBLAS
+
+/*
+** Get the transposition and the leading dimension describing a rows x cols
+** matrix to CBLAS (row major). Returns false if none of its dimensions is
+** contiguous.
+*/
+static bool blas_matrix(int64_t rows, int64_t cols, int64_t row_stride, int64_t col_stride,
+        int *trans, int *ld)
+{
+    int64_t lead;
+
+    if (col_stride == 1 && (rows == 1 || row_stride >= cols))
+    {
+        *trans = CblasNoTrans;
+        lead = rows == 1 ? cols : row_stride;
+    }
+    else if (row_stride == 1 && (cols == 1 || col_stride >= rows))
+    {
+        *trans = CblasTrans;
+        lead = cols == 1 ? rows : col_stride;
+    }
+    else
+        return (false);
+    if (lead > INT_MAX)
+        return (false);
+    *ld = (int)lead;
+    return (true);
+}
+
+/* strides of vectors accepted by CBLAS (the negative ones would start from the end) */
+static inline bool blas_increment(int64_t stride)
+{
+    return (stride > 0 && stride <= INT_MAX);
+}
+
+/*
+** Compute the product with gemv when c is a vector and with gemm otherwise.
+** Returns false if the layout of the arrays is not accepted by CBLAS.
+*/
+#define BLAS_MATMUL_(NAME, TYPE, PREFIX, SCALAR) \
+    static bool blas_matmul_##NAME(const t_matmul *p) \
+    { \
+        TYPE one = 1; \
+        TYPE zero = 0; \
+        int trans_a, trans_b, trans_c, lda, ldb, ldc; \
+        if (p->m > INT_MAX || p->n > INT_MAX || p->k > INT_MAX) \
+            return (false); \
+        int m = (int)p->m; \
+        int n = (int)p->n; \
+        int k = (int)p->k; \
+        if (n == 1) \
+        { \
+            if (!blas_matrix(p->m, p->k, p->a_row_stride, p->a_col_stride, &trans_a, &lda) \
+                    || !blas_increment(p->b_row_stride) || !blas_increment(p->c_row_stride)) \
+                return (false); \
+            cblas_##PREFIX##gemv(CblasRowMajor, trans_a, trans_a == CblasNoTrans ? m : k, \
+                    trans_a == CblasNoTrans ? k : m, SCALAR(one), p->a, lda, \
+                    p->b, (int)p->b_row_stride, SCALAR(zero), p->c, (int)p->c_row_stride); \
+            return (true); \
+        } \
+        if (m == 1) \
+        { \
+            if (!blas_matrix(p->k, p->n, p->b_row_stride, p->b_col_stride, &trans_b, &ldb) \
+                    || !blas_increment(p->a_col_stride) || !blas_increment(p->c_col_stride)) \
+                return (false); \
+            cblas_##PREFIX##gemv(CblasRowMajor, trans_b == CblasNoTrans ? CblasTrans : CblasNoTrans, \
+                    trans_b == CblasNoTrans ? k : n, trans_b == CblasNoTrans ? n : k, \
+                    SCALAR(one), p->b, ldb, p->a, (int)p->a_col_stride, \
+                    SCALAR(zero), p->c, (int)p->c_col_stride); \
+            return (true); \
+        } \
+        if (!blas_matrix(p->m, p->n, p->c_row_stride, p->c_col_stride, &trans_c, &ldc) \
+                || trans_c != CblasNoTrans \
+                || !blas_matrix(p->m, p->k, p->a_row_stride, p->a_col_stride, &trans_a, &lda) \
+                || !blas_matrix(p->k, p->n, p->b_row_stride, p->b_col_stride, &trans_b, &ldb)) \
+            return (false); \
+        cblas_##PREFIX##gemm(CblasRowMajor, trans_a, trans_b, m, n, k, SCALAR(one), \
+                p->a, lda, p->b, ldb, SCALAR(zero), p->c, ldc); \
+        return (true); \
+    }
+
+#define BLAS_REAL_(x) (x)
+#define BLAS_COMPLEX_(x) (&(x))
+
+BLAS_MATMUL_(float32, float, s, BLAS_REAL_)
+BLAS_MATMUL_(float64, double, d, BLAS_REAL_)
+BLAS_MATMUL_(complex64, float complex, c, BLAS_COMPLEX_)
+BLAS_MATMUL_(complex128, double complex, z, BLAS_COMPLEX_)
+
+static bool blas_dot_float32(float *result, t_ndarray a, t_ndarray b)
+{
+    if (a.shape[0] > INT_MAX || !blas_increment(a.strides[0]) || !blas_increment(b.strides[0]))
+        return (false);
+    *result = cblas_sdot((int)a.shape[0], a.nd_float, (int)a.strides[0], b.nd_float, (int)b.strides[0]);
+    return (true);
+}
+
+static bool blas_dot_float64(double *result, t_ndarray a, t_ndarray b)
+{
+    if (a.shape[0] > INT_MAX || !blas_increment(a.strides[0]) || !blas_increment(b.strides[0]))
+        return (false);
+    *result = cblas_ddot((int)a.shape[0], a.nd_double, (int)a.strides[0], b.nd_double, (int)b.strides[0]);
+    return (true);
+}
+
+static bool blas_dot_complex64(float complex *result, t_ndarray a, t_ndarray b)
+{
+    if (a.shape[0] > INT_MAX || !blas_increment(a.strides[0]) || !blas_increment(b.strides[0]))
+        return (false);
+    cblas_cdotu_sub((int)a.shape[0], a.nd_cfloat, (int)a.strides[0], b.nd_cfloat, (int)b.strides[0], result);
+    return (true);
+}
+
+static bool blas_dot_complex128(double complex *result, t_ndarray a, t_ndarray b)
+{
+    if (a.shape[0] > INT_MAX || !blas_increment(a.strides[0]) || !blas_increment(b.strides[0]))
+        return (false);
+    cblas_zdotu_sub((int)a.shape[0], a.nd_cdouble, (int)a.strides[0], b.nd_cdouble, (int)b.strides[0], result);
+    return (true);
+}
+
+#else
+
+# define blas_matmul_float32(p) false
+# define blas_matmul_float64(p) false
+# define blas_matmul_complex64(p) false
+# define blas_matmul_complex128(p) false
+# define blas_dot_float32(result, a, b) false
+# define blas_dot_float64(result, a, b) false
+# define blas_dot_complex64(result, a, b) false
+# define blas_dot_complex128(result, a, b) false
+
+#endif
+
+#define NO_BLAS_MATMUL_(p) false
+#define NO_BLAS_DOT_(result, a, b) false
+
+/*
+** Kernels
+**
+** Both kernels accumulate the product in c (which is first set to 0) by
+** blocks of MATMUL_BLOCK_K values of the inner dimension so that the block
+** of b which is read for all the rows of c stays in the cache:
+** - rows : c[i, :] += a[i, l] * b[l, :], used when the rows of b and c are
+**   contiguous. Four rows of c are updated at once to reuse the loads of b,
+**   the inner loop is vectorised.
+** - dots : c[i, j] += a[i, :] . b[:, j], used when the rows of a and the
+**   columns of b are contiguous (e.g. order_c @ order_f). The inner products
+**   use 4 accumulators.
+** Any other layout is computed by the rows kernel with strided accesses.
+*/
+#define MATMUL_BLOCK_K 128
+#define MATMUL_BLOCK_N 256
+#define MATMUL_BLOCK_DOT_N 64
+
+#define NUM_ADD_(a, b) ((a) + (b))
+#define NUM_MADD_(c, a, b) ((c) + (a) * (b))
+#define BOOL_ADD_(a, b) ((a) | (b))
+#define BOOL_MADD_(c, a, b) ((c) | ((a) & (b)))
+
+#define MATMUL_(NAME, TYPE, CTYPE, ADD, MADD, BLAS_MATMUL, BLAS_DOT) \
+    static TYPE dot_run_##NAME(const TYPE *x, int64_t x_stride, const TYPE *y, int64_t y_stride, int64_t n) \
+    { \
+        TYPE acc[4] = {0, 0, 0, 0}; \
+        int64_t i = 0; \
+        if (x_stride == 1 && y_stride == 1) \
+        { \
+            for (; i + 4 <= n; i += 4) \
+                for (int32_t j = 0; j < 4; j++) \
+                    acc[j] = MADD(acc[j], x[i + j], y[i + j]); \
+        } \
+        for (; i < n; i++) \
+            acc[0] = MADD(acc[0], x[i * x_stride], y[i * y_stride]); \
+        return (ADD(ADD(acc[0], acc[1]), ADD(acc[2], acc[3]))); \
+    } \
+    static void matmul_rows_##NAME(const t_matmul *p) \
+    { \
+        const TYPE *a = p->a; \
+        const TYPE *b = p->b; \
+        TYPE *c = p->c; \
+        bool contiguous = p->b_col_stride == 1 && p->c_col_stride == 1; \
+        for (int64_t kk = 0; kk < p->k; kk += MATMUL_BLOCK_K) \
+        { \
+            int64_t k_end = p->k - kk > MATMUL_BLOCK_K ? kk + MATMUL_BLOCK_K : p->k; \
+            for (int64_t jj = 0; jj < p->n; jj += MATMUL_BLOCK_N) \
+            { \
+                int64_t n = p->n - jj > MATMUL_BLOCK_N ? MATMUL_BLOCK_N : p->n - jj; \
+                int64_t i = 0; \
+                if (contiguous) \
+                { \
+                    for (; i + 4 <= p->m; i += 4) \
+                    { \
+                        TYPE *restrict c0 = c + i * p->c_row_stride + jj; \
+                        TYPE *restrict c1 = c0 + p->c_row_stride; \
+                        TYPE *restrict c2 = c1 + p->c_row_stride; \
+                        TYPE *restrict c3 = c2 + p->c_row_stride; \
+                        const TYPE *a_i = a + i * p->a_row_stride; \
+                        for (int64_t l = kk; l < k_end; l++) \
+                        { \
+                            const TYPE *restrict b_l = b + l * p->b_row_stride + jj; \
+                            TYPE a0 = a_i[l * p->a_col_stride]; \
+                            TYPE a1 = a_i[p->a_row_stride + l * p->a_col_stride]; \
+                            TYPE a2 = a_i[2 * p->a_row_stride + l * p->a_col_stride]; \
+                            TYPE a3 = a_i[3 * p->a_row_stride + l * p->a_col_stride]; \
+                            for (int64_t j = 0; j < n; j++) \
+                            { \
+                                c0[j] = MADD(c0[j], a0, b_l[j]); \
+                                c1[j] = MADD(c1[j], a1, b_l[j]); \
+                                c2[j] = MADD(c2[j], a2, b_l[j]); \
+                                c3[j] = MADD(c3[j], a3, b_l[j]); \
+                            } \
+                        } \
+                    } \
+                    for (; i < p->m; i++) \
+                    { \
+                        TYPE *restrict c_i = c + i * p->c_row_stride + jj; \
+                        for (int64_t l = kk; l < k_end; l++) \
+                        { \
+                            const TYPE *restrict b_l = b + l * p->b_row_stride + jj; \
+                            TYPE a_il = a[i * p->a_row_stride + l * p->a_col_stride]; \
+                            for (int64_t j = 0; j < n; j++) \
+                                c_i[j] = MADD(c_i[j], a_il, b_l[j]); \
+                        } \
+                    } \
+                } \
+                for (; i < p->m; i++) \
+                { \
+                    TYPE *c_i = c + i * p->c_row_stride + jj * p->c_col_stride; \
+                    for (int64_t l = kk; l < k_end; l++) \
+                    { \
+                        const TYPE *b_l = b + l * p->b_row_stride + jj * p->b_col_stride; \
+                        TYPE a_il = a[i * p->a_row_stride + l * p->a_col_stride]; \
+                        for (int64_t j = 0; j < n; j++) \
+                            c_i[j * p->c_col_stride] = MADD(c_i[j * p->c_col_stride], a_il, b_l[j * p->b_col_stride]); \
+                    } \
+                } \
+            } \
+        } \
+    } \
+    static void matmul_dots_##NAME(const t_matmul *p) \
+    { \
+        const TYPE *a = p->a; \
+        const TYPE *b = p->b; \
+        TYPE *c = p->c; \
+        for (int64_t kk = 0; kk < p->k; kk += MATMUL_BLOCK_K) \
+        { \
+            int64_t k = p->k - kk > MATMUL_BLOCK_K ? MATMUL_BLOCK_K : p->k - kk; \
+            for (int64_t jj = 0; jj < p->n; jj += MATMUL_BLOCK_DOT_N) \
+            { \
+                int64_t j_end = p->n - jj > MATMUL_BLOCK_DOT_N ? jj + MATMUL_BLOCK_DOT_N : p->n; \
+                for (int64_t i = 0; i < p->m; i++) \
+                { \
+                    const TYPE *a_i = a + i * p->a_row_stride + kk * p->a_col_stride; \
+                    for (int64_t j = jj; j < j_end; j++) \
+                    { \
+                        TYPE *c_ij = c + i * p->c_row_stride + j * p->c_col_stride; \
+                        *c_ij = ADD(*c_ij, dot_run_##NAME(a_i, p->a_col_stride, \
+                                b + kk * p->b_row_stride + j * p->b_col_stride, p->b_row_stride, k)); \
+                    } \
+                } \
+            } \
+        } \
+    } \
+    void numpy_matmul_##NAME(t_ndarray *out, t_ndarray a, t_ndarray b) \
+    { \
+        t_matmul p = get_matmul(out, a, b); \
+        TYPE *c = p.c; \
+        if (p.m == 0 || p.n == 0) \
+            return; \
+        if (p.m == 1 && p.n == 1) \
+        { \
+            c[0] = dot_run_##NAME(p.a, p.a_col_stride, p.b, p.b_row_stride, p.k); \
+            return; \
+        } \
+        if (p.k > 0 && BLAS_MATMUL(&p)) \
+            return; \
+        for (int64_t i = 0; i < p.m; i++) \
+            for (int64_t j = 0; j < p.n; j++) \
+                c[i * p.c_row_stride + j * p.c_col_stride] = 0; \
+        if (p.b_col_stride != 1 && p.a_col_stride == 1 && p.b_row_stride == 1) \
+            matmul_dots_##NAME(&p); \
+        else \
+            matmul_rows_##NAME(&p); \
+    } \
+    TYPE numpy_dot_##NAME(t_ndarray a, t_ndarray b) \
+    { \
+        TYPE result; \
+        if (BLAS_DOT(&result, a, b)) \
+            return (result); \
+        return (dot_run_##NAME(a.nd_##CTYPE, a.strides[0], b.nd_##CTYPE, b.strides[0], a.shape[0])); \
+    }
+
+MATMUL_(bool, bool, bool, BOOL_ADD_, BOOL_MADD_, NO_BLAS_MATMUL_, NO_BLAS_DOT_)
+MATMUL_(int8, int8_t, int8, NUM_ADD_, NUM_MADD_, NO_BLAS_MATMUL_, NO_BLAS_DOT_)
+MATMUL_(int16, int16_t, int16, NUM_ADD_, NUM_MADD_, NO_BLAS_MATMUL_, NO_BLAS_DOT_)
+MATMUL_(int32, int32_t, int32, NUM_ADD_, NUM_MADD_, NO_BLAS_MATMUL_, NO_BLAS_DOT_)
+MATMUL_(int64, int64_t, int64, NUM_ADD_, NUM_MADD_, NO_BLAS_MATMUL_, NO_BLAS_DOT_)
+MATMUL_(float32, float, float, NUM_ADD_, NUM_MADD_, blas_matmul_float32, blas_dot_float32)
+MATMUL_(float64, double, double, NUM_ADD_, NUM_MADD_, blas_matmul_float64, blas_dot_float64)
+MATMUL_(complex64, float complex, cfloat, NUM_ADD_, NUM_MADD_, blas_matmul_complex64, blas_dot_complex64)
+MATMUL_(complex128, double complex, cdouble, NUM_ADD_, NUM_MADD_, blas_matmul_complex128, blas_dot_complex128)
@@ -0,0 +1,50 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the matrix products of ndarrays (numpy.matmul and the @
+ * operator). When the file is compiled with PYCCEL_USE_CBLAS (accelerator
+ * 'blas') the products of float and complex arrays are computed by the CBLAS
+ * functions gemm, gemv and dot whenever the layout of the arrays allows it.
+ * The other products are computed by cache-blocked loops which read the rows
+ * or the columns of the operands along their contiguous dimension, whatever
+ * the order of the arrays, without copying them.
+ */
+
+#ifndef LINALG_H
+# define LINALG_H
+
+# include <complex.h>
+# include <stdbool.h>
+# include <stdint.h>
+# include "ndarrays.h"
+
+/* numpy matmul of two arrays of rank 1 or 2 (at least one of rank 2), the
+** result is written in out which is already allocated with the shape of the
+** result and does not share its data with a or b */
+
+void            numpy_matmul_bool(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_int8(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_int16(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_int32(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_int64(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_float32(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_float64(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_complex64(t_ndarray *out, t_ndarray a, t_ndarray b);
+void            numpy_matmul_complex128(t_ndarray *out, t_ndarray a, t_ndarray b);
+
+/* numpy matmul of two arrays of rank 1 (inner product) */
+
+bool            numpy_dot_bool(t_ndarray a, t_ndarray b);
+int8_t          numpy_dot_int8(t_ndarray a, t_ndarray b);
+int16_t         numpy_dot_int16(t_ndarray a, t_ndarray b);
+int32_t         numpy_dot_int32(t_ndarray a, t_ndarray b);
+int64_t         numpy_dot_int64(t_ndarray a, t_ndarray b);
+float           numpy_dot_float32(t_ndarray a, t_ndarray b);
+double          numpy_dot_float64(t_ndarray a, t_ndarray b);
+float complex   numpy_dot_complex64(t_ndarray a, t_ndarray b);
+double complex  numpy_dot_complex128(t_ndarray a, t_ndarray b);
+
+#endif
@@ -7,33 +7,68 @@
 #include <math.h>
 
 /*---------------------------------------------------------------------------*/
+/* 20! is the largest factorial which fits in an int64_t */
+static const int64_t        factorials[21] = {
+    1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800,
+    479001600, 6227020800, 87178291200, 1307674368000, 20922789888000,
+    355687428096000, 6402373705728000, 121645100408832000,
+    2432902008176640000
+};
+
 int64_t                     pyc_factorial(int64_t n)
 {
-    int64_t    res = 1;
-
     /* ValueError: factorial() not defined for negative values */
     if (n < 0)
         return 0;
-    for (int64_t i = 2; i <= n; i++)
-        res *= i;
-    return (res);
+    if (n <= 20)
+        return factorials[n];
+    /* the result overflows, it is computed modulo 2^64 */
+    uint64_t    res = (uint64_t)factorials[20];
+    for (int64_t i = 21; i <= n; i++)
+        res *= (uint64_t)i;
+    return (int64_t)res;
 }
 /*---------------------------------------------------------------------------*/
+static int                  count_trailing_zeros(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    for (; !(x & 1); x >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+/* binary GCD algorithm: shifts and subtractions instead of divisions */
 int64_t                     pyc_gcd (int64_t a, int64_t b)
 {
-    while (b) {
-        a %= b;
-        /* swap a and b*/
-        a = a ^ b;
-        b = b ^ a;
-        a = a ^ b;
-    }
-    return a;
+    uint64_t   u = a < 0 ? -(uint64_t)a : (uint64_t)a;
+    uint64_t   v = b < 0 ? -(uint64_t)b : (uint64_t)b;
+
+    if (u == 0 || v == 0)
+        return (int64_t)(u | v);
+    int shift = count_trailing_zeros(u | v);
+    u >>= count_trailing_zeros(u);
+    do {
+        v >>= count_trailing_zeros(v);
+        uint64_t m = u < v ? u : v;
+        v = (u < v ? v : u) - m;
+        u = m;
+    } while (v != 0);
+    return (int64_t)(u << shift);
 }
 /*---------------------------------------------------------------------------*/
 int64_t                     pyc_lcm (int64_t a, int64_t b)
 {
-    return a / pyc_gcd(a, b) * b;
+    int64_t     gcd = pyc_gcd(a, b);
+    int64_t     lcm;
+
+    if (gcd == 0)
+        return 0;
+    lcm = a / gcd * b;
+    return lcm < 0 ? -lcm : lcm;
 }
 /*---------------------------------------------------------------------------*/
 extern inline double        pyc_radians(double degrees);
@@ -27,16 +27,13 @@ inline double       pyc_degrees(double radians)
 }
 inline int64_t      pyc_modulo(int64_t a, int64_t b){
         int64_t modulo = a % b;
-        if(!((a < 0) ^ (b < 0)) || modulo == 0)
-            return modulo;
-        else
-            return modulo + b;
+        /* add b when the remainder and b have opposite signs */
+        return modulo + ((modulo != 0) & ((modulo ^ b) < 0) ? b : 0);
 }
 inline double        pyc_fmodulo(double a, double b){
         double modulo = fmod(a, b);
-        if(!((a < 0) ^ (b < 0)) || modulo == 0)
-            return modulo;
-        else
-            return modulo + b;
+        double res = (modulo != 0 && (modulo < 0) != (b < 0)) ? modulo + b : modulo;
+        /* a zero result has the sign of b */
+        return modulo == 0 ? copysign(0.0, b) : res;
 }
 #endif
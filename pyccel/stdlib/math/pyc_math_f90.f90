@@ -71,7 +71,7 @@ pure function pyc_factorial_8(x) result(fx) ! integers with precision 8
 end function pyc_factorial_8
 
 ! Implementation of math gcd function
-pure function pyc_gcd_4(a, b) result(gcd) ! integers with precision 4
+elemental function pyc_gcd_4(a, b) result(gcd) ! integers with precision 4
 
     implicit none
 
@@ -79,8 +79,8 @@ pure function pyc_gcd_4(a, b) result(gcd) ! integers with precision 4
     integer(C_INT32_T)             :: x, y
     integer(C_INT32_T)             :: gcd
 
-    x = a
-    y = b
+    x = abs(a)
+    y = abs(b)
     do while (y > 0)
         x = MOD(x, y)
         x = IEOR(x, y)
@@ -92,7 +92,7 @@ pure function pyc_gcd_4(a, b) result(gcd) ! integers with precision 4
 
 end function pyc_gcd_4
 
-pure function pyc_gcd_8(a, b) result(gcd) ! integers with precision 8
+elemental function pyc_gcd_8(a, b) result(gcd) ! integers with precision 8
 
     implicit none
 
@@ -100,8 +100,8 @@ pure function pyc_gcd_8(a, b) result(gcd) ! integers with precision 8
     integer(C_INT64_T)              :: x, y
     integer(C_INT64_T)              :: gcd
 
-    x = a
-    y = b
+    x = abs(a)
+    y = abs(b)
     do while (y > 0)
         x = MOD(x, y)
         x = IEOR(x, y)
@@ -114,7 +114,7 @@ pure function pyc_gcd_8(a, b) result(gcd) ! integers with precision 8
 end function pyc_gcd_8
 
 ! Implementation of math lcm function
-pure function pyc_lcm_4(a, b) result(lcm)
+elemental function pyc_lcm_4(a, b) result(lcm)
 
     implicit none
 
@@ -122,12 +122,13 @@ pure function pyc_lcm_4(a, b) result(lcm)
     integer(C_INT32_T), value      :: b
     integer(C_INT32_T)             :: lcm
 
-    lcm = a / pyc_gcd(a, b) * b
+    lcm = pyc_gcd(a, b)
+    if (lcm /= 0) lcm = abs(a / lcm * b)
     return
 
 end function pyc_lcm_4
 
-pure function pyc_lcm_8(a, b) result(lcm)
+elemental function pyc_lcm_8(a, b) result(lcm)
 
     implicit none
 
@@ -135,7 +136,8 @@ pure function pyc_lcm_8(a, b) result(lcm)
     integer(C_INT64_T), value      :: b
     integer(C_INT64_T)             :: lcm
 
-    lcm = a / pyc_gcd(a, b) * b
+    lcm = pyc_gcd(a, b)
+    if (lcm /= 0) lcm = abs(a / lcm * b)
     return
 
 end function pyc_lcm_8
@@ -3,6 +3,11 @@
 /* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
 /* --------------------------------------------------------------------------------------- */
 
+/* posix_memalign, madvise and the file functions are not part of C99 */
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+# define _DEFAULT_SOURCE
+#endif
+
 # include "ndarrays.h"
 # include <string.h>
 # include <stdarg.h>
@@ -12,6 +17,25 @@
 # include <inttypes.h>
 # include <complex.h>
 # include <math.h>
+# include <errno.h>
+#if defined(_WIN32)
+# include <malloc.h>
+#else
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <pthread.h>
+#endif
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+#ifdef _OPENACC
+# include <openacc.h>
+#endif
+#ifdef PYCCEL_PROFILE
+# include "pyc_profile.h"
+#endif
 
 /*
  * Takes an array, and prints its elements the way they are laid out in memory (similar to ravel)
@@ -19,7 +43,7 @@
 
 void print_ndarray_memory(t_ndarray nd)
 {
-    int i;
+    int64_t i;
 
     for (i = 0; i < nd.length; ++i)
     {
@@ -67,6 +91,366 @@ void print_ndarray_memory(t_ndarray nd)
         printf("\n");
 }
 
+/*
+** shape and strides
+**
+** The shape and the strides of an array are stored in a single block of
+** 2 * nd integers (the strides follow the shape). The blocks released by
+** free_array and free_pointer are kept in a small per-thread cache, one per
+** rank, so that creating views in a loop does not call malloc. The cache of
+** a thread is emptied when the thread exits by the destructor of a pthread
+** key. Without pthreads (on Windows) this is not possible so the blocks are
+** not cached.
+*/
+
+#if defined(_MSC_VER)
+# define THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+# define THREAD_LOCAL _Thread_local
+#else
+# define THREAD_LOCAL __thread
+#endif
+
+#define METADATA_CACHE_SIZE 16
+
+static THREAD_LOCAL int64_t *metadata_cache[MAX_NDIM][METADATA_CACHE_SIZE];
+static THREAD_LOCAL int32_t metadata_cache_count[MAX_NDIM];
+
+#if !defined(_WIN32)
+static pthread_key_t        metadata_cache_key;
+static pthread_once_t       metadata_cache_key_once = PTHREAD_ONCE_INIT;
+static bool                 metadata_cache_key_created = false;
+static THREAD_LOCAL bool    metadata_cache_registered = false;
+
+static void release_thread_metadata_cache(void *unused)
+{
+    (void)unused;
+    release_metadata_cache();
+    /* A destructor running afterwards may fill the cache again */
+    metadata_cache_registered = false;
+}
+
+static void create_metadata_cache_key(void)
+{
+    metadata_cache_key_created = pthread_key_create(&metadata_cache_key, release_thread_metadata_cache) == 0;
+}
+
+# if defined(__GNUC__)
+/* The destructor must not be called after the library is unloaded */
+__attribute__((destructor)) static void delete_metadata_cache_key(void)
+{
+    if (metadata_cache_key_created)
+        pthread_key_delete(metadata_cache_key);
+}
+# endif
+#endif
+
+/* Indicate whether the cache of the calling thread can be used, i.e. whether it will be released */
+static bool use_metadata_cache(void)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    if (!metadata_cache_registered)
+    {
+        pthread_once(&metadata_cache_key_once, create_metadata_cache_key);
+        metadata_cache_registered = metadata_cache_key_created
+                && pthread_setspecific(metadata_cache_key, &metadata_cache_registered) == 0;
+    }
+    return metadata_cache_registered;
+#endif
+}
+
+int64_t     *allocate_metadata(int32_t nd)
+{
+    if (nd > 0 && nd <= MAX_NDIM && metadata_cache_count[nd - 1] > 0)
+        return metadata_cache[nd - 1][--metadata_cache_count[nd - 1]];
+    return malloc(2 * nd * sizeof(int64_t));
+}
+
+void        free_metadata(int64_t *metadata, int32_t nd)
+{
+    if (nd > 0 && nd <= MAX_NDIM && metadata_cache_count[nd - 1] < METADATA_CACHE_SIZE
+            && use_metadata_cache())
+        metadata_cache[nd - 1][metadata_cache_count[nd - 1]++] = metadata;
+    else
+        free(metadata);
+}
+
+void        release_metadata_cache(void)
+{
+    for (int32_t i = 0; i < MAX_NDIM; i++)
+    {
+        while (metadata_cache_count[i] > 0)
+            free(metadata_cache[i][--metadata_cache_count[i]]);
+    }
+}
+
+/*
+** errors
+**
+** The functions of the library do not exit when they fail: they record the
+** error of the calling thread and return a value which can be used safely
+** (e.g. an empty array). The generated code checks pyc_error_occurred after
+** the calls which may fail and returns to its caller, the wrapper of the
+** Python module then raises the corresponding exception (see pyc_raise_error
+** in cwrapper_ndarrays.h) and a program prints the error and exits.
+*/
+
+#define ERROR_MESSAGE_SIZE 512
+
+static THREAD_LOCAL t_error_kind    error_kind = error_none;
+static THREAD_LOCAL char            error_message[ERROR_MESSAGE_SIZE];
+
+void            pyc_set_error(t_error_kind kind, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(error_message, ERROR_MESSAGE_SIZE, format, args);
+    va_end(args);
+    error_kind = kind;
+}
+
+bool            pyc_error_occurred(void)
+{
+    return (error_kind != error_none);
+}
+
+t_error_kind    pyc_error_kind(void)
+{
+    return (error_kind);
+}
+
+const char      *pyc_error_message(void)
+{
+    return (error_kind != error_none ? error_message : "");
+}
+
+void            pyc_clear_error(void)
+{
+    error_kind = error_none;
+}
+
+void            pyc_print_error(void)
+{
+    if (error_kind != error_none)
+        fprintf(stderr, "%s\n", error_message);
+    error_kind = error_none;
+}
+
+/*
+** data buffers
+**
+** The buffers are aligned on NDARRAY_ALIGNMENT bytes. On Linux, buffers of at
+** least NDARRAY_HUGEPAGE_THRESHOLD bytes are aligned on the size of a huge
+** page and the kernel is advised to back them with transparent huge pages.
+** The memory is not touched here so, with a first-touch NUMA policy, the pages
+** are placed on the node of the thread which initialises them. When the
+** library is compiled with PYCCEL_PROFILE the allocations are counted (see
+** pyc_profile.h).
+*/
+
+#ifndef NDARRAY_HUGEPAGE_THRESHOLD
+# define NDARRAY_HUGEPAGE_THRESHOLD ((int64_t)4 << 20)
+#endif
+#define HUGEPAGE_SIZE ((int64_t)2 << 20)
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+# define USE_HUGEPAGES
+#endif
+
+void        *allocate_data(int64_t size)
+{
+    void    *data = NULL;
+
+#if defined(_WIN32)
+    data = _aligned_malloc(size, NDARRAY_ALIGNMENT);
+#else
+    size_t  alignment = NDARRAY_ALIGNMENT;
+# ifdef USE_HUGEPAGES
+    if (size >= NDARRAY_HUGEPAGE_THRESHOLD)
+        alignment = HUGEPAGE_SIZE;
+# endif
+    if (posix_memalign(&data, alignment, size) != 0)
+        return (NULL);
+# ifdef USE_HUGEPAGES
+    if (size >= NDARRAY_HUGEPAGE_THRESHOLD)
+        madvise(data, size - size % HUGEPAGE_SIZE, MADV_HUGEPAGE);
+# endif
+#endif
+#ifdef PYCCEL_PROFILE
+    if (data != NULL)
+        pyc_profile_allocation(size);
+#endif
+    return (data);
+}
+
+/*
+** The data of the arrays stored in files may be mapped in memory instead of
+** being allocated (see array_from_file). The mappings are recorded in a list
+** so that free_data can unmap them. The list is protected by a mutex, its
+** length is read without the mutex so that the data of the other arrays is
+** freed without taking it when no array is mapped (a thread which frees a
+** mapped array received it after the mapping was recorded, so it reads a
+** positive length).
+*/
+
+typedef struct  s_mapping
+{
+    void                *data;
+    void                *address;
+    size_t              length;
+    struct s_mapping    *next;
+}               t_mapping;
+
+#if !defined(_WIN32)
+static t_mapping        *mappings = NULL;
+static int64_t          mappings_count = 0;
+static pthread_mutex_t  mappings_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+# if defined(__GNUC__)
+#  define MAPPINGS_COUNT() __atomic_load_n(&mappings_count, __ATOMIC_ACQUIRE)
+#  define SET_MAPPINGS_COUNT(value) __atomic_store_n(&mappings_count, (value), __ATOMIC_RELEASE)
+# else
+#  define MAPPINGS_COUNT() (mappings_count)
+#  define SET_MAPPINGS_COUNT(value) (mappings_count = (value))
+# endif
+
+/*
+ * Function : record_mapping
+ * -------------------------
+ * Add a mapping to the list of the mappings.
+ */
+static void     record_mapping(t_mapping *mapping)
+{
+    pthread_mutex_lock(&mappings_mutex);
+    mapping->next = mappings;
+    mappings = mapping;
+    SET_MAPPINGS_COUNT(mappings_count + 1);
+    pthread_mutex_unlock(&mappings_mutex);
+}
+#endif
+
+/*
+ * Function : unmap_array_data
+ * ---------------------------
+ * Unmap the data of an array if it was mapped in memory.
+ * Returns    :
+ *     True if the data was mapped in memory
+ */
+static bool     unmap_array_data(void *data)
+{
+#if !defined(_WIN32)
+    t_mapping   *found = NULL;
+
+    if (MAPPINGS_COUNT() == 0)
+        return (false);
+    pthread_mutex_lock(&mappings_mutex);
+    for (t_mapping **mapping = &mappings; *mapping != NULL; mapping = &(*mapping)->next)
+    {
+        if ((*mapping)->data == data)
+        {
+            found = *mapping;
+            *mapping = found->next;
+            SET_MAPPINGS_COUNT(mappings_count - 1);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mappings_mutex);
+    if (found == NULL)
+        return (false);
+    munmap(found->address, found->length);
+    free(found);
+    return (true);
+#else
+    (void)data;
+    return (false);
+#endif
+}
+
+void        free_data(void *data, int64_t size)
+{
+    if (unmap_array_data(data))
+        return;
+#ifdef PYCCEL_PROFILE
+    if (data != NULL)
+        pyc_profile_deallocation(size);
+#else
+    (void)size;
+#endif
+#if defined(_WIN32)
+    _aligned_free(data);
+#else
+    free(data);
+#endif
+}
+
+/*
+** parallelism
+**
+** When this file is compiled with OpenMP, the fill, copy and reduction
+** functions use several threads for the arrays of at least
+** PYCCEL_PARALLEL_THRESHOLD elements (environment variable, the default is
+** PARALLEL_THRESHOLD). The number of threads is PYCCEL_NUM_THREADS, or the
+** OpenMP default if it is not set. Nothing is parallelised inside an
+** existing parallel region.
+*/
+
+#define PARALLEL_THRESHOLD ((int64_t)1 << 18)
+
+#ifdef _OPENMP
+# define PARALLEL_FOR _Pragma("omp parallel for schedule(static) num_threads(n_threads)")
+#else
+# define PARALLEL_FOR
+#endif
+
+#ifdef _OPENMP
+static int64_t  parallel_threshold = PARALLEL_THRESHOLD;
+static int32_t  parallel_n_threads = 0;
+
+/* Read the environment variables once, before the settings are used by any thread */
+static void read_parallel_settings(void)
+{
+    const char  *env = getenv("PYCCEL_NUM_THREADS");
+    parallel_n_threads = env ? atoi(env) : 0;
+    env = getenv("PYCCEL_PARALLEL_THRESHOLD");
+    int64_t threshold = env ? strtoll(env, NULL, 10) : PARALLEL_THRESHOLD;
+    parallel_threshold = threshold < 0 ? PARALLEL_THRESHOLD : threshold;
+}
+
+# if !defined(_WIN32)
+static pthread_once_t   parallel_settings_once = PTHREAD_ONCE_INIT;
+# else
+static bool             parallel_settings_read = false;
+# endif
+#endif
+
+static int32_t  get_n_threads(int64_t size)
+{
+#ifdef _OPENMP
+# if !defined(_WIN32)
+    pthread_once(&parallel_settings_once, read_parallel_settings);
+# else
+    _Pragma("omp critical(pyc_parallel_settings)")
+    {
+        if (!parallel_settings_read)
+        {
+            read_parallel_settings();
+            parallel_settings_read = true;
+        }
+    }
+# endif
+    if (size < parallel_threshold || size < 2 || omp_in_parallel())
+        return (1);
+    int32_t n = parallel_n_threads > 0 ? parallel_n_threads : omp_get_max_threads();
+    return (n > size ? (int32_t)size : n);
+#else
+    (void)size;
+    return (1);
+#endif
+}
+
 /*
 ** allocation
 */
@@ -111,14 +495,14 @@ t_ndarray   array_create(int32_t nd, int64_t *shape,
     }
     arr.is_view = is_view;
     arr.length = 1;
-    arr.shape = malloc(arr.nd * sizeof(int64_t));
+    arr.shape = allocate_metadata(arr.nd);
+    arr.strides = arr.shape + arr.nd;
     for (int32_t i = 0; i < arr.nd; i++)
     {
         arr.length *= shape[i];
         arr.shape[i] = shape[i];
     }
     arr.buffer_size = arr.length * arr.type_size;
-    arr.strides = malloc(nd * sizeof(int64_t));
     if (arr.order == order_c)
     {
         for (int32_t i = 0; i < arr.nd; i++)
@@ -137,8 +521,12 @@ t_ndarray   array_create(int32_t nd, int64_t *shape,
                 arr.strides[i] *= arr.shape[j];
         }
     }
+    arr.device = NULL;
     if (!is_view)
-        arr.raw_data = malloc(arr.buffer_size);
+    {
+        arr.raw_data = allocate_data(arr.buffer_size);
+        array_device_init(&arr);
+    }
     return (arr);
 }
 
@@ -181,163 +569,712 @@ void    stack_array_init(t_ndarray *arr)
     for (int32_t i = 0; i < arr->nd; i++)
     {
         arr->strides[i] = 1;
-        for (int32_t j = i + 1; j < arr->nd; j++)
-            arr->strides[i] *= arr->shape[j];
+        if (arr->order == order_f)
+            for (int32_t j = 0; j < i; j++)
+                arr->strides[i] *= arr->shape[j];
+        else
+            for (int32_t j = i + 1; j < arr->nd; j++)
+                arr->strides[i] *= arr->shape[j];
     }
 }
 
-void   _array_fill_int8(int8_t c, t_ndarray arr)
+/*
+** The data of a stack array is stored in a buffer on the stack of the
+** function which declares it if it fits (the buffer is at most
+** NDARRAY_STACK_MAX_BYTES bytes), otherwise it is allocated on the heap.
+*/
+void    stack_array_create(t_ndarray *arr, int64_t buffer_size)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_int8[i] = c;
+    stack_array_init(arr);
+    if (arr->buffer_size > buffer_size)
+        arr->raw_data = allocate_data(arr->buffer_size);
+    array_device_init(arr);
 }
 
-void   _array_fill_int16(int16_t c, t_ndarray arr)
+void    stack_array_free(t_ndarray *arr, const void *buffer)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_int16[i] = c;
+    array_device_release(arr, false);
+    if (arr->raw_data != buffer)
+        free_data(arr->raw_data, arr->buffer_size);
+    arr->raw_data = NULL;
 }
 
-void   _array_fill_int32(int32_t c, t_ndarray arr)
-{
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_int32[i] = c;
-}
+/*
+** The buffer is split into one contiguous chunk per thread, so that with a
+** first-touch NUMA policy the pages of a new array are spread over the
+** nodes of the threads which will use them.
+*/
+#define ARRAY_FILL_(NAME, TYPE) \
+    static void fill_chunk_##NAME(TYPE c, t_ndarray arr, int64_t begin, int64_t end) \
+    { \
+        if (c == 0) \
+            memset((unsigned char*)arr.raw_data + begin * arr.type_size, 0, \
+                   (end - begin) * arr.type_size); \
+        else \
+            for (int64_t i = begin; i < end; i++) \
+                arr.nd_##NAME[i] = c; \
+    } \
+    void   _array_fill_##NAME(TYPE c, t_ndarray arr) \
+    { \
+        int32_t n_threads = get_n_threads(arr.length); \
+        if (n_threads == 1) \
+        { \
+            fill_chunk_##NAME(c, arr, 0, arr.length); \
+            return; \
+        } \
+        PARALLEL_FOR \
+        for (int32_t t = 0; t < n_threads; t++) \
+            fill_chunk_##NAME(c, arr, arr.length * t / n_threads, \
+                              arr.length * (t + 1) / n_threads); \
+    }
 
-void   _array_fill_int64(int64_t c, t_ndarray arr)
-{
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_int64[i] = c;
-}
+ARRAY_FILL_(int8, int8_t)
+ARRAY_FILL_(int16, int16_t)
+ARRAY_FILL_(int32, int32_t)
+ARRAY_FILL_(int64, int64_t)
+ARRAY_FILL_(bool, bool)
+ARRAY_FILL_(float, float)
+ARRAY_FILL_(double, double)
+ARRAY_FILL_(cfloat, float complex)
+ARRAY_FILL_(cdouble, double complex)
+
+/*
+** arrays stored in files
+**
+** The data of an array stored in a file is either read into memory or mapped
+** in memory, in which case the pages are only read from the file when they are
+** accessed (the mappings are released by free_data).
+**
+** The generated code assumes that the data of the arrays it creates is aligned
+** on NDARRAY_ALIGNMENT bytes, the data is read into memory instead of being
+** mapped if its offset in the file is not a multiple of NDARRAY_ALIGNMENT (the
+** data of the .npy files written by NumPy is aligned on 64 bytes).
+**
+** When the file cannot be used the error is recorded (see pyc_set_error) and
+** an array without data is returned (its shape is NULL so freeing it does
+** nothing).
+*/
 
-void   _array_fill_bool(bool c, t_ndarray arr)
+static void     file_error(t_error_kind kind, const char *filename, const char *message)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_bool[i] = c;
+    pyc_set_error(kind, "%s: %s", filename, message);
 }
 
-void   _array_fill_float(float c, t_ndarray arr)
+/*
+ * Function : npy_type_descr
+ * -------------------------
+ * Get the kind and the size of the elements of the given type as they are
+ * written in the 'descr' field of the header of a .npy file (e.g. "f8").
+ */
+static const char   *npy_type_descr(t_types type)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_float[i] = c;
+    switch (type)
+    {
+        case nd_bool:
+            return "b1";
+        case nd_int8:
+            return "i1";
+        case nd_int16:
+            return "i2";
+        case nd_int32:
+            return "i4";
+        case nd_int64:
+            return "i8";
+        case nd_float:
+            return "f4";
+        case nd_double:
+            return "f8";
+        case nd_cfloat:
+            return "c8";
+        case nd_cdouble:
+            return "c16";
+    }
+    return "";
 }
 
-void   _array_fill_double(double c, t_ndarray arr)
+/*
+ * Function : npy_header_value
+ * ---------------------------
+ * Find the value of a key of the dictionary stored in the header of a .npy
+ * file (e.g. {'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }).
+ * Returns    :
+ *     A pointer to the first character of the value, NULL if the key is
+ *     missing
+ */
+static const char   *npy_header_value(const char *header, const char *key, const char *filename)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_double[i] = c;
+    const char  *value = strstr(header, key);
+
+    if (value != NULL)
+        value = strchr(value + strlen(key), ':');
+    if (value == NULL)
+    {
+        file_error(error_value, filename, "invalid header of the .npy file");
+        return (NULL);
+    }
+    value++;
+    while (*value == ' ')
+        value++;
+    return (value);
 }
 
-void   _array_fill_cfloat(float complex c, t_ndarray arr)
+/*
+ * Function : parse_npy_header
+ * ---------------------------
+ * Check that the dictionary stored in the header of a .npy file describes an
+ * array of the expected type, rank and order. The shape of the array is saved
+ * in shape.
+ * Returns    :
+ *     True if the header matches the array
+ */
+static bool     parse_npy_header(const char *header, const char *filename, t_types type,
+                                 int32_t nd, t_order order, int64_t *shape)
 {
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_cfloat[i] = c;
-}
+    const uint16_t  one = 1;
+    const bool      little_endian = *(const unsigned char *)&one == 1;
 
+    const char  *descr = npy_header_value(header, "'descr'", filename);
+    if (descr == NULL)
+        return (false);
+    char        byte_order = descr[1];
+    size_t      descr_length = strlen(npy_type_descr(type));
+    if (descr[0] != '\'' || strncmp(descr + 2, npy_type_descr(type), descr_length) != 0
+            || descr[2 + descr_length] != '\'')
+    {
+        file_error(error_value, filename, "the type of the data in the file does not match the type of the array");
+        return (false);
+    }
+    if ((byte_order == '<' && !little_endian) || (byte_order == '>' && little_endian))
+    {
+        file_error(error_value, filename, "the byte order of the data in the file is not supported");
+        return (false);
+    }
 
-void   _array_fill_cdouble(double complex c, t_ndarray arr)
-{
-    if (c == 0)
-        memset(arr.raw_data, 0, arr.buffer_size);
-    else
-        for (int32_t i = 0; i < arr.length; i++)
-            arr.nd_cdouble[i] = c;
+    const char  *fortran_order = npy_header_value(header, "'fortran_order'", filename);
+    if (fortran_order == NULL)
+        return (false);
+    if (nd > 1 && (strncmp(fortran_order, "True", 4) == 0) != (order == order_f))
+    {
+        file_error(error_value, filename, "the order of the data in the file does not match the order of the array");
+        return (false);
+    }
+
+    const char  *dims = npy_header_value(header, "'shape'", filename);
+    int32_t     file_nd = 0;
+    if (dims == NULL)
+        return (false);
+    if (*dims != '(')
+    {
+        file_error(error_value, filename, "invalid header of the .npy file");
+        return (false);
+    }
+    dims++;
+    while (true)
+    {
+        char    *end;
+        int64_t dim = strtoll(dims, &end, 10);
+
+        if (end == dims)
+            break;
+        if (file_nd < nd)
+            shape[file_nd] = dim;
+        file_nd++;
+        dims = end;
+        while (*dims == ' ' || *dims == ',')
+            dims++;
+    }
+    if (file_nd != nd)
+    {
+        file_error(error_value, filename, "the rank of the array in the file does not match the rank of the array");
+        return (false);
+    }
+    return (true);
 }
 
 /*
-** deallocation
-*/
-
-int32_t free_array(t_ndarray* arr)
+ * Function : read_npy_header
+ * --------------------------
+ * Read the header of a .npy file (see numpy.lib.format) and check that it
+ * describes an array of the expected type, rank and order. The shape of the
+ * array is saved in shape.
+ * Returns    :
+ *     The offset of the data in the file, -1 if the header cannot be read or
+ *     does not match the array
+ */
+static int64_t  read_npy_header(const char *filename, t_types type, int32_t nd,
+                                t_order order, int64_t *shape)
 {
-    if (arr->shape == NULL)
-        return (0);
-    free(arr->raw_data);
-    arr->raw_data = NULL;
-    free(arr->shape);
-    arr->shape = NULL;
-    free(arr->strides);
-    arr->strides = NULL;
-    return (1);
-}
+    unsigned char   preamble[12];
+    int64_t         header_length = 0;
+    int64_t         offset = 0;
+    FILE            *file = fopen(filename, "rb");
 
+    if (file == NULL)
+    {
+        file_error(error_os, filename, strerror(errno));
+        return (-1);
+    }
+    if (fread(preamble, 1, 10, file) != 10 || memcmp(preamble, "\x93NUMPY", 6) != 0)
+    {
+        fclose(file);
+        file_error(error_value, filename, "not a .npy file");
+        return (-1);
+    }
+    if (preamble[6] == 1)
+    {
+        header_length = (int64_t)preamble[8] | (int64_t)preamble[9] << 8;
+        offset = 10;
+    }
+    else if ((preamble[6] == 2 || preamble[6] == 3) && fread(preamble + 10, 1, 2, file) == 2)
+    {
+        header_length = (int64_t)preamble[8] | (int64_t)preamble[9] << 8
+                      | (int64_t)preamble[10] << 16 | (int64_t)preamble[11] << 24;
+        offset = 12;
+    }
+    else
+    {
+        fclose(file);
+        file_error(error_value, filename, "unsupported version of the .npy format");
+        return (-1);
+    }
 
-int32_t free_pointer(t_ndarray* arr)
-{
-    if (arr->is_view == false || arr->shape == NULL)
-        return (0);
-    free(arr->shape);
-    arr->shape = NULL;
-    free(arr->strides);
-    arr->strides = NULL;
-    return (1);
+    char    *header = malloc(header_length + 1);
+    bool    valid = header != NULL && fread(header, 1, header_length, file) == (size_t)header_length;
+    fclose(file);
+    if (valid)
+    {
+        header[header_length] = '\0';
+        valid = parse_npy_header(header, filename, type, nd, order, shape);
+    }
+    else
+        file_error(error_value, filename, "invalid header of the .npy file");
+    free(header);
+    return (valid ? offset + header_length : -1);
 }
 
 /*
-** slices
-*/
-
-t_slice new_slice(int32_t start, int32_t end, int32_t step, t_slice_type type)
+ * Function : read_array_data
+ * --------------------------
+ * Allocate the data of an array and read it from a file.
+ * Returns    :
+ *     True if the data was read
+ */
+static bool     read_array_data(t_ndarray *arr, const char *filename, int64_t offset)
 {
-    t_slice slice;
+    FILE    *file = fopen(filename, "rb");
 
-    slice.start = start;
-    slice.end = end;
-    slice.step = step;
-    slice.type = type;
-    return (slice);
+    if (file == NULL)
+    {
+        file_error(error_os, filename, strerror(errno));
+        return (false);
+    }
+    arr->raw_data = allocate_data(arr->buffer_size);
+    bool    valid = arr->raw_data != NULL && fseek(file, (long)offset, SEEK_SET) == 0
+            && fread(arr->raw_data, 1, arr->buffer_size, file) == (size_t)arr->buffer_size;
+    fclose(file);
+    if (!valid)
+        file_error(error_value, filename, "the file is too small for the requested array");
+    return (valid);
 }
 
-t_ndarray array_slicing(t_ndarray arr, int n, ...)
+#if !defined(_WIN32)
+/*
+ * Function : map_array_data
+ * -------------------------
+ * Map the data of an array stored in a file in memory.
+ * Returns    :
+ *     True if the data was mapped
+ */
+static bool     map_array_data(t_ndarray *arr, const char *filename, t_file_mode mode, int64_t offset)
 {
-    t_ndarray view;
-    va_list  va;
-    t_slice slice;
-    int32_t start = 0;
-    int32_t j = 0;
-    t_order order = arr.order;
+    int flags = mode == file_map_rplus ? O_RDWR
+              : mode == file_map_wplus ? O_RDWR | O_CREAT | O_TRUNC
+              : O_RDONLY;
+    int fd = open(filename, flags, 0666);
 
-    view.nd = n;
-    view.type = arr.type;
-    view.type_size = arr.type_size;
-    view.shape = malloc(sizeof(int64_t) * view.nd);
-    view.strides = malloc(sizeof(int64_t) * view.nd);
-    view.order = order;
-    view.is_view = true;
-
-    va_start(va, n);
-    for (int32_t i = 0; i < arr.nd; i++)
+    if (fd < 0)
     {
-        slice = va_arg(va, t_slice);
-        if (slice.type == RANGE)
+        file_error(error_os, filename, strerror(errno));
+        return (false);
+    }
+    if (mode == file_map_wplus)
+    {
+        if (ftruncate(fd, (off_t)(offset + arr->buffer_size)) != 0)
         {
-            view.shape[j] = (slice.end - slice.start + (slice.step - 1)) / slice.step;
-            view.strides[j] = arr.strides[i] * slice.step;
-            j++;
+            file_error(error_os, filename, strerror(errno));
+            close(fd);
+            return (false);
+        }
+    }
+    else
+    {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0)
+        {
+            file_error(error_os, filename, strerror(errno));
+            close(fd);
+            return (false);
+        }
+        if (file_stat.st_size < offset + arr->buffer_size)
+        {
+            file_error(error_value, filename, "the file is too small for the requested array");
+            close(fd);
+            return (false);
+        }
+    }
+    if (arr->buffer_size == 0)
+    {
+        // An empty mapping cannot be created
+        close(fd);
+        arr->raw_data = allocate_data(0);
+        return (true);
+    }
+
+    int64_t     page_size = sysconf(_SC_PAGESIZE);
+    int64_t     start = offset - offset % page_size;
+    size_t      length = (size_t)(offset - start + arr->buffer_size);
+    int         protection = mode == file_map_r ? PROT_READ : PROT_READ | PROT_WRITE;
+    void        *address = mmap(NULL, length, protection,
+                                mode == file_map_c ? MAP_PRIVATE : MAP_SHARED, fd, (off_t)start);
+    if (address == MAP_FAILED)
+    {
+        file_error(error_os, filename, strerror(errno));
+        close(fd);
+        return (false);
+    }
+    close(fd);
+
+    t_mapping   *mapping = malloc(sizeof(t_mapping));
+    if (mapping == NULL)
+    {
+        int     malloc_errno = errno;
+        munmap(address, length);
+        file_error(error_os, filename, strerror(malloc_errno));
+        return (false);
+    }
+    mapping->data = (char *)address + (offset - start);
+    mapping->address = address;
+    mapping->length = length;
+    record_mapping(mapping);
+    arr->raw_data = mapping->data;
+    array_madvise(*arr, NDARRAY_FILE_ACCESS);
+    return (true);
+}
+#endif
+
+static t_ndarray    array_from_file(const char *filename, t_file_mode mode, int64_t offset,
+                                    int32_t nd, int64_t *shape, t_types type, t_order order)
+{
+    t_ndarray   arr = array_create(nd, shape, type, true, order);
+    bool        valid;
+
+    arr.is_view = false;
+    arr.raw_data = NULL;
+    if (offset < 0)
+    {
+        file_error(error_value, filename, "the offset of the data cannot be negative");
+        valid = false;
+    }
+#if !defined(_WIN32)
+    else if (mode != file_read && offset % NDARRAY_ALIGNMENT == 0)
+        valid = map_array_data(&arr, filename, mode, offset);
+#endif
+    else if (mode == file_map_rplus || mode == file_map_wplus)
+    {
+        file_error(error_value, filename, "the data cannot be mapped in memory for writing");
+        valid = false;
+    }
+    else
+        valid = read_array_data(&arr, filename, offset);
+    if (!valid)
+    {
+        free_array(&arr);
+        return (arr);
+    }
+    array_device_init(&arr);
+    return (arr);
+}
+
+t_ndarray   array_load_npy(const char *filename, t_file_mode mode, t_types type,
+        int32_t nd, t_order order)
+{
+    int64_t shape[MAX_NDIM];
+    int64_t offset = read_npy_header(filename, type, nd, order, shape);
+
+    if (offset < 0)
+        return ((t_ndarray){.shape = NULL, .strides = NULL, .nd = nd, .is_view = false});
+    return (array_from_file(filename, mode, offset, nd, shape, type, order));
+}
+
+t_ndarray   array_memmap(const char *filename, t_file_mode mode, int64_t offset,
+        int32_t nd, int64_t *shape, t_types type, t_order order)
+{
+    return (array_from_file(filename, mode, offset, nd, shape, type, order));
+}
+
+int32_t     array_madvise(t_ndarray arr, t_access_hint hint)
+{
+#if !defined(_WIN32)
+    int advice;
+    switch (hint)
+    {
+        case access_sequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case access_random:
+            advice = MADV_RANDOM;
+            break;
+        case access_willneed:
+            advice = MADV_WILLNEED;
+            break;
+        case access_dontneed:
+            advice = MADV_DONTNEED;
+            break;
+        default:
+            advice = MADV_NORMAL;
+            break;
+    }
+    if (arr.length == 0)
+        return (0);
+    // Find the memory spanned by the elements of the array (which may be a view)
+    int64_t first = 0;
+    int64_t last = 0;
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        int64_t extent = (arr.shape[i] - 1) * arr.strides[i];
+        if (extent < 0)
+            first += extent;
+        else
+            last += extent;
+    }
+    int64_t     page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t   begin = (uintptr_t)arr.raw_data + first * arr.type_size;
+    uintptr_t   end = (uintptr_t)arr.raw_data + (last + 1) * arr.type_size;
+    begin -= begin % page_size;
+    return (madvise((void *)begin, end - begin, advice));
+#else
+    (void)arr;
+    (void)hint;
+    return (0);
+#endif
+}
+
+/*
+** device copies (OpenACC)
+**
+** The data of an array is copied to the device when it is first used in a
+** compute region and stays there until the array is freed, so the arrays used
+** by successive compute regions (e.g. in a time loop) are not copied back and
+** forth. The flags of the copy record which side was modified since the last
+** update: a compute region only updates the device if the host data was
+** modified, and host code only updates the host if the device data was
+** modified. The metadata (struct, shape and strides) is small and is mapped
+** for each compute region. Without OpenACC these functions do nothing.
+*/
+
+#ifdef _OPENACC
+static t_device_data    *device_data_new(void *host_data, int64_t bytes, bool transient)
+{
+    t_device_data *device = malloc(sizeof(t_device_data));
+
+    device->host_data = host_data;
+    device->bytes = bytes;
+    device->device_data = NULL;
+    device->host_modified = true;
+    device->device_modified = false;
+    device->transient = transient;
+    return (device);
+}
+
+static void             device_data_free(t_device_data *device, bool keep_host)
+{
+    if (device->device_data != NULL)
+    {
+        if (keep_host && device->device_modified)
+            acc_update_self(device->host_data, device->bytes);
+        acc_delete(device->host_data, device->bytes);
+    }
+    free(device);
+}
+#endif
+
+void        array_device_init(t_ndarray *arr)
+{
+#ifdef _OPENACC
+    arr->device = device_data_new(arr->raw_data, arr->buffer_size, false);
+#else
+    arr->device = NULL;
+#endif
+}
+
+void        array_device_release(t_ndarray *arr, bool keep_host)
+{
+#ifdef _OPENACC
+    /* the views share the copy of the array which owns the data */
+    if (arr->device != NULL && !arr->is_view)
+        device_data_free(arr->device, keep_host);
+#else
+    (void)keep_host;
+#endif
+    arr->device = NULL;
+}
+
+void        array_device_map(t_ndarray *arr)
+{
+#ifdef _OPENACC
+    t_device_data *device = arr->device;
+
+    if (device == NULL)
+    {
+        /* view of data which is not owned by an array (e.g. a NumPy array):
+        ** the elements it can access are copied for this compute region */
+        int64_t first = 0;
+        int64_t last = 0;
+
+        for (int32_t i = 0; i < arr->nd; i++)
+        {
+            int64_t extent = (arr->shape[i] - 1) * arr->strides[i];
+
+            if (extent < 0)
+                first += extent;
+            else
+                last += extent;
+        }
+        device = device_data_new((unsigned char*)arr->raw_data + first * arr->type_size,
+                (last - first + (arr->length > 0)) * arr->type_size, true);
+        arr->device = device;
+    }
+    if (device->device_data == NULL)
+        device->device_data = acc_create(device->host_data, device->bytes);
+    if (device->host_modified)
+    {
+        acc_update_device(device->host_data, device->bytes);
+        device->host_modified = false;
+    }
+    acc_copyin(arr, sizeof(t_ndarray));
+    acc_copyin(arr->shape, 2 * arr->nd * sizeof(int64_t));
+    acc_attach(&arr->raw_data);
+    acc_attach((void **)&arr->shape);
+    acc_attach((void **)&arr->strides);
+#else
+    (void)arr;
+#endif
+}
+
+void        array_device_unmap(t_ndarray *arr, bool modified)
+{
+#ifdef _OPENACC
+    acc_detach(&arr->raw_data);
+    acc_detach((void **)&arr->shape);
+    acc_detach((void **)&arr->strides);
+    acc_delete(arr->shape, 2 * arr->nd * sizeof(int64_t));
+    acc_delete(arr, sizeof(t_ndarray));
+    arr->device->device_modified |= modified;
+    if (arr->device->transient)
+    {
+        device_data_free(arr->device, true);
+        arr->device = NULL;
+    }
+#else
+    (void)arr;
+    (void)modified;
+#endif
+}
+
+void        array_host_sync(t_ndarray arr)
+{
+#ifdef _OPENACC
+    if (arr.device != NULL && arr.device->device_modified)
+    {
+        acc_update_self(arr.device->host_data, arr.device->bytes);
+        arr.device->device_modified = false;
+    }
+#else
+    (void)arr;
+#endif
+}
+
+void        array_host_modified(t_ndarray arr)
+{
+#ifdef _OPENACC
+    if (arr.device != NULL)
+        arr.device->host_modified = true;
+#else
+    (void)arr;
+#endif
+}
+
+/*
+** deallocation
+*/
+
+int32_t free_array(t_ndarray* arr)
+{
+    if (arr->shape == NULL)
+        return (0);
+    array_device_release(arr, false);
+    free_data(arr->raw_data, arr->buffer_size);
+    arr->raw_data = NULL;
+    free_metadata(arr->shape, arr->nd);
+    arr->shape = NULL;
+    arr->strides = NULL;
+    return (1);
+}
+
+
+int32_t free_pointer(t_ndarray* arr)
+{
+    if (arr->is_view == false || arr->shape == NULL)
+        return (0);
+    array_device_release(arr, false);
+    free_metadata(arr->shape, arr->nd);
+    arr->shape = NULL;
+    arr->strides = NULL;
+    return (1);
+}
+
+/*
+** slices
+*/
+
+t_slice new_slice(int64_t start, int64_t end, int64_t step, t_slice_type type)
+{
+    t_slice slice;
+
+    slice.start = start;
+    slice.end = end;
+    slice.step = step;
+    slice.type = type;
+    return (slice);
+}
+
+t_ndarray array_slicing(t_ndarray arr, int n, ...)
+{
+    t_ndarray view;
+    va_list  va;
+    t_slice slice;
+    int64_t start = 0;
+    int32_t j = 0;
+    t_order order = arr.order;
+
+    view.nd = n;
+    view.type = arr.type;
+    view.type_size = arr.type_size;
+    view.shape = allocate_metadata(view.nd);
+    view.strides = view.shape + view.nd;
+    view.order = order;
+    view.is_view = true;
+    view.device = arr.device;
+
+    va_start(va, n);
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        slice = va_arg(va, t_slice);
+        if (slice.type == RANGE)
+        {
+            view.shape[j] = (slice.end - slice.start + (slice.step - 1)) / slice.step;
+            view.strides[j] = arr.strides[i] * slice.step;
+            j++;
         }
         start += slice.start * arr.strides[i];
     }
@@ -365,9 +1302,9 @@ void        alias_assign(t_ndarray *dest, t_ndarray src)
     */
 
     *dest = src;
-    dest->shape = malloc(sizeof(int64_t) * src.nd);
+    dest->shape = allocate_metadata(src.nd);
+    dest->strides = dest->shape + src.nd;
     memcpy(dest->shape, src.shape, sizeof(int64_t) * src.nd);
-    dest->strides = malloc(sizeof(int64_t) * src.nd);
     memcpy(dest->strides, src.strides, sizeof(int64_t) * src.nd);
     dest->is_view = true;
 }
@@ -381,8 +1318,8 @@ void        transpose_alias_assign(t_ndarray *dest, t_ndarray src)
     */
 
     *dest = src;
-    dest->shape = malloc(sizeof(int64_t) * src.nd);
-    dest->strides = malloc(sizeof(int64_t) * src.nd);
+    dest->shape = allocate_metadata(src.nd);
+    dest->strides = dest->shape + src.nd;
     for (int32_t i = 0; i < src.nd; i++)
     {
         dest->shape[i] = src.shape[src.nd-1-i];
@@ -398,7 +1335,7 @@ void        transpose_alias_assign(t_ndarray *dest, t_ndarray src)
 int64_t     get_index(t_ndarray arr, ...)
 {
     va_list va;
-    int32_t index;
+    int64_t index;
 
     va_start(va, arr);
     index = 0;
@@ -440,44 +1377,6 @@ int64_t     *numpy_to_ndarray_shape(int64_t *np_shape, int32_t nd)
     return nd_shape;
 }
 
-/**
-** takes an array containing the shape of an array 'shape', number of a 
-** certain dimension 'nd', and the number of the array's dimensions
-** returns the stride (number of single elements to jump in a dimension
-** to get to this dimension's next element) of the 'nd`th dimension
-*/
-int64_t get_dimension_stride(int64_t *shape, int32_t nd, int32_t max_nd)
-{
-    int64_t product = 1;
-
-    for (int i = nd; i < max_nd; ++i)
-        product *= shape[i];
-    return (product);
-}
-
-/**
-**  arr : Takes an array needed to do the calculations
-**  flat_c_idx : An element number, representing an element's index if it were
-**              in a flattened (order_c/row major) array
-**  nd : representing the number of dimensions
-**
-**  Returns the element's index depending on its required memory layout
-**          (order_f/column major or order_c/row major)
-*/
-int64_t element_index(t_ndarray arr, int64_t flat_c_idx, int32_t nd)
-{
-    if (arr.order == order_c && !arr.is_view)
-        return flat_c_idx;
-    if (nd == 0)
-        return (0);
-    if (nd == arr.nd)
-        return (flat_c_idx % arr.shape[nd - 1]) * arr.strides[nd - 1] + element_index(arr, flat_c_idx, nd - 1);
-    int64_t true_index = (flat_c_idx / get_dimension_stride(arr.shape, nd, arr.nd));
-    if (true_index >= arr.shape[nd - 1])
-        true_index = true_index % arr.shape[nd - 1];
-    return (true_index * arr.strides[nd - 1] + element_index(arr, flat_c_idx, nd - 1));
-}
-
 bool is_same_shape(t_ndarray a, t_ndarray b)
 {
     if (a.nd != b.nd)
@@ -490,333 +1389,1050 @@ bool is_same_shape(t_ndarray a, t_ndarray b)
     return (true);
 }
 
-#define COPY_DATA_FROM_(SRC_TYPE) \
-    void copy_data_from_##SRC_TYPE(t_ndarray **ds, t_ndarray src, uint32_t offset, bool elem_wise_cp) \
-    { \
-        t_ndarray *dest = *ds; \
-        switch(dest->type) \
-        { \
-            case nd_bool: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_bool[i + offset] = (bool)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_bool[element_index(*dest, i, dest->nd) + offset] = (bool)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_int8: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int8[i + offset] = (int8_t)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int8[element_index(*dest, i, dest->nd) + offset] = (int8_t)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_int16: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int16[i + offset] = (int16_t)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int16[element_index(*dest, i, dest->nd) + offset] = (int16_t)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_int32: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int32[i + offset] = (int32_t)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int32[element_index(*dest, i, dest->nd) + offset] = (int32_t)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_int64: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int64[i + offset] = (int64_t)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_int64[element_index(*dest, i, dest->nd) + offset] = (int64_t)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_float: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_float[i + offset] = (float)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_float[element_index(*dest, i, dest->nd) + offset] = (float)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_double: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_double[i + offset] = (double)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_double[element_index(*dest, i, dest->nd) + offset] = (double)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_cfloat: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_cfloat[i + offset] = (float complex)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_cfloat[element_index(*dest, i, dest->nd) + offset] = (float complex)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-            case nd_cdouble: \
-                if(elem_wise_cp == false)\
-                { \
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_cdouble[i + offset] = (double complex)src.nd_##SRC_TYPE[i]; \
-                }\
-                else \
-                {\
-                    for(int64_t i = 0; i < src.length; i++) \
-                        dest->nd_cdouble[element_index(*dest, i, dest->nd) + offset] = (double complex)src.nd_##SRC_TYPE[element_index(src, i, src.nd)]; \
-                }\
-                break; \
-        } \
+/*
+** returns true if the strides of arr are the strides of a contiguous array
+** with the given order (the dimensions of length 1 are ignored)
+*/
+static bool     has_layout(t_ndarray arr, t_order order)
+{
+    int64_t expected = 1;
+
+    for (int32_t k = 0; k < arr.nd; k++)
+    {
+        int32_t i = order == order_c ? arr.nd - 1 - k : k;
+        if (arr.shape[i] != 1 && arr.strides[i] != expected)
+            return (false);
+        expected *= arr.shape[i];
     }
+    return (true);
+}
+
+/*
+** copies
+**
+** A copy is split into one-dimensional lines which are copied (and cast) by
+** a copy_line function chosen from the source and destination types.
+** - Arrays with the same type and the same memory layout are copied with
+**   a single memcpy.
+** - When the source and the destination are contiguous along the same
+**   dimension, the lines follow that dimension and an odometer moves from
+**   one line to the next over the other dimensions.
+** - Otherwise (e.g. order_c to order_f) the two fastest dimensions are
+**   copied by square tiles of COPY_BLOCK x COPY_BLOCK elements so that both
+**   the reads and the writes stay in cache.
+*/
 
-COPY_DATA_FROM_(bool)
-COPY_DATA_FROM_(int8)
-COPY_DATA_FROM_(int16)
-COPY_DATA_FROM_(int32)
-COPY_DATA_FROM_(int64)
-COPY_DATA_FROM_(float)
-COPY_DATA_FROM_(double)
-COPY_DATA_FROM_(cfloat)
-COPY_DATA_FROM_(cdouble)
+#define COPY_BLOCK 32
 
-void copy_data(t_ndarray **ds, t_ndarray src, uint32_t offset, bool elem_wise_cp)
+typedef void (*t_copy_line)(unsigned char *dest, int64_t dest_stride,
+                            const unsigned char *src, int64_t src_stride, int64_t n);
+
+#define COPY_LINE_(SRC, SRC_TYPE, DEST, DEST_TYPE) \
+    static void copy_line_##SRC##_to_##DEST(unsigned char *dest, int64_t dest_stride, \
+                                const unsigned char *src, int64_t src_stride, int64_t n) \
+    { \
+        DEST_TYPE *d = (DEST_TYPE*)dest; \
+        const SRC_TYPE *s = (const SRC_TYPE*)src; \
+        if (dest_stride == 1 && src_stride == 1) \
+            for (int64_t i = 0; i < n; i++) \
+                d[i] = (DEST_TYPE)s[i]; \
+        else \
+            for (int64_t i = 0; i < n; i++) \
+                d[i * dest_stride] = (DEST_TYPE)s[i * src_stride]; \
+    }
+
+#define COPY_LINES_FROM_(SRC, SRC_TYPE) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_bool, bool) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_int8, int8_t) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_int16, int16_t) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_int32, int32_t) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_int64, int64_t) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_float, float) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_double, double) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_cfloat, float complex) \
+    COPY_LINE_(SRC, SRC_TYPE, nd_cdouble, double complex)
+
+COPY_LINES_FROM_(nd_bool, bool)
+COPY_LINES_FROM_(nd_int8, int8_t)
+COPY_LINES_FROM_(nd_int16, int16_t)
+COPY_LINES_FROM_(nd_int32, int32_t)
+COPY_LINES_FROM_(nd_int64, int64_t)
+COPY_LINES_FROM_(nd_float, float)
+COPY_LINES_FROM_(nd_double, double)
+COPY_LINES_FROM_(nd_cfloat, float complex)
+COPY_LINES_FROM_(nd_cdouble, double complex)
+
+#define COPY_LINES_TO_(DEST) \
+    {copy_line_nd_bool_to_##DEST, copy_line_nd_int8_to_##DEST, copy_line_nd_int16_to_##DEST, \
+     copy_line_nd_int32_to_##DEST, copy_line_nd_int64_to_##DEST, copy_line_nd_float_to_##DEST, \
+     copy_line_nd_double_to_##DEST, copy_line_nd_cfloat_to_##DEST, copy_line_nd_cdouble_to_##DEST}
+
+/* copy_lines[dest][src] in the order of type_index */
+static const t_copy_line copy_lines[9][9] = {
+    COPY_LINES_TO_(nd_bool),
+    COPY_LINES_TO_(nd_int8),
+    COPY_LINES_TO_(nd_int16),
+    COPY_LINES_TO_(nd_int32),
+    COPY_LINES_TO_(nd_int64),
+    COPY_LINES_TO_(nd_float),
+    COPY_LINES_TO_(nd_double),
+    COPY_LINES_TO_(nd_cfloat),
+    COPY_LINES_TO_(nd_cdouble)
+};
+
+static int32_t  type_index(t_types type)
 {
-    switch(src.type)
+    switch (type)
     {
         case nd_bool:
-            copy_data_from_bool(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (0);
         case nd_int8:
-            copy_data_from_int8(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (1);
         case nd_int16:
-            copy_data_from_int16(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (2);
         case nd_int32:
-            copy_data_from_int32(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (3);
         case nd_int64:
-            copy_data_from_int64(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (4);
         case nd_float:
-            copy_data_from_float(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (5);
         case nd_double:
-            copy_data_from_double(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (6);
         case nd_cfloat:
-            copy_data_from_cfloat(ds, src, offset, elem_wise_cp);
-            break;
-
+            return (7);
         case nd_cdouble:
-            copy_data_from_cdouble(ds, src, offset, elem_wise_cp);
-            break;
+            return (8);
     }
+    return (0);
 }
 
-void array_copy_data(t_ndarray *dest, t_ndarray src, uint32_t offset)
+/* the dimension with the smallest stride (ignoring dimensions of length 1) */
+static int32_t  fastest_dimension(int32_t nd, int64_t *shape, int64_t *strides)
 {
-    unsigned char *d = (unsigned char*)dest->raw_data;
-    unsigned char *s = (unsigned char*)src.raw_data;
+    int32_t fastest = -1;
 
-    if (!src.is_view && dest->order == src.order
-        && (src.order == order_c
-            || (src.order == order_f && is_same_shape(*dest, src))))
+    for (int32_t i = 0; i < nd; i++)
     {
-        copy_data(&dest, src, offset, false);
+        if (shape[i] != 1 && (fastest == -1
+                || llabs(strides[i]) < llabs(strides[fastest])))
+            fastest = i;
     }
-    else
+    return (fastest);
+}
+
+/*
+** A copy of nd dimensions is a sequence of items: one line when the two
+** arrays share their fastest dimension a, otherwise one band of COPY_BLOCK
+** lines of the fastest dimension b of dest. The outer dimensions are visited
+** with an odometer. The strides are expressed in bytes.
+*/
+typedef struct  s_copy
+{
+    t_copy_line         copy_line;
+    int32_t             a;
+    int32_t             b;
+    int32_t             n_outer;
+    int64_t             shape[MAX_NDIM];
+    int64_t             dest_strides[MAX_NDIM];
+    int64_t             src_strides[MAX_NDIM];
+    int64_t             dest_line_stride;
+    int64_t             src_line_stride;
+    int64_t             n_bands;
+    int64_t             n_items;
+    unsigned char       *dest;
+    const unsigned char *src;
+}               t_copy;
+
+/* copies the items [begin, end) */
+static void     copy_items(const t_copy *copy, int64_t begin, int64_t end)
+{
+    int32_t a = copy->a;
+    int32_t b = copy->b;
+    const int64_t *shape = copy->shape;
+    int64_t indices[MAX_NDIM];
+    int64_t it = begin / copy->n_bands;
+    unsigned char *dest = copy->dest;
+    const unsigned char *src = copy->src;
+
+    /* position of the odometer for the first item */
+    for (int32_t j = 0; j < copy->n_outer; j++)
+    {
+        indices[j] = it % shape[j];
+        it /= shape[j];
+        dest += indices[j] * copy->dest_strides[j];
+        src += indices[j] * copy->src_strides[j];
+    }
+    for (int64_t item = begin; item < end; item++)
     {
-        copy_data(&dest, src, offset, true);
+        int64_t band = item % copy->n_bands;
+        if (a == b)
+            copy->copy_line(dest, copy->dest_line_stride, src, copy->src_line_stride, shape[a]);
+        else
+        {
+            int64_t ib = band * COPY_BLOCK;
+            int64_t end_b = ib + COPY_BLOCK < shape[b] ? ib + COPY_BLOCK : shape[b];
+            for (int64_t ia = 0; ia < shape[a]; ia += COPY_BLOCK)
+            {
+                int64_t len = ia + COPY_BLOCK < shape[a] ? COPY_BLOCK : shape[a] - ia;
+                for (int64_t jb = ib; jb < end_b; jb++)
+                    copy->copy_line(dest + jb * copy->dest_strides[b] + ia * copy->dest_strides[a],
+                                    copy->dest_line_stride,
+                                    src + jb * copy->src_strides[b] + ia * copy->src_strides[a],
+                                    copy->src_line_stride, len);
+            }
+        }
+        if (band != copy->n_bands - 1)
+            continue;
+        /* odometer over the outer dimensions */
+        for (int32_t j = 0; j < copy->n_outer; j++)
+        {
+            dest += copy->dest_strides[j];
+            src += copy->src_strides[j];
+            if (++indices[j] < shape[j])
+                break;
+            dest -= shape[j] * copy->dest_strides[j];
+            src -= shape[j] * copy->src_strides[j];
+            indices[j] = 0;
+        }
     }
 }
 
 /*
-** sum of ndarray
+** copies the elements of an array of the given shape, the strides are
+** expressed in elements
 */
+static void     copy_nd(t_copy_line copy_line, int32_t nd, int64_t *shape,
+                        unsigned char *dest, int64_t *dest_strides, int32_t dest_size,
+                        const unsigned char *src, int64_t *src_strides, int32_t src_size)
+{
+    t_copy  copy;
+    int64_t length = 1;
 
-static int64_t     get_index_from_array(t_ndarray arr, int64_t *nd_indices)
+    copy.a = fastest_dimension(nd, shape, src_strides);
+    copy.b = fastest_dimension(nd, shape, dest_strides);
+    if (copy.a == -1)
+    {
+        copy_line(dest, 1, src, 1, 1);
+        return;
+    }
+    copy.copy_line = copy_line;
+    copy.dest = dest;
+    copy.src = src;
+    copy.n_outer = 0;
+    copy.n_items = 1;
+    for (int32_t i = 0; i < nd; i++)
+    {
+        length *= shape[i];
+        if (i != copy.a && i != copy.b && shape[i] != 1)
+        {
+            copy.shape[copy.n_outer] = shape[i];
+            copy.dest_strides[copy.n_outer] = dest_strides[i] * dest_size;
+            copy.src_strides[copy.n_outer++] = src_strides[i] * src_size;
+            copy.n_items *= shape[i];
+        }
+    }
+    /* the fastest dimensions are stored after the outer ones */
+    int32_t a = copy.n_outer;
+    int32_t b = copy.a == copy.b ? a : a + 1;
+    copy.shape[a] = shape[copy.a];
+    copy.dest_strides[a] = dest_strides[copy.a] * dest_size;
+    copy.src_strides[a] = src_strides[copy.a] * src_size;
+    copy.shape[b] = shape[copy.b];
+    copy.dest_strides[b] = dest_strides[copy.b] * dest_size;
+    copy.src_strides[b] = src_strides[copy.b] * src_size;
+    copy.dest_line_stride = dest_strides[copy.a];
+    copy.src_line_stride = src_strides[copy.a];
+    copy.a = a;
+    copy.b = b;
+    copy.n_bands = a == b ? 1 : (copy.shape[b] + COPY_BLOCK - 1) / COPY_BLOCK;
+    copy.n_items *= copy.n_bands;
+
+    int32_t n_threads = get_n_threads(length);
+    if (n_threads > copy.n_items)
+        n_threads = (int32_t)copy.n_items;
+    if (n_threads <= 1)
+    {
+        copy_items(&copy, 0, copy.n_items);
+        return;
+    }
+    PARALLEL_FOR
+    for (int32_t t = 0; t < n_threads; t++)
+        copy_items(&copy, copy.n_items * t / n_threads, copy.n_items * (t + 1) / n_threads);
+}
+
+/*
+** copies size bytes, in one chunk per thread for the large arrays
+*/
+static void     copy_bytes(unsigned char *dest, const unsigned char *src,
+                           int64_t size, int64_t length)
 {
-    /*
-    ** returns the one dimentional index equivalent to
-    ** the indices in each dimension stored in nd_indices
-    */
-    int64_t idx = 0;
-    for (int64_t dim = 0; dim<arr.nd; ++dim)
+    int32_t n_threads = get_n_threads(length);
+
+    if (n_threads == 1)
+    {
+        memcpy(dest, src, size);
+        return;
+    }
+    PARALLEL_FOR
+    for (int32_t t = 0; t < n_threads; t++)
     {
-        idx += arr.strides[dim] * (nd_indices[dim]);
+        int64_t begin = size * t / n_threads;
+        int64_t end = size * (t + 1) / n_threads;
+        memcpy(dest + begin, src + begin, end - begin);
     }
-    return idx;
 }
 
 /*
-** Calculate the sum of a numpy array of bools by
-** looping over the length of the array and computing
-** the n-dimensional indices of each element
+** The elements of src are copied in order_c order into the elements of dest,
+** also in order_c order, starting from the element offset of dest. The shapes
+** only need to match when dest is not contiguous in order_c, otherwise src
+** can be copied into a part of dest (e.g. to concatenate arrays).
+*/
+void array_copy_data(t_ndarray *dest, t_ndarray src, int64_t offset)
+{
+    t_copy_line     copy_line = copy_lines[type_index(dest->type)][type_index(src.type)];
+    unsigned char   *d = (unsigned char*)dest->raw_data + offset * dest->type_size;
+    bool            same_shape = is_same_shape(*dest, src);
+    bool            dest_c = has_layout(*dest, order_c);
+
+    if (src.length == 0)
+        return;
+    if (dest->type == src.type
+        && ((dest_c && has_layout(src, order_c))
+            || (same_shape && has_layout(*dest, order_f) && has_layout(src, order_f))))
+    {
+        copy_bytes(d, src.raw_data, src.buffer_size, src.length);
+    }
+    else if (same_shape)
+    {
+        copy_nd(copy_line, src.nd, src.shape, d, dest->strides, dest->type_size,
+                src.raw_data, src.strides, src.type_size);
+    }
+    else if (dest_c)
+    {
+        /* the destination is seen as a contiguous array with the shape of src */
+        int64_t c_strides[MAX_NDIM];
+        int64_t stride = 1;
+        for (int32_t i = src.nd - 1; i >= 0; i--)
+        {
+            c_strides[i] = stride;
+            stride *= src.shape[i];
+        }
+        copy_nd(copy_line, src.nd, src.shape, d, c_strides, dest->type_size,
+                src.raw_data, src.strides, src.type_size);
+    }
+    else
+    {
+        /* element by element, with an odometer over each array */
+        int64_t src_indices[MAX_NDIM] = {0};
+        int64_t dest_indices[MAX_NDIM] = {0};
+        const unsigned char *s = src.raw_data;
+        for (int64_t n = 0; n < src.length; n++)
+        {
+            copy_line(d, 1, s, 1, 1);
+            for (int32_t i = src.nd - 1; i >= 0; i--)
+            {
+                s += src.strides[i] * src.type_size;
+                if (++src_indices[i] < src.shape[i])
+                    break;
+                s -= src.shape[i] * src.strides[i] * src.type_size;
+                src_indices[i] = 0;
+            }
+            for (int32_t i = dest->nd - 1; i >= 0; i--)
+            {
+                d += dest->strides[i] * dest->type_size;
+                if (++dest_indices[i] < dest->shape[i])
+                    break;
+                d -= dest->shape[i] * dest->strides[i] * dest->type_size;
+                dest_indices[i] = 0;
+            }
+        }
+    }
+}
+
+/*
+** reductions
+*/
+
+/*
+** The reductions see an array as a set of one-dimensional runs of
+** `run_length` elements separated by `run_stride`. The offset of the first
+** element of the current run is `start`, it is moved from one run to the
+** next with an odometer over the `nd` remaining (outer) dimensions.
+** Contiguous arrays are a single run with a unit stride and views keep the
+** dimension with the smallest stride as their run, so the inner loops never
+** compute an nd-dimensional index.
 **
 ** Example:
-**      For a two dimentional array of shape (2, 3),
-**  nd_indices is initialized to be [0, 0],
-**  the main loop will run for 6 iterations
-**  each iteration increments nd_indices[0] by 1, then
-**  a carry is performed when nd_indices[i] is equal to shape[i]
-**  iteration 0:
-**      nd_indices = [0, 0] -> no carry
-**  iteration 1:
-**      nd_indices = [1, 0] -> no carry
-**  iteration 2:
-**      nd_indices = [2, 0] -> nd_indices[0] == shape[0]
-**                          -> carry -> [0, 1]
-**  iteration 3:
-**      nd_indices = [1, 1] -> no carry
-**  iteration 4:
-**      nd_indices = [2, 1] -> nd_indices[0] == shape[0]
-**                          -> carry -> [0, 2]
-**  iteration 5:
-**      nd_indices = [1, 2] -> no carry
-*/
-#define NUMPY_SUM_(NAME, TYPE, CTYPE) \
-    TYPE numpy_sum_##NAME(t_ndarray arr) \
+**      For a view of shape (2, 3) and strides (12, 2) (e.g. a[::2, ::2] with
+**  a of shape (4, 6)) the run is the second dimension, of length 3 and
+**  stride 2, and the odometer loops over the first dimension:
+**  run 0: start = 0  -> elements 0, 2, 4
+**  run 1: start = 12 -> elements 12, 14, 16
+*/
+typedef struct  s_nd_runs
+{
+    int32_t     nd;
+    int64_t     shape[MAX_NDIM];
+    int64_t     strides[MAX_NDIM];
+    int64_t     indices[MAX_NDIM];
+    int64_t     n_runs;
+    int64_t     run_length;
+    int64_t     run_stride;
+    int64_t     start;
+}               t_nd_runs;
+
+/*
+** returns true if the elements of arr fill a contiguous block of memory
+** (in either order_c or order_f), whether or not arr is a view
+*/
+static bool     is_contiguous(t_ndarray arr)
+{
+    return (has_layout(arr, order_c) || has_layout(arr, order_f));
+}
+
+static t_nd_runs    get_nd_runs(t_ndarray arr)
+{
+    t_nd_runs   runs;
+    int32_t     inner = -1;
+    bool        used[MAX_NDIM] = {false};
+
+    runs.nd = 0;
+    runs.start = 0;
+    runs.run_length = arr.length;
+    runs.run_stride = 1;
+    runs.n_runs = arr.length == 0 ? 0 : 1;
+    if (arr.length == 0 || is_contiguous(arr))
+        return (runs);
+
+    /* the run follows the dimension with the smallest stride */
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        if (arr.shape[i] == 1)
+            used[i] = true;
+        else if (inner == -1 || llabs(arr.strides[i]) < llabs(arr.strides[inner]))
+            inner = i;
+    }
+    used[inner] = true;
+    runs.run_length = arr.shape[inner];
+    runs.run_stride = arr.strides[inner];
+
+    /* merge the dimensions which extend the run, e.g. a[:, ::2] */
+    for (bool merged = true; merged;)
+    {
+        merged = false;
+        for (int32_t i = 0; i < arr.nd; i++)
+        {
+            if (!used[i] && arr.strides[i] == runs.run_stride * runs.run_length)
+            {
+                runs.run_length *= arr.shape[i];
+                used[i] = true;
+                merged = true;
+            }
+        }
+    }
+
+    /* the outer dimensions are visited from the fastest to the slowest */
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        int32_t next = -1;
+        for (int32_t j = 0; j < arr.nd; j++)
+            if (!used[j] && (next == -1 || llabs(arr.strides[j]) < llabs(arr.strides[next])))
+                next = j;
+        if (next == -1)
+            break;
+        used[next] = true;
+        runs.shape[runs.nd] = arr.shape[next];
+        runs.strides[runs.nd] = arr.strides[next];
+        runs.indices[runs.nd] = 0;
+        runs.nd++;
+    }
+    runs.n_runs = arr.length / runs.run_length;
+    return (runs);
+}
+
+/*
+** move runs->start to the first element of the next run
+*/
+static inline void  next_run(t_nd_runs *runs)
+{
+    for (int32_t j = 0; j < runs->nd; j++)
+    {
+        runs->indices[j]++;
+        runs->start += runs->strides[j];
+        if (runs->indices[j] < runs->shape[j])
+            return;
+        runs->start -= runs->strides[j] * runs->indices[j];
+        runs->indices[j] = 0;
+    }
+}
+
+/*
+** move runs to the run containing the element `element` (counted in the
+** order of the runs) and return the position of the element in its run
+*/
+static int64_t  seek_element(t_nd_runs *runs, int64_t element)
+{
+    int64_t r = element / runs->run_length;
+
+    runs->start = 0;
+    for (int32_t j = 0; j < runs->nd; j++)
+    {
+        runs->indices[j] = r % runs->shape[j];
+        runs->start += runs->indices[j] * runs->strides[j];
+        r /= runs->shape[j];
+    }
+    return (element % runs->run_length);
+}
+
+/*
+** The reductions are split into tasks of about PARALLEL_CHUNK elements:
+** pieces of the run for the arrays made of a single run (the pieces are a
+** multiple of 8 elements for the pairwise summation), groups of whole runs
+** otherwise. The tasks only depend on the shape of the array and their
+** partial results are combined in order, so the result does not depend on
+** the number of threads, or on whether OpenMP is used at all.
+*/
+#define PARALLEL_CHUNK ((int64_t)1 << 16)
+
+static int64_t  get_task_size(t_nd_runs runs)
+{
+    if (runs.n_runs <= 1 || runs.run_length >= PARALLEL_CHUNK)
+        return (runs.n_runs <= 1 ? PARALLEL_CHUNK : runs.run_length);
+    return (PARALLEL_CHUNK / runs.run_length * runs.run_length);
+}
+
+/*
+** Updates OUTPUT = PROCESS(OUTPUT, data, n, stride) with the pieces of the
+** runs of the array DATA holding the elements [BEGIN, END) of the runs (RUNS is modified).
+*/
+#define FOR_EACH_PIECE_(DATA, RUNS, BEGIN, END, OUTPUT, PROCESS) \
     { \
-        int64_t nd_indices[arr.nd]; \
-        memset(nd_indices, 0, sizeof(int64_t) * arr.nd); \
-        TYPE output = 0; \
-        for (int32_t i = 0; i < arr.length; i++) \
+        int64_t element_ = (BEGIN); \
+        int64_t pos_ = seek_element(&(RUNS), element_); \
+        while (element_ < (END)) \
         { \
-            output += arr.nd_##CTYPE[get_index_from_array(arr, nd_indices)]; \
-            nd_indices[0]++; \
-            for (int32_t j = 0; j < arr.nd - 1; j++) \
-                if (nd_indices[j] == arr.shape[j]) \
-                { \
-                    nd_indices[j] = 0; \
-                    nd_indices[j + 1]++; \
-                } \
+            int64_t n_ = (RUNS).run_length - pos_; \
+            if (n_ > (END) - element_) \
+                n_ = (END) - element_; \
+            OUTPUT = PROCESS(OUTPUT, (DATA) + (RUNS).start + pos_ * (RUNS).run_stride, \
+                             n_, (RUNS).run_stride); \
+            element_ += n_; \
+            pos_ = 0; \
+            next_run(&(RUNS)); \
         } \
+    }
+
+/*
+** Computes the partial results of the tasks with TASK(arr, runs, begin, end)
+** then combines them in order with COMBINE(partials, n_tasks). The array is
+** reduced in a single task if the partial results cannot be allocated.
+*/
+#define REDUCE_TASKS_(TYPE, ARR, RUNS, TASK, COMBINE) \
+    { \
+        int64_t task_size = get_task_size(RUNS); \
+        int64_t n_tasks = ((ARR).length + task_size - 1) / task_size; \
+        if (n_tasks == 1) \
+            return TASK((ARR), (RUNS), 0, (ARR).length); \
+        TYPE *partials = malloc(n_tasks * sizeof(TYPE)); \
+        if (partials == NULL) \
+            return TASK((ARR), (RUNS), 0, (ARR).length); \
+        int32_t n_threads = get_n_threads((ARR).length); \
+        if (n_threads > n_tasks) \
+            n_threads = (int32_t)n_tasks; \
+        PARALLEL_FOR \
+        for (int32_t t = 0; t < n_threads; t++) \
+            for (int64_t k = n_tasks * t / n_threads; k < n_tasks * (t + 1) / n_threads; k++) \
+            { \
+                int64_t end = (k + 1) * task_size; \
+                partials[k] = TASK((ARR), (RUNS), k * task_size, \
+                                   end < (ARR).length ? end : (ARR).length); \
+            } \
+        TYPE output = COMBINE(partials, n_tasks); \
+        free(partials); \
         return output; \
     }
 
-NUMPY_SUM_(bool, int64_t, bool)
-NUMPY_SUM_(int8, int64_t, int8)
-NUMPY_SUM_(int16, int64_t, int16)
-NUMPY_SUM_(int32, int64_t, int32)
-NUMPY_SUM_(int64, int64_t, int64)
-NUMPY_SUM_(float32, float, float)
-NUMPY_SUM_(float64, double, double)
-NUMPY_SUM_(complex64, float complex, cfloat)
-NUMPY_SUM_(complex128, double complex, cdouble)
+/*
+** Pairwise summation of the n elements of data separated by stride.
+** Blocks of at most PAIRWISE_BLOCKSIZE elements are summed with 8
+** independent accumulators (which the compiler can map onto vector
+** registers), larger ranges are split in two and summed recursively.
+** As in NumPy, the rounding error grows as O(log(n)) instead of O(n).
+*/
+#define PAIRWISE_BLOCKSIZE 128
 
-#define NUMPY_AMAX_(NAME, TYPE, CTYPE) \
-    TYPE numpy_amax_##NAME(t_ndarray arr) \
+#define PAIRWISE_SUM_(NAME, TYPE, ELEM_TYPE) \
+    static TYPE pairwise_sum_##NAME(const ELEM_TYPE *data, int64_t n, int64_t stride) \
     { \
-        int64_t nd_indices[arr.nd]; \
-        memset(nd_indices, 0, sizeof(int64_t) * arr.nd); \
-        TYPE output = arr.nd_##CTYPE[get_index_from_array(arr, nd_indices)]; \
-        for (int32_t i = 0; i < arr.length; i++) \
+        if (n < 8) \
+        { \
+            TYPE output = 0; \
+            for (int64_t i = 0; i < n; i++) \
+                output += data[i * stride]; \
+            return output; \
+        } \
+        if (n <= PAIRWISE_BLOCKSIZE) \
         { \
-            TYPE current_value = arr.nd_##CTYPE[get_index_from_array(arr, nd_indices)]; \
-            if (creal(current_value) > creal(output) || \
-                (creal(current_value) == creal(output) && cimag(current_value) > cimag(output))) \
+            TYPE acc[8]; \
+            int64_t i; \
+            for (int32_t k = 0; k < 8; k++) \
+                acc[k] = data[k * stride]; \
+            if (stride == 1) \
             { \
-                output = current_value; \
+                for (i = 8; i < n - (n % 8); i += 8) \
+                    for (int32_t k = 0; k < 8; k++) \
+                        acc[k] += data[i + k]; \
             } \
-            nd_indices[0]++; \
-            for (int32_t j = 0; j < arr.nd - 1; j++) \
-                if (nd_indices[j] == arr.shape[j]) \
-                { \
-                    nd_indices[j] = 0; \
-                    nd_indices[j + 1]++; \
-                } \
+            else \
+            { \
+                for (i = 8; i < n - (n % 8); i += 8) \
+                    for (int32_t k = 0; k < 8; k++) \
+                        acc[k] += data[(i + k) * stride]; \
+            } \
+            TYPE output = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + \
+                          ((acc[4] + acc[5]) + (acc[6] + acc[7])); \
+            for (; i < n; i++) \
+                output += data[i * stride]; \
+            return output; \
+        } \
+        int64_t half = n / 2; \
+        half -= half % 8; \
+        return pairwise_sum_##NAME(data, half, stride) + \
+               pairwise_sum_##NAME(data + half * stride, n - half, stride); \
+    }
+
+PAIRWISE_SUM_(bool, int64_t, bool)
+PAIRWISE_SUM_(int8, int64_t, int8_t)
+PAIRWISE_SUM_(int16, int64_t, int16_t)
+PAIRWISE_SUM_(int32, int64_t, int32_t)
+PAIRWISE_SUM_(int64, int64_t, int64_t)
+PAIRWISE_SUM_(float32, float, float)
+PAIRWISE_SUM_(float64, double, double)
+PAIRWISE_SUM_(complex64, float complex, float complex)
+PAIRWISE_SUM_(complex128, double complex, double complex)
+
+#define NUMPY_SUM_(NAME, TYPE, CTYPE, ELEM_TYPE, PARTIAL) \
+    static inline TYPE sum_piece_##NAME(TYPE output, const ELEM_TYPE *data, \
+                                        int64_t n, int64_t stride) \
+    { \
+        return output + pairwise_sum_##NAME(data, n, stride); \
+    } \
+    static TYPE sum_task_##NAME(t_ndarray arr, t_nd_runs runs, int64_t begin, int64_t end) \
+    { \
+        TYPE output = 0; \
+        FOR_EACH_PIECE_(arr.nd_##CTYPE, runs, begin, end, output, sum_piece_##NAME) \
+        return output; \
+    } \
+    static TYPE sum_partials_##NAME(const TYPE *partials, int64_t n) \
+    { \
+        return pairwise_sum_##PARTIAL(partials, n, 1); \
+    } \
+    TYPE numpy_sum_##NAME(t_ndarray arr) \
+    { \
+        t_nd_runs runs = get_nd_runs(arr); \
+        if (runs.n_runs == 0) \
+            return 0; \
+        REDUCE_TASKS_(TYPE, arr, runs, sum_task_##NAME, sum_partials_##NAME) \
+    }
+
+NUMPY_SUM_(bool, int64_t, bool, bool, int64)
+NUMPY_SUM_(int8, int64_t, int8, int8_t, int64)
+NUMPY_SUM_(int16, int64_t, int16, int16_t, int64)
+NUMPY_SUM_(int32, int64_t, int32, int32_t, int64)
+NUMPY_SUM_(int64, int64_t, int64, int64_t, int64)
+NUMPY_SUM_(float32, float, float, float, float32)
+NUMPY_SUM_(float64, double, double, double, float64)
+NUMPY_SUM_(complex64, float complex, cfloat, float complex, complex64)
+NUMPY_SUM_(complex128, double complex, cdouble, double complex, complex128)
+
+/*
+** Orderings used by numpy.amax and numpy.amin. Complex numbers are ordered
+** lexicographically (real part first) as in NumPy.
+*/
+#define REAL_GREATER(a, b) ((a) > (b))
+#define REAL_LESS(a, b) ((a) < (b))
+#define COMPLEX_GREATER(a, b) (creal(a) > creal(b) || (creal(a) == creal(b) && cimag(a) > cimag(b)))
+#define COMPLEX_LESS(a, b) (creal(a) < creal(b) || (creal(a) == creal(b) && cimag(a) < cimag(b)))
+
+/*
+** Search the extremum of the array for the ordering CMP. The comparison is
+** branch-free on the unit-stride path so that it can be vectorised.
+** As in NumPy, the extremum of an empty array is an error (error_value).
+*/
+#define NUMPY_EXTREMUM_(FUNC, NAME, TYPE, CTYPE, ELEM_TYPE, CMP) \
+    static inline TYPE FUNC##_piece_##NAME(TYPE output, const ELEM_TYPE *data, \
+                                           int64_t n, int64_t stride) \
+    { \
+        if (stride == 1) \
+        { \
+            for (int64_t i = 0; i < n; i++) \
+                output = CMP(data[i], output) ? data[i] : output; \
         } \
+        else \
+        { \
+            for (int64_t i = 0; i < n; i++) \
+                output = CMP(data[i * stride], output) ? data[i * stride] : output; \
+        } \
+        return output; \
+    } \
+    static TYPE FUNC##_task_##NAME(t_ndarray arr, t_nd_runs runs, int64_t begin, int64_t end) \
+    { \
+        t_nd_runs first = runs; \
+        int64_t pos = seek_element(&first, begin); \
+        TYPE output = arr.nd_##CTYPE[first.start + pos * first.run_stride]; \
+        FOR_EACH_PIECE_(arr.nd_##CTYPE, runs, begin, end, output, FUNC##_piece_##NAME) \
         return output; \
+    } \
+    static TYPE FUNC##_partials_##NAME(const TYPE *partials, int64_t n) \
+    { \
+        TYPE output = partials[0]; \
+        for (int64_t k = 1; k < n; k++) \
+            output = CMP(partials[k], output) ? partials[k] : output; \
+        return output; \
+    } \
+    TYPE numpy_##FUNC##_##NAME(t_ndarray arr) \
+    { \
+        t_nd_runs runs = get_nd_runs(arr); \
+        if (runs.n_runs == 0) \
+        { \
+            pyc_set_error(error_value, "numpy." #FUNC ": zero-size array to reduction operation which has no identity"); \
+            return 0; \
+        } \
+        REDUCE_TASKS_(TYPE, arr, runs, FUNC##_task_##NAME, FUNC##_partials_##NAME) \
+    }
+
+NUMPY_EXTREMUM_(amax, bool, int64_t, bool, bool, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, int8, int64_t, int8, int8_t, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, int16, int64_t, int16, int16_t, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, int32, int64_t, int32, int32_t, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, int64, int64_t, int64, int64_t, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, float32, float, float, float, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, float64, double, double, double, REAL_GREATER)
+NUMPY_EXTREMUM_(amax, complex64, float complex, cfloat, float complex, COMPLEX_GREATER)
+NUMPY_EXTREMUM_(amax, complex128, double complex, cdouble, double complex, COMPLEX_GREATER)
+
+NUMPY_EXTREMUM_(amin, bool, int64_t, bool, bool, REAL_LESS)
+NUMPY_EXTREMUM_(amin, int8, int64_t, int8, int8_t, REAL_LESS)
+NUMPY_EXTREMUM_(amin, int16, int64_t, int16, int16_t, REAL_LESS)
+NUMPY_EXTREMUM_(amin, int32, int64_t, int32, int32_t, REAL_LESS)
+NUMPY_EXTREMUM_(amin, int64, int64_t, int64, int64_t, REAL_LESS)
+NUMPY_EXTREMUM_(amin, float32, float, float, float, REAL_LESS)
+NUMPY_EXTREMUM_(amin, float64, double, double, double, REAL_LESS)
+NUMPY_EXTREMUM_(amin, complex64, float complex, cfloat, float complex, COMPLEX_LESS)
+NUMPY_EXTREMUM_(amin, complex128, double complex, cdouble, double complex, COMPLEX_LESS)
+
+/*
+** axis reductions
+**
+** The reduction of arr along an axis is written in out, an array which has
+** the shape of arr without the axis, or with a dimension of length 1 instead
+** of the axis (keepdims). Among the other dimensions of arr, the one with the
+** smallest stride is the inner dimension of the loops and the outer ones are
+** visited with a flat index. Two traversals are used depending on the strides:
+** - along the axis : when the axis has the smallest stride of arr (e.g. the
+**   last axis of a C array) each element of out is the reduction of a run of
+**   the axis, which is contiguous for the contiguous arrays (the sums are
+**   pairwise and vectorised as in numpy_sum)
+** - across the axis : otherwise the slices of arr (e.g. the rows of a C array
+**   reduced along its first axis) are accumulated into out one after the
+**   other, the inner loop reads both arrays along their smallest stride
+*/
+typedef struct  s_nd_axis_loops
+{
+    /* outer dimensions, from the fastest to the slowest */
+    int32_t     nd;
+    int64_t     shape[MAX_NDIM];
+    int64_t     arr_strides[MAX_NDIM];
+    int64_t     out_strides[MAX_NDIM];
+    int64_t     n_outer;
+    /* inner dimension */
+    int64_t     inner_length;
+    int64_t     inner_arr_stride;
+    int64_t     inner_out_stride;
+    /* reduced axis */
+    int64_t     axis_length;
+    int64_t     axis_stride;
+    bool        along_axis;
+}               t_nd_axis_loops;
+
+static t_nd_axis_loops  get_axis_loops(t_ndarray *out, t_ndarray arr, int32_t axis)
+{
+    t_nd_axis_loops loops;
+    bool            used[MAX_NDIM] = {false};
+    int32_t         inner = -1;
+
+    loops.nd = 0;
+    loops.n_outer = 1;
+    loops.inner_length = 1;
+    loops.inner_arr_stride = 0;
+    loops.inner_out_stride = 0;
+    loops.axis_length = arr.shape[axis];
+    loops.axis_stride = arr.strides[axis];
+    used[axis] = true;
+    for (int32_t i = 0; i < arr.nd; i++)
+        if (arr.shape[i] == 1)
+            used[i] = true;
+    for (int32_t n = 0; n < arr.nd; n++)
+    {
+        int32_t next = -1;
+        for (int32_t i = 0; i < arr.nd; i++)
+            if (!used[i] && (next == -1 || llabs(arr.strides[i]) < llabs(arr.strides[next])))
+                next = i;
+        if (next == -1)
+            break;
+        used[next] = true;
+        /* the dimensions after the axis are shifted in out unless it keeps the axis */
+        int64_t out_stride = out->strides[out->nd == arr.nd || next < axis ? next : next - 1];
+        if (inner == -1)
+        {
+            inner = next;
+            loops.inner_length = arr.shape[next];
+            loops.inner_arr_stride = arr.strides[next];
+            loops.inner_out_stride = out_stride;
+        }
+        else
+        {
+            loops.shape[loops.nd] = arr.shape[next];
+            loops.arr_strides[loops.nd] = arr.strides[next];
+            loops.out_strides[loops.nd] = out_stride;
+            loops.n_outer *= arr.shape[next];
+            loops.nd++;
+        }
     }
+    loops.along_axis = (inner == -1 || llabs(loops.axis_stride) <= llabs(loops.inner_arr_stride));
+    return (loops);
+}
 
-NUMPY_AMAX_(bool, int64_t, bool)
-NUMPY_AMAX_(int8, int64_t, int8)
-NUMPY_AMAX_(int16, int64_t, int16)
-NUMPY_AMAX_(int32, int64_t, int32)
-NUMPY_AMAX_(int64, int64_t, int64)
-NUMPY_AMAX_(float32, float, float)
-NUMPY_AMAX_(float64, double, double)
-NUMPY_AMAX_(complex64, float complex, cfloat)
-NUMPY_AMAX_(complex128, double complex, cdouble)
+/*
+** get the offsets in arr and in out of the outer position `flat`
+*/
+static inline void  seek_outer(const t_nd_axis_loops *loops, int64_t flat,
+                               int64_t *arr_offset, int64_t *out_offset)
+{
+    *arr_offset = 0;
+    *out_offset = 0;
+    for (int32_t j = 0; j < loops->nd; j++)
+    {
+        int64_t index = flat % loops->shape[j];
+        flat /= loops->shape[j];
+        *arr_offset += index * loops->arr_strides[j];
+        *out_offset += index * loops->out_strides[j];
+    }
+}
+
+#define ADD_(a, b) ((a) + (b))
+#define MUL_(a, b) ((a) * (b))
+#define REAL_MAX_(a, b) (REAL_GREATER(b, a) ? (b) : (a))
+#define REAL_MIN_(a, b) (REAL_LESS(b, a) ? (b) : (a))
+#define COMPLEX_MAX_(a, b) (COMPLEX_GREATER(b, a) ? (b) : (a))
+#define COMPLEX_MIN_(a, b) (COMPLEX_LESS(b, a) ? (b) : (a))
 
-#define NUMPY_AMIN_(NAME, TYPE, CTYPE) \
-    TYPE numpy_amin_##NAME(t_ndarray arr) \
+/*
+** Defines numpy_FUNC_axis_NAME(out, arr, axis) which reduces arr along axis
+** into out (whose elements have the type OUT_TYPE) with the operation
+** OP(accumulator, element). RUN(data, n, stride) reduces a run of the axis and
+** EMPTY is the result of the reduction of an empty axis.
+** When the axis is reduced across and there are fewer outer positions than
+** threads, each thread reduces a part of the axis into a buffer and the
+** partial results are combined in order.
+*/
+#define AXIS_REDUCTION_(FUNC, NAME, OUT_TYPE, OUT_CTYPE, CTYPE, ELEM_TYPE, RUN, OP, EMPTY) \
+    static void FUNC##_across_##NAME(OUT_TYPE *res, int64_t res_stride, const ELEM_TYPE *data, \
+                                     const t_nd_axis_loops *loops, int64_t begin, int64_t end) \
+    { \
+        int64_t arr_stride = loops->inner_arr_stride; \
+        const ELEM_TYPE *slice = data + begin * loops->axis_stride; \
+        for (int64_t i = 0; i < loops->inner_length; i++) \
+            res[i * res_stride] = slice[i * arr_stride]; \
+        for (int64_t k = begin + 1; k < end; k++) \
+        { \
+            slice = data + k * loops->axis_stride; \
+            if (res_stride == 1 && arr_stride == 1) \
+            { \
+                for (int64_t i = 0; i < loops->inner_length; i++) \
+                    res[i] = OP(res[i], slice[i]); \
+            } \
+            else \
+            { \
+                for (int64_t i = 0; i < loops->inner_length; i++) \
+                    res[i * res_stride] = OP(res[i * res_stride], slice[i * arr_stride]); \
+            } \
+        } \
+    } \
+    void numpy_##FUNC##_axis_##NAME(t_ndarray *out, t_ndarray arr, int32_t axis) \
     { \
-        int64_t nd_indices[arr.nd]; \
-        memset(nd_indices, 0, sizeof(int64_t) * arr.nd); \
-        TYPE output = arr.nd_##CTYPE[get_index_from_array(arr, nd_indices)]; \
-        for (int32_t i = 0; i < arr.length; i++) \
+        if (axis < 0) \
+            axis += arr.nd; \
+        t_nd_axis_loops loops = get_axis_loops(out, arr, axis); \
+        OUT_TYPE *out_data = out->nd_##OUT_CTYPE; \
+        const ELEM_TYPE *data = arr.nd_##CTYPE; \
+        if (out->length == 0) \
+            return; \
+        int32_t n_threads = get_n_threads(arr.length); \
+        if (loops.axis_length == 0) \
         { \
-            TYPE current_value = arr.nd_##CTYPE[get_index_from_array(arr, nd_indices)]; \
-            if (creal(current_value) < creal(output) || \
-                (creal(current_value) == creal(output) && cimag(current_value) < cimag(output))) \
+            for (int64_t k = 0; k < loops.n_outer; k++) \
             { \
-                output = current_value; \
+                int64_t arr_offset, out_offset; \
+                seek_outer(&loops, k, &arr_offset, &out_offset); \
+                for (int64_t i = 0; i < loops.inner_length; i++) \
+                    out_data[out_offset + i * loops.inner_out_stride] = EMPTY; \
             } \
-            nd_indices[0]++; \
-            for (int32_t j = 0; j < arr.nd - 1; j++) \
-                if (nd_indices[j] == arr.shape[j]) \
+        } \
+        else if (loops.along_axis || n_threads <= loops.n_outer) \
+        { \
+            if (n_threads > loops.n_outer) \
+                n_threads = (int32_t)loops.n_outer; \
+            PARALLEL_FOR \
+            for (int32_t t = 0; t < n_threads; t++) \
+                for (int64_t k = loops.n_outer * t / n_threads; k < loops.n_outer * (t + 1) / n_threads; k++) \
                 { \
-                    nd_indices[j] = 0; \
-                    nd_indices[j + 1]++; \
+                    int64_t arr_offset, out_offset; \
+                    seek_outer(&loops, k, &arr_offset, &out_offset); \
+                    if (!loops.along_axis) \
+                    { \
+                        FUNC##_across_##NAME(out_data + out_offset, loops.inner_out_stride, data + arr_offset, \
+                                             &loops, 0, loops.axis_length); \
+                        continue; \
+                    } \
+                    for (int64_t i = 0; i < loops.inner_length; i++) \
+                        out_data[out_offset + i * loops.inner_out_stride] = \
+                            RUN(data + arr_offset + i * loops.inner_arr_stride, \
+                                loops.axis_length, loops.axis_stride); \
                 } \
         } \
+        else \
+        { \
+            if (n_threads > loops.axis_length) \
+                n_threads = (int32_t)loops.axis_length; \
+            int64_t out_length = loops.n_outer * loops.inner_length; \
+            OUT_TYPE *partials = malloc(n_threads * out_length * sizeof(OUT_TYPE)); \
+            if (partials == NULL) \
+            { \
+                /* Reduce the whole axis in a single thread without the buffer */ \
+                for (int64_t k = 0; k < loops.n_outer; k++) \
+                { \
+                    int64_t arr_offset, out_offset; \
+                    seek_outer(&loops, k, &arr_offset, &out_offset); \
+                    FUNC##_across_##NAME(out_data + out_offset, loops.inner_out_stride, data + arr_offset, \
+                                         &loops, 0, loops.axis_length); \
+                } \
+                return; \
+            } \
+            PARALLEL_FOR \
+            for (int32_t t = 0; t < n_threads; t++) \
+                for (int64_t k = 0; k < loops.n_outer; k++) \
+                { \
+                    int64_t arr_offset, out_offset; \
+                    seek_outer(&loops, k, &arr_offset, &out_offset); \
+                    FUNC##_across_##NAME(partials + t * out_length + k * loops.inner_length, 1, \
+                                         data + arr_offset, &loops, loops.axis_length * t / n_threads, \
+                                         loops.axis_length * (t + 1) / n_threads); \
+                } \
+            for (int64_t k = 0; k < loops.n_outer; k++) \
+            { \
+                int64_t arr_offset, out_offset; \
+                seek_outer(&loops, k, &arr_offset, &out_offset); \
+                OUT_TYPE *res = out_data + out_offset; \
+                for (int64_t i = 0; i < loops.inner_length; i++) \
+                { \
+                    OUT_TYPE value = partials[k * loops.inner_length + i]; \
+                    for (int32_t t = 1; t < n_threads; t++) \
+                        value = OP(value, partials[t * out_length + k * loops.inner_length + i]); \
+                    res[i * loops.inner_out_stride] = value; \
+                } \
+            } \
+            free(partials); \
+        } \
+    }
+
+AXIS_REDUCTION_(sum, bool, int64_t, int64, bool, bool, pairwise_sum_bool, ADD_, 0)
+AXIS_REDUCTION_(sum, int8, int64_t, int64, int8, int8_t, pairwise_sum_int8, ADD_, 0)
+AXIS_REDUCTION_(sum, int16, int64_t, int64, int16, int16_t, pairwise_sum_int16, ADD_, 0)
+AXIS_REDUCTION_(sum, int32, int64_t, int64, int32, int32_t, pairwise_sum_int32, ADD_, 0)
+AXIS_REDUCTION_(sum, int64, int64_t, int64, int64, int64_t, pairwise_sum_int64, ADD_, 0)
+AXIS_REDUCTION_(sum, float32, float, float, float, float, pairwise_sum_float32, ADD_, 0)
+AXIS_REDUCTION_(sum, float64, double, double, double, double, pairwise_sum_float64, ADD_, 0)
+AXIS_REDUCTION_(sum, complex64, float complex, cfloat, cfloat, float complex, pairwise_sum_complex64, ADD_, 0)
+AXIS_REDUCTION_(sum, complex128, double complex, cdouble, cdouble, double complex, pairwise_sum_complex128, ADD_, 0)
+
+/*
+** product of the n elements of data separated by stride
+*/
+#define PRODUCT_RUN_(NAME, TYPE, ELEM_TYPE) \
+    static TYPE product_run_##NAME(const ELEM_TYPE *data, int64_t n, int64_t stride) \
+    { \
+        TYPE output = 1; \
+        for (int64_t i = 0; i < n; i++) \
+            output *= data[i * stride]; \
         return output; \
     }
 
-NUMPY_AMIN_(bool, int64_t, bool)
-NUMPY_AMIN_(int8, int64_t, int8)
-NUMPY_AMIN_(int16, int64_t, int16)
-NUMPY_AMIN_(int32, int64_t, int32)
-NUMPY_AMIN_(int64, int64_t, int64)
-NUMPY_AMIN_(float32, float, float)
-NUMPY_AMIN_(float64, double, double)
-NUMPY_AMIN_(complex64, float complex, cfloat)
-NUMPY_AMIN_(complex128, double complex, cdouble)
+PRODUCT_RUN_(bool, int64_t, bool)
+PRODUCT_RUN_(int8, int64_t, int8_t)
+PRODUCT_RUN_(int16, int64_t, int16_t)
+PRODUCT_RUN_(int32, int64_t, int32_t)
+PRODUCT_RUN_(int64, int64_t, int64_t)
+PRODUCT_RUN_(float32, float, float)
+PRODUCT_RUN_(float64, double, double)
+PRODUCT_RUN_(complex64, float complex, float complex)
+PRODUCT_RUN_(complex128, double complex, double complex)
+
+AXIS_REDUCTION_(prod, bool, int64_t, int64, bool, bool, product_run_bool, MUL_, 1)
+AXIS_REDUCTION_(prod, int8, int64_t, int64, int8, int8_t, product_run_int8, MUL_, 1)
+AXIS_REDUCTION_(prod, int16, int64_t, int64, int16, int16_t, product_run_int16, MUL_, 1)
+AXIS_REDUCTION_(prod, int32, int64_t, int64, int32, int32_t, product_run_int32, MUL_, 1)
+AXIS_REDUCTION_(prod, int64, int64_t, int64, int64, int64_t, product_run_int64, MUL_, 1)
+AXIS_REDUCTION_(prod, float32, float, float, float, float, product_run_float32, MUL_, 1)
+AXIS_REDUCTION_(prod, float64, double, double, double, double, product_run_float64, MUL_, 1)
+AXIS_REDUCTION_(prod, complex64, float complex, cfloat, cfloat, float complex, product_run_complex64, MUL_, 1)
+AXIS_REDUCTION_(prod, complex128, double complex, cdouble, cdouble, double complex, product_run_complex128, MUL_, 1)
+
+/*
+** extremum of a run of the axis (which is not empty), the elements of out
+** have the type of the elements of arr
+*/
+#define EXTREMUM_RUN_(FUNC, NAME, TYPE, ELEM_TYPE) \
+    static inline TYPE FUNC##_run_##NAME(const ELEM_TYPE *data, int64_t n, int64_t stride) \
+    { \
+        return FUNC##_piece_##NAME(data[0], data, n, stride); \
+    }
 
+EXTREMUM_RUN_(amax, bool, int64_t, bool)
+EXTREMUM_RUN_(amax, int8, int64_t, int8_t)
+EXTREMUM_RUN_(amax, int16, int64_t, int16_t)
+EXTREMUM_RUN_(amax, int32, int64_t, int32_t)
+EXTREMUM_RUN_(amax, int64, int64_t, int64_t)
+EXTREMUM_RUN_(amax, float32, float, float)
+EXTREMUM_RUN_(amax, float64, double, double)
+EXTREMUM_RUN_(amax, complex64, float complex, float complex)
+EXTREMUM_RUN_(amax, complex128, double complex, double complex)
+EXTREMUM_RUN_(amin, bool, int64_t, bool)
+EXTREMUM_RUN_(amin, int8, int64_t, int8_t)
+EXTREMUM_RUN_(amin, int16, int64_t, int16_t)
+EXTREMUM_RUN_(amin, int32, int64_t, int32_t)
+EXTREMUM_RUN_(amin, int64, int64_t, int64_t)
+EXTREMUM_RUN_(amin, float32, float, float)
+EXTREMUM_RUN_(amin, float64, double, double)
+EXTREMUM_RUN_(amin, complex64, float complex, float complex)
+EXTREMUM_RUN_(amin, complex128, double complex, double complex)
+
+AXIS_REDUCTION_(amax, bool, bool, bool, bool, bool, amax_run_bool, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, int8, int8_t, int8, int8, int8_t, amax_run_int8, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, int16, int16_t, int16, int16, int16_t, amax_run_int16, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, int32, int32_t, int32, int32, int32_t, amax_run_int32, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, int64, int64_t, int64, int64, int64_t, amax_run_int64, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, float32, float, float, float, float, amax_run_float32, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, float64, double, double, double, double, amax_run_float64, REAL_MAX_, 0)
+AXIS_REDUCTION_(amax, complex64, float complex, cfloat, cfloat, float complex, amax_run_complex64, COMPLEX_MAX_, 0)
+AXIS_REDUCTION_(amax, complex128, double complex, cdouble, cdouble, double complex, amax_run_complex128, COMPLEX_MAX_, 0)
+AXIS_REDUCTION_(amin, bool, bool, bool, bool, bool, amin_run_bool, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, int8, int8_t, int8, int8, int8_t, amin_run_int8, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, int16, int16_t, int16, int16, int16_t, amin_run_int16, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, int32, int32_t, int32, int32, int32_t, amin_run_int32, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, int64, int64_t, int64, int64, int64_t, amin_run_int64, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, float32, float, float, float, float, amin_run_float32, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, float64, double, double, double, double, amin_run_float64, REAL_MIN_, 0)
+AXIS_REDUCTION_(amin, complex64, float complex, cfloat, cfloat, float complex, amin_run_complex64, COMPLEX_MIN_, 0)
+AXIS_REDUCTION_(amin, complex128, double complex, cdouble, cdouble, double complex, amin_run_complex128, COMPLEX_MIN_, 0)
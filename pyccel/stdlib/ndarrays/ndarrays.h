@@ -22,13 +22,16 @@
                                         float complex : _array_fill_cfloat,\
                                         double complex : _array_fill_cdouble)(c, arr)
 
+/* maximum rank of the arrays handled by the C code generated by pyccel */
+# define MAX_NDIM 15
+
 typedef enum e_slice_type { ELEMENT, RANGE } t_slice_type;
 
 typedef struct  s_slice
 {
-    int32_t             start;
-    int32_t             end;
-    int32_t             step;
+    int64_t             start;
+    int64_t             end;
+    int64_t             step;
     t_slice_type   type;
 }               t_slice;
 
@@ -57,6 +60,30 @@ typedef struct  s_slice
 #define INDEX(arr, dim, a) (arr.strides[dim] * (a))
 #define GET_ELEMENT(arr, type, ...) arr.type[GET_INDEX(arr, __VA_ARGS__)]
 
+/* alignment (in bytes) of the data allocated by array_create, all the code
+** using the arrays must be compiled with the same value */
+#ifndef NDARRAY_ALIGNMENT
+# define NDARRAY_ALIGNMENT 64
+#endif
+
+/* maximum size (in bytes) of the buffer storing the data of a stack array, the
+** data of the larger stack arrays is allocated on the heap */
+#ifndef NDARRAY_STACK_MAX_BYTES
+# define NDARRAY_STACK_MAX_BYTES 16384
+#endif
+
+/* number of elements of the buffer declared for a stack array of the given length */
+#define STACK_BUFFER_LENGTH(length, type) ((length) > 0 && (length) <= NDARRAY_STACK_MAX_BYTES / (int64_t)sizeof(type) ? (length) : 1)
+
+/* tell the compiler that a pointer is aligned on NDARRAY_ALIGNMENT bytes */
+#if defined(__GNUC__)
+# define ASSUME_ALIGNED(ptr) ((__typeof__(ptr))__builtin_assume_aligned((ptr), NDARRAY_ALIGNMENT))
+#else
+# define ASSUME_ALIGNED(ptr) (ptr)
+#endif
+/* GET_ELEMENT for an array whose data was allocated by array_create */
+#define GET_ALIGNED_ELEMENT(arr, type, ...) ASSUME_ALIGNED(arr.type)[GET_INDEX(arr, __VA_ARGS__)]
+
 /*
 ** Map e_types enum to numpy NPY_TYPES enum
 ** ref: numpy_repo: numpy/numpy/core/include/numpy/ndarraytypes.h
@@ -80,6 +107,60 @@ typedef enum e_order
     order_c,
 } t_order;
 
+/* access to the data of an array stored in a file */
+typedef enum e_file_mode
+{
+    file_read,      /* the data is read into memory */
+    file_map_r,     /* read-only mapping ('r') */
+    file_map_rplus, /* writes are saved in the file ('r+') */
+    file_map_wplus, /* the file is created or overwritten ('w+') */
+    file_map_c,     /* writes are only done in memory ('c', copy-on-write) */
+} t_file_mode;
+
+/* expected access pattern of the data of an array (see madvise) */
+typedef enum e_access_hint
+{
+    access_normal,
+    access_sequential,
+    access_random,
+    access_willneed,
+    access_dontneed,
+} t_access_hint;
+
+/* kind of the errors reported by the functions of the library (the errors
+** are recorded per thread and checked by the caller with pyc_error_occurred) */
+typedef enum e_error_kind
+{
+    error_none,
+    error_os,       /* the error of a system call (e.g. a missing file) */
+    error_value,    /* an invalid argument (e.g. a file of the wrong type) */
+} t_error_kind;
+
+/* access pattern given for the data of the arrays mapped in memory */
+#ifndef NDARRAY_FILE_ACCESS
+# define NDARRAY_FILE_ACCESS access_normal
+#endif
+
+/*
+** copy of the data of an array on the device in OpenACC builds, owned by the
+** array which owns the data and shared by its views: the copy is created when
+** the data is first used in a compute region, and the data is only copied when
+** one side reads data which was modified on the other side since the last copy
+*/
+typedef struct  s_device_data
+{
+    /* host data (covering all the elements of the array) mirrored on the device */
+    void                    *host_data;
+    int64_t                 bytes;
+    /* device copy of host_data, NULL until the data is used on the device */
+    void                    *device_data;
+    /* the host (or device) data was modified since the last copy */
+    bool                    host_modified;
+    bool                    device_modified;
+    /* the device copy is released at the end of the compute region */
+    bool                    transient;
+}               t_device_data;
+
 typedef struct  s_ndarray
 {
     /* raw data buffer*/
@@ -99,26 +180,47 @@ typedef struct  s_ndarray
     int32_t                 nd;
     /* shape 'size of each dimension' */
     int64_t                 *shape;
-    /* strides 'number of elements to skip to get the next element' */
+    /* strides 'number of elements to skip to get the next element' (stored after the shape) */
     int64_t                 *strides;
     /* type of the array elements */
     t_types            type;
     /* type size of the array elements */
     int32_t                 type_size;
     /* number of element in the array */
-    int32_t                 length;
+    int64_t                 length;
     /* size of the array */
-    int32_t                 buffer_size;
+    int64_t                 buffer_size;
     /* True if the array does not own the data */
     bool                    is_view;
     /* stores the order of the array: order_f or order_c */
     t_order            order;
+    /* copy of the data on the device (OpenACC builds only, NULL otherwise) */
+    t_device_data           *device;
 }               t_ndarray;
 
 /* functions prototypes */
 
+/* errors */
+void            pyc_set_error(t_error_kind kind, const char *format, ...);
+bool            pyc_error_occurred(void);
+t_error_kind    pyc_error_kind(void);
+const char      *pyc_error_message(void);
+void            pyc_clear_error(void);
+void            pyc_print_error(void);
+
+/* data buffers */
+void        *allocate_data(int64_t size);
+void        free_data(void *data, int64_t size);
+
+/* shape and strides */
+int64_t     *allocate_metadata(int32_t nd);
+void        free_metadata(int64_t *metadata, int32_t nd);
+void        release_metadata_cache(void);
+
 /* allocations */
 void        stack_array_init(t_ndarray *arr);
+void        stack_array_create(t_ndarray *arr, int64_t buffer_size);
+void        stack_array_free(t_ndarray *arr, const void *buffer);
 t_ndarray   array_create(int32_t nd, int64_t *shape,
         t_types type, bool is_view, t_order order);
 void        _array_fill_int8(int8_t c, t_ndarray arr);
@@ -131,9 +233,25 @@ void        _array_fill_bool(bool c, t_ndarray arr);
 void        _array_fill_cfloat(float complex c, t_ndarray arr);
 void        _array_fill_cdouble(double complex c, t_ndarray arr);
 
+/* arrays stored in files */
+t_ndarray   array_load_npy(const char *filename, t_file_mode mode, t_types type,
+        int32_t nd, t_order order);
+t_ndarray   array_memmap(const char *filename, t_file_mode mode, int64_t offset,
+        int32_t nd, int64_t *shape, t_types type, t_order order);
+int32_t     array_madvise(t_ndarray arr, t_access_hint hint);
+
+/* device copies (OpenACC): map/unmap an array around a compute region, and
+** copy the data back before (and flag it after) host code uses (modifies) it */
+void        array_device_init(t_ndarray *arr);
+void        array_device_release(t_ndarray *arr, bool keep_host);
+void        array_device_map(t_ndarray *arr);
+void        array_device_unmap(t_ndarray *arr, bool modified);
+void        array_host_sync(t_ndarray arr);
+void        array_host_modified(t_ndarray arr);
+
 /* slicing */
                 /* creating a Slice object */
-t_slice new_slice(int32_t start, int32_t end, int32_t step, t_slice_type type);
+t_slice new_slice(int64_t start, int64_t end, int64_t step, t_slice_type type);
                 /* creating an array view */
 t_ndarray   array_slicing(t_ndarray arr, int n, ...);
 
@@ -153,7 +271,7 @@ int64_t     *numpy_to_ndarray_strides(int64_t *np_strides, int type_size, int nd
 int64_t     *numpy_to_ndarray_shape(int64_t *np_shape, int nd);
 void print_ndarray_memory(t_ndarray nd);
 /* copy data from ndarray */
-void array_copy_data(t_ndarray* dest, t_ndarray src, uint32_t offset);
+void array_copy_data(t_ndarray* dest, t_ndarray src, int64_t offset);
 
 /* numpy sum */
 
@@ -167,7 +285,7 @@ double             numpy_sum_float64(t_ndarray arr);
 float complex      numpy_sum_complex64(t_ndarray arr);
 double complex     numpy_sum_complex128(t_ndarray arr);
 
-/*numpy max/amax */
+/*numpy max/amax (an empty array records an error_value) */
 
 int64_t            numpy_amax_bool(t_ndarray arr);
 int64_t            numpy_amax_int8(t_ndarray arr);
@@ -179,7 +297,7 @@ double             numpy_amax_float64(t_ndarray arr);
 float complex      numpy_amax_complex64(t_ndarray arr);
 double complex     numpy_amax_complex128(t_ndarray arr);
 
-/* numpy min/amin */
+/* numpy min/amin (an empty array records an error_value) */
 
 int64_t            numpy_amin_bool(t_ndarray arr);
 int64_t            numpy_amin_int8(t_ndarray arr);
@@ -191,4 +309,47 @@ double             numpy_amin_float64(t_ndarray arr);
 float complex      numpy_amin_complex64(t_ndarray arr);
 double complex     numpy_amin_complex128(t_ndarray arr);
 
+/* numpy sum/prod/amax/amin along an axis, the result is written in out which
+** has the shape of arr without the axis (or with a dimension of length 1) */
+
+void               numpy_sum_axis_bool(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_int8(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_int16(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_int32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_int64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_float32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_float64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_complex64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_sum_axis_complex128(t_ndarray *out, t_ndarray arr, int32_t axis);
+
+void               numpy_prod_axis_bool(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_int8(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_int16(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_int32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_int64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_float32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_float64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_complex64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_prod_axis_complex128(t_ndarray *out, t_ndarray arr, int32_t axis);
+
+void               numpy_amax_axis_bool(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_int8(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_int16(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_int32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_int64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_float32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_float64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_complex64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amax_axis_complex128(t_ndarray *out, t_ndarray arr, int32_t axis);
+
+void               numpy_amin_axis_bool(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_int8(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_int16(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_int32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_int64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_float32(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_float64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_complex64(t_ndarray *out, t_ndarray arr, int32_t axis);
+void               numpy_amin_axis_complex128(t_ndarray *out, t_ndarray arr, int32_t axis);
+
 #endif
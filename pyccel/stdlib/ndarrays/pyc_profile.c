@@ -0,0 +1,193 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/* clock_gettime is not part of C99 */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+# define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "pyc_profile.h"
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+# define USE_TSC
+#endif
+
+/*
+** atomic operations (ATOMIC_ADD returns the new value), the counters are not
+** atomic with compilers which do not provide the GNU builtins
+*/
+
+#if defined(__GNUC__)
+# define ATOMIC_ADD(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_RELAXED)
+# define ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+# define ATOMIC_CAS(ptr, expected, value) __atomic_compare_exchange_n((ptr), (expected), (value), \
+                                            false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+# define ATOMIC_ADD(ptr, value) (*(ptr) += (value))
+# define ATOMIC_LOAD(ptr) (*(ptr))
+# define ATOMIC_STORE(ptr, value) (*(ptr) = (value))
+# define ATOMIC_CAS(ptr, expected, value) (*(ptr) == *(expected) ? (*(ptr) = (value), true) \
+                                                                : (*(expected) = *(ptr), false))
+#endif
+
+/*
+** clocks
+**
+** The time-stamp counter is used on x86 (it is read in a few cycles), the
+** other processors use the monotonic clock. The duration of a tick is
+** measured against the monotonic clock since the first timer was started.
+*/
+
+static int64_t  _monotonic_ns(void)
+{
+    struct timespec ts;
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t    pyc_profile_ticks(void)
+{
+#ifdef USE_TSC
+    return __rdtsc();
+#else
+    return (uint64_t)_monotonic_ns();
+#endif
+}
+
+static uint64_t reference_ticks = 0;
+static int64_t  reference_ns = 0;
+
+static void     _set_reference(void)
+{
+    reference_ns = _monotonic_ns();
+    reference_ticks = pyc_profile_ticks();
+}
+
+double      pyc_profile_seconds_per_tick(void)
+{
+#ifdef USE_TSC
+    // Measure for at least 10ms to get a precise estimation
+    if (reference_ns == 0)
+        _set_reference();
+    while (_monotonic_ns() - reference_ns < 10000000)
+        ;
+    return (double)(_monotonic_ns() - reference_ns) * 1e-9 /
+           (double)(pyc_profile_ticks() - reference_ticks);
+#else
+    return 1e-9;
+#endif
+}
+
+/*
+** timers
+**
+** Each timer is added to a list the first time that the function is called.
+** The list is only ever prepended to so it can be read at any time.
+*/
+
+static t_pyc_timer  *timers = NULL;
+
+static void     _register_timer(t_pyc_timer *timer)
+{
+    int32_t unregistered = 0;
+    if (!ATOMIC_CAS(&timer->registered, &unregistered, 1))
+        return;
+    if (reference_ns == 0)
+        _set_reference();
+    timer->next = ATOMIC_LOAD(&timers);
+    while (!ATOMIC_CAS(&timers, &timer->next, timer))
+        ;
+}
+
+t_pyc_timer_scope   pyc_profile_start(t_pyc_timer *timer, int32_t *depth)
+{
+    if (!ATOMIC_LOAD(&timer->registered))
+        _register_timer(timer);
+    ATOMIC_ADD(&timer->calls, 1);
+    (*depth)++;
+    return (t_pyc_timer_scope){timer, depth, pyc_profile_ticks()};
+}
+
+void        pyc_profile_stop(t_pyc_timer_scope *scope)
+{
+    uint64_t    end = pyc_profile_ticks();
+    // Only the outermost call of a recursive function is measured
+    if (--(*scope->depth) == 0)
+        ATOMIC_ADD(&scope->timer->ticks, end - scope->start);
+}
+
+void        pyc_profile_count(t_pyc_timer *timer)
+{
+    if (!ATOMIC_LOAD(&timer->registered))
+        _register_timer(timer);
+    ATOMIC_ADD(&timer->calls, 1);
+}
+
+t_pyc_timer *pyc_profile_timers(void)
+{
+    return ATOMIC_LOAD(&timers);
+}
+
+/*
+** allocations
+*/
+
+static t_pyc_allocation_stats   allocation_stats = {0, 0, 0, 0, 0};
+
+void        pyc_profile_allocation(int64_t size)
+{
+    ATOMIC_ADD(&allocation_stats.allocations, 1);
+    ATOMIC_ADD(&allocation_stats.allocated_bytes, size);
+    int64_t live = ATOMIC_ADD(&allocation_stats.live_bytes, size);
+    int64_t peak = ATOMIC_LOAD(&allocation_stats.peak_bytes);
+    while (live > peak && !ATOMIC_CAS(&allocation_stats.peak_bytes, &peak, live))
+        ;
+}
+
+void        pyc_profile_deallocation(int64_t size)
+{
+    ATOMIC_ADD(&allocation_stats.deallocations, 1);
+    ATOMIC_ADD(&allocation_stats.live_bytes, -size);
+}
+
+t_pyc_allocation_stats  pyc_profile_allocations(void)
+{
+    t_pyc_allocation_stats  stats;
+    stats.allocations = ATOMIC_LOAD(&allocation_stats.allocations);
+    stats.deallocations = ATOMIC_LOAD(&allocation_stats.deallocations);
+    stats.allocated_bytes = ATOMIC_LOAD(&allocation_stats.allocated_bytes);
+    stats.live_bytes = ATOMIC_LOAD(&allocation_stats.live_bytes);
+    stats.peak_bytes = ATOMIC_LOAD(&allocation_stats.peak_bytes);
+    return stats;
+}
+
+/*
+** reset
+*/
+
+void        pyc_profile_reset(void)
+{
+    for (t_pyc_timer *timer = pyc_profile_timers(); timer != NULL; timer = timer->next)
+    {
+        ATOMIC_STORE(&timer->calls, 0);
+        ATOMIC_STORE(&timer->ticks, 0);
+    }
+    ATOMIC_STORE(&allocation_stats.allocations, 0);
+    ATOMIC_STORE(&allocation_stats.deallocations, 0);
+    ATOMIC_STORE(&allocation_stats.allocated_bytes, 0);
+    // The arrays which are still allocated are not forgotten
+    ATOMIC_STORE(&allocation_stats.peak_bytes, ATOMIC_LOAD(&allocation_stats.live_bytes));
+}
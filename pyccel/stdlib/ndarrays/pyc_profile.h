@@ -0,0 +1,98 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the counters used to instrument the code generated with
+ * `pyccel --profile`:
+ * - a timer for each function, which counts the calls and the time spent in
+ *   the function (measured with the time-stamp counter when it is available)
+ * - the number and the size of the allocations of the ndarrays runtime (when
+ *   it is compiled with PYCCEL_PROFILE)
+ * The counters are updated atomically so they can be used from OpenMP threads.
+ */
+
+#ifndef PYC_PROFILE_H
+# define PYC_PROFILE_H
+
+# include <stdint.h>
+# include <stdbool.h>
+
+typedef struct  s_pyc_timer
+{
+    /* name of the measured function */
+    const char          *name;
+    /* number of calls */
+    int64_t             calls;
+    /* ticks spent in the calls (recursive calls are only counted once) */
+    uint64_t            ticks;
+    /* true once the timer is in the list returned by pyc_profile_timers */
+    int32_t             registered;
+    struct s_pyc_timer  *next;
+}               t_pyc_timer;
+
+typedef struct  s_pyc_timer_scope
+{
+    t_pyc_timer         *timer;
+    /* number of calls to the function running in the current thread */
+    int32_t             *depth;
+    uint64_t            start;
+}               t_pyc_timer_scope;
+
+typedef struct  s_pyc_allocation_stats
+{
+    int64_t     allocations;
+    int64_t     deallocations;
+    /* total size of the allocations */
+    int64_t     allocated_bytes;
+    /* size of the allocations which have not been freed */
+    int64_t     live_bytes;
+    int64_t     peak_bytes;
+}               t_pyc_allocation_stats;
+
+# if defined(_MSC_VER)
+#  define PYC_PROFILE_THREAD_LOCAL __declspec(thread)
+# else
+#  define PYC_PROFILE_THREAD_LOCAL __thread
+# endif
+
+/*
+ * Macro : PYC_PROFILE_FUNCTION
+ * ----------------------------
+ * Measure the function in which the macro is used (from the macro until the
+ * function returns). It must be used at the start of the function body.
+ * Compilers which do not support the cleanup attribute only count the calls.
+ *
+ * Parameters :
+ *     name : the name of the function (a string literal)
+ */
+# if defined(__GNUC__)
+#  define PYC_PROFILE_FUNCTION(name) \
+    static t_pyc_timer pyc_profile_timer = {name, 0, 0, 0, NULL}; \
+    static PYC_PROFILE_THREAD_LOCAL int32_t pyc_profile_depth = 0; \
+    t_pyc_timer_scope pyc_profile_scope __attribute__((cleanup(pyc_profile_stop))) = \
+            pyc_profile_start(&pyc_profile_timer, &pyc_profile_depth)
+# else
+#  define PYC_PROFILE_FUNCTION(name) \
+    static t_pyc_timer pyc_profile_timer = {name, 0, 0, 0, NULL}; \
+    pyc_profile_count(&pyc_profile_timer)
+# endif
+
+/* timers */
+uint64_t                pyc_profile_ticks(void);
+double                  pyc_profile_seconds_per_tick(void);
+t_pyc_timer_scope       pyc_profile_start(t_pyc_timer *timer, int32_t *depth);
+void                    pyc_profile_stop(t_pyc_timer_scope *scope);
+void                    pyc_profile_count(t_pyc_timer *timer);
+t_pyc_timer             *pyc_profile_timers(void);
+
+/* allocations */
+void                    pyc_profile_allocation(int64_t size);
+void                    pyc_profile_deallocation(int64_t size);
+t_pyc_allocation_stats  pyc_profile_allocations(void);
+
+/* reset all the counters */
+void                    pyc_profile_reset(void);
+
+#endif
@@ -0,0 +1,484 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/* clock_gettime is not part of C99 */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+# define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "pyc_random.h"
+#include <math.h>
+#include <stdbool.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+# define THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+# define THREAD_LOCAL _Thread_local
+#else
+# define THREAD_LOCAL __thread
+#endif
+
+/*
+** atomic operations (ATOMIC_FETCH_ADD returns the previous value), the
+** seeding of the streams is not thread-safe with compilers which do not
+** provide the GNU builtins
+*/
+
+#if defined(__GNUC__)
+# define ATOMIC_FETCH_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+# define ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+# define ATOMIC_CAS(ptr, expected, value) __atomic_compare_exchange_n((ptr), (expected), (value), \
+                                            false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+# define ATOMIC_FETCH_ADD(ptr, value) ((*(ptr) += (value)) - (value))
+# define ATOMIC_LOAD(ptr) (*(ptr))
+# define ATOMIC_STORE(ptr, value) (*(ptr) = (value))
+# define ATOMIC_CAS(ptr, expected, value) (*(ptr) == *(expected) ? (*(ptr) = (value), true) \
+                                                                : (*(expected) = *(ptr), false))
+#endif
+
+/* the errors are recorded for the caller (see pyc_set_error in ndarrays.h) */
+static void     random_error(const char *message)
+{
+    pyc_set_error(error_value, "numpy.random: %s", message);
+}
+
+/*
+** xoshiro256++ (D. Blackman and S. Vigna, "Scrambled linear pseudorandom
+** number generators", 2021)
+*/
+
+static inline uint64_t  rotl(uint64_t x, int32_t k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t  next(uint64_t *s)
+{
+    const uint64_t  result = rotl(s[0] + s[3], 23) + s[0];
+    const uint64_t  t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+/* advance the state by 2^128 numbers */
+static void     jump(uint64_t *s)
+{
+    static const uint64_t   jump_polynomial[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                                 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    uint64_t                t[4] = {0, 0, 0, 0};
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        for (int32_t b = 0; b < 64; b++)
+        {
+            if (jump_polynomial[i] & (UINT64_C(1) << b))
+                for (int32_t j = 0; j < 4; j++)
+                    t[j] ^= s[j];
+            next(s);
+        }
+    }
+    for (int32_t j = 0; j < 4; j++)
+        s[j] = t[j];
+}
+
+/* splitmix64, used to expand a seed into a state */
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t    z = (*x += 0x9e3779b97f4a7c15);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+/*
+** distributions
+*/
+
+/* uniform in [0, 1) with the 53 (or 24) high bits of a number */
+static inline double    next_double(uint64_t *s)
+{
+    return (next(s) >> 11) * 0x1.0p-53;
+}
+
+static inline float     next_float(uint64_t *s)
+{
+    return (next(s) >> 40) * 0x1.0p-24f;
+}
+
+/*
+ * Function : bounded
+ * ------------------
+ * Draw an integer uniformly in [0, range) without bias (D. Lemire, "Fast
+ * random integer generation in an interval", 2019). The division is only
+ * computed when the number may have to be rejected.
+ */
+#if defined(__SIZEOF_INT128__)
+static inline uint64_t  bounded(uint64_t *s, uint64_t range)
+{
+    unsigned __int128   m = (unsigned __int128)next(s) * range;
+
+    if ((uint64_t)m < range)
+    {
+        uint64_t    threshold = -range % range;
+        while ((uint64_t)m < threshold)
+            m = (unsigned __int128)next(s) * range;
+    }
+    return (uint64_t)(m >> 64);
+}
+#else
+static inline uint64_t  bounded(uint64_t *s, uint64_t range)
+{
+    uint64_t    threshold = -range % range;
+    uint64_t    x = next(s);
+
+    while (x < threshold)
+        x = next(s);
+    return x % range;
+}
+#endif
+
+/*
+ * Function : next_normal
+ * ----------------------
+ * Draw a number of the standard normal distribution with the ziggurat method
+ * of G. Marsaglia and W. W. Tsang ("The ziggurat method for generating random
+ * variables", 2000) with 256 layers. A single 64-bit number gives the layer
+ * (8 bits), the sign (1 bit) and the abscissa (52 bits), which is accepted
+ * without any other computation 99% of the time.
+ */
+
+#define ZIGGURAT_R 3.6541528853610088
+#define ZIGGURAT_AREA 0.00492867323399
+
+static uint64_t ziggurat_k[256];
+static double   ziggurat_w[256];
+static double   ziggurat_f[256];
+/* 0: the tables are not computed, 1: they are being computed, 2: they are ready */
+static uint64_t ziggurat_status;
+
+static void     init_ziggurat(void)
+{
+    const double    m = 0x1.0p52;
+    uint64_t        expected = 0;
+    double          x = ZIGGURAT_R;
+    double          previous_x = ZIGGURAT_R;
+    double          q = ZIGGURAT_AREA / exp(-0.5 * x * x);
+
+    if (ATOMIC_LOAD(&ziggurat_status) == 2)
+        return;
+    if (!ATOMIC_CAS(&ziggurat_status, &expected, 1))
+    {
+        while (ATOMIC_LOAD(&ziggurat_status) != 2)
+            ;
+        return;
+    }
+    ziggurat_k[0] = (uint64_t)(x / q * m);
+    ziggurat_k[1] = 0;
+    ziggurat_w[0] = q / m;
+    ziggurat_w[255] = x / m;
+    ziggurat_f[0] = 1.;
+    ziggurat_f[255] = exp(-0.5 * x * x);
+    for (int32_t i = 254; i >= 1; i--)
+    {
+        x = sqrt(-2. * log(ZIGGURAT_AREA / x + exp(-0.5 * x * x)));
+        ziggurat_k[i + 1] = (uint64_t)(x / previous_x * m);
+        previous_x = x;
+        ziggurat_f[i] = exp(-0.5 * x * x);
+        ziggurat_w[i] = x / m;
+    }
+    ATOMIC_STORE(&ziggurat_status, 2);
+}
+
+/* the rejection test of the layers which are not accepted immediately, out of
+** the main loop which remains small (returns false if the number is rejected) */
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static bool     normal_slow_path(uint64_t *s, uint64_t r, int32_t layer, double *x)
+{
+    if (layer == 0)
+    {
+        /* the tail beyond ZIGGURAT_R */
+        while (true)
+        {
+            double  tail_x = -log1p(-next_double(s)) / ZIGGURAT_R;
+            double  tail_y = -log1p(-next_double(s));
+            if (tail_y + tail_y > tail_x * tail_x)
+            {
+                *x = (r & 0x100) ? -(ZIGGURAT_R + tail_x) : ZIGGURAT_R + tail_x;
+                return true;
+            }
+        }
+    }
+    return (ziggurat_f[layer - 1] - ziggurat_f[layer]) * next_double(s) + ziggurat_f[layer]
+                < exp(-0.5 * *x * *x);
+}
+
+static inline double    next_normal(uint64_t *s)
+{
+    while (true)
+    {
+        uint64_t    r = next(s);
+        int32_t     layer = r & 0xff;
+        uint64_t    abscissa = (r >> 9) & 0x000fffffffffffff;
+        /* the sign is applied without a branch, it cannot be predicted */
+        int64_t     sign = -(int64_t)((r >> 8) & 1);
+        double      x = (((int64_t)abscissa ^ sign) - sign) * ziggurat_w[layer];
+
+        if (abscissa < ziggurat_k[layer] || normal_slow_path(s, r, layer, &x))
+            return x;
+    }
+}
+
+static bool     check_range(int64_t low, int64_t high, uint64_t *range)
+{
+    if (high <= low)
+    {
+        random_error("high <= low");
+        return false;
+    }
+    *range = (uint64_t)high - (uint64_t)low;
+    return true;
+}
+
+static bool     check_scale(double scale)
+{
+    if (scale < 0)
+    {
+        random_error("scale < 0");
+        return false;
+    }
+    return true;
+}
+
+/*
+** streams
+**
+** The state of a thread is (re)initialised when it first draws a number after
+** a change of seed_generation. With a seed, the threads are given the streams
+** 0, 1, 2, ... (the state expanded from the seed followed by 1, 2, ... jumps)
+** in the order in which they first draw a number.
+*/
+
+typedef struct  s_random_state
+{
+    uint64_t    s[4];
+    /* value of seed_generation when the state was initialised (0: never) */
+    uint64_t    generation;
+}               t_random_state;
+
+static THREAD_LOCAL t_random_state  thread_state;
+
+static uint64_t seed_generation = 1;
+static uint64_t seed_from_entropy = 1;
+static uint64_t seed_value;
+/* next stream given to a thread for the current seed */
+static uint64_t next_stream;
+static uint64_t entropy_calls;
+
+static uint64_t entropy(const void *address)
+{
+    uint64_t        x;
+#if defined(_WIN32)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    x = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    x ^= (uint64_t)clock() << 32;
+    x ^= (uint64_t)(uintptr_t)address * 0xd1342543de82ef95;
+    x += ATOMIC_FETCH_ADD(&entropy_calls, 1) * 0x9e3779b97f4a7c15;
+    return x;
+}
+
+static inline t_random_state    *get_state(void)
+{
+    t_random_state  *state = &thread_state;
+    uint64_t        generation = ATOMIC_LOAD(&seed_generation);
+
+    if (state->generation != generation)
+    {
+        uint64_t    x;
+        uint64_t    stream = 0;
+
+        if (ATOMIC_LOAD(&seed_from_entropy))
+            x = entropy(state);
+        else
+        {
+            x = ATOMIC_LOAD(&seed_value);
+            stream = ATOMIC_FETCH_ADD(&next_stream, 1);
+        }
+        for (int32_t i = 0; i < 4; i++)
+            state->s[i] = splitmix64(&x);
+        for (uint64_t i = 0; i < stream; i++)
+            jump(state->s);
+        state->generation = generation;
+    }
+    return state;
+}
+
+void    pyc_random_seed(int64_t seed)
+{
+    ATOMIC_STORE(&seed_value, (uint64_t)seed);
+    ATOMIC_STORE(&seed_from_entropy, 0);
+    ATOMIC_STORE(&next_stream, 0);
+    ATOMIC_FETCH_ADD(&seed_generation, 1);
+}
+
+void    pyc_random_seed_entropy(void)
+{
+    ATOMIC_STORE(&seed_from_entropy, 1);
+    ATOMIC_FETCH_ADD(&seed_generation, 1);
+}
+
+/*
+** scalars
+*/
+
+double  pyc_random_uniform(void)
+{
+    return next_double(get_state()->s);
+}
+
+int64_t pyc_random_randint(int64_t low, int64_t high)
+{
+    uint64_t    range;
+
+    if (!check_range(low, high, &range))
+        return low;
+    return (int64_t)((uint64_t)low + bounded(get_state()->s, range));
+}
+
+double  pyc_random_normal(double loc, double scale)
+{
+    if (!check_scale(scale))
+        return loc;
+    init_ziggurat();
+    return loc + scale * next_normal(get_state()->s);
+}
+
+/*
+** arrays
+**
+** The state is copied in local variables so that the compiler can keep it in
+** registers while the array is written.
+*/
+
+#define FILL_UNIFORM_(NAME, TYPE, NEXT) \
+    static void fill_uniform_##NAME(TYPE *data, int64_t length, uint64_t *state) \
+    { \
+        uint64_t s[4] = {state[0], state[1], state[2], state[3]}; \
+        for (int64_t i = 0; i < length; i++) \
+            data[i] = NEXT(s); \
+        for (int32_t j = 0; j < 4; j++) \
+            state[j] = s[j]; \
+    }
+
+#define FILL_RANDINT_(NAME, TYPE) \
+    static void fill_randint_##NAME(TYPE *data, int64_t length, uint64_t *state, \
+                                    int64_t low, uint64_t range) \
+    { \
+        uint64_t s[4] = {state[0], state[1], state[2], state[3]}; \
+        for (int64_t i = 0; i < length; i++) \
+            data[i] = (TYPE)(int64_t)((uint64_t)low + bounded(s, range)); \
+        for (int32_t j = 0; j < 4; j++) \
+            state[j] = s[j]; \
+    }
+
+#define FILL_NORMAL_(NAME, TYPE) \
+    static void fill_normal_##NAME(TYPE *data, int64_t length, uint64_t *state, \
+                                   double loc, double scale) \
+    { \
+        uint64_t s[4] = {state[0], state[1], state[2], state[3]}; \
+        for (int64_t i = 0; i < length; i++) \
+            data[i] = (TYPE)(loc + scale * next_normal(s)); \
+        for (int32_t j = 0; j < 4; j++) \
+            state[j] = s[j]; \
+    }
+
+FILL_UNIFORM_(double, double, next_double)
+FILL_UNIFORM_(float, float, next_float)
+FILL_RANDINT_(int8, int8_t)
+FILL_RANDINT_(int16, int16_t)
+FILL_RANDINT_(int32, int32_t)
+FILL_RANDINT_(int64, int64_t)
+FILL_NORMAL_(double, double)
+FILL_NORMAL_(float, float)
+
+void    pyc_random_fill_uniform(t_ndarray arr)
+{
+    uint64_t    *s = get_state()->s;
+
+    switch (arr.type)
+    {
+        case nd_double:
+            fill_uniform_double(arr.nd_double, arr.length, s);
+            break;
+        case nd_float:
+            fill_uniform_float(arr.nd_float, arr.length, s);
+            break;
+        default:
+            random_error("the uniform distribution is only available for arrays of floats");
+    }
+}
+
+void    pyc_random_fill_randint(t_ndarray arr, int64_t low, int64_t high)
+{
+    uint64_t    range;
+    uint64_t    *s = get_state()->s;
+
+    if (!check_range(low, high, &range))
+        return;
+    switch (arr.type)
+    {
+        case nd_int64:
+            fill_randint_int64(arr.nd_int64, arr.length, s, low, range);
+            break;
+        case nd_int32:
+            fill_randint_int32(arr.nd_int32, arr.length, s, low, range);
+            break;
+        case nd_int16:
+            fill_randint_int16(arr.nd_int16, arr.length, s, low, range);
+            break;
+        case nd_int8:
+            fill_randint_int8(arr.nd_int8, arr.length, s, low, range);
+            break;
+        default:
+            random_error("randint is only available for arrays of integers");
+    }
+}
+
+void    pyc_random_fill_normal(t_ndarray arr, double loc, double scale)
+{
+    uint64_t    *s;
+
+    if (!check_scale(scale))
+        return;
+    init_ziggurat();
+    s = get_state()->s;
+    switch (arr.type)
+    {
+        case nd_double:
+            fill_normal_double(arr.nd_double, arr.length, s, loc, scale);
+            break;
+        case nd_float:
+            fill_normal_float(arr.nd_float, arr.length, s, loc, scale);
+            break;
+        default:
+            random_error("the normal distribution is only available for arrays of floats");
+    }
+}
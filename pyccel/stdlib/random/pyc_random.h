@@ -0,0 +1,42 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing the random number generator used by the functions of
+ * numpy.random. The numbers are drawn from the generator xoshiro256++ whose
+ * state is stored per thread: each thread (e.g. each thread of an OpenMP
+ * parallel region) draws from its own stream without locks. After a call to
+ * pyc_random_seed the streams are derived from the seed with the jump
+ * function of xoshiro256++, so they do not overlap (each stream contains 2^128
+ * numbers) and the numbers drawn by a single thread are reproducible. Before
+ * the first call to pyc_random_seed each thread seeds its stream from the
+ * clock and the address of its state.
+ */
+
+#ifndef PYC_RANDOM_H
+# define PYC_RANDOM_H
+
+# include <stdint.h>
+# include "ndarrays.h"
+
+/* reset the streams of all the threads */
+void    pyc_random_seed(int64_t seed);
+void    pyc_random_seed_entropy(void);
+
+/* scalars: uniform in [0, 1), integer in [low, high), normal N(loc, scale^2) */
+double  pyc_random_uniform(void);
+int64_t pyc_random_randint(int64_t low, int64_t high);
+double  pyc_random_normal(double loc, double scale);
+
+/* fill a contiguous array (the arrays of floating point numbers for the
+** uniform and normal distributions, the arrays of integers for randint) */
+void    pyc_random_fill_uniform(t_ndarray arr);
+void    pyc_random_fill_randint(t_ndarray arr, int64_t low, int64_t high);
+void    pyc_random_fill_normal(t_ndarray arr, double loc, double scale);
+
+/* an invalid argument (high <= low for randint, scale < 0 for normal, or an
+** array of the wrong type) is recorded as an error_value (see pyc_set_error) */
+
+#endif
@@ -0,0 +1,837 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "ufuncs.h"
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*
+** The kernels are written as plain loops over branch-free element functions
+** so that the compiler vectorises them. On x86 they are compiled once per
+** instruction set (SSE2, AVX2+FMA, AVX-512) thanks to the target attribute,
+** and the best version supported by the CPU is selected on the first call.
+** On other architectures (e.g. aarch64 where NEON is always available) only
+** the default version is built.
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define UFUNCS_X86_DISPATCH
+#endif
+
+#if defined(__GNUC__)
+# define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+# define ALWAYS_INLINE inline
+#endif
+
+/* sqrt must not set errno to be vectorised */
+#if defined(__clang__)
+# if __has_builtin(__builtin_elementwise_sqrt)
+#  define VSQRT(x) __builtin_elementwise_sqrt(x)
+#  define VSQRTF(x) __builtin_elementwise_sqrt(x)
+# else
+#  define VSQRT(x) sqrt(x)
+#  define VSQRTF(x) sqrtf(x)
+# endif
+# define NO_ERRNO
+#elif defined(__GNUC__)
+# define VSQRT(x) sqrt(x)
+# define VSQRTF(x) sqrtf(x)
+# define NO_ERRNO __attribute__((optimize("no-math-errno")))
+#else
+# define VSQRT(x) sqrt(x)
+# define VSQRTF(x) sqrtf(x)
+# define NO_ERRNO
+#endif
+
+/* number of elements handled at once by the kernels */
+#define UFUNC_BLOCK 256
+
+/*
+** bit manipulations
+*/
+
+static ALWAYS_INLINE int64_t    as_int64(double x)
+{
+    int64_t i;
+    memcpy(&i, &x, sizeof(double));
+    return i;
+}
+
+static ALWAYS_INLINE double     as_double(int64_t i)
+{
+    double x;
+    memcpy(&x, &i, sizeof(double));
+    return x;
+}
+
+/*
+** Adding then removing 1.5 * 2^52 rounds x to the nearest integer, and the
+** low bits of the intermediate value hold that integer in two's complement.
+** This avoids float <-> int conversions which SSE2 and AVX2 cannot vectorise.
+*/
+static const double ROUND_SHIFT = 0x1.8p52;
+
+/*
+** exponential
+**
+** x = n * ln2 + r with |r| <= ln2 / 2, exp(x) = 2^n * exp(r).
+** exp(r) is computed with a degree 13 Taylor polynomial (error < 1e-17),
+** 2^n is built directly from its bits. Results which are subnormal or close
+** to the overflow threshold are scaled in two steps.
+*/
+static const double EXP_OVERFLOW = 0x1.62e42fefa39efp+9;    /* 709.78 */
+static const double EXP_UNDERFLOW = -0x1.74910d52d3051p+9;  /* -745.13 */
+static const double INV_LN2 = 0x1.71547652b82fep+0;
+static const double LN2_HI = 0x1.62e42fee00000p-1;
+static const double LN2_LO = 0x1.a39ef35793c76p-33;
+
+static ALWAYS_INLINE double     pyc_exp(double x)
+{
+    double shifted = x * INV_LN2 + ROUND_SHIFT;
+    double n = shifted - ROUND_SHIFT;
+    double r = (x - n * LN2_HI) - n * LN2_LO;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    /* keep 2^n representable, the remainder is applied by the extra factor */
+    double extra = n < -1020 ? 0x1p-60 : (n > 1020 ? 0x1p+60 : 1.0);
+    double n_adj = n < -1020 ? n + 60 : (n > 1020 ? n - 60 : n);
+    int64_t e = as_int64(n_adj + ROUND_SHIFT) - as_int64(ROUND_SHIFT);
+    double scale = as_double((e + 1023) << 52);
+
+    double res = (p * scale) * extra;
+    res = x > EXP_OVERFLOW ? INFINITY : res;
+    res = x < EXP_UNDERFLOW ? 0.0 : res;
+    return res;
+}
+
+/*
+** logarithm
+**
+** x = 2^e * m with sqrt(2)/2 <= m < sqrt(2), f = m - 1, s = f / (2 + f).
+** log(1 + f) = 2 * atanh(s) = f - s * (f - R(s^2)) where R is the Taylor
+** series of 2 * atanh(s) / s - 2 (|s| < 0.172 so 10 terms are enough).
+*/
+static ALWAYS_INLINE double     pyc_log(double x)
+{
+    /* bring subnormals into the normal range */
+    bool subnormal = x < 0x1p-1022;
+    double y = subnormal ? x * 0x1p+54 : x;
+    int64_t bits = as_int64(y);
+
+    /* exponent and mantissa in [1, 2) */
+    int64_t e = ((bits >> 52) & 0x7ff) - 1023;
+    double m = as_double((bits & 0x000fffffffffffff) | 0x3ff0000000000000);
+    bool big = m > 0x1.6a09e667f3bcdp+0;
+    m = big ? m * 0.5 : m;
+    e = big ? e + 1 : e;
+    double de = as_double(as_int64(ROUND_SHIFT) + e) - ROUND_SHIFT;
+    de = subnormal ? de - 54 : de;
+
+    double f = m - 1.0;
+    double s = f / (2.0 + f);
+    double z = s * s;
+    double R = 2.0 / 21.0;
+    R = R * z + 2.0 / 19.0;
+    R = R * z + 2.0 / 17.0;
+    R = R * z + 2.0 / 15.0;
+    R = R * z + 2.0 / 13.0;
+    R = R * z + 2.0 / 11.0;
+    R = R * z + 2.0 / 9.0;
+    R = R * z + 2.0 / 7.0;
+    R = R * z + 2.0 / 5.0;
+    R = R * z + 2.0 / 3.0;
+    R = R * z;
+    double log1pf = f - s * (f - R);
+
+    double res = de * LN2_HI + (log1pf + de * LN2_LO);
+    res = x == INFINITY ? INFINITY : res;
+    res = x == 0.0 ? -INFINITY : res;
+    res = x < 0.0 ? NAN : res;
+    res = x != x ? x : res;
+    return res;
+}
+
+/*
+** sine and cosine
+**
+** x = k * pi/2 + r with |r| <= pi/4 using a 3 part Cody-Waite reduction
+** (exact for |x| < SINCOS_MAX), sin(r) and cos(r) are computed with Taylor
+** polynomials and the quadrant k % 4 selects the result. Larger values
+** are handled by the C library.
+*/
+static const double SINCOS_MAX = 0x1p+20;
+static const double TWO_OVER_PI = 0x1.45f306dc9c883p-1;
+static const double PIO2_1 = 0x1.921fb54400000p+0;
+static const double PIO2_2 = 0x1.0b4611a600000p-34;
+static const double PIO2_3 = 0x1.3198a2e037073p-69;
+
+static ALWAYS_INLINE double     sin_poly(double r)
+{
+    double z = r * r;
+    double p = -1.0 / 355687428096000.0;
+    p = p * z + 1.0 / 1307674368000.0;
+    p = p * z - 1.0 / 6227020800.0;
+    p = p * z + 1.0 / 39916800.0;
+    p = p * z - 1.0 / 362880.0;
+    p = p * z + 1.0 / 5040.0;
+    p = p * z - 1.0 / 120.0;
+    p = p * z + 1.0 / 6.0;
+    return r - r * z * p;
+}
+
+static ALWAYS_INLINE double     cos_poly(double r)
+{
+    double z = r * r;
+    double p = 1.0 / 6402373705728000.0;
+    p = p * z - 1.0 / 20922789888000.0;
+    p = p * z + 1.0 / 87178291200.0;
+    p = p * z - 1.0 / 479001600.0;
+    p = p * z + 1.0 / 3628800.0;
+    p = p * z - 1.0 / 40320.0;
+    p = p * z + 1.0 / 720.0;
+    p = p * z - 1.0 / 24.0;
+    p = p * z + 0.5;
+    return 1.0 - z * p;
+}
+
+/* quadrant is 0 for sin and 1 for cos as cos(x) = sin(x + pi/2) */
+static ALWAYS_INLINE double     pyc_sincos(double x, int64_t quadrant)
+{
+    double shifted = x * TWO_OVER_PI + ROUND_SHIFT;
+    double k = shifted - ROUND_SHIFT;
+    int64_t q = (as_int64(shifted) + quadrant) & 3;
+    double r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+
+    double s = sin_poly(r);
+    double c = cos_poly(r);
+    double res = (q & 1) ? c : s;
+    return (q & 2) ? -res : res;
+}
+
+static ALWAYS_INLINE double     pyc_sin(double x)
+{
+    /* keep the sign of zero */
+    return x == 0.0 ? x : pyc_sincos(x, 0);
+}
+
+static ALWAYS_INLINE double     pyc_cos(double x)
+{
+    return pyc_sincos(x, 1);
+}
+
+/*
+** other unary functions
+*/
+
+static ALWAYS_INLINE double     pyc_sqrt(double x)
+{
+    return VSQRT(x);
+}
+
+static ALWAYS_INLINE float      pyc_sqrtf(float x)
+{
+    return VSQRTF(x);
+}
+
+static ALWAYS_INLINE double     pyc_abs(double x)
+{
+    return fabs(x);
+}
+
+static ALWAYS_INLINE float      pyc_absf(float x)
+{
+    return fabsf(x);
+}
+
+/* numpy.sign, NaN is returned for NaN */
+static ALWAYS_INLINE double     pyc_sign(double x)
+{
+    double res = (double)((x > 0) - (x < 0));
+    return x != x ? x : res;
+}
+
+static ALWAYS_INLINE float      pyc_signf(float x)
+{
+    float res = (float)((x > 0) - (x < 0));
+    return x != x ? x : res;
+}
+
+static ALWAYS_INLINE int64_t    pyc_sign_i64(int64_t x)
+{
+    return (x > 0) - (x < 0);
+}
+
+static ALWAYS_INLINE int32_t    pyc_sign_i32(int32_t x)
+{
+    return (x > 0) - (x < 0);
+}
+
+/*
+** modulo
+**
+** Python's modulo has the sign of the divisor: the remainder r of the
+** truncated division (sign of the dividend) is shifted by b when r and b
+** have opposite signs, and a zero result has the sign of b.
+** For floats r = a - n * b where n is the nearest integer to a / b: this
+** value is exactly representable and the fused multiply-add computes it
+** exactly. The quotient must be below 2^51 to be rounded with ROUND_SHIFT,
+** the other elements (an infinite or zero divisor, a huge quotient) are
+** computed with fmod by the fix-up.
+*/
+static const double MOD_MAX_QUOTIENT = 0x1p+51;
+
+/*
+** The shift b is added unconditionally (b or 0) so the compiler does not
+** need to speculate a floating point operation to vectorise the loop. The
+** result (zero included) always has the sign of b.
+*/
+static ALWAYS_INLINE double     python_mod(double r, double b)
+{
+    return copysign(r + ((r != 0.0) & ((r < 0.0) != (b < 0.0)) ? b : 0.0), b);
+}
+
+static ALWAYS_INLINE double     pyc_mod(double a, double b)
+{
+    double n = (a / b + ROUND_SHIFT) - ROUND_SHIFT;
+    return python_mod(fma(-n, b, a), b);
+}
+
+static ALWAYS_INLINE float      pyc_modf(float a, float b)
+{
+    /* the remainder of two floats is computed exactly in double precision */
+    return (float)pyc_mod(a, b);
+}
+
+static inline double            libm_mod(double a, double b)
+{
+    return python_mod(fmod(a, b), b);
+}
+
+static inline float             libm_modf(float a, float b)
+{
+    float r = fmodf(a, b);
+    return copysignf(r + ((r != 0.0f) & ((r < 0.0f) != (b < 0.0f)) ? b : 0.0f), b);
+}
+
+/*
+** Integers are divided in double precision (integer divisions cannot be
+** vectorised) with the same method: n is the nearest integer to a / b and
+** a - n * b is computed exactly with integer arithmetic. A zero divisor is
+** replaced by 1 so the result is 0 like in numpy. 64-bit integers are
+** converted with ROUND_SHIFT which requires |a|, |b| < 2^51, the other
+** elements are computed with an integer division by the fix-up.
+*/
+static const int64_t MOD_MAX_INT = (int64_t)1 << 51;
+
+static ALWAYS_INLINE double     small_int_to_double(int64_t i)
+{
+    /* unsigned arithmetic as the result is discarded for large integers */
+    return as_double((int64_t)((uint64_t)i + (uint64_t)as_int64(ROUND_SHIFT))) - ROUND_SHIFT;
+}
+
+static ALWAYS_INLINE int64_t    pyc_mod_i64(int64_t a, int64_t b)
+{
+    int64_t d = b | (b == 0);
+    double q = small_int_to_double(a) / small_int_to_double(d);
+    uint64_t n = (uint64_t)as_int64(q + ROUND_SHIFT) - (uint64_t)as_int64(ROUND_SHIFT);
+    int64_t r = (int64_t)((uint64_t)a - n * (uint64_t)d);
+    return (int64_t)((uint64_t)r + ((r != 0) & ((r ^ b) < 0) ? (uint64_t)b : 0));
+}
+
+static ALWAYS_INLINE int32_t    pyc_mod_i32(int32_t a, int32_t b)
+{
+    int32_t d = b | (b == 0);
+    double n = ((double)a / (double)d + ROUND_SHIFT) - ROUND_SHIFT;
+    /* exact as |n * d| < 2^32 */
+    int32_t r = (int32_t)((double)a - n * (double)d);
+    return r + ((r != 0) & ((r ^ b) < 0) ? b : 0);
+}
+
+static inline int64_t           idiv_mod_i64(int64_t a, int64_t b)
+{
+    /* b = -1 would overflow for INT64_MIN % -1 */
+    int64_t r = (b == 0) | (b == -1) ? 0 : a % b;
+    return r + ((r != 0) & ((r ^ b) < 0) ? b : 0);
+}
+
+/*
+** greatest common divisor and least common multiple
+**
+** The binary GCD algorithm only uses shifts, subtractions and minimum and
+** maximum operations (no divisions and no data dependent branches in the
+** loop body).
+*/
+#if defined(__GNUC__)
+# define CTZ64(x) __builtin_ctzll(x)
+# define CTZ32(x) __builtin_ctz(x)
+#else
+static inline int   ctz64(uint64_t x) { int n = 0; while (!(x & 1)) { x >>= 1; n++; } return n; }
+static inline int   ctz32(uint32_t x) { return ctz64(x); }
+# define CTZ64(x) ctz64(x)
+# define CTZ32(x) ctz32(x)
+#endif
+
+#define BINARY_GCD_(NAME, UTYPE, CTZ) \
+    static ALWAYS_INLINE UTYPE NAME(UTYPE u, UTYPE v) \
+    { \
+        if (u == 0 || v == 0) \
+            return u | v; \
+        int shift = CTZ(u | v); \
+        u >>= CTZ(u); \
+        do \
+        { \
+            v >>= CTZ(v); \
+            UTYPE m = u < v ? u : v; \
+            v = (u < v ? v : u) - m; \
+            u = m; \
+        } while (v != 0); \
+        return u << shift; \
+    }
+
+BINARY_GCD_(binary_gcd_u64, uint64_t, CTZ64)
+BINARY_GCD_(binary_gcd_u32, uint32_t, CTZ32)
+
+/* absolute values are computed as unsigned integers so INT_MIN is handled */
+static ALWAYS_INLINE uint64_t   uabs64(int64_t x) { return x < 0 ? -(uint64_t)x : (uint64_t)x; }
+static ALWAYS_INLINE uint32_t   uabs32(int32_t x) { return x < 0 ? -(uint32_t)x : (uint32_t)x; }
+
+static ALWAYS_INLINE int64_t    pyc_gcd_i64(int64_t a, int64_t b)
+{
+    return (int64_t)binary_gcd_u64(uabs64(a), uabs64(b));
+}
+
+static ALWAYS_INLINE int32_t    pyc_gcd_i32(int32_t a, int32_t b)
+{
+    return (int32_t)binary_gcd_u32(uabs32(a), uabs32(b));
+}
+
+static ALWAYS_INLINE int64_t    pyc_lcm_i64(int64_t a, int64_t b)
+{
+    uint64_t g = binary_gcd_u64(uabs64(a), uabs64(b));
+    return g == 0 ? 0 : (int64_t)(uabs64(a) / g * uabs64(b));
+}
+
+static ALWAYS_INLINE int32_t    pyc_lcm_i32(int32_t a, int32_t b)
+{
+    uint32_t g = binary_gcd_u32(uabs32(a), uabs32(b));
+    return g == 0 ? 0 : (int32_t)(uabs32(a) / g * uabs32(b));
+}
+
+/* single precision values are computed in double precision */
+static ALWAYS_INLINE float  pyc_expf(float x) { return (float)pyc_exp(x); }
+static ALWAYS_INLINE float  pyc_logf(float x) { return (float)pyc_log(x); }
+static ALWAYS_INLINE float  pyc_sinf(float x) { return (float)pyc_sin(x); }
+static ALWAYS_INLINE float  pyc_cosf(float x) { return (float)pyc_cos(x); }
+
+/*
+** Fix-ups applied to the elements the vectorised functions cannot handle
+*/
+#define NO_FIXUP(BUF, X, X_STRIDE, N, LIBM_FUNC)
+
+#define SINCOS_FIXUP(BUF, X, X_STRIDE, N, LIBM_FUNC) \
+    for (int64_t i = 0; i < N; i++) \
+        if (!(fabs((double)X[i * X_STRIDE]) < SINCOS_MAX)) \
+            BUF[i] = LIBM_FUNC(X[i * X_STRIDE]);
+
+#define NO_FIXUP2(BUF, X1, X1_STRIDE, X2, X2_STRIDE, N, LIBM_FUNC)
+
+#define INT_MOD_FIXUP(BUF, X1, X1_STRIDE, X2, X2_STRIDE, N, LIBM_FUNC) \
+    for (int64_t i = 0; i < N; i++) \
+        if ((uint64_t)X1[i * X1_STRIDE] + MOD_MAX_INT >= 2 * (uint64_t)MOD_MAX_INT \
+                || (uint64_t)X2[i * X2_STRIDE] + MOD_MAX_INT >= 2 * (uint64_t)MOD_MAX_INT) \
+            BUF[i] = LIBM_FUNC(X1[i * X1_STRIDE], X2[i * X2_STRIDE]);
+
+#define MOD_FIXUP(BUF, X1, X1_STRIDE, X2, X2_STRIDE, N, LIBM_FUNC) \
+    for (int64_t i = 0; i < N; i++) \
+        if (!(fabs((double)X1[i * X1_STRIDE] / (double)X2[i * X2_STRIDE]) < MOD_MAX_QUOTIENT) \
+                || isinf(X2[i * X2_STRIDE])) \
+            BUF[i] = LIBM_FUNC(X1[i * X1_STRIDE], X2[i * X2_STRIDE]);
+
+/*
+** Kernels
+**
+** Each kernel computes n elements with arbitrary strides (in elements).
+** The values are first computed into a local buffer which cannot alias the
+** arguments, so the compute loop is always vectorised even when the
+** operation is done in place.
+*/
+#define UNARY_KERNEL_(ISA, ATTRIBUTE, NAME, TYPE, ELEM_FUNC, FIXUP, LIBM_FUNC) \
+    static ATTRIBUTE void NAME##_##ISA(TYPE *out, int64_t out_stride, \
+                                       const TYPE *x, int64_t x_stride, int64_t n) \
+    { \
+        TYPE buf[UFUNC_BLOCK]; \
+        for (int64_t start = 0; start < n; start += UFUNC_BLOCK) \
+        { \
+            int64_t len = n - start < UFUNC_BLOCK ? n - start : UFUNC_BLOCK; \
+            const TYPE *xs = x + start * x_stride; \
+            if (x_stride == 1) \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(xs[i]); \
+            else \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(xs[i * x_stride]); \
+            FIXUP(buf, xs, x_stride, len, LIBM_FUNC) \
+            if (out_stride == 1) \
+                memcpy(out + start, buf, len * sizeof(TYPE)); \
+            else \
+                for (int64_t i = 0; i < len; i++) \
+                    out[(start + i) * out_stride] = buf[i]; \
+        } \
+    }
+
+#define BINARY_KERNEL_(ISA, ATTRIBUTE, NAME, TYPE, ELEM_FUNC, FIXUP, LIBM_FUNC) \
+    static ATTRIBUTE void NAME##_##ISA(TYPE *out, int64_t out_stride, \
+                                       const TYPE *x1, int64_t x1_stride, \
+                                       const TYPE *x2, int64_t x2_stride, int64_t n) \
+    { \
+        TYPE buf[UFUNC_BLOCK]; \
+        for (int64_t start = 0; start < n; start += UFUNC_BLOCK) \
+        { \
+            int64_t len = n - start < UFUNC_BLOCK ? n - start : UFUNC_BLOCK; \
+            const TYPE *a = x1 + start * x1_stride; \
+            const TYPE *b = x2 + start * x2_stride; \
+            if (x1_stride == 1 && x2_stride == 1) \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(a[i], b[i]); \
+            else if (x1_stride == 1 && x2_stride == 0) \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(a[i], b[0]); \
+            else if (x1_stride == 0 && x2_stride == 1) \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(a[0], b[i]); \
+            else \
+                for (int64_t i = 0; i < len; i++) \
+                    buf[i] = ELEM_FUNC(a[i * x1_stride], b[i * x2_stride]); \
+            FIXUP(buf, a, x1_stride, b, x2_stride, len, LIBM_FUNC) \
+            if (out_stride == 1) \
+                memcpy(out + start, buf, len * sizeof(TYPE)); \
+            else \
+                for (int64_t i = 0; i < len; i++) \
+                    out[(start + i) * out_stride] = buf[i]; \
+        } \
+    }
+
+/* the arithmetic operators used as element functions of the binary kernels */
+#define OP_ADD(a, b) ((a) + (b))
+#define OP_SUBTRACT(a, b) ((a) - (b))
+#define OP_MULTIPLY(a, b) ((a) * (b))
+#define OP_DIVIDE(a, b) ((a) / (b))
+
+typedef enum e_unary_ufunc
+{
+    uf_exp,
+    uf_log,
+    uf_sin,
+    uf_cos,
+    uf_sqrt,
+    uf_abs,
+    uf_sign,
+    n_unary_ufuncs
+} t_unary_ufunc;
+
+typedef enum e_binary_ufunc
+{
+    uf_add,
+    uf_subtract,
+    uf_multiply,
+    uf_divide,
+    uf_mod,
+    n_binary_ufuncs
+} t_binary_ufunc;
+
+typedef enum e_int_unary_ufunc
+{
+    uf_int_sign,
+    n_int_unary_ufuncs
+} t_int_unary_ufunc;
+
+typedef enum e_int_binary_ufunc
+{
+    uf_int_mod,
+    uf_int_gcd,
+    uf_int_lcm,
+    n_int_binary_ufuncs
+} t_int_binary_ufunc;
+
+typedef void (*t_unary_kernel_f64)(double*, int64_t, const double*, int64_t, int64_t);
+typedef void (*t_unary_kernel_f32)(float*, int64_t, const float*, int64_t, int64_t);
+typedef void (*t_binary_kernel_f64)(double*, int64_t, const double*, int64_t, const double*, int64_t, int64_t);
+typedef void (*t_binary_kernel_f32)(float*, int64_t, const float*, int64_t, const float*, int64_t, int64_t);
+typedef void (*t_unary_kernel_i64)(int64_t*, int64_t, const int64_t*, int64_t, int64_t);
+typedef void (*t_unary_kernel_i32)(int32_t*, int64_t, const int32_t*, int64_t, int64_t);
+typedef void (*t_binary_kernel_i64)(int64_t*, int64_t, const int64_t*, int64_t, const int64_t*, int64_t, int64_t);
+typedef void (*t_binary_kernel_i32)(int32_t*, int64_t, const int32_t*, int64_t, const int32_t*, int64_t, int64_t);
+
+typedef struct  s_ufunc_kernels
+{
+    const char          *name;
+    t_unary_kernel_f64  unary_f64[n_unary_ufuncs];
+    t_unary_kernel_f32  unary_f32[n_unary_ufuncs];
+    t_binary_kernel_f64 binary_f64[n_binary_ufuncs];
+    t_binary_kernel_f32 binary_f32[n_binary_ufuncs];
+    t_unary_kernel_i64  unary_i64[n_int_unary_ufuncs];
+    t_unary_kernel_i32  unary_i32[n_int_unary_ufuncs];
+    t_binary_kernel_i64 binary_i64[n_int_binary_ufuncs];
+    t_binary_kernel_i32 binary_i32[n_int_binary_ufuncs];
+}               t_ufunc_kernels;
+
+/* define all the kernels for one instruction set */
+#define UFUNC_KERNELS_(ISA, ATTRIBUTE) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, exp_f64, double, pyc_exp, NO_FIXUP, exp) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, log_f64, double, pyc_log, NO_FIXUP, log) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sin_f64, double, pyc_sin, SINCOS_FIXUP, sin) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, cos_f64, double, pyc_cos, SINCOS_FIXUP, cos) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE NO_ERRNO, sqrt_f64, double, pyc_sqrt, NO_FIXUP, sqrt) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, abs_f64, double, pyc_abs, NO_FIXUP, fabs) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sign_f64, double, pyc_sign, NO_FIXUP, sign) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, exp_f32, float, pyc_expf, NO_FIXUP, expf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, log_f32, float, pyc_logf, NO_FIXUP, logf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sin_f32, float, pyc_sinf, SINCOS_FIXUP, sinf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, cos_f32, float, pyc_cosf, SINCOS_FIXUP, cosf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE NO_ERRNO, sqrt_f32, float, pyc_sqrtf, NO_FIXUP, sqrtf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, abs_f32, float, pyc_absf, NO_FIXUP, fabsf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sign_f32, float, pyc_signf, NO_FIXUP, signf) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sign_i64, int64_t, pyc_sign_i64, NO_FIXUP, ) \
+    UNARY_KERNEL_(ISA, ATTRIBUTE, sign_i32, int32_t, pyc_sign_i32, NO_FIXUP, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, add_f64, double, OP_ADD, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, subtract_f64, double, OP_SUBTRACT, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, multiply_f64, double, OP_MULTIPLY, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, divide_f64, double, OP_DIVIDE, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, mod_f64, double, pyc_mod, MOD_FIXUP, libm_mod) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, add_f32, float, OP_ADD, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, subtract_f32, float, OP_SUBTRACT, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, multiply_f32, float, OP_MULTIPLY, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, divide_f32, float, OP_DIVIDE, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, mod_f32, float, pyc_modf, MOD_FIXUP, libm_modf) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, mod_i64, int64_t, pyc_mod_i64, INT_MOD_FIXUP, idiv_mod_i64) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, gcd_i64, int64_t, pyc_gcd_i64, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, lcm_i64, int64_t, pyc_lcm_i64, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, mod_i32, int32_t, pyc_mod_i32, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, gcd_i32, int32_t, pyc_gcd_i32, NO_FIXUP2, ) \
+    BINARY_KERNEL_(ISA, ATTRIBUTE, lcm_i32, int32_t, pyc_lcm_i32, NO_FIXUP2, ) \
+    static const t_ufunc_kernels ufunc_kernels_##ISA = { \
+        #ISA, \
+        {exp_f64_##ISA, log_f64_##ISA, sin_f64_##ISA, cos_f64_##ISA, \
+         sqrt_f64_##ISA, abs_f64_##ISA, sign_f64_##ISA}, \
+        {exp_f32_##ISA, log_f32_##ISA, sin_f32_##ISA, cos_f32_##ISA, \
+         sqrt_f32_##ISA, abs_f32_##ISA, sign_f32_##ISA}, \
+        {add_f64_##ISA, subtract_f64_##ISA, multiply_f64_##ISA, divide_f64_##ISA, mod_f64_##ISA}, \
+        {add_f32_##ISA, subtract_f32_##ISA, multiply_f32_##ISA, divide_f32_##ISA, mod_f32_##ISA}, \
+        {sign_i64_##ISA}, \
+        {sign_i32_##ISA}, \
+        {mod_i64_##ISA, gcd_i64_##ISA, lcm_i64_##ISA}, \
+        {mod_i32_##ISA, gcd_i32_##ISA, lcm_i32_##ISA}, \
+    };
+
+UFUNC_KERNELS_(default, )
+#ifdef UFUNCS_X86_DISPATCH
+UFUNC_KERNELS_(avx2, __attribute__((target("avx2,fma"))))
+UFUNC_KERNELS_(avx512f, __attribute__((target("avx512f,avx2,fma"))))
+#endif
+
+static const t_ufunc_kernels    *get_kernels(void)
+{
+    static const t_ufunc_kernels *kernels = NULL;
+
+    if (kernels == NULL)
+    {
+        const t_ufunc_kernels *best = &ufunc_kernels_default;
+#ifdef UFUNCS_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            best = &ufunc_kernels_avx512f;
+        else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            best = &ufunc_kernels_avx2;
+#endif
+        kernels = best;
+    }
+    return kernels;
+}
+
+const char  *ufuncs_simd_target(void)
+{
+    return get_kernels()->name;
+}
+
+/*
+** Iteration
+**
+** The kernels are called on each line of the innermost dimension of out
+** (the last one for order_c, the first one for order_f). The inputs are
+** broadcast against out: a dimension of length 1 has a stride 0.
+** When all the arrays are contiguous with the same layout, a single call
+** covers the whole buffer.
+*/
+
+static bool     has_layout(t_ndarray arr, t_order order)
+{
+    int64_t expected = 1;
+
+    for (int32_t k = 0; k < arr.nd; k++)
+    {
+        int32_t i = order == order_c ? arr.nd - 1 - k : k;
+        if (arr.shape[i] != 1 && arr.strides[i] != expected)
+            return false;
+        expected *= arr.shape[i];
+    }
+    return true;
+}
+
+static bool     is_same_layout(t_ndarray *out, t_ndarray x)
+{
+    if (x.nd != out->nd)
+        return false;
+    for (int32_t i = 0; i < x.nd; i++)
+        if (x.shape[i] != out->shape[i])
+            return false;
+    return has_layout(*out, out->order) && has_layout(x, out->order);
+}
+
+/* strides of x when broadcast against the shape of out */
+static void     broadcast_strides(t_ndarray *out, t_ndarray x, int64_t *strides)
+{
+    int32_t shift = out->nd - x.nd;
+
+    for (int32_t i = 0; i < out->nd; i++)
+    {
+        int32_t j = i - shift;
+        strides[i] = (j < 0 || x.shape[j] == 1) ? 0 : x.strides[j];
+    }
+}
+
+typedef struct  s_lines
+{
+    int32_t     inner;
+    int64_t     n_lines;
+    int64_t     indices[MAX_NDIM];
+}               t_lines;
+
+static t_lines  init_lines(t_ndarray *out)
+{
+    t_lines lines;
+
+    lines.inner = out->order == order_c ? out->nd - 1 : 0;
+    lines.n_lines = out->length == 0 ? 0 : out->length / out->shape[lines.inner];
+    memset(lines.indices, 0, sizeof(lines.indices));
+    return lines;
+}
+
+/* offset (in elements) of the start of the current line for the given strides */
+static int64_t  line_offset(t_ndarray *out, t_lines *lines, int64_t *strides)
+{
+    int64_t offset = 0;
+
+    for (int32_t i = 0; i < out->nd; i++)
+        offset += lines->indices[i] * strides[i];
+    return offset;
+}
+
+static void     next_line(t_ndarray *out, t_lines *lines)
+{
+    for (int32_t k = 0; k < out->nd; k++)
+    {
+        int32_t i = out->order == order_c ? out->nd - 1 - k : k;
+        if (i == lines->inner)
+            continue;
+        if (++lines->indices[i] < out->shape[i])
+            return;
+        lines->indices[i] = 0;
+    }
+}
+
+#define APPLY_UNARY_(NAME, TYPE, CTYPE, TABLE, UFUNC) \
+    void numpy_##NAME(t_ndarray *out, t_ndarray x) \
+    { \
+        TABLE kernel = get_kernels()->UFUNC; \
+        if (is_same_layout(out, x)) \
+        { \
+            kernel(out->nd_##CTYPE, 1, x.nd_##CTYPE, 1, out->length); \
+            return; \
+        } \
+        int64_t x_strides[MAX_NDIM]; \
+        broadcast_strides(out, x, x_strides); \
+        t_lines lines = init_lines(out); \
+        for (int64_t l = 0; l < lines.n_lines; l++, next_line(out, &lines)) \
+            kernel(out->nd_##CTYPE + line_offset(out, &lines, out->strides), \
+                   out->strides[lines.inner], \
+                   x.nd_##CTYPE + line_offset(out, &lines, x_strides), \
+                   x_strides[lines.inner], out->shape[lines.inner]); \
+    }
+
+#define APPLY_BINARY_(NAME, TYPE, CTYPE, TABLE, UFUNC) \
+    void numpy_##NAME(t_ndarray *out, t_ndarray x1, t_ndarray x2) \
+    { \
+        TABLE kernel = get_kernels()->UFUNC; \
+        if (is_same_layout(out, x1) && is_same_layout(out, x2)) \
+        { \
+            kernel(out->nd_##CTYPE, 1, x1.nd_##CTYPE, 1, x2.nd_##CTYPE, 1, out->length); \
+            return; \
+        } \
+        int64_t x1_strides[MAX_NDIM]; \
+        int64_t x2_strides[MAX_NDIM]; \
+        broadcast_strides(out, x1, x1_strides); \
+        broadcast_strides(out, x2, x2_strides); \
+        t_lines lines = init_lines(out); \
+        for (int64_t l = 0; l < lines.n_lines; l++, next_line(out, &lines)) \
+            kernel(out->nd_##CTYPE + line_offset(out, &lines, out->strides), \
+                   out->strides[lines.inner], \
+                   x1.nd_##CTYPE + line_offset(out, &lines, x1_strides), \
+                   x1_strides[lines.inner], \
+                   x2.nd_##CTYPE + line_offset(out, &lines, x2_strides), \
+                   x2_strides[lines.inner], out->shape[lines.inner]); \
+    }
+
+APPLY_UNARY_(exp_float64, double, double, t_unary_kernel_f64, unary_f64[uf_exp])
+APPLY_UNARY_(log_float64, double, double, t_unary_kernel_f64, unary_f64[uf_log])
+APPLY_UNARY_(sin_float64, double, double, t_unary_kernel_f64, unary_f64[uf_sin])
+APPLY_UNARY_(cos_float64, double, double, t_unary_kernel_f64, unary_f64[uf_cos])
+APPLY_UNARY_(sqrt_float64, double, double, t_unary_kernel_f64, unary_f64[uf_sqrt])
+APPLY_UNARY_(abs_float64, double, double, t_unary_kernel_f64, unary_f64[uf_abs])
+APPLY_UNARY_(sign_float64, double, double, t_unary_kernel_f64, unary_f64[uf_sign])
+
+APPLY_UNARY_(exp_float32, float, float, t_unary_kernel_f32, unary_f32[uf_exp])
+APPLY_UNARY_(log_float32, float, float, t_unary_kernel_f32, unary_f32[uf_log])
+APPLY_UNARY_(sin_float32, float, float, t_unary_kernel_f32, unary_f32[uf_sin])
+APPLY_UNARY_(cos_float32, float, float, t_unary_kernel_f32, unary_f32[uf_cos])
+APPLY_UNARY_(sqrt_float32, float, float, t_unary_kernel_f32, unary_f32[uf_sqrt])
+APPLY_UNARY_(abs_float32, float, float, t_unary_kernel_f32, unary_f32[uf_abs])
+APPLY_UNARY_(sign_float32, float, float, t_unary_kernel_f32, unary_f32[uf_sign])
+
+APPLY_BINARY_(add_float64, double, double, t_binary_kernel_f64, binary_f64[uf_add])
+APPLY_BINARY_(subtract_float64, double, double, t_binary_kernel_f64, binary_f64[uf_subtract])
+APPLY_BINARY_(multiply_float64, double, double, t_binary_kernel_f64, binary_f64[uf_multiply])
+APPLY_BINARY_(divide_float64, double, double, t_binary_kernel_f64, binary_f64[uf_divide])
+
+APPLY_BINARY_(add_float32, float, float, t_binary_kernel_f32, binary_f32[uf_add])
+APPLY_BINARY_(subtract_float32, float, float, t_binary_kernel_f32, binary_f32[uf_subtract])
+APPLY_BINARY_(multiply_float32, float, float, t_binary_kernel_f32, binary_f32[uf_multiply])
+APPLY_BINARY_(divide_float32, float, float, t_binary_kernel_f32, binary_f32[uf_divide])
+APPLY_BINARY_(mod_float64, double, double, t_binary_kernel_f64, binary_f64[uf_mod])
+APPLY_BINARY_(mod_float32, float, float, t_binary_kernel_f32, binary_f32[uf_mod])
+
+APPLY_UNARY_(sign_int64, int64_t, int64, t_unary_kernel_i64, unary_i64[uf_int_sign])
+APPLY_UNARY_(sign_int32, int32_t, int32, t_unary_kernel_i32, unary_i32[uf_int_sign])
+
+APPLY_BINARY_(mod_int64, int64_t, int64, t_binary_kernel_i64, binary_i64[uf_int_mod])
+APPLY_BINARY_(gcd_int64, int64_t, int64, t_binary_kernel_i64, binary_i64[uf_int_gcd])
+APPLY_BINARY_(lcm_int64, int64_t, int64, t_binary_kernel_i64, binary_i64[uf_int_lcm])
+APPLY_BINARY_(mod_int32, int32_t, int32, t_binary_kernel_i32, binary_i32[uf_int_mod])
+APPLY_BINARY_(gcd_int32, int32_t, int32, t_binary_kernel_i32, binary_i32[uf_int_gcd])
+APPLY_BINARY_(lcm_int32, int32_t, int32, t_binary_kernel_i32, binary_i32[uf_int_lcm])
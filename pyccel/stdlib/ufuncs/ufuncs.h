@@ -0,0 +1,67 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * File containing elementwise kernels for NumPy's universal functions.
+ * The kernels operate on whole ndarrays. Contiguous arrays are processed by
+ * SIMD loops compiled for the best instruction set available on the machine
+ * (chosen at runtime), other arrays fall back to a strided loop. The output
+ * array must already be allocated with the shape of the result, the inputs
+ * are broadcast against it.
+ */
+
+#ifndef UFUNCS_H
+# define UFUNCS_H
+
+# include <stdint.h>
+# include "ndarrays.h"
+
+/* unary functions */
+void    numpy_exp_float64(t_ndarray *out, t_ndarray x);
+void    numpy_log_float64(t_ndarray *out, t_ndarray x);
+void    numpy_sin_float64(t_ndarray *out, t_ndarray x);
+void    numpy_cos_float64(t_ndarray *out, t_ndarray x);
+void    numpy_sqrt_float64(t_ndarray *out, t_ndarray x);
+void    numpy_abs_float64(t_ndarray *out, t_ndarray x);
+void    numpy_sign_float64(t_ndarray *out, t_ndarray x);
+
+void    numpy_exp_float32(t_ndarray *out, t_ndarray x);
+void    numpy_log_float32(t_ndarray *out, t_ndarray x);
+void    numpy_sin_float32(t_ndarray *out, t_ndarray x);
+void    numpy_cos_float32(t_ndarray *out, t_ndarray x);
+void    numpy_sqrt_float32(t_ndarray *out, t_ndarray x);
+void    numpy_abs_float32(t_ndarray *out, t_ndarray x);
+void    numpy_sign_float32(t_ndarray *out, t_ndarray x);
+
+void    numpy_sign_int64(t_ndarray *out, t_ndarray x);
+void    numpy_sign_int32(t_ndarray *out, t_ndarray x);
+
+/* binary arithmetic */
+void    numpy_add_float64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_subtract_float64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_multiply_float64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_divide_float64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+
+void    numpy_add_float32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_subtract_float32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_multiply_float32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_divide_float32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+
+/* modulo with the semantics of Python (the result has the sign of x2) */
+void    numpy_mod_float64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_mod_float32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_mod_int64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_mod_int32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+
+/* greatest common divisor and least common multiple (always positive) */
+void    numpy_gcd_int64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_gcd_int32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_lcm_int64(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+void    numpy_lcm_int32(t_ndarray *out, t_ndarray x1, t_ndarray x2);
+
+/* name of the instruction set used by the kernels (e.g. "avx2") */
+const char  *ufuncs_simd_target(void);
+
+#endif
@@ -0,0 +1,285 @@
+#------------------------------------------------------------------------------------------#
+# This file is part of Pyccel which is released under MIT License. See the LICENSE file or #
+# go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details.     #
+#------------------------------------------------------------------------------------------#
+"""
+Module containing the tools used to measure the time spent in the different parts of Pyccel.
+"""
+from contextlib import contextmanager
+import json
+import os
+import sys
+import threading
+import time
+
+try:
+    import resource
+except ImportError: # Windows
+    resource = None
+
+from pyccel.version import __version__
+from .metaclasses import Singleton
+
+__all__ = ('Profiler', 'Span')
+
+#==============================================================================
+def peak_memory(who = 'self'):
+    """
+    Get the peak resident memory.
+
+    Get the peak resident set size of the process or of its terminated children
+    (e.g. the compilers) in KiB. None is returned if it cannot be measured.
+
+    Parameters
+    ----------
+    who : {'self', 'children'}
+        The processes whose memory is measured.
+
+    Returns
+    -------
+    int | None
+        The peak resident memory in KiB.
+    """
+    if resource is None:
+        return None
+    usage = resource.getrusage(resource.RUSAGE_SELF if who == 'self' else resource.RUSAGE_CHILDREN)
+    # ru_maxrss is given in bytes on macOS
+    return usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+
+#==============================================================================
+class Span:
+    """
+    Class describing a measured part of the execution.
+
+    Class describing a part of the execution of Pyccel (a stage, the treatment of
+    a module or of a function, a compiler command, etc.) with the time at which it
+    started and stopped.
+
+    Parameters
+    ----------
+    name : str
+        The name of the span.
+    category : str
+        The kind of span (e.g. 'stage', 'module', 'function', 'compile', 'subprocess').
+    start : float
+        The time (from time.time) at which the span started.
+    end : float
+        The time (from time.time) at which the span stopped.
+    args : dict
+        Any additional information about the span.
+    """
+    __slots__ = ('name', 'category', 'start', 'end', 'thread', 'peak_rss', 'args')
+
+    def __init__(self, name, category, start, end, args):
+        self.name = name
+        self.category = category
+        self.start = start
+        self.end = end
+        self.thread = threading.get_ident()
+        self.peak_rss = peak_memory()
+        self.args = args
+
+    @property
+    def duration(self):
+        """ The time spent in the span (in seconds).
+        """
+        return self.end - self.start
+
+    def contains(self, other):
+        """
+        Indicate whether another span happens during this one.
+
+        Parameters
+        ----------
+        other : Span
+            The other span.
+
+        Returns
+        -------
+        bool
+            True if the other span starts and stops while this one is running.
+        """
+        return self.start <= other.start and other.end <= self.end
+
+#==============================================================================
+class Profiler(metaclass = Singleton):
+    """
+    Class collecting the spans measured during the execution of Pyccel.
+
+    Class collecting the spans (see Span) measured during the execution of
+    Pyccel. The spans can be recorded from any thread. They can be exported
+    as a tree (where each span contains the spans which happened during it)
+    in JSON format, or in the Chrome trace event format which can be opened
+    with chrome://tracing or Perfetto.
+    """
+    def __init__(self):
+        self._spans = []
+        self._lock = threading.Lock()
+
+    def reset(self):
+        """
+        Forget the spans recorded so far.
+        """
+        with self._lock:
+            self._spans = []
+
+    @property
+    def spans(self):
+        """ The spans recorded so far (in the order in which they finished).
+        """
+        return tuple(self._spans)
+
+    def record(self, name, category, start, end = None, **args):
+        """
+        Record a span which has finished.
+
+        Record a span which started at the time `start` and stopped at the time
+        `end`.
+
+        Parameters
+        ----------
+        name : str
+            The name of the span.
+        category : str
+            The kind of span.
+        start : float
+            The time (from time.time) at which the span started.
+        end : float, optional
+            The time (from time.time) at which the span stopped. Default is now.
+        **args : dict
+            Any additional information about the span.
+
+        Returns
+        -------
+        float
+            The duration of the span in seconds.
+        """
+        if end is None:
+            end = time.time()
+        span = Span(name, category, start, end, args)
+        with self._lock:
+            self._spans.append(span)
+        return span.duration
+
+    @contextmanager
+    def span(self, name, category, **args):
+        """
+        Measure the code executed in a with block.
+
+        Record a span for the code executed in the with block. The dictionary of
+        arguments is given to the with block so that it can add information to
+        the span.
+
+        Parameters
+        ----------
+        name : str
+            The name of the span.
+        category : str
+            The kind of span.
+        **args : dict
+            Any additional information about the span.
+
+        Yields
+        ------
+        dict
+            The arguments of the span.
+        """
+        start = time.time()
+        try:
+            yield args
+        finally:
+            self.record(name, category, start, **args)
+
+    def as_tree(self):
+        """
+        Get the spans nested in one another.
+
+        Get a list of dictionaries describing the spans which did not happen
+        during another span. Each dictionary contains the spans which happened
+        during it under the key 'children'. The times are given in seconds from
+        the start of the first span.
+
+        Returns
+        -------
+        list of dict
+            The spans which did not happen during another span.
+        """
+        spans = sorted(self._spans, key = lambda s: (s.start, -s.end))
+        if not spans:
+            return []
+        origin = spans[0].start
+        main_thread = threading.main_thread().ident
+        roots = []
+        # The spans which may contain the next spans
+        open_spans = []
+        for s in spans:
+            node = {'name'     : s.name,
+                    'category' : s.category,
+                    'start'    : s.start - origin,
+                    'duration' : s.duration,
+                    'thread'   : s.thread,
+                    'peak_rss_kib' : s.peak_rss,
+                    'args'     : s.args,
+                    'children' : []}
+            # Spans measured in a worker thread (e.g. concurrent compilations) are
+            # placed in the main thread span which contains them
+            parent = next((n for o, n in reversed(open_spans) if o.thread == s.thread and o.contains(s)),
+                    next((n for o, n in reversed(open_spans) if o.thread == main_thread and o.contains(s)), None))
+            if parent is None:
+                roots.append(node)
+            else:
+                parent['children'].append(node)
+            open_spans = [(o, n) for o, n in open_spans if o.end > s.start]
+            open_spans.append((s, node))
+        return roots
+
+    def as_chrome_trace(self):
+        """
+        Get the spans in the Chrome trace event format.
+
+        Get a dictionary describing the spans in the Chrome trace event format.
+        Each span is a complete event, the peak memory of the process is given
+        as a counter.
+
+        Returns
+        -------
+        dict
+            The trace.
+        """
+        spans = sorted(self._spans, key = lambda s: (s.start, -s.end))
+        origin = spans[0].start if spans else 0
+        pid = os.getpid()
+        events = []
+        for s in spans:
+            events.append({'name' : s.name, 'cat' : s.category, 'ph' : 'X',
+                           'ts' : (s.start - origin) * 1e6, 'dur' : s.duration * 1e6,
+                           'pid' : pid, 'tid' : s.thread, 'args' : s.args})
+            if s.peak_rss is not None:
+                events.append({'name' : 'peak_rss_kib', 'ph' : 'C', 'ts' : (s.end - origin) * 1e6,
+                               'pid' : pid, 'args' : {'peak_rss_kib' : s.peak_rss}})
+        return {'traceEvents' : events,
+                'displayTimeUnit' : 'ms',
+                'otherData' : {'pyccel' : __version__}}
+
+    def export(self, filename, file_format = 'json'):
+        """
+        Export the spans to a file.
+
+        Export the spans to a file, either as a tree (see `as_tree`) or in the
+        Chrome trace event format (see `as_chrome_trace`).
+
+        Parameters
+        ----------
+        filename : str
+            The name of the file.
+        file_format : {'json', 'chrome'}
+            The format of the file.
+        """
+        if file_format == 'chrome':
+            description = self.as_chrome_trace()
+        elif file_format == 'json':
+            description = {'pyccel' : __version__, 'unit' : 's', 'spans' : self.as_tree()}
+        else:
+            raise ValueError(f"Unknown timings format : {file_format}")
+        with open(filename, 'w', encoding="utf-8") as f:
+            json.dump(description, f, indent = 1, default = str)
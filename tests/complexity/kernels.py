@@ -0,0 +1,43 @@
+# pylint: disable=missing-function-docstring, missing-module-docstring
+import numpy as np
+
+def mxm(a : 'float[:,:]', b : 'float[:,:]', c : 'float[:,:]'):
+    n, m = a.shape
+    p = b.shape[1]
+    for i in range(n):
+        for j in range(p):
+            for k in range(m):
+                c[i, j] += a[i, k] * b[k, j]
+
+def row_sum(x : 'float[:,:](order=F)', s : 'float[:]'):
+    n, m = x.shape
+    for i in range(n):
+        for j in range(m):
+            s[i] = s[i] + x[i, j]
+
+def column_sum(x : 'float[:,:](order=F)', s : 'float[:]'):
+    n, m = x.shape
+    for j in range(m):
+        for i in range(n):
+            s[j] = s[j] + x[i, j]
+
+def axpy(a : float, x : 'float[:]', y : 'float[:]'):
+    y[:] = a * x + y
+
+def every_other():
+    x = np.ones(64)
+    for i in range(32):
+        x[2*i] = np.sqrt(x[2*i+1])
+    return x
+
+def square(x : float):
+    return x * x
+
+def call_in_loop(x : 'float[:]'):
+    s = 0.0
+    for i in range(10):
+        s += square(x[i])
+    return s
+
+def product(a : 'float[:,:]', b : 'float[:,:]'):
+    return np.sum(np.matmul(a, b))
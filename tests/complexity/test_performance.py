@@ -0,0 +1,85 @@
+# pylint: disable=missing-function-docstring, missing-module-docstring
+import json
+import os
+import pytest
+
+from pyccel.complexity.performance import PerfComplexity, MachineProfile
+
+base_dir = os.path.dirname(os.path.realpath(__file__))
+kernels_file = os.path.join(base_dir, 'kernels.py')
+
+@pytest.fixture(scope='module')
+def costs():
+    return PerfComplexity(kernels_file).cost(extent = 100)
+
+def test_loops_with_unknown_shapes(costs):
+    cost = costs['mxm']
+    assert cost.assumed_extent
+    assert cost.flops == 2 * 100**3
+    # c[i, j] is read and written once for all the iterations over k and
+    # each access to b[k, j] moves a cache line
+    assert cost.bytes_written == 8 * 100**2
+    assert cost.bytes_read == 8 * 100**2 + 8 * 100**3 + 64 * 100**3
+
+def test_non_unit_stride(costs):
+    strided, = costs['mxm'].strided
+    assert strided.array == 'b'
+    assert strided.axis == 0
+    assert strided.line == 9
+
+    strided, = costs['row_sum'].strided
+    assert strided.array == 'x'
+    assert strided.axis == 1
+    assert 'order F' in str(strided)
+
+    assert costs['column_sum'].strided == ()
+    assert costs['column_sum'].intensity > costs['row_sum'].intensity
+
+def test_array_expressions(costs):
+    cost = costs['axpy']
+    assert cost.flops == 2 * 100
+    assert cost.bytes_read == 2 * 8 * 100
+    assert cost.bytes_written == 8 * 100
+    assert cost.strided == ()
+
+def test_known_sizes(costs):
+    cost = costs['every_other']
+    assert not cost.assumed_extent
+    assert cost.flops == 32
+    assert cost.bytes_read == 32 * 16
+    assert cost.bytes_written == 64 * 8 + 32 * 16
+    assert {s.stride for s in cost.strided} == {2}
+
+def test_function_calls(costs):
+    assert costs['square'].flops == 1
+    cost = costs['call_in_loop']
+    assert cost.flops == 10 * 2
+    assert cost.bytes_read == 10 * 8
+
+def test_reductions(costs):
+    cost = costs['product']
+    assert cost.flops == 2 * 100**3 + 100**2
+    # The product is stored in a temporary array which is read by the sum
+    assert cost.bytes_read == 3 * 8 * 100**2
+    assert cost.bytes_written == 8 * 100**2
+
+def test_roofline_report(tmp_path):
+    profile_file = str(tmp_path / 'machine.json')
+    with open(profile_file, 'w', encoding='utf-8') as f:
+        json.dump({'name' : 'test machine', 'peak_gflops' : 100, 'bandwidth_gbs' : 10}, f)
+    machine = MachineProfile.load(profile_file)
+    assert machine.ridge_point == 10
+    assert machine.attainable_gflops(1) == 10
+    assert machine.attainable_gflops(100) == 100
+
+    report = PerfComplexity(kernels_file).report(profile_file)
+    lines = report.split('\n')
+    assert 'test machine' in lines[1]
+    bounds = {l.split()[0] : l.split()[-1] for l in lines[4:] if l.endswith(('memory', 'compute'))}
+    assert bounds['axpy*'] == 'memory'
+    assert bounds['product*'] == 'compute'
+    assert 'Non-unit-stride accesses in the innermost loops:' in lines
+
+def test_unknown_profile():
+    with pytest.raises(ValueError):
+        MachineProfile.load('no_such_machine')
@@ -1,7 +1,7 @@
 # pylint: disable=missing-function-docstring, missing-module-docstring
 import numpy as np
 
-from pyccel.decorators import template, stack_array, allow_negative_index
+from pyccel.decorators import template, stack_array, allow_negative_index, nogil
 
 a_1d   = np.array([1 << i for i in range(21)], dtype=int)
 a_1d_f = np.array([1 << i for i in range(21)], dtype=int, order="F")
@@ -650,6 +650,33 @@ def multiple_2d_stack_array_2():
             s = s + b[i][j] - a[j] / c[i][j]
     return s
 
+@stack_array('a')
+def array_float_stack_array_runtime_size(n : int):
+    from numpy import zeros
+    a = zeros(n)
+    for i in range(n):
+        a[i] = i
+    s = 0.
+    for i in range(n):
+        s += a[i]
+    return s
+
+@stack_array('a')
+def array_int_2d_stack_array_order_f(n : int):
+    from numpy import zeros
+    a = zeros((n, 3), dtype=int, order='F')
+    for i in range(n):
+        for j in range(3):
+            a[i, j] = 3 * i + j
+    return a[n-1, 0], a[0, 2], a[n-1, 2]
+
+def array_float_local_arrays(x : 'float[:]', n : int):
+    from numpy import empty, ones
+    a = empty(x.shape[0])
+    b = ones(n)
+    a[:] = 2 * x
+    return a[0] + a[-1] + b[n-1]
+
 #==============================================================================
 # TEST: Array with ndmin argument
 #==============================================================================
@@ -715,9 +742,33 @@ def array_float_2d_2d_matmul_mixorder(A : 'float[:,:]', B : 'float[:,:](order=F)
     from numpy import matmul
     out[:,:] = matmul(A, B)
 
+# Mixed order, not supported currently, see #244
+def array_float_2d_2d_matmul_F_C_F(A : 'float[:,:](order=F)', B : 'float[:,:]', out : 'float[:,:](order=F)'):
+    from numpy import matmul
+    out[:,:] = matmul(A, B)
+
 def array_float_2d_2d_matmul_operator(A : 'float[:,:]', B : 'float[:,:]', out : 'float[:,:]'):
     out[:,:] = A @ B
 
+def array_float_2d_2d_matmul_inplace(B : 'float[:,:]', out : 'float[:,:]'):
+    out[:,:] = out[:,:] @ B
+
+def array_float_2d_1d_matmul_inplace(A : 'float[:,:]', y : 'float[:]'):
+    y[:] = A @ y[:]
+
+def array_float_1d_1d_matmul(x : 'float[:]', y : 'float[:]'):
+    return x @ y
+
+def array_int_2d_2d_matmul(A : 'int32[:,:]', B : 'int32[:,:]', out : 'int32[:,:]'):
+    out[:,:] = A @ B
+
+def array_complex_2d_2d_matmul(A : 'complex[:,:]', B : 'complex[:,:](order=F)', out : 'complex[:,:]'):
+    out[:,:] = A @ B
+
+def array_float_2d_2d_matmul_expression(A : 'float[:,:]', B : 'float[:,:]', x : 'float[:]', out : 'float[:,:]'):
+    out[:,:] = 2.0 * (A @ B) + 1.0
+    return x @ (B @ A) @ x
+
 def array_float_loopdiff(x : 'float[:]', y : 'float[:]', out : 'float[:]'):
     dxy = x - y
     for k in range(len(x)):
@@ -2075,3 +2126,88 @@ def unpack_array_2D_of_known_size():
     arr = array([[1,2,3], [4,5,6], [7,8,9]], dtype='float64')
     x, y, z = arr[:]
     return x.sum(), y.sum(), z.sum()
+
+#==============================================================================
+# Fused array expressions
+#==============================================================================
+
+def array_expression_shifted_copy(n : int):
+    from numpy import arange
+    x = arange(n)
+    x[1:] = x[:-1] + 1
+    return x[0], x[1], x[n-1]
+
+def array_expression_reversed(x : 'int[:]'):
+    from numpy import empty_like
+    y = empty_like(x)
+    y[:] = x[::-1] + 1
+    x[:] = x[::-1]
+    return y[0], y[-1], x[0], x[-1]
+
+def array_expression_pointer(x : 'float[:]'):
+    y = x[::2]
+    x[:5] = y * 2
+    return x[0], x[1], x[4]
+
+def array_expression_order_f(x : 'float[:,:](order=F)', y : 'float[:,:](order=F)'):
+    from numpy import empty_like
+    z = empty_like(x)
+    z[:,:] = 2 * x - y
+    return z[0, 0], z[-1, 0], z[0, -1]
+
+def array_expression_transpose_inplace(x : 'float[:,:]'):
+    x[:,:] = x.T
+
+def array_expression_transpose_sum(x : 'float[:,:]'):
+    x[:,:] = 2 * x.T + x
+
+#==============================================================================
+# Arrays stored in files
+#==============================================================================
+
+def array_float_2d_load():
+    from numpy import load
+    x : 'float[:,:]' = load('arrays_load.npy')
+    return x.shape[0], x.shape[1], x[0, 0], x[2, 1], x[-1, -1]
+
+def array_float_2d_load_missing():
+    from numpy import load
+    x : 'float[:,:]' = load('arrays_load_missing.npy', mmap_mode='r')
+    return x[0, 0]
+
+def array_float_2d_load_mmap():
+    from numpy import load
+    x : 'float[:,:](order=F)' = load('arrays_load_order_f.npy', mmap_mode='r')
+    s = 0.0
+    for j in range(x.shape[1]):
+        for i in range(x.shape[0]):
+            s += x[i, j] * (i + 1)
+    return s
+
+def array_float_2d_load_copy_on_write():
+    from numpy import load
+    x : 'float[:,:]' = load('arrays_load.npy', mmap_mode='c')
+    x[0, :] = -1.0
+    return x[0, 0], x[1, 0]
+
+def array_int32_memmap_write(n : int):
+    from numpy import memmap, int32
+    y = memmap('arrays_memmap.bin', dtype=int32, mode='w+', offset=64, shape=(n, 3), order='F')
+    for j in range(3):
+        for i in range(n):
+            y[i, j] = 10 * i + j
+
+@nogil
+def array_int32_memmap_sum(n : int):
+    from numpy import memmap, int32
+    y = memmap('arrays_memmap.bin', dtype=int32, mode='r', offset=64, shape=(n, 3), order='F')
+    s = 0
+    for j in range(3):
+        for i in range(n):
+            s += y[i, j]
+    return s
+
+def array_int32_memmap_read(n : int):
+    from numpy import memmap, int32
+    y = memmap('arrays_memmap.bin', dtype=int32, mode='r', offset=64, shape=(n, 3), order='F')
+    return y[0, 1], y[n-1, 2]
@@ -58,6 +58,11 @@ def double_loop_on_2d_array_F(z : 'int[:,:](order=F)'):
         for j in range( n ):
             z[i,j] = i-j
 
+# ...
+def axpy_loop_on_1d_arrays(a : int, x : 'int[:]', y : 'int[:]'):
+    for i in range(x.shape[0]):
+        y[i] = a * x[i] + y[i]
+
 # ...
 def product_loop_on_2d_array_C(z : 'int[:,:](order=C)'):
 
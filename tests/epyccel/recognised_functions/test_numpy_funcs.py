@@ -2181,10 +2181,7 @@ def test_array_new_dtype(language):
 
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="rand not implemented"),
-            pytest.mark.c]
-        ),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("python", marks = pytest.mark.python)
     )
 )
@@ -2202,10 +2199,7 @@ def test_rand_basic(language):
 
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="rand not implemented"),
-            pytest.mark.c]
-        ),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("python", marks = pytest.mark.python)
     )
 )
@@ -2266,10 +2260,7 @@ def test_rand_args(language):
 
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="rand not implemented"),
-            pytest.mark.c]
-        ),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("python", marks = pytest.mark.python)
     )
 )
@@ -2286,7 +2277,18 @@ def test_rand_expr(language):
     assert(all([isinstance(yi,float) for yi in y]))
     assert(len(set(y))>1)
 
-@pytest.mark.xfail(reason="a is not allocated")
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.xfail(reason="a is not allocated"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = [
+            pytest.mark.xfail(reason="a is not allocated"),
+            pytest.mark.python]
+        )
+    )
+)
 def test_rand_expr_array(language):
     def create_array_vals_2d():
         from numpy.random import rand # pylint: disable=reimported
@@ -2302,10 +2304,7 @@ def test_rand_expr_array(language):
 
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="randint not implemented"),
-            pytest.mark.c]
-        ),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("python", marks = pytest.mark.python)
     )
 )
@@ -2345,10 +2344,7 @@ def test_randint_basic(language):
 
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="randint not implemented"),
-            pytest.mark.c]
-        ),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("python", marks = pytest.mark.python)
     )
 )
@@ -2377,6 +2373,111 @@ def test_randint_expr(language):
     assert(all([isinstance(yi,int) for yi in y]))
     assert(len(set(y))>1)
 
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="randint with a size is not implemented in fortran"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+)
+def test_randint_array(language):
+    def create_array(n : 'int'):
+        from numpy.random import randint # pylint: disable=reimported
+        from numpy import amin, amax
+        a = randint(-3, 4, n)
+        return amin(a), amax(a)
+
+    f1 = epyccel(create_array, language = language)
+    assert f1(1000) == (-3, 3)
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="numpy.random.normal is not implemented in fortran"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+)
+def test_random_normal(language):
+    def create_val():
+        from numpy.random import normal
+        return normal(), normal(2.0), normal(1.0, 0.5)
+
+    def create_array_moments(n : 'int', loc : 'float', scale : 'float'):
+        from numpy.random import normal
+        a = normal(loc, scale, size = n)
+        mean = 0.0
+        for i in range(n):
+            mean += a[i]
+        mean /= n
+        var = 0.0
+        for i in range(n):
+            var += (a[i] - mean)**2
+        return mean, var / n
+
+    f1 = epyccel(create_val, language = language)
+    y = f1()
+    assert(all([isinstance(yi,float) for yi in y]))
+    assert(len(set(y))>1)
+
+    f2 = epyccel(create_array_moments, language = language)
+    mean, var = f2(100000, 2.0, 3.0)
+    assert abs(mean - 2.0) < 0.1
+    assert abs(var - 9.0) < 0.5
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="numpy.random.seed is not implemented in fortran"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+)
+def test_random_seed(language):
+    def draw(s : 'int', n : 'int'):
+        from numpy.random import seed, random, randint, normal
+        seed(s)
+        a = random(n)
+        b = normal(size = n)
+        return random(), randint(1000000), normal(), a[n-1], b[n-1]
+
+    f1 = epyccel(draw, language = language)
+    assert f1(3, 10) == f1(3, 10)
+    assert f1(3, 10) != f1(4, 10)
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="numpy.random.normal is not implemented in fortran"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+)
+def test_random_invalid_arguments(language):
+    def draw_int(low : 'int', high : 'int'):
+        from numpy.random import randint
+        return randint(low, high)
+
+    def draw_array(n : 'int', scale : 'float'):
+        from numpy.random import normal
+        a = normal(0.0, scale, n)
+        return a[0]
+
+    f1 = epyccel(draw_int, language = language)
+    with pytest.raises(ValueError):
+        f1(5, 5)
+    assert f1(5, 6) == 5
+
+    f2 = epyccel(draw_array, language = language)
+    with pytest.raises(ValueError):
+        f2(10, -1.0)
+    assert isinstance(f2(10, 1.0), float)
+
 def test_sum_int(language):
     def sum_call(x : 'int[:]'):
         from numpy import sum as np_sum
@@ -2569,6 +2670,93 @@ def test_max_property(language):
     x = randint(99,size=10)
     assert(f1(x) == max_call(x))
 
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="maxval returns -huge for an empty array"),
+            pytest.mark.fortran]
+        ),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+)
+def test_max_min_empty(language):
+    def max_call(x : 'float[:]'):
+        from numpy import amax
+        return amax(x)
+    def min_call(x : 'int[:]'):
+        return x.min()
+
+    f1 = epyccel(max_call, language = language)
+    f2 = epyccel(min_call, language = language)
+    with pytest.raises(ValueError):
+        f1(np.empty(0))
+    with pytest.raises(ValueError):
+        f2(np.empty(0, dtype=int))
+    x = randint(99,size=10)
+    assert(f2(x) == min_call(x))
+
+def test_sum_axis(language):
+    def sum_axis_0(x : 'float[:,:]'):
+        from numpy import sum as np_sum
+        s = np_sum(x, axis = 0)
+        return s
+    def sum_axis_1(x : 'float[:,:]'):
+        s = x.sum(axis = 1)
+        return s
+    def sum_keepdims(x : 'int32[:,:]'):
+        from numpy import sum as np_sum
+        s = np_sum(x, axis = -1, keepdims = True)
+        return s
+
+    f1 = epyccel(sum_axis_0, language = language)
+    f2 = epyccel(sum_axis_1, language = language)
+    f3 = epyccel(sum_keepdims, language = language)
+    x = rand(200, 7)
+    assert np.allclose(f1(x), sum_axis_0(x), rtol=RTOL, atol=ATOL)
+    assert np.allclose(f2(x), sum_axis_1(x), rtol=RTOL, atol=ATOL)
+    y = randint(99, size=(4, 6), dtype=np.int32)
+    assert np.array_equal(f3(y), sum_keepdims(y))
+    assert matching_types(f3(y)[0, 0], sum_keepdims(y)[0, 0])
+
+def test_sum_axis_order_f(language):
+    def sum_axis(x : 'float[:,:](order=F)'):
+        from numpy import sum as np_sum
+        s = np_sum(x, axis = 0)
+        t = np_sum(x, axis = 1)
+        return s[0] + t[0], s[1] + t[-1]
+
+    f1 = epyccel(sum_axis, language = language)
+    x = np.asfortranarray(rand(9, 5))
+    assert np.allclose(f1(x), sum_axis(x), rtol=RTOL, atol=ATOL)
+
+def test_sum_expression(language):
+    def sum_expression(x : 'float[:]', y : 'float[:]'):
+        from numpy import sum as np_sum
+        return np_sum(x * y + 1.0)
+    def sum_expression_2d(x : 'int[:,:](order=F)'):
+        from numpy import sum as np_sum
+        return np_sum(2 * x - 1) + np_sum(x[:, 1:] * x[:, 1:])
+
+    f1 = epyccel(sum_expression, language = language)
+    f2 = epyccel(sum_expression_2d, language = language)
+    x = rand(30)
+    y = rand(30)
+    assert isclose(f1(x, y), sum_expression(x, y), rtol=RTOL, atol=ATOL)
+    z = np.asfortranarray(randint(-99, 99, size=(4, 5)))
+    assert f2(z) == sum_expression_2d(z)
+
+def test_max_min_axis(language):
+    def max_min_axis(x : 'int[:,:,:]'):
+        from numpy import amax, amin
+        a = amax(x, axis = 1)
+        b = amin(x, axis = -1)
+        c = x.max(axis = 0)
+        return a[1, 2] + b[0, 1] + c[2, 3]
+
+    f1 = epyccel(max_min_axis, language = language)
+    x = randint(-99, 99, size=(3, 4, 5))
+    assert f1(x) == max_min_axis(x)
+
 
 def test_full_like_basic_int(language):
     def create_full_like_shape_1d(n : 'int'):
@@ -4329,6 +4517,49 @@ def test_numpy_mod_array_like_2d(language):
     assert epyccel_func(fl32) == get_mod(fl32)
     assert epyccel_func(fl64) == get_mod(fl64)
 
+
+def test_numpy_mod_negative_arrays(language):
+
+    @template('T', ['int[:]', 'int32[:]', 'float[:]', 'float32[:]'])
+    def get_mod(x : 'T', y : 'T', z : 'T'):
+        from numpy import mod
+        z[:] = mod(x, y)
+        w = x % y
+        return w[0], w[-1]
+
+    epyccel_func = epyccel(get_mod, language=language)
+
+    for dtype in (int, np.int32, float, np.float32):
+        x = np.array([-7, 7, -7, 7, -8, 0, 100003], dtype=dtype)
+        y = np.array([3, -3, -3, 3, 4, -5, 97], dtype=dtype)
+        z_pyc = np.empty_like(x)
+        z_pyt = np.empty_like(x)
+        assert epyccel_func(x, y, z_pyc) == get_mod(x, y, z_pyt)
+        assert np.array_equal(z_pyc, z_pyt)
+        assert np.array_equal(np.signbit(z_pyc), np.signbit(z_pyt))
+
+def test_numpy_gcd_lcm(language):
+
+    @template('T', ['int[:]', 'int32[:]'])
+    def get_gcd_lcm(x : 'T', y : 'T', g : 'T', l : 'T'):
+        from numpy import gcd, lcm
+        g[:] = gcd(x, y)
+        l[:] = lcm(x, y)
+        return gcd(x[0], y[0]), lcm(x[0], y[0])
+
+    epyccel_func = epyccel(get_gcd_lcm, language=language)
+
+    for dtype in (int, np.int32):
+        x = np.array([-12, 12, 0, 0, 1 << 20, 17, 1155], dtype=dtype)
+        y = np.array([18, -18, 5, 0, 1 << 12, 5, -715], dtype=dtype)
+        g_pyc = np.empty_like(x)
+        l_pyc = np.empty_like(x)
+        g_pyt = np.empty_like(x)
+        l_pyt = np.empty_like(x)
+        assert epyccel_func(x, y, g_pyc, l_pyc) == get_gcd_lcm(x, y, g_pyt, l_pyt)
+        assert np.array_equal(g_pyc, g_pyt)
+        assert np.array_equal(l_pyc, l_pyt)
+
 @pytest.mark.parametrize( 'language', (
         pytest.param("fortran", marks = [pytest.mark.fortran]),
         pytest.param("c", marks = [
@@ -3,6 +3,8 @@ This test file is made for testing the functionality of passing numpy arrays
 in the function arguments.
 """
 # pylint: disable=missing-function-docstring
+import array
+import pytest
 import numpy as np
 from numpy.random import randint, uniform
 
@@ -135,3 +137,51 @@ def test_array_complex_2d_scalar_add(language):
         f2(x2, a, d1, d2)
 
         assert np.array_equal( x1, x2 )
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_array_from_buffer(language):
+    def array_real_2d_scale(x : 'float[:,:]', a : float):
+        x[:,:] *= a
+
+    f = epyccel(array_real_2d_scale, language=language)
+
+    # Objects exporting the buffer protocol are used without a copy
+    data = array.array('d', range(12))
+    x = memoryview(data).cast('B').cast('d', (3, 4))
+    f(x, 2.0)
+    assert list(data) == [2.0 * i for i in range(12)]
+
+    x = np.arange(12, dtype=float).reshape(3, 4)
+    f(memoryview(x), 2.0)
+    assert np.array_equal(x, 2.0 * np.arange(12).reshape(3, 4))
+
+    with pytest.raises(TypeError):
+        f(memoryview(np.ones((3, 4), dtype=np.int32)), 2.0)
+    with pytest.raises(TypeError):
+        f(memoryview(np.ones((3, 4), order='F')), 2.0)
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_array_from_read_only_buffer(language):
+    def array_real_1d_copy(x : 'float[:]', y : 'const float[:]'):
+        x[:] = y
+
+    f = epyccel(array_real_1d_copy, language=language)
+
+    x = array.array('d', [0.0] * 4)
+    y = memoryview(bytes(array.array('d', range(4))))
+    f(x, y.cast('d'))
+    assert list(x) == [0.0, 1.0, 2.0, 3.0]
+
+    # The buffers are released when the function returns
+    x.append(4.0)
+    assert len(x) == 5
+
+    # A read-only buffer cannot be modified
+    with pytest.raises(ValueError):
+        f(y.cast('d'), x)
@@ -1,4 +1,6 @@
 # pylint: disable=missing-function-docstring, missing-module-docstring
+import os
+from concurrent.futures import ThreadPoolExecutor
 import pytest
 import numpy as np
 from numpy import iinfo, finfo
@@ -1854,6 +1856,27 @@ def test_multiple_2d_stack_array_2(language):
     f2 = epyccel(f1, language = language)
     assert np.allclose(f1(), f2(), rtol=RTOL, atol=ATOL)
 
+@pytest.mark.parametrize('n', [10, 100000])
+def test_array_float_stack_array_runtime_size(language, n):
+
+    f1 = arrays.array_float_stack_array_runtime_size
+    f2 = epyccel(f1, language = language)
+    assert np.equal(f1(n), f2(n))
+
+def test_array_int_2d_stack_array_order_f(language):
+
+    f1 = arrays.array_int_2d_stack_array_order_f
+    f2 = epyccel(f1, language = language)
+    assert f1(4) == f2(4)
+
+@pytest.mark.parametrize('n', [10, 100000])
+def test_array_float_local_arrays(language, n):
+
+    f1 = arrays.array_float_local_arrays
+    f2 = epyccel(f1, language = language)
+    x = np.random.rand(n)
+    assert np.isclose(f1(x, n), f2(x, n), rtol=RTOL, atol=ATOL)
+
 #==============================================================================
 # TEST: Product and matrix multiplication
 #==============================================================================
@@ -1876,14 +1899,6 @@ def test_array_float_1d_1d_prod(language):
     f2(x2, y2)
     assert np.array_equal(y1, y2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_1d_matmul(language):
     f1 = arrays.array_float_2d_1d_matmul
     f2 = epyccel( f1 , language = language)
@@ -1898,14 +1913,6 @@ def test_array_float_2d_1d_matmul(language):
     f2(A2, x2, y2)
     assert np.array_equal(y1, y2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_1d_matmul_creation(language):
     f1 = arrays.array_float_2d_1d_matmul_creation
     f2 = epyccel( f1 , language = language)
@@ -1918,14 +1925,6 @@ def test_array_float_2d_1d_matmul_creation(language):
     y2 = f2(A2, x2)
     assert np.isclose(y1, y2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_1d_matmul_order_F_F(language):
     f1 = arrays.array_float_2d_1d_matmul_order_F
     f2 = epyccel( f1 , language = language)
@@ -1940,14 +1939,6 @@ def test_array_float_2d_1d_matmul_order_F_F(language):
     f2(A2, x2, y2)
     assert np.array_equal(y1, y2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_2d_matmul(language):
     f1 = arrays.array_float_2d_2d_matmul
     f2 = epyccel( f1 , language = language)
@@ -1962,14 +1953,6 @@ def test_array_float_2d_2d_matmul(language):
     f2(A2, B2, C2)
     assert np.array_equal(C1, C2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_2d_matmul_F_F_F_F(language):
     f1 = arrays.array_float_2d_2d_matmul_F_F
     f2 = epyccel( f1 , language = language)
@@ -1985,9 +1968,7 @@ def test_array_float_2d_2d_matmul_F_F_F_F(language):
     assert np.array_equal(C1, C2)
 
 @pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
+        pytest.param("c", marks = pytest.mark.c),
         pytest.param("fortran", marks = [
             pytest.mark.fortran,
             pytest.mark.skip(reason="Should fail as long as mixed order not supported, see #244")
@@ -2009,14 +1990,6 @@ def test_array_float_2d_2d_matmul_mixorder(language):
     f2(A2, B2, C2)
     assert np.array_equal(C1, C2)
 
-@pytest.mark.parametrize( 'language', [
-        pytest.param("c", marks = [
-            pytest.mark.skip(reason="matmul not implemented in c"),
-            pytest.mark.c]),
-        pytest.param("fortran", marks = pytest.mark.fortran),
-        pytest.param("python", marks = pytest.mark.python)
-    ]
-)
 def test_array_float_2d_2d_matmul_operator(language):
     f1 = arrays.array_float_2d_2d_matmul_operator
     f2 = epyccel( f1 , language = language)
@@ -2031,6 +2004,146 @@ def test_array_float_2d_2d_matmul_operator(language):
     f2(A2, B2, C2)
     assert np.array_equal(C1, C2)
 
+def test_array_float_2d_2d_matmul_inplace(language):
+    f1 = arrays.array_float_2d_2d_matmul_inplace
+    f2 = epyccel( f1 , language = language)
+    B = np.random.random([4, 4])
+    C1 = np.random.random([4, 4])
+    C2 = np.copy(C1)
+    f1(B, C1)
+    f2(B, C2)
+    assert np.allclose(C1, C2, rtol=RTOL, atol=ATOL)
+
+def test_array_float_2d_1d_matmul_inplace(language):
+    f1 = arrays.array_float_2d_1d_matmul_inplace
+    f2 = epyccel( f1 , language = language)
+    A = np.random.random([5, 5])
+    y1 = np.random.random([5])
+    y2 = np.copy(y1)
+    f1(A, y1)
+    f2(A, y2)
+    assert np.allclose(y1, y2, rtol=RTOL, atol=ATOL)
+
+def test_array_float_1d_2d_matmul(language):
+    f1 = arrays.array_float_1d_2d_matmul
+    f2 = epyccel( f1 , language = language)
+    A1 = np.ones([3, 2])
+    A1[1, 0] = 2
+    A2 = np.copy(A1)
+    x1 = np.arange(3.0)
+    x2 = np.copy(x1)
+    y1 = np.empty([2])
+    y2 = np.empty([2])
+    f1(x1, A1, y1)
+    f2(x2, A2, y2)
+    assert np.array_equal(y1, y2)
+
+def test_array_float_1d_1d_matmul(language):
+    f1 = arrays.array_float_1d_1d_matmul
+    f2 = epyccel( f1 , language = language)
+    x = np.arange(10.0)
+    y = np.ones(20)[::2]
+    assert np.isclose(f1(x, y), f2(x, y), rtol=RTOL, atol=ATOL)
+
+def matmul_large(f1, language, orders):
+    f2 = epyccel( f1 , language = language)
+    order_a, order_b, order_c = orders
+    A = np.array(np.random.random([301, 203]), order = order_a)
+    B = np.array(np.random.random([203, 157]), order = order_b)
+    C1 = np.empty([301, 157], order = order_c)
+    C2 = np.empty([301, 157], order = order_c)
+    f1(A, B, C1)
+    f2(A, B, C2)
+    assert np.allclose(C1, C2, rtol=RTOL, atol=ATOL)
+
+def test_array_float_2d_2d_matmul_large(language):
+    matmul_large(arrays.array_float_2d_2d_matmul, language, 'CCC')
+
+def test_array_float_2d_2d_matmul_large_F_F_F(language):
+    matmul_large(arrays.array_float_2d_2d_matmul_F_F, language, 'FFF')
+
+@pytest.mark.parametrize( 'language', [
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("fortran", marks = [
+            pytest.mark.fortran,
+            pytest.mark.skip(reason="Should fail as long as mixed order not supported, see #244")
+            ]),
+        pytest.param("python", marks = pytest.mark.python)
+    ]
+)
+@pytest.mark.parametrize( 'function, orders', [('array_float_2d_2d_matmul_mixorder', 'CFC'),
+                                             ('array_float_2d_2d_matmul_F_C_F', 'FCF')])
+def test_array_float_2d_2d_matmul_large_mixorder(language, function, orders):
+    matmul_large(getattr(arrays, function), language, orders)
+
+def test_array_float_2d_1d_matmul_strided(language):
+    # The arguments of rank 2 must be contiguous, the strided matrices are tested in tests/ndarrays
+    f1 = arrays.array_float_2d_1d_matmul
+    f2 = epyccel( f1 , language = language)
+    A = np.random.random([20, 15])
+    x = np.random.random([60])[::4]
+    out1 = np.zeros([40])
+    out2 = np.zeros([40])
+    f1(A, x, out1[::2])
+    f2(A, x, out2[::2])
+    assert np.allclose(out1, out2, rtol=RTOL, atol=ATOL)
+
+def test_array_int_2d_2d_matmul(language):
+    f1 = arrays.array_int_2d_2d_matmul
+    f2 = epyccel( f1 , language = language)
+    A = np.random.randint(-10, 10, size = (7, 5), dtype = np.int32)
+    B = np.random.randint(-10, 10, size = (5, 9), dtype = np.int32)
+    C1 = np.empty([7, 9], dtype = np.int32)
+    C2 = np.empty([7, 9], dtype = np.int32)
+    f1(A, B, C1)
+    f2(A, B, C2)
+    assert np.array_equal(C1, C2)
+
+@pytest.mark.parametrize( 'language', [
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("fortran", marks = [
+            pytest.mark.fortran,
+            pytest.mark.skip(reason="Should fail as long as mixed order not supported, see #244")
+            ]),
+        pytest.param("python", marks = pytest.mark.python)
+    ]
+)
+def test_array_complex_2d_2d_matmul(language):
+    f1 = arrays.array_complex_2d_2d_matmul
+    f2 = epyccel( f1 , language = language)
+    A = np.random.random([6, 4]) + 1j * np.random.random([6, 4])
+    B = np.array(np.random.random([4, 5]) - 2j * np.random.random([4, 5]), order = 'F')
+    C1 = np.empty([6, 5], dtype = complex)
+    C2 = np.empty([6, 5], dtype = complex)
+    f1(A, B, C1)
+    f2(A, B, C2)
+    assert np.allclose(C1, C2, rtol=RTOL, atol=ATOL)
+
+def test_array_float_2d_2d_matmul_expression(language):
+    f1 = arrays.array_float_2d_2d_matmul_expression
+    f2 = epyccel( f1 , language = language)
+    A = np.random.random([4, 3])
+    B = np.random.random([3, 4])
+    x = np.random.random([4])
+    C1 = np.empty([4, 4])
+    C2 = np.empty([4, 4])
+    r1 = f1(A, B, x, C1)
+    r2 = f2(A, B, x, C2)
+    assert np.allclose(C1, C2, rtol=RTOL, atol=ATOL)
+    assert np.isclose(r1, r2, rtol=RTOL, atol=ATOL)
+
+@pytest.mark.c
+def test_array_float_2d_2d_matmul_blas():
+    f1 = arrays.array_float_2d_2d_matmul_mixorder
+    f2 = epyccel( f1 , language = 'c', accelerators = ['blas'])
+    A = np.random.random([130, 70])
+    B = np.array(np.random.random([70, 90]), order = 'F')
+    C1 = np.empty([130, 90])
+    C2 = np.empty([130, 90])
+    f1(A, B, C1)
+    f2(A, B, C2)
+    assert np.allclose(C1, C2, rtol=RTOL, atol=ATOL)
+
 def test_array_float_loopdiff(language):
     f1 = arrays.array_float_loopdiff
     f2 = epyccel( f1 , language = language)
@@ -6097,3 +6210,122 @@ def test_unpacking_2D_of_known_size(language):
     f1 = arrays.unpack_array_2D_of_known_size
     f2 = epyccel(f1, language = language)
     assert f1() == f2()
+
+#==============================================================================
+# Fused array expressions
+#==============================================================================
+
+def test_array_expression_shifted_copy(language):
+    f1 = arrays.array_expression_shifted_copy
+    f2 = epyccel(f1, language = language)
+    assert f1(10) == f2(10)
+
+def test_array_expression_reversed(language):
+    f1 = arrays.array_expression_reversed
+    f2 = epyccel(f1, language = language)
+    x1 = np.arange(7)
+    x2 = x1.copy()
+    assert f1(x1) == f2(x2)
+    check_array_equal(x1, x2)
+
+def test_array_expression_pointer(language):
+    f1 = arrays.array_expression_pointer
+    f2 = epyccel(f1, language = language)
+    x1 = np.arange(10, dtype=float)
+    x2 = x1.copy()
+    assert f1(x1) == f2(x2)
+    check_array_equal(x1, x2)
+
+def test_array_expression_order_f(language):
+    f1 = arrays.array_expression_order_f
+    f2 = epyccel(f1, language = language)
+    x = np.asfortranarray(np.random.rand(4, 3))
+    y = np.asfortranarray(np.random.rand(4, 3))
+    assert np.allclose(f1(x, y), f2(x, y))
+
+def test_array_expression_transpose_inplace(language):
+    f1 = arrays.array_expression_transpose_inplace
+    f2 = epyccel(f1, language = language)
+    x1 = np.random.rand(5, 5)
+    x2 = x1.copy()
+    f1(x1)
+    f2(x2)
+    check_array_equal(x1, x2)
+
+def test_array_expression_transpose_sum(language):
+    f1 = arrays.array_expression_transpose_sum
+    f2 = epyccel(f1, language = language)
+    x1 = np.random.rand(5, 5)
+    x2 = x1.copy()
+    f1(x1)
+    f2(x2)
+    assert np.allclose(x1, x2)
+
+#==============================================================================
+# Arrays stored in files
+#==============================================================================
+
+file_languages = (
+        pytest.param("fortran", marks = [
+            pytest.mark.skip(reason="Arrays stored in files are only supported in C"),
+            pytest.mark.fortran]),
+        pytest.param("c", marks = pytest.mark.c),
+        pytest.param("python", marks = pytest.mark.python)
+    )
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_float_2d_load(language):
+    np.save('arrays_load.npy', np.arange(15, dtype=float).reshape(5, 3))
+    f1 = arrays.array_float_2d_load
+    f2 = epyccel(f1, language = language)
+    assert f1() == f2()
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_float_2d_load_errors(language):
+    f1 = arrays.array_float_2d_load_missing
+    f2 = epyccel(f1, language = language)
+    with pytest.raises(OSError):
+        f2()
+    if language != 'python':
+        # The file contains an array of integers
+        np.save('arrays_load_missing.npy', np.arange(15).reshape(5, 3))
+        with pytest.raises(ValueError):
+            f2()
+        os.remove('arrays_load_missing.npy')
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_float_2d_load_mmap(language):
+    np.save('arrays_load_order_f.npy', np.asfortranarray(np.random.rand(40, 30)))
+    f1 = arrays.array_float_2d_load_mmap
+    f2 = epyccel(f1, language = language)
+    assert np.isclose(f1(), f2(), rtol=RTOL, atol=ATOL)
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_float_2d_load_copy_on_write(language):
+    x = np.arange(15, dtype=float).reshape(5, 3)
+    np.save('arrays_load.npy', x)
+    f1 = arrays.array_float_2d_load_copy_on_write
+    f2 = epyccel(f1, language = language)
+    assert f1() == f2()
+    check_array_equal(np.load('arrays_load.npy'), x)
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_int32_memmap(language):
+    f1_write = arrays.array_int32_memmap_write
+    f2_write = epyccel(f1_write, language = language)
+    f1_read = arrays.array_int32_memmap_read
+    f2_read = epyccel(f1_read, language = language)
+    f2_write(7)
+    assert f1_read(7) == f2_read(7)
+    f1_write(7)
+    assert f1_read(7) == f2_read(7)
+
+@pytest.mark.parametrize('language', file_languages)
+def test_array_int32_memmap_threads(language):
+    arrays.array_int32_memmap_write(50)
+    f1 = arrays.array_int32_memmap_sum
+    f2 = epyccel(f1, language = language)
+    # The function does not hold the GIL so the arrays are mapped and freed by several threads at once
+    with ThreadPoolExecutor(max_workers = 4) as pool:
+        sums = list(pool.map(f2, [50] * 16))
+    assert sums == [f1(50)] * 16
@@ -1,10 +1,11 @@
 # pylint: disable=missing-function-docstring, missing-module-docstring
 # coding: utf-8
 
+from concurrent.futures import ThreadPoolExecutor
 import pytest
 import numpy as np
 from pyccel.epyccel import epyccel
-from pyccel.decorators import private, inline, template
+from pyccel.decorators import private, inline, template, nogil, ufunc
 
 @pytest.mark.parametrize( 'lang', (
         pytest.param("fortran", marks = pytest.mark.fortran),
@@ -169,3 +170,94 @@ def test_indexed_template(language):
 
     assert python_cmplx == pyccel_cmplx
     assert isinstance(python_cmplx, type(pyccel_cmplx))
+
+def test_nogil(language):
+    @nogil
+    def axpy(a : float, x : 'float[:]', y : 'float[:]'):
+        for i in range(x.shape[0]):
+            y[i] = a * x[i] + y[i]
+        return y.sum()
+
+    pyccel_axpy = epyccel(axpy, language=language)
+
+    x = np.linspace(0, 1, 1000)
+    python_y = [np.full(1000, float(i)) for i in range(8)]
+    pyccel_y = [np.full(1000, float(i)) for i in range(8)]
+
+    python_sums = [axpy(2.0, x, y) for y in python_y]
+    with ThreadPoolExecutor(max_workers = 4) as pool:
+        pyccel_sums = list(pool.map(lambda y: pyccel_axpy(2.0, x, y), pyccel_y))
+
+    assert np.allclose(python_sums, pyccel_sums)
+    for python_yi, pyccel_yi in zip(python_y, pyccel_y):
+        assert np.allclose(python_yi, pyccel_yi)
+
+@pytest.mark.parametrize( 'lang', (
+        pytest.param("fortran", marks = pytest.mark.fortran),
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_ufunc(lang):
+    @ufunc
+    def hypot(x : float, y : float):
+        return (x*x + y*y)**0.5
+
+    pyccel_hypot = epyccel(hypot, language=lang)
+
+    assert isinstance(pyccel_hypot, np.ufunc)
+    assert pyccel_hypot.nin == 2 and pyccel_hypot.nout == 1
+
+    # Broadcasting between a strided 2D array and a 1D array
+    x = np.arange(24, dtype=float).reshape(4, 6)[:, ::2]
+    y = np.linspace(0, 1, 3)
+    assert np.allclose(pyccel_hypot(x, y), np.hypot(x, y))
+    assert np.isclose(pyccel_hypot(3.0, 4.0), 5.0)
+
+    out = np.empty((4, 3))
+    res = pyccel_hypot(x, y, out=out)
+    assert res is out
+    assert np.allclose(out, np.hypot(x, y))
+
+    # Integer inputs are cast safely to the float loop
+    assert np.allclose(pyccel_hypot(np.arange(5), 1), np.hypot(np.arange(5), 1))
+
+@pytest.mark.parametrize( 'lang', (
+        pytest.param("fortran", marks = pytest.mark.fortran),
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_ufunc_template(lang):
+    @ufunc
+    @template('T', [int, float])
+    def twice(x : 'T'):
+        return 2*x
+
+    pyccel_twice = epyccel(twice, language=lang)
+
+    x_int = np.arange(10)
+    x_float = np.linspace(0, 1, 10)
+    assert pyccel_twice(x_int).dtype == x_int.dtype
+    assert np.array_equal(pyccel_twice(x_int), 2*x_int)
+    assert pyccel_twice(x_float).dtype == x_float.dtype
+    assert np.allclose(pyccel_twice(x_float), 2*x_float)
+
+@pytest.mark.parametrize( 'lang', (
+        pytest.param("fortran", marks = pytest.mark.fortran),
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_gufunc(lang):
+    @ufunc
+    def weighted_sum(x : 'float[:]', w : 'float[:]', scale : float):
+        s = 0.0
+        for i in range(x.shape[0]):
+            s += x[i] * w[i]
+        return scale * s
+
+    pyccel_weighted_sum = epyccel(weighted_sum, language=lang)
+
+    x = np.random.random((5, 8))
+    w = np.random.random(16)[::2]
+    scale = np.linspace(1, 2, 5)
+    assert pyccel_weighted_sum.signature is not None
+    assert np.allclose(pyccel_weighted_sum(x, w, scale), scale * (x @ w))
@@ -5,7 +5,7 @@ import sys
 import pytest
 import numpy as np
 
-from pyccel.epyccel import epyccel
+from pyccel.epyccel import epyccel, epyccel_seq
 
 RTOL = 2e-14
 ATOL = 1e-15
@@ -358,6 +358,51 @@ def test_union_type(language):
     assert np.isclose(f(y), square(y), rtol=RTOL, atol=ATOL)
     assert isinstance(f(y), type(square(y)))
 
+def test_epyccel_cache(language):
+    def cube(a : int):
+        return a*a*a
+
+    mod1, f1 = epyccel_seq(cube, language=language)
+    mod2, f2 = epyccel_seq(cube, language=language)
+    mod3, _ = epyccel_seq(cube, language=language, cache=False)
+
+    assert f1(3) == f2(3) == cube(3)
+    if language != 'python':
+        # The second call uses the module compiled by the first one
+        assert mod1 is mod2
+    assert mod3 is not mod1
+
+    def cube_float(a : float):
+        return a*a*a
+
+    mod4, f4 = epyccel_seq(cube_float, language=language)
+    assert mod4 is not mod1
+    assert np.isclose(f4(1.5), cube_float(1.5), rtol=RTOL, atol=ATOL)
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_epyccel_profile(language):
+    def sum_of_ones(n : int):
+        import numpy as np
+        x = np.ones(n)
+        return np.sum(x)
+
+    mod, f = epyccel_seq(sum_of_ones, language=language, accelerators=['profile'])
+
+    mod._pyccel_profile_reset()
+    assert f(10) == 10
+    assert f(20) == 20
+    stats = mod._pyccel_profile()
+    timer, = (t for name, t in stats['functions'].items() if name.endswith('sum_of_ones'))
+    assert timer['calls'] == 2
+    assert timer['time'] > 0
+    allocations = stats['allocations']
+    assert allocations['count'] == allocations['freed'] == 2
+    assert allocations['bytes'] == 30 * 8
+    assert allocations['peak_bytes'] == 20 * 8
+
 ##==============================================================================
 ## CLEAN UP GENERATED FILES AFTER RUNNING TESTS
 ##==============================================================================
@@ -889,3 +889,25 @@ def test_copy_f_to_default(language):
         assert pyth_out.dtype is pycc_out.dtype
         assert pyth_out.flags.c_contiguous == pycc_out.flags.c_contiguous
         assert pyth_out.flags.f_contiguous == pycc_out.flags.f_contiguous
+
+@pytest.mark.parametrize( 'language', (
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_return_array_without_copy(language):
+    def return_ones(n : int):
+        from numpy import ones
+        a = ones((n, 3))
+        return a
+
+    epyccel_func = epyccel(return_ones, language=language)
+
+    for _ in range(10):
+        pycc_out = epyccel_func(1000)
+
+        assert np.array_equal(pycc_out, return_ones(1000))
+        # The NumPy array uses the memory allocated in C, which is freed with the array
+        assert not pycc_out.flags.owndata
+        assert type(pycc_out.base).__name__ == 'PyCapsule'
+        assert pycc_out.flags.writeable
+        del pycc_out
@@ -76,6 +76,30 @@ def test_double_loop_on_2d_array_F(language):
     f2( y )
     assert np.array_equal( x, y )
 
+def test_axpy_loop_on_1d_arrays(language):
+
+    f1 = loops.axpy_loop_on_1d_arrays
+    f2 = epyccel(f1, language=language)
+
+    x = np.arange(20)
+    y1 = np.arange(40)
+    y2 = y1.copy()
+
+    # Contiguous arrays
+    f1(3, x[:10], y1[:10])
+    f2(3, x[:10], y2[:10])
+    assert np.array_equal( y1, y2 )
+
+    # Strided arrays
+    f1(3, x[::2], y1[::4])
+    f2(3, x[::2], y2[::4])
+    assert np.array_equal( y1, y2 )
+
+    # Contiguous and strided arrays
+    f1(-2, x[10:], y1[1::2][:10])
+    f2(-2, x[10:], y2[1::2][:10])
+    assert np.array_equal( y1, y2 )
+
 def test_product_loop_on_2d_array_C(language):
 
     f1 = loops.product_loop_on_2d_array_C
@@ -0,0 +1,11 @@
+# pylint: disable=missing-function-docstring, missing-module-docstring
+from pyccel.decorators import ufunc
+
+@ufunc
+def scale(x : float, factor : float = 2.0):
+    return factor * x
+
+@ufunc
+def fill(x : 'float[:]', v : float):
+    x[:] = v
+    return v
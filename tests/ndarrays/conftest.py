@@ -37,12 +37,44 @@ class CTestFile(pytest.File):
         rootdir = str(self.config.rootdir)
         test_exe = os.path.relpath(test_exe)
         ndarray_path =  os.path.join(rootdir , "pyccel", "stdlib", "ndarrays")
-        comp_cmd = [shutil.which("gcc"), test_exe + ".c",
-                    os.path.join(ndarray_path,"ndarrays.c"), "-I", ndarray_path, "-o", test_exe]
+        ufuncs_path =  os.path.join(rootdir , "pyccel", "stdlib", "ufuncs")
+        linalg_path =  os.path.join(rootdir , "pyccel", "stdlib", "linalg")
+        random_path =  os.path.join(rootdir , "pyccel", "stdlib", "random")
+        distributed_path =  os.path.join(rootdir , "pyccel", "stdlib", "distributed")
+        hdf5_path =  os.path.join(rootdir , "pyccel", "stdlib", "hdf5")
+        # the distributed arrays are tested on 4 processes with MPI
+        uses_mpi = self.path.name == "test_distributed.c"
+        if uses_mpi:
+            if not (shutil.which("mpicc") and shutil.which("mpiexec")):
+                pytest.skip("MPI is not available", allow_module_level=True)
+            comp_cmd = [shutil.which("mpicc"), test_exe + ".c",
+                        os.path.join(distributed_path,"pyc_distributed.c"),
+                        os.path.join(ndarray_path,"ndarrays.c"), os.path.join(ndarray_path,"pyc_profile.c"),
+                        "-I", ndarray_path, "-I", distributed_path,
+                        "-o", test_exe, "-lm"]
+        elif self.path.name == "test_hdf5.c":
+            # the HDF5 compiler wrapper gives the paths of the library
+            if not shutil.which("h5cc"):
+                pytest.skip("HDF5 is not available", allow_module_level=True)
+            comp_cmd = [shutil.which("h5cc"), test_exe + ".c",
+                        os.path.join(hdf5_path,"pyc_hdf5.c"),
+                        os.path.join(ndarray_path,"ndarrays.c"), os.path.join(ndarray_path,"pyc_profile.c"),
+                        "-I", ndarray_path, "-I", hdf5_path,
+                        "-o", test_exe, "-lm"]
+        else:
+            comp_cmd = [shutil.which("gcc"), test_exe + ".c",
+                        os.path.join(ndarray_path,"ndarrays.c"), os.path.join(ndarray_path,"pyc_profile.c"),
+                        os.path.join(ufuncs_path,"ufuncs.c"), os.path.join(linalg_path,"linalg.c"),
+                        os.path.join(random_path,"pyc_random.c"),
+                        "-I", ndarray_path, "-I", ufuncs_path, "-I", linalg_path, "-I", random_path,
+                        "-o", test_exe, "-lm", *([] if sys.platform.startswith("win") else ["-pthread"])]
         subprocess.run(comp_cmd, check= 'TRUE')
         if sys.platform.startswith("win"):
             test_exe += ".exe"
-        test_output = subprocess.check_output("./" + test_exe)
+        run_cmd = ["./" + test_exe]
+        if uses_mpi:
+            run_cmd = [shutil.which("mpiexec"), "-n", "4", *os.environ.get("MPI_OPTS", "").split(), *run_cmd]
+        test_output = subprocess.check_output(run_cmd)
 
         # Clean up the unit test output and remove non test data lines.
         lines = test_output.decode().split("\n")
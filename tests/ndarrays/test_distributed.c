@@ -0,0 +1,235 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+/*
+ * Tests of the distributed arrays, run on several processes with mpiexec. The
+ * assertions are collective: they fail if they fail on any process and only
+ * the first process prints the results.
+ */
+
+#include "ndarrays.h"
+#include "pyc_distributed.h"
+#include <stdio.h>
+
+#define getname(X) #X
+#define my_assert(X , Y, dscr) assert_int64_all(X , Y, getname(X), getname(Y), dscr, __func__, __FILE__, __LINE__)
+
+void assert_int64_all(int64_t v1 , int64_t v2,
+        const char *v1_name, const char *v2_name,const char *dscr,
+        const char * func, const char *file, int32_t line)
+{
+    int failed = v1 != v2;
+    int n_failed;
+    int rank;
+
+    MPI_Allreduce(&failed, &n_failed, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0)
+        return ;
+    if (n_failed != 0)
+    {
+        printf("[FAIL] %s:%d:%s\n", file, line, func);
+        printf("[INFO] %s:%ld != %s:%ld on %d processes\n", v1_name, v1, v2_name, v2, n_failed);
+        printf("[DSCR] %s\n", dscr);
+        return ;
+    }
+    printf("[PASS] %s:%d:%s\n", file, line, func);
+    printf("[DSCR] %s\n", dscr);
+}
+
+/* value stored at a global index of the test arrays */
+static int64_t  global_value(int32_t nd, const int64_t *index)
+{
+    int64_t value = 0;
+
+    for (int32_t i = 0; i < nd; i++)
+        value = value * 1000 + index[i];
+    return (value);
+}
+
+/* multi-index of the k-th element of the data of an array */
+static int64_t  element_index(t_ndarray arr, int64_t k, int64_t *index)
+{
+    int64_t offset = 0;
+
+    for (int32_t i = 0; i < arr.nd; i++)
+    {
+        int32_t dim = arr.order == order_c ? arr.nd - 1 - i : i;
+
+        index[dim] = k % arr.shape[dim];
+        k /= arr.shape[dim];
+    }
+    for (int32_t i = 0; i < arr.nd; i++)
+        offset += index[i] * arr.strides[i];
+    return (offset);
+}
+
+/* fill the owned points with their global value and the halos with -1 */
+static void     fill_owned(t_dist_ndarray arr)
+{
+    const t_cart_decomposition *decomp = arr.decomp;
+    int64_t index[MAX_NDIM];
+
+    for (int64_t k = 0; k < arr.data.length; k++)
+    {
+        int64_t offset = element_index(arr.data, k, index);
+        bool owned = true;
+
+        for (int32_t i = 0; i < decomp->nd; i++)
+        {
+            owned &= index[i] >= arr.halo[i] && index[i] < arr.halo[i] + decomp->local_shape[i];
+            index[i] += decomp->starts[i] - arr.halo[i];
+        }
+        arr.data.nd_int64[offset] = owned ? global_value(decomp->nd, index) : -1;
+    }
+}
+
+/* number of points which do not hold the expected value after an exchange */
+static int64_t  count_wrong_points(t_dist_ndarray arr, bool corners)
+{
+    const t_cart_decomposition *decomp = arr.decomp;
+    int64_t index[MAX_NDIM];
+    int64_t wrong = 0;
+
+    for (int64_t k = 0; k < arr.data.length; k++)
+    {
+        int64_t offset = element_index(arr.data, k, index);
+        int32_t n_outside = 0;
+        bool received = true;
+        int64_t expected;
+
+        for (int32_t i = 0; i < decomp->nd; i++)
+        {
+            int64_t global = index[i] + decomp->starts[i] - arr.halo[i];
+
+            if (index[i] < arr.halo[i] || index[i] >= arr.halo[i] + decomp->local_shape[i])
+            {
+                n_outside++;
+                received &= decomp->periods[i] || (global >= 0 && global < decomp->global_shape[i]);
+            }
+            index[i] = (global + decomp->global_shape[i]) % decomp->global_shape[i];
+        }
+        received &= n_outside <= 1 || corners;
+        expected = received ? global_value(decomp->nd, index) : -1;
+        wrong += arr.data.nd_int64[offset] != expected;
+    }
+    return (wrong);
+}
+
+int32_t test_cart_decomposition_blocks(void)
+{
+    int64_t global_shape[] = {37, 23, 5};
+    bool periods[] = {true, false, false};
+    int dims[] = {0, 0, 1};
+    t_cart_decomposition decomp;
+    int64_t n_owned;
+    int64_t n_total;
+    int64_t end;
+    int64_t next;
+    int source;
+    int dest;
+    int size;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    cart_decomposition_create(&decomp, MPI_COMM_WORLD, 3, global_shape, dims, periods, true);
+    n_owned = decomp.local_shape[0] * decomp.local_shape[1] * decomp.local_shape[2];
+    MPI_Allreduce(&n_owned, &n_total, 1, MPI_INT64_T, MPI_SUM, decomp.comm);
+    my_assert(n_total, (int64_t)(37 * 23 * 5), "testing that the blocks cover the global index space");
+    my_assert((int64_t)(decomp.dims[0] * decomp.dims[1]), (int64_t)size, "testing the number of processes of the communicator");
+    my_assert((int64_t)decomp.dims[2], (int64_t)1, "testing an imposed number of processes");
+    /* each block starts after the end of the previous block along the first
+    ** (periodic) dimension, the first one after the end of the last one */
+    end = (decomp.starts[0] + decomp.local_shape[0]) % global_shape[0];
+    MPI_Cart_shift(decomp.comm, 0, 1, &source, &dest);
+    MPI_Sendrecv(&end, 1, MPI_INT64_T, dest, 0, &next, 1, MPI_INT64_T, source, 0,
+            decomp.comm, MPI_STATUS_IGNORE);
+    my_assert(decomp.starts[0], next, "testing that the blocks are contiguous");
+    cart_decomposition_free(&decomp);
+    return (0);
+}
+
+int32_t test_halo_exchange_periodic_corners(void)
+{
+    int64_t global_shape[] = {37, 23};
+    bool periods[] = {true, true};
+    int64_t halo[] = {2, 1};
+    t_cart_decomposition decomp;
+    t_dist_ndarray arr;
+
+    cart_decomposition_create(&decomp, MPI_COMM_WORLD, 2, global_shape, NULL, periods, true);
+    arr = dist_array_create(&decomp, halo, nd_int64, order_c, true);
+    fill_owned(arr);
+    halo_exchange(&arr);
+    my_assert(count_wrong_points(arr, true), (int64_t)0, "testing the exchange of the faces and corners of periodic C arrays");
+    /* the requests are persistent */
+    fill_owned(arr);
+    halo_exchange(&arr);
+    my_assert(count_wrong_points(arr, true), (int64_t)0, "testing a second exchange");
+    dist_array_free(&arr);
+    cart_decomposition_free(&decomp);
+    return (0);
+}
+
+int32_t test_halo_exchange_faces_order_f(void)
+{
+    int64_t global_shape[] = {9, 10, 11};
+    bool periods[] = {false, true, false};
+    int64_t halo[] = {1, 2, 0};
+    t_cart_decomposition decomp;
+    t_dist_ndarray arr;
+
+    cart_decomposition_create(&decomp, MPI_COMM_WORLD, 3, global_shape, NULL, periods, false);
+    arr = dist_array_create(&decomp, halo, nd_int64, order_f, false);
+    fill_owned(arr);
+    halo_exchange(&arr);
+    my_assert(count_wrong_points(arr, false), (int64_t)0, "testing the exchange of the faces of Fortran arrays");
+    dist_array_free(&arr);
+    cart_decomposition_free(&decomp);
+    return (0);
+}
+
+int32_t test_halo_exchange_overlap(void)
+{
+    int64_t global_shape[] = {1000};
+    bool periods[] = {true};
+    int64_t halo[] = {1};
+    t_cart_decomposition decomp;
+    t_dist_ndarray arr;
+    t_ndarray inner;
+    int64_t n;
+    int64_t local_sum = 0;
+    int64_t sum;
+
+    cart_decomposition_create(&decomp, MPI_COMM_WORLD, 1, global_shape, NULL, periods, true);
+    arr = dist_array_create(&decomp, halo, nd_int64, order_c, false);
+    fill_owned(arr);
+    n = decomp.local_shape[0];
+    /* sum of the 3-point stencil, the inner points are computed during the exchange */
+    halo_exchange_begin(&arr);
+    inner = dist_array_inner(&arr, halo);
+    my_assert(inner.shape[0], n - 2, "testing the shape of the inner points");
+    for (int64_t i = 0; i < inner.shape[0]; i++)
+        local_sum += inner.nd_int64[i - 1] + inner.nd_int64[i] + inner.nd_int64[i + 1];
+    halo_exchange_end(&arr);
+    local_sum += arr.data.nd_int64[0] + arr.data.nd_int64[1] + arr.data.nd_int64[2];
+    local_sum += arr.data.nd_int64[n - 1] + arr.data.nd_int64[n] + arr.data.nd_int64[n + 1];
+    MPI_Allreduce(&local_sum, &sum, 1, MPI_INT64_T, MPI_SUM, decomp.comm);
+    my_assert(sum, (int64_t)(3 * 999 * 1000 / 2), "testing a stencil computed during the exchange");
+    free_pointer(&inner);
+    dist_array_free(&arr);
+    cart_decomposition_free(&decomp);
+    return (0);
+}
+
+int32_t main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    test_cart_decomposition_blocks();
+    test_halo_exchange_periodic_corners();
+    test_halo_exchange_faces_order_f();
+    test_halo_exchange_overlap();
+    MPI_Finalize();
+    return (0);
+}
@@ -0,0 +1,254 @@
+/* --------------------------------------------------------------------------------------- */
+/* This file is part of Pyccel which is released under MIT License. See the LICENSE file   */
+/* or go to https://github.com/pyccel/pyccel/blob/master/LICENSE for full license details. */
+/* --------------------------------------------------------------------------------------- */
+
+#include "ndarrays.h"
+#include "pyc_hdf5.h"
+#include <stdio.h>
+
+#define getname(X) #X
+#define my_assert(X , Y, dscr) assert_int64(X , Y, getname(X), getname(Y), dscr, __func__, __FILE__, __LINE__)
+
+#define TEST_FILE "test_hdf5.h5"
+
+void assert_int64(int64_t v1 , int64_t v2,
+        const char *v1_name, const char *v2_name,const char *dscr,
+        const char * func, const char *file, int32_t line)
+{
+    if (v1 != v2)
+    {
+        printf("[FAIL] %s:%d:%s\n", file, line, func);
+        printf("[INFO] %s:%ld != %s:%ld\n", v1_name, v1, v2_name, v2);
+        printf("[DSCR] %s\n", dscr);
+        return ;
+    }
+    printf("[PASS] %s:%d:%s\n", file, line, func);
+    printf("[DSCR] %s\n", dscr);
+}
+
+/* number of elements of arr which differ from the elements of the dataset
+** written by write_rows_columns at the index start + (i, j) */
+static int64_t  count_wrong_elements(t_ndarray arr, int64_t row, int64_t column)
+{
+    int64_t wrong = 0;
+
+    for (int64_t i = 0; i < arr.shape[0]; i++)
+        for (int64_t j = 0; j < arr.shape[1]; j++)
+            wrong += GET_ELEMENT(arr, nd_int64, i, j) != (row + i) * 100 + column + j;
+    return (wrong);
+}
+
+/* dataset of shape {rows, columns} whose element (i, j) is i * 100 + j */
+static t_h5_dataset write_rows_columns(hid_t file, const char *name, int64_t rows, int64_t columns)
+{
+    int64_t         shape[] = {rows, columns};
+    t_h5_dataset    dset = h5_dataset_create(file, name, 2, shape, nd_int64, NULL);
+    t_ndarray       arr = array_create(2, shape, nd_int64, false, order_c);
+
+    for (int64_t i = 0; i < rows; i++)
+        for (int64_t j = 0; j < columns; j++)
+            GET_ELEMENT(arr, nd_int64, i, j) = i * 100 + j;
+    h5_write(&dset, NULL, arr);
+    free_array(&arr);
+    return (dset);
+}
+
+int32_t test_h5_read_blocks(void)
+{
+    hid_t           file = h5_file_open(TEST_FILE, h5_file_w);
+    t_h5_dataset    dset = write_rows_columns(file, "a", 6, 8);
+    t_ndarray       big = array_create(2, (int64_t[]){7, 12}, nd_int64, false, order_c);
+    t_ndarray       view = array_slicing(big, 2, new_slice(1, 7, 2, RANGE), new_slice(0, 12, 3, RANGE));
+    t_ndarray       arr_f;
+
+    array_fill((int64_t)0, big);
+    my_assert(dset.shape[0], (int64_t)6, "testing the shape of a dataset");
+    /* the strided view is a hyperslab of the memory */
+    h5_read(&dset, (int64_t[]){2, 3}, view);
+    my_assert(count_wrong_elements(view, 2, 3), (int64_t)0, "testing the read of a block in a view");
+    my_assert(GET_ELEMENT(big, nd_int64, 1, 0), (int64_t)203, "testing the position of the elements of the view");
+    my_assert(GET_ELEMENT(big, nd_int64, 1, 1), (int64_t)0, "testing that the read does not write between the elements of the view");
+    /* arrays in order_f are read through a copy */
+    arr_f = h5_read_array(&dset, (int64_t[]){1, 1}, (int64_t[]){5, 7}, order_f);
+    my_assert(count_wrong_elements(arr_f, 1, 1), (int64_t)0, "testing the read of a block in an array in order_f");
+    free_array(&arr_f);
+    arr_f = h5_read_array(&dset, NULL, NULL, order_f);
+    my_assert(arr_f.shape[1], (int64_t)8, "testing the shape of a whole dataset");
+    my_assert(count_wrong_elements(arr_f, 0, 0), (int64_t)0, "testing the read of a whole dataset");
+    free_array(&arr_f);
+    free_pointer(&view);
+    free_array(&big);
+    h5_dataset_close(&dset);
+    h5_file_close(file);
+    remove(TEST_FILE);
+    return (0);
+}
+
+int32_t test_h5_write_blocks(void)
+{
+    hid_t           file = h5_file_open(TEST_FILE, h5_file_w);
+    t_h5_dataset    dset = write_rows_columns(file, "a", 6, 8);
+    t_ndarray       arr_f = array_create(2, (int64_t[]){4, 4}, nd_int64, false, order_f);
+    t_ndarray       view = array_slicing(arr_f, 2, new_slice(0, 4, 2, RANGE), new_slice(1, 4, 1, RANGE));
+    t_ndarray       arr;
+
+    for (int64_t i = 0; i < 4; i++)
+        for (int64_t j = 0; j < 4; j++)
+            GET_ELEMENT(arr_f, nd_int64, i, j) = -(i * 4 + j);
+    h5_write(&dset, (int64_t[]){3, 5}, view);
+    h5_dataset_close(&dset);
+    h5_file_close(file);
+
+    file = h5_file_open(TEST_FILE, h5_file_r);
+    dset = h5_dataset_open(file, "a", nd_int64);
+    arr = h5_read_array(&dset, NULL, NULL, order_c);
+    my_assert(GET_ELEMENT(arr, nd_int64, 3, 5), (int64_t)-1, "testing the first element written from a view");
+    my_assert(GET_ELEMENT(arr, nd_int64, 4, 7), (int64_t)-11, "testing the last element written from a view");
+    my_assert(GET_ELEMENT(arr, nd_int64, 3, 4), (int64_t)304, "testing that the elements outside of the block are kept");
+    free_array(&arr);
+    free_pointer(&view);
+    free_array(&arr_f);
+    h5_dataset_close(&dset);
+    h5_file_close(file);
+    remove(TEST_FILE);
+    return (0);
+}
+
+int32_t test_h5_types(void)
+{
+    hid_t           file = h5_file_open(TEST_FILE, h5_file_w);
+    int64_t         shape[] = {3};
+    t_h5_dataset    dset_c = h5_dataset_create(file, "c", 1, shape, nd_cdouble, NULL);
+    t_h5_dataset    dset_b = h5_dataset_create(file, "b", 1, shape, nd_bool, NULL);
+    t_ndarray       arr_c = array_create(1, shape, nd_cdouble, false, order_c);
+    t_ndarray       arr_b = array_create(1, shape, nd_bool, false, order_c);
+    t_h5_dataset    dset_f;
+    t_ndarray       arr_f;
+
+    for (int64_t i = 0; i < 3; i++)
+    {
+        arr_c.nd_cdouble[i] = i + 2.0 * i * I;
+        arr_b.nd_bool[i] = i != 1;
+    }
+    h5_write(&dset_c, NULL, arr_c);
+    h5_write(&dset_b, NULL, arr_b);
+    array_fill(0.0, arr_c);
+    array_fill(false, arr_b);
+    h5_read(&dset_c, NULL, arr_c);
+    h5_read(&dset_b, NULL, arr_b);
+    my_assert((int64_t)cimag(arr_c.nd_cdouble[2]), (int64_t)4, "testing the imaginary part of complex numbers");
+    my_assert((int64_t)creal(arr_c.nd_cdouble[2]), (int64_t)2, "testing the real part of complex numbers");
+    my_assert((int64_t)(arr_b.nd_bool[0] && !arr_b.nd_bool[1] && arr_b.nd_bool[2]), (int64_t)1, "testing booleans");
+    /* the elements are converted to the type of the arrays */
+    dset_f = h5_dataset_open(file, "c", nd_cfloat);
+    arr_f = h5_read_array(&dset_f, NULL, NULL, order_c);
+    my_assert((int64_t)cimagf(arr_f.nd_cfloat[1]), (int64_t)2, "testing the conversion of the type of a dataset");
+    free_array(&arr_f);
+    free_array(&arr_b);
+    free_array(&arr_c);
+    h5_dataset_close(&dset_f);
+    h5_dataset_close(&dset_b);
+    h5_dataset_close(&dset_c);
+    h5_file_close(file);
+    remove(TEST_FILE);
+    return (0);
+}
+
+static void     stream_rows(const t_h5_dataset *dset, bool prefetch, const char *dscr)
+{
+    t_h5_stream stream;
+    int64_t     n_chunks = 0;
+    int64_t     wrong = 0;
+    int64_t     rows = 0;
+
+    h5_stream_open(&stream, dset, 100, 900, 64, prefetch);
+    while (h5_stream_next(&stream))
+    {
+        wrong += count_wrong_elements(stream.chunk, stream.start, 0);
+        rows += stream.chunk.shape[0];
+        n_chunks++;
+    }
+    h5_stream_close(&stream);
+    my_assert(wrong, (int64_t)0, dscr);
+    my_assert(rows, (int64_t)900, "testing the number of rows of the chunks");
+    my_assert(n_chunks, (int64_t)15, "testing the number of chunks");
+}
+
+int32_t test_h5_stream(void)
+{
+    hid_t           file = h5_file_open(TEST_FILE, h5_file_w);
+    t_h5_dataset    dset = write_rows_columns(file, "a", 1000, 3);
+    t_h5_stream     stream;
+
+    stream_rows(&dset, false, "testing the chunks read by a stream");
+    stream_rows(&dset, true, "testing the chunks read in advance by a stream");
+    h5_stream_open(&stream, &dset, 1000, 0, 10, true);
+    my_assert((int64_t)h5_stream_next(&stream), (int64_t)0, "testing an empty stream");
+    h5_stream_close(&stream);
+    h5_dataset_close(&dset);
+    h5_file_close(file);
+    remove(TEST_FILE);
+    return (0);
+}
+
+int32_t test_h5_errors(void)
+{
+    hid_t           file = h5_file_open("test_hdf5_missing.h5", h5_file_r);
+    t_h5_dataset    dset;
+    t_h5_dataset    closed;
+    t_h5_stream     stream;
+    t_ndarray       arr;
+
+    my_assert((int64_t)(file < 0), (int64_t)1, "testing the opening of a missing file");
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_os, "testing the error of a missing file");
+    pyc_clear_error();
+    file = h5_file_open(TEST_FILE, h5_file_w);
+    dset = h5_dataset_open(file, "missing", nd_double);
+    my_assert((int64_t)(dset.dataset < 0), (int64_t)1, "testing the opening of a missing dataset");
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of a missing dataset");
+    pyc_clear_error();
+    h5_dataset_close(&dset);
+    dset = write_rows_columns(file, "a", 6, 8);
+    arr = array_create(2, (int64_t[]){4, 4}, nd_int64, false, order_c);
+    my_assert((int64_t)h5_read(&dset, (int64_t[]){4, 0}, arr), (int64_t)0, "testing the read of a block outside of the dataset");
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of a block outside of the dataset");
+    pyc_clear_error();
+    my_assert((int64_t)h5_write(&dset, (int64_t[]){0, 6}, arr), (int64_t)0, "testing the write of a block outside of the dataset");
+    pyc_clear_error();
+    free_array(&arr);
+    arr = h5_read_array(&dset, NULL, (int64_t[]){7, 8}, order_c);
+    my_assert((int64_t)(arr.shape == NULL), (int64_t)1, "testing the array of a block outside of the dataset");
+    pyc_clear_error();
+    my_assert((int64_t)h5_stream_open(&stream, &dset, 4, 4, 2, false), (int64_t)0, "testing a stream of invalid rows");
+    h5_stream_close(&stream);
+    pyc_clear_error();
+    /* the chunks of a dataset which was closed cannot be read */
+    for (int32_t prefetch = 0; prefetch < 2; prefetch++)
+    {
+        closed = dset;
+        closed.dataset = H5Dopen2(file, "a", H5P_DEFAULT);
+        h5_stream_open(&stream, &closed, 0, 6, 2, prefetch);
+        H5Dclose(closed.dataset);
+        my_assert((int64_t)h5_stream_next(&stream), (int64_t)0, "testing a stream whose chunk cannot be read");
+        my_assert((int64_t)pyc_error_kind(), (int64_t)error_os, "testing the error of a chunk which cannot be read");
+        pyc_clear_error();
+        my_assert((int64_t)h5_stream_next(&stream), (int64_t)0, "testing that the stream stops after an error");
+        h5_stream_close(&stream);
+    }
+    my_assert((int64_t)pyc_error_occurred(), (int64_t)0, "testing that no other error is recorded");
+    h5_dataset_close(&dset);
+    h5_file_close(file);
+    remove(TEST_FILE);
+    return (0);
+}
+
+int32_t main(void)
+{
+    test_h5_read_blocks();
+    test_h5_write_blocks();
+    test_h5_types();
+    test_h5_stream();
+    test_h5_errors();
+    return (0);
+}
@@ -4,7 +4,15 @@
 /* --------------------------------------------------------------------------------------- */
 
 #include "ndarrays.h"
+#include "ufuncs.h"
+#include "linalg.h"
+#include "pyc_random.h"
+#include "pyc_profile.h"
+#include <math.h>
 #include <unistd.h>
+#if !defined(_WIN32)
+# include <pthread.h>
+#endif
 #include <stdio.h>
 #include <string.h>
 
@@ -1399,6 +1407,1267 @@ int32_t test_array_zeros_cdouble(void)
     return (0);
 }
 
+int32_t test_numpy_sum_int64(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    t_ndarray x;
+    t_ndarray xview;
+
+    x = array_create(2, m_1_shape, nd_int64, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_int64[i] = i;
+    my_assert(numpy_sum_int64(x), (int64_t)276, "testing the sum of a contiguous array");
+    my_assert(numpy_amax_int64(x), (int64_t)23, "testing the max of a contiguous array");
+    my_assert(numpy_amin_int64(x), (int64_t)0, "testing the min of a contiguous array");
+    // x[::2, 1::2] contains 1, 3, 5, 13, 15, 17
+    xview = array_slicing(x, 2, new_slice(0, 4, 2, RANGE), new_slice(1, 6, 2, RANGE));
+    my_assert(numpy_sum_int64(xview), (int64_t)54, "testing the sum of a strided view");
+    my_assert(numpy_amax_int64(xview), (int64_t)17, "testing the max of a strided view");
+    my_assert(numpy_amin_int64(xview), (int64_t)1, "testing the min of a strided view");
+    free_pointer(&xview);
+    // x[1:, :] is a contiguous view
+    xview = array_slicing(x, 2, new_slice(1, 4, 1, RANGE), new_slice(0, 6, 1, RANGE));
+    my_assert(numpy_sum_int64(xview), (int64_t)261, "testing the sum of a contiguous view");
+    my_assert(numpy_amin_int64(xview), (int64_t)6, "testing the min of a contiguous view");
+    free_pointer(&xview);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_int32_order_f(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    t_ndarray x;
+    t_ndarray xview;
+
+    x = array_create(2, m_1_shape, nd_int32, false, order_f);
+    for (int32_t i = 0; i < x.length; i++)
+        x.nd_int32[i] = i;
+    my_assert(numpy_sum_int32(x), (int64_t)276, "testing the sum of a contiguous array");
+    // x[1:3, :] contains 1, 2, 5, 6, ..., 21, 22
+    xview = array_slicing(x, 2, new_slice(1, 3, 1, RANGE), new_slice(0, 6, 1, RANGE));
+    my_assert(numpy_sum_int32(xview), (int64_t)138, "testing the sum of a view with a unit stride inner dimension");
+    my_assert(numpy_amax_int32(xview), (int64_t)22, "testing the max of a view with a unit stride inner dimension");
+    my_assert(numpy_amin_int32(xview), (int64_t)1, "testing the min of a view with a unit stride inner dimension");
+    free_pointer(&xview);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_axis_int32_order_f(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    int64_t axis_0_shape[] = {6};
+    int64_t axis_1_shape[] = {4};
+    t_ndarray x;
+    t_ndarray out;
+
+    x = array_create(2, m_1_shape, nd_int32, false, order_f);
+    for (int32_t i = 0; i < x.length; i++)
+        x.nd_int32[i] = i;
+    // x[i, j] = i + 4 * j
+    out = array_create(1, axis_1_shape, nd_int64, false, order_c);
+    numpy_sum_axis_int32(&out, x, 1);
+    for (int64_t i = 0; i < 4; i++)
+        my_assert(out.nd_int64[i], 6 * i + 60, "testing the sum across the columns");
+    free_array(&out);
+    out = array_create(1, axis_0_shape, nd_int64, false, order_c);
+    numpy_sum_axis_int32(&out, x, 0);
+    my_assert(out.nd_int64[5], (int64_t)86, "testing the sum along the columns");
+    numpy_prod_axis_int32(&out, x, 0);
+    my_assert(out.nd_int64[0], (int64_t)0, "testing the product along the columns");
+    my_assert(out.nd_int64[1], (int64_t)840, "testing the product along the columns");
+    free_array(&out);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_float32_accuracy(void)
+{
+    int64_t m_1_shape[] = {1000000};
+    t_ndarray x;
+    float value;
+
+    x = array_create(1, m_1_shape, nd_float, false, order_c);
+    array_fill((float)0.1, x);
+    // a sequential float sum gives 100958.34
+    value = numpy_sum_float32(x);
+    my_assert((int32_t)(fabsf(value - 100000.f) < 1.f), (int32_t)1, "testing the accuracy of the pairwise summation");
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_amax_double(void)
+{
+    double m_1[] = {2, 3, 5, 5, 6,
+                    7, 10, 11, 12, 260,
+                    6.34, 8, 8.002, 0.056, 45,
+                    0.1, 1.02, 0.25, 0.00005, 1};
+    int64_t m_1_shape[] = {4, 5};
+    t_ndarray x;
+    t_ndarray xview;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    memcpy(x.raw_data, m_1, x.buffer_size);
+    my_assert(numpy_amax_float64(x), 260., "testing the max of a contiguous array");
+    my_assert(numpy_amin_float64(x), 0.00005, "testing the min of a contiguous array");
+    // x[:, 2] contains 5, 11, 8.002, 0.25
+    xview = array_slicing(x, 1, new_slice(0, 4, 1, RANGE), new_slice(2, 3, 1, ELEMENT));
+    my_assert(numpy_amax_float64(xview), 11., "testing the max of a column");
+    my_assert(numpy_amin_float64(xview), 0.25, "testing the min of a column");
+    free_pointer(&xview);
+    // x[0, :] contains 2, 3, 5, 5, 6
+    xview = array_slicing(x, 1, new_slice(0, 1, 1, ELEMENT), new_slice(0, 5, 1, RANGE));
+    my_assert(numpy_sum_float64(xview), 21., "testing the sum of a row");
+    free_pointer(&xview);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_amax_cdouble(void)
+{
+    double complex m_1[] = {1 + 2*I, 3 - 1*I, 3 + 1*I, -4 + 5*I};
+    int64_t m_1_shape[] = {4};
+    t_ndarray x;
+
+    x = array_create(1, m_1_shape, nd_cdouble, false, order_c);
+    memcpy(x.raw_data, m_1, x.buffer_size);
+    my_assert(numpy_amax_complex128(x), 3 + 1*I, "testing the lexicographic max of complex values");
+    my_assert(numpy_amin_complex128(x), -4 + 5*I, "testing the lexicographic min of complex values");
+    my_assert(numpy_sum_complex128(x), 3 + 7*I, "testing the sum of complex values");
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_amax_empty(void)
+{
+    t_ndarray x = array_create(1, (int64_t[]){0}, nd_double, false, order_c);
+
+    numpy_amax_float64(x);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of the max of an empty array");
+    pyc_clear_error();
+    numpy_amin_float64(x);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of the min of an empty array");
+    pyc_clear_error();
+    my_assert(numpy_sum_float64(x), 0., "testing the sum of an empty array");
+    my_assert((int64_t)pyc_error_occurred(), (int64_t)0, "testing the sum of an empty array is not an error");
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_axis_int64(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    int64_t axis_0_shape[] = {6};
+    int64_t axis_1_shape[] = {4};
+    int64_t keepdims_shape[] = {1, 6};
+    t_ndarray x;
+    t_ndarray out;
+
+    x = array_create(2, m_1_shape, nd_int64, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_int64[i] = i;
+    // x[i, j] = 6 * i + j
+    out = array_create(1, axis_0_shape, nd_int64, false, order_c);
+    numpy_sum_axis_int64(&out, x, 0);
+    for (int64_t j = 0; j < 6; j++)
+        my_assert(out.nd_int64[j], 36 + 4 * j, "testing the sum across the rows");
+    numpy_amax_axis_int64(&out, x, 0);
+    my_assert(out.nd_int64[5], (int64_t)23, "testing the max across the rows");
+    free_array(&out);
+    out = array_create(1, axis_1_shape, nd_int64, false, order_c);
+    numpy_sum_axis_int64(&out, x, -1);
+    for (int64_t i = 0; i < 4; i++)
+        my_assert(out.nd_int64[i], 36 * i + 15, "testing the sum along the rows");
+    numpy_amin_axis_int64(&out, x, 1);
+    my_assert(out.nd_int64[3], (int64_t)18, "testing the min along the rows");
+    free_array(&out);
+    out = array_create(2, keepdims_shape, nd_int64, false, order_c);
+    numpy_sum_axis_int64(&out, x, 0);
+    my_assert(GET_ELEMENT(out, nd_int64, 0, 2), (int64_t)44, "testing the sum with keepdims");
+    free_array(&out);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_axis_double_3d(void)
+{
+    int64_t m_1_shape[] = {2, 3, 4};
+    int64_t out_shape[] = {2, 4};
+    t_ndarray x;
+    t_ndarray out;
+
+    x = array_create(3, m_1_shape, nd_double, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_double[i] = i;
+    // x[a, b, c] = 12 * a + 4 * b + c
+    out = array_create(2, out_shape, nd_double, false, order_c);
+    numpy_sum_axis_float64(&out, x, 1);
+    my_assert(GET_ELEMENT(out, nd_double, 0, 0), 12., "testing the sum along the middle axis");
+    my_assert(GET_ELEMENT(out, nd_double, 1, 2), 54., "testing the sum along the middle axis");
+    numpy_prod_axis_float64(&out, x, 1);
+    my_assert(GET_ELEMENT(out, nd_double, 0, 1), 1. * 5. * 9., "testing the product along the middle axis");
+    free_array(&out);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_amax_axis_int64_view(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    int64_t keepdims_shape[] = {1, 3};
+    int64_t axis_1_shape[] = {2};
+    t_ndarray x;
+    t_ndarray xview;
+    t_ndarray out;
+
+    x = array_create(2, m_1_shape, nd_int64, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_int64[i] = i;
+    // x[::2, 1::2] contains [[1, 3, 5], [13, 15, 17]]
+    xview = array_slicing(x, 2, new_slice(0, 4, 2, RANGE), new_slice(1, 6, 2, RANGE));
+    out = array_create(2, keepdims_shape, nd_int64, false, order_c);
+    numpy_amax_axis_int64(&out, xview, 0);
+    my_assert(GET_ELEMENT(out, nd_int64, 0, 0), (int64_t)13, "testing the max of a strided view");
+    my_assert(GET_ELEMENT(out, nd_int64, 0, 2), (int64_t)17, "testing the max of a strided view");
+    free_array(&out);
+    out = array_create(1, axis_1_shape, nd_int64, false, order_c);
+    numpy_amin_axis_int64(&out, xview, 1);
+    my_assert(out.nd_int64[1], (int64_t)13, "testing the min of a strided view");
+    free_array(&out);
+    free_pointer(&xview);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_numpy_sum_axis_large(void)
+{
+    int64_t m_1_shape[] = {300000, 3};
+    int64_t out_shape[] = {3};
+    t_ndarray x;
+    t_ndarray out;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_double[i] = i % 3;
+    // with OpenMP the rows are split between the threads
+    out = array_create(1, out_shape, nd_double, false, order_c);
+    numpy_sum_axis_float64(&out, x, 0);
+    my_assert(out.nd_double[2], 600000., "testing the sum of a large array across its rows");
+    numpy_amax_axis_float64(&out, x, 0);
+    my_assert(out.nd_double[1], 1., "testing the max of a large array across its rows");
+    free_array(&out);
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_array_create_alignment(void)
+{
+    int64_t m_1_shape[] = {3, 7};
+    int64_t m_2_shape[] = {1 << 20};
+    t_ndarray x;
+    t_ndarray y;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    my_assert((int64_t)((uintptr_t)x.raw_data % NDARRAY_ALIGNMENT), (int64_t)0, "testing the alignment of a small array");
+    for (int64_t i = 0; i < 3; i++)
+        for (int64_t j = 0; j < 7; j++)
+            GET_ALIGNED_ELEMENT(x, nd_double, i, j) = i * 7 + j;
+    my_assert(GET_ELEMENT(x, nd_double, 2, 3), 17., "testing the access to an aligned array");
+    y = array_create(1, m_2_shape, nd_double, false, order_c);
+    my_assert((int64_t)((uintptr_t)y.raw_data % NDARRAY_ALIGNMENT), (int64_t)0, "testing the alignment of a large array");
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_large_array_sizes(void)
+{
+    int8_t  buffer[1];
+    t_ndarray x = {.nd_int8 = buffer,
+                   .shape = (int64_t[]){65536, 65536},
+                   .strides = (int64_t[2]){0},
+                   .nd = 2,
+                   .type = nd_double,
+                   .is_view = false,
+                   .order = order_c};
+    t_ndarray xview;
+
+    // only the metadata are computed, the data is never accessed
+    stack_array_init(&x);
+    my_assert(x.length, (int64_t)1 << 32, "testing the length of an array with more than 2^31 elements");
+    my_assert(x.buffer_size, (int64_t)1 << 35, "testing the size of a buffer larger than 2 GiB");
+    xview = array_slicing(x, 1, new_slice(40000, 40001, 1, ELEMENT), new_slice(10, 20, 1, RANGE));
+    my_assert((int64_t)(xview.nd_double - x.nd_double), (int64_t)40000 * 65536 + 10, "testing the offset of a view beyond 2^31 elements");
+    my_assert(xview.length, (int64_t)10, "testing the length of a view beyond 2^31 elements");
+    free_pointer(&xview);
+    return (0);
+}
+
+int32_t test_stack_array_buffer(void)
+{
+    double      buffer[STACK_BUFFER_LENGTH(12, double)];
+    t_ndarray   x = {.nd_double = buffer,
+                     .shape = (int64_t[]){3, 4},
+                     .strides = (int64_t[2]){0},
+                     .nd = 2,
+                     .type = nd_double,
+                     .is_view = false,
+                     .order = order_f};
+
+    stack_array_create(&x, sizeof(buffer));
+    my_assert((int64_t)(x.nd_double == buffer), (int64_t)1, "testing the data of a small stack array is in the buffer");
+    my_assert(x.strides[0], (int64_t)1, "testing the first stride of a stack array in order F");
+    my_assert(x.strides[1], (int64_t)3, "testing the second stride of a stack array in order F");
+    GET_ELEMENT(x, nd_double, 2, 3) = 5.;
+    my_assert(buffer[11], 5., "testing the access to a stack array in order F");
+    stack_array_free(&x, buffer);
+    return (0);
+}
+
+int32_t test_stack_array_heap_fallback(void)
+{
+    int64_t     length = NDARRAY_STACK_MAX_BYTES;
+    int64_t     buffer[STACK_BUFFER_LENGTH(length, int64_t)];
+    t_ndarray   x = {.nd_int64 = buffer,
+                     .shape = (int64_t[]){length},
+                     .strides = (int64_t[1]){0},
+                     .nd = 1,
+                     .type = nd_int64,
+                     .is_view = false,
+                     .order = order_c};
+
+    my_assert((int64_t)sizeof(buffer), (int64_t)sizeof(int64_t), "testing the size of the buffer of a large stack array");
+    stack_array_create(&x, sizeof(buffer));
+    my_assert((int64_t)(x.nd_int64 != buffer), (int64_t)1, "testing the data of a large stack array is on the heap");
+    for (int64_t i = 0; i < length; i++)
+        x.nd_int64[i] = i;
+    my_assert(x.nd_int64[length - 1], length - 1, "testing the access to a large stack array");
+    stack_array_free(&x, buffer);
+    return (0);
+}
+
+/* write a (3, 4) array of doubles in the .npy format (version 1.0) */
+static void write_npy_file(const char *filename, bool fortran_order, int64_t header_size)
+{
+    char    header[128];
+    FILE    *file = fopen(filename, "wb");
+
+    memset(header, ' ', header_size);
+    memcpy(header, "\x93NUMPY\x01\x00", 8);
+    header[8] = (char)(header_size - 10);
+    header[9] = 0;
+    int32_t n = sprintf(header + 10, "{'descr': '<f8', 'fortran_order': %s, 'shape': (3, 4), }",
+                        fortran_order ? "True" : "False");
+    header[10 + n] = ' ';
+    header[header_size - 1] = '\n';
+    fwrite(header, 1, header_size, file);
+    for (int32_t i = 0; i < 12; i++)
+    {
+        double value = i;
+        fwrite(&value, sizeof(double), 1, file);
+    }
+    fclose(file);
+}
+
+int32_t test_array_load_npy(void)
+{
+    const char  *filename = "test_ndarrays_load.npy";
+    t_ndarray   x;
+    t_ndarray   y;
+
+    write_npy_file(filename, false, 128);
+    x = array_load_npy(filename, file_map_r, nd_double, 2, order_c);
+    y = array_load_npy(filename, file_read, nd_double, 2, order_c);
+    my_assert(x.shape[0], (int64_t)3, "testing the shape of a mapped array");
+    my_assert(x.shape[1], (int64_t)4, "testing the shape of a mapped array");
+    my_assert(GET_ALIGNED_ELEMENT(x, nd_double, 2, 1), 9., "testing the data of a mapped array");
+    my_assert(GET_ALIGNED_ELEMENT(y, nd_double, 2, 1), 9., "testing the data of an array read from a file");
+    my_assert((int64_t)((uintptr_t)x.raw_data % NDARRAY_ALIGNMENT), (int64_t)0, "testing the alignment of a mapped array");
+    my_assert(array_madvise(x, access_sequential), (int32_t)0, "testing the access hint of a mapped array");
+    free_array(&x);
+    free_array(&y);
+    // The header is not aligned on NDARRAY_ALIGNMENT bytes so the data is read
+    write_npy_file(filename, true, 80);
+    x = array_load_npy(filename, file_map_r, nd_double, 2, order_f);
+    my_assert(GET_ALIGNED_ELEMENT(x, nd_double, 2, 1), 5., "testing the data of an order_f array stored in a file");
+    my_assert((int64_t)((uintptr_t)x.raw_data % NDARRAY_ALIGNMENT), (int64_t)0, "testing the alignment of an array read from a file");
+    free_array(&x);
+    remove(filename);
+    return (0);
+}
+
+int32_t test_array_load_npy_copy_on_write(void)
+{
+    const char  *filename = "test_ndarrays_copy_on_write.npy";
+    t_ndarray   x;
+
+    write_npy_file(filename, false, 128);
+    x = array_load_npy(filename, file_map_c, nd_double, 2, order_c);
+    GET_ELEMENT(x, nd_double, 0, 0) = 42.;
+    my_assert(GET_ELEMENT(x, nd_double, 0, 0), 42., "testing a write into a copy-on-write mapping");
+    free_array(&x);
+    x = array_load_npy(filename, file_map_rplus, nd_double, 2, order_c);
+    my_assert(GET_ELEMENT(x, nd_double, 0, 0), 0., "testing the file is not modified by a copy-on-write mapping");
+    GET_ELEMENT(x, nd_double, 0, 0) = 42.;
+    free_array(&x);
+    x = array_load_npy(filename, file_map_r, nd_double, 2, order_c);
+    my_assert(GET_ELEMENT(x, nd_double, 0, 0), 42., "testing the file is modified by a shared mapping");
+    free_array(&x);
+    remove(filename);
+    return (0);
+}
+
+int32_t test_array_memmap(void)
+{
+    const char  *filename = "test_ndarrays_memmap.bin";
+    int64_t     shape[] = {5, 7};
+    t_ndarray   x;
+    t_ndarray   y;
+
+    x = array_memmap(filename, file_map_wplus, 64, 2, shape, nd_int32, order_f);
+    for (int32_t i = 0; i < 5; i++)
+        for (int32_t j = 0; j < 7; j++)
+            GET_ELEMENT(x, nd_int32, i, j) = 10 * i + j;
+    free_array(&x);
+    x = array_memmap(filename, file_map_r, 64, 2, shape, nd_int32, order_f);
+    my_assert(GET_ELEMENT(x, nd_int32, 3, 6), (int32_t)36, "testing the data written through a mapping");
+    // The data at an offset which is not aligned is read
+    y = array_memmap(filename, file_map_c, 64 + 4 * 5, 1, (int64_t[]){5}, nd_int32, order_c);
+    my_assert(GET_ALIGNED_ELEMENT(y, nd_int32, 2), (int32_t)21, "testing the data at an unaligned offset");
+    free_array(&x);
+    free_array(&y);
+    remove(filename);
+    return (0);
+}
+
+#if !defined(_WIN32)
+/* map and free the arrays of a file while other threads do the same */
+static void *memmap_thread(void *filename)
+{
+    int64_t     errors = 0;
+
+    for (int32_t i = 0; i < 200; i++)
+    {
+        t_ndarray   x = array_memmap(filename, file_map_r, 64, 1, (int64_t[]){64}, nd_int32, order_c);
+        t_ndarray   y = array_create(1, (int64_t[]){16}, nd_int32, false, order_c);
+
+        if (x.shape == NULL || x.nd_int32[i % 64] != i % 64)
+            errors++;
+        free_array(&y);
+        free_array(&x);
+    }
+    return ((void *)(intptr_t)errors);
+}
+
+int32_t test_array_memmap_threads(void)
+{
+    const char  *filename = "test_ndarrays_memmap_threads.bin";
+    pthread_t   threads[4];
+    int64_t     errors = 0;
+    t_ndarray   x;
+
+    x = array_memmap(filename, file_map_wplus, 64, 1, (int64_t[]){64}, nd_int32, order_c);
+    for (int32_t i = 0; i < 64; i++)
+        x.nd_int32[i] = i;
+    free_array(&x);
+    for (int32_t i = 0; i < 4; i++)
+        pthread_create(&threads[i], NULL, memmap_thread, (void *)filename);
+    for (int32_t i = 0; i < 4; i++)
+    {
+        void    *thread_errors;
+        pthread_join(threads[i], &thread_errors);
+        errors += (int64_t)(intptr_t)thread_errors;
+    }
+    my_assert(errors, (int64_t)0, "testing the arrays mapped and freed by several threads");
+    remove(filename);
+    return (0);
+}
+
+/* create views in a thread which exits with blocks in its cache of shapes and strides */
+static void *slicing_thread(void *arg)
+{
+    t_ndarray   *x = arg;
+    int64_t     errors = 0;
+
+    for (int64_t i = 0; i < x->shape[0]; i++)
+    {
+        t_ndarray   xview = array_slicing(*x, 1, new_slice(i, i + 1, 1, ELEMENT), new_slice(0, 5, 1, RANGE));
+
+        if (xview.shape == NULL || xview.shape[0] != 5)
+            errors++;
+        free_pointer(&xview);
+    }
+    return ((void *)(intptr_t)errors);
+}
+
+int32_t test_slicing_metadata_threads(void)
+{
+    pthread_t   threads[4];
+    int64_t     errors = 0;
+    t_ndarray   x;
+
+    x = array_create(2, (int64_t[]){4, 5}, nd_double, false, order_c);
+    for (int32_t i = 0; i < 4; i++)
+        pthread_create(&threads[i], NULL, slicing_thread, &x);
+    for (int32_t i = 0; i < 4; i++)
+    {
+        void    *thread_errors;
+        pthread_join(threads[i], &thread_errors);
+        errors += (int64_t)(intptr_t)thread_errors;
+    }
+    my_assert(errors, (int64_t)0, "testing the views created by threads which exit");
+    free_array(&x);
+    return (0);
+}
+#endif
+
+int32_t test_array_file_errors(void)
+{
+    const char  *filename = "test_ndarrays_errors.npy";
+    t_ndarray   x;
+
+    x = array_load_npy("test_ndarrays_missing.npy", file_map_r, nd_double, 2, order_c);
+    my_assert((int64_t)pyc_error_occurred(), (int64_t)1, "testing the error of a missing file");
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_os, "testing the kind of the error of a missing file");
+    my_assert((int64_t)(x.shape == NULL), (int64_t)1, "testing the array returned for a missing file");
+    free_array(&x);
+    pyc_clear_error();
+    my_assert((int64_t)pyc_error_occurred(), (int64_t)0, "testing the error is cleared");
+    write_npy_file(filename, false, 128);
+    x = array_load_npy(filename, file_read, nd_int32, 2, order_c);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of a file of the wrong type");
+    my_assert((int64_t)(strstr(pyc_error_message(), filename) != NULL), (int64_t)1, "testing the message of the error of a file");
+    pyc_clear_error();
+    x = array_load_npy(filename, file_map_r, nd_double, 1, order_c);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of a file of the wrong rank");
+    pyc_clear_error();
+    x = array_memmap(filename, file_map_r, 64, 2, (int64_t[]){30, 30}, nd_double, order_c);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of a file which is too small");
+    my_assert((int64_t)(x.shape == NULL), (int64_t)1, "testing the array returned for a file which is too small");
+    pyc_clear_error();
+    remove(filename);
+    return (0);
+}
+
+int32_t test_array_copy_data_order_c_to_f(void)
+{
+    int64_t m_1_shape[] = {37, 45};
+    t_ndarray x;
+    t_ndarray y;
+    int32_t  same;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    y = array_create(2, m_1_shape, nd_double, false, order_f);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_double[i] = i;
+    array_copy_data(&y, x, 0);
+    same = 1;
+    for (int64_t i = 0; i < 37; i++)
+        for (int64_t j = 0; j < 45; j++)
+            same &= GET_ELEMENT(y, nd_double, i, j) == GET_ELEMENT(x, nd_double, i, j);
+    my_assert(same, 1, "testing the copy of an order_c array into an order_f array");
+    my_assert(y.nd_double[1], 45., "testing the layout of the order_f copy");
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_array_copy_data_view_cast(void)
+{
+    int64_t m_1_shape[] = {4, 3, 6};
+    int64_t m_2_shape[] = {2, 3, 3};
+    t_ndarray x;
+    t_ndarray xview;
+    t_ndarray y;
+    int32_t  same;
+
+    x = array_create(3, m_1_shape, nd_int32, false, order_c);
+    y = array_create(3, m_2_shape, nd_double, false, order_f);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_int32[i] = i;
+    // x[1::2, :, ::2]
+    xview = array_slicing(x, 3, new_slice(1, 4, 2, RANGE), new_slice(0, 3, 1, RANGE), new_slice(0, 6, 2, RANGE));
+    array_copy_data(&y, xview, 0);
+    same = 1;
+    for (int64_t i = 0; i < 2; i++)
+        for (int64_t j = 0; j < 3; j++)
+            for (int64_t k = 0; k < 3; k++)
+                same &= GET_ELEMENT(y, nd_double, i, j, k) == GET_ELEMENT(xview, nd_int32, i, j, k);
+    my_assert(same, 1, "testing the copy of a strided view with a cast");
+    free_pointer(&xview);
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_array_copy_data_offset(void)
+{
+    int64_t m_1_shape[] = {3};
+    int64_t m_2_shape[] = {2, 3};
+    int64_t m_1[] = {1, 2, 3};
+    t_ndarray x;
+    t_ndarray y;
+
+    x = array_create(1, m_1_shape, nd_int64, false, order_c);
+    y = array_create(2, m_2_shape, nd_int64, false, order_c);
+    memcpy(x.raw_data, m_1, x.buffer_size);
+    array_copy_data(&y, x, 0);
+    array_copy_data(&y, x, 3);
+    my_assert(GET_ELEMENT(y, nd_int64, (int64_t)1, (int64_t)0), (int64_t)1, "testing the copy into the second row");
+    my_assert(GET_ELEMENT(y, nd_int64, (int64_t)1, (int64_t)2), (int64_t)3, "testing the copy into the second row");
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_large_array_reductions(void)
+{
+    int64_t m_1_shape[] = {1024, 513};
+    t_ndarray x;
+    t_ndarray y;
+    t_ndarray xview;
+
+    /* large enough to be split into several tasks (and threads with OpenMP) */
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    y = array_create(2, m_1_shape, nd_double, false, order_f);
+    array_fill(0.5, x);
+    GET_ELEMENT(x, nd_double, (int64_t)700, (int64_t)300) = 3.;
+    GET_ELEMENT(x, nd_double, (int64_t)1000, (int64_t)4) = -1.;
+    xview = array_slicing(x, 2, new_slice(0, 1024, 1, RANGE), new_slice(0, 513, 2, RANGE));
+    my_assert(numpy_sum_float64(x), 262657., "testing the sum of a large array");
+    my_assert(numpy_sum_float64(xview), 131585., "testing the sum of a large view");
+    my_assert(numpy_amax_float64(xview), 3., "testing the maximum of a large view");
+    my_assert(numpy_amin_float64(xview), -1., "testing the minimum of a large view");
+    array_copy_data(&y, x, 0);
+    my_assert(GET_ELEMENT(y, nd_double, (int64_t)700, (int64_t)300), 3., "testing the copy of a large array");
+    my_assert(numpy_sum_float64(y), 262657., "testing the sum of the copy");
+    free_pointer(&xview);
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_slicing_metadata_reuse(void)
+{
+    int64_t m_1_shape[] = {4, 5};
+    t_ndarray x;
+    t_ndarray xview;
+    int64_t *metadata;
+    int32_t  reused;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    xview = array_slicing(x, 1, new_slice(0, 1, 1, ELEMENT), new_slice(0, 5, 1, RANGE));
+    metadata = xview.shape;
+    free_pointer(&xview);
+    reused = 1;
+    for (int64_t i = 0; i < x.shape[0]; i++)
+    {
+        xview = array_slicing(x, 1, new_slice(i, i + 1, 1, ELEMENT), new_slice(0, 5, 1, RANGE));
+        reused &= xview.shape == metadata;
+        free_pointer(&xview);
+    }
+    my_assert(reused, 1, "testing that the views reuse the same shape and strides");
+    my_assert((int64_t)(x.strides - x.shape), (int64_t)2, "testing that the strides are stored after the shape");
+    free_array(&x);
+    release_metadata_cache();
+    return (0);
+}
+
+int32_t test_numpy_exp_float64(void)
+{
+    int64_t m_1_shape[] = {1000};
+    t_ndarray x;
+    t_ndarray out;
+    int32_t  close;
+
+    x = array_create(1, m_1_shape, nd_double, false, order_c);
+    out = array_create(1, m_1_shape, nd_double, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_double[i] = -700. + 1.4 * i;
+    numpy_exp_float64(&out, x);
+    close = 1;
+    for (int64_t i = 0; i < x.length; i++)
+        close &= fabs(out.nd_double[i] - exp(x.nd_double[i])) <= 1e-15 * exp(x.nd_double[i]);
+    my_assert(close, 1, "testing exp against the C library");
+    numpy_log_float64(&out, out);
+    close = 1;
+    for (int64_t i = 0; i < x.length; i++)
+        close &= fabs(out.nd_double[i] - x.nd_double[i]) <= 1e-13;
+    my_assert(close, 1, "testing log(exp(x)) computed in place");
+    free_array(&x);
+    free_array(&out);
+    return (0);
+}
+
+int32_t test_numpy_sin_float64_view(void)
+{
+    int64_t m_1_shape[] = {4, 6};
+    int64_t out_shape[] = {4, 3};
+    t_ndarray x;
+    t_ndarray xview;
+    t_ndarray out;
+    int32_t  close;
+
+    x = array_create(2, m_1_shape, nd_double, false, order_c);
+    out = array_create(2, out_shape, nd_double, false, order_c);
+    for (int64_t i = 0; i < x.length; i++)
+        x.nd_double[i] = 0.5 * i;
+    // x[:, ::2]
+    xview = array_slicing(x, 2, new_slice(0, 4, 1, RANGE), new_slice(0, 6, 2, RANGE));
+    numpy_sin_float64(&out, xview);
+    close = 1;
+    for (int64_t i = 0; i < 4; i++)
+        for (int64_t j = 0; j < 3; j++)
+            close &= fabs(out.nd_double[i * 3 + j] - sin(x.nd_double[i * 6 + 2 * j])) <= 1e-15;
+    my_assert(close, 1, "testing sin of a strided view");
+    free_pointer(&xview);
+    free_array(&x);
+    free_array(&out);
+    return (0);
+}
+
+int32_t test_numpy_add_float64_broadcast(void)
+{
+    double m_1[] = {1, 2, 3,
+                    4, 5, 6};
+    double m_2[] = {10, 20, 30};
+    int64_t m_1_shape[] = {2, 3};
+    int64_t m_2_shape[] = {3};
+    t_ndarray x1;
+    t_ndarray x2;
+
+    x1 = array_create(2, m_1_shape, nd_double, false, order_c);
+    x2 = array_create(1, m_2_shape, nd_double, false, order_c);
+    memcpy(x1.raw_data, m_1, x1.buffer_size);
+    memcpy(x2.raw_data, m_2, x2.buffer_size);
+    numpy_add_float64(&x1, x1, x2);
+    my_assert(x1.nd_double[0], 11., "testing the broadcast addition");
+    my_assert(x1.nd_double[5], 36., "testing the broadcast addition");
+    numpy_multiply_float64(&x1, x1, x1);
+    my_assert(x1.nd_double[4], 625., "testing the in place multiplication");
+    free_array(&x1);
+    free_array(&x2);
+    return (0);
+}
+
+int32_t test_numpy_divide_float32_order_f(void)
+{
+    float m_1[] = {1, 2, 3, 4, 5, 6};
+    int64_t m_1_shape[] = {2, 3};
+    t_ndarray x;
+    t_ndarray out;
+
+    x = array_create(2, m_1_shape, nd_float, false, order_f);
+    out = array_create(2, m_1_shape, nd_float, false, order_f);
+    memcpy(x.raw_data, m_1, x.buffer_size);
+    numpy_sqrt_float32(&out, x);
+    my_assert(out.nd_float[3], 2.f, "testing sqrt of a float32 array");
+    numpy_divide_float32(&out, x, out);
+    my_assert(out.nd_float[3], 2.f, "testing the division of float32 arrays");
+    numpy_sign_float32(&out, x);
+    my_assert(out.nd_float[5], 1.f, "testing the sign of a float32 array");
+    free_array(&x);
+    free_array(&out);
+    return (0);
+}
+
+int32_t test_numpy_mod_float64(void)
+{
+    double m_1[] = {7.5, -7.5, 7.5, -7.5, -4., 1e300, -1e-300, 3.};
+    double m_2[] = {2., 2., -2., -2., 2., 3., 1., INFINITY};
+    int64_t m_1_shape[] = {8};
+    t_ndarray x1;
+    t_ndarray x2;
+    t_ndarray out;
+
+    x1 = array_create(1, m_1_shape, nd_double, false, order_c);
+    x2 = array_create(1, m_1_shape, nd_double, false, order_c);
+    out = array_create(1, m_1_shape, nd_double, false, order_c);
+    memcpy(x1.raw_data, m_1, x1.buffer_size);
+    memcpy(x2.raw_data, m_2, x2.buffer_size);
+    numpy_mod_float64(&out, x1, x2);
+    my_assert(out.nd_double[0], 1.5, "testing the modulo of positive floats");
+    my_assert(out.nd_double[1], 0.5, "testing the modulo of a negative dividend");
+    my_assert(out.nd_double[2], -0.5, "testing the modulo of a negative divisor");
+    my_assert(out.nd_double[3], -1.5, "testing the modulo of negative floats");
+    my_assert((int32_t)signbit(out.nd_double[4]), 0, "testing the sign of a zero modulo");
+    my_assert(out.nd_double[5], fmod(1e300, 3.), "testing the modulo of a large quotient");
+    my_assert(out.nd_double[6], 1., "testing the modulo of a tiny negative dividend");
+    my_assert(out.nd_double[7], 3., "testing the modulo by infinity");
+    free_array(&x1);
+    free_array(&x2);
+    free_array(&out);
+    return (0);
+}
+
+int32_t test_numpy_mod_int_broadcast(void)
+{
+    int64_t m_1[] = {-7, 7, INT64_MIN, (int64_t)1 << 60,
+                     -6, 6, -1, 0};
+    int64_t m_2[] = {3, -3, -1, 0};
+    int32_t m_3[] = {-7, 7, INT32_MIN, 5, -8, 6, -1, 0};
+    int32_t m_4[] = {3, -3, -1, 0};
+    int64_t m_1_shape[] = {2, 4};
+    int64_t m_2_shape[] = {4};
+    t_ndarray x1;
+    t_ndarray x2;
+    t_ndarray y1;
+    t_ndarray y2;
+
+    x1 = array_create(2, m_1_shape, nd_int64, false, order_c);
+    x2 = array_create(1, m_2_shape, nd_int64, false, order_c);
+    y1 = array_create(2, m_1_shape, nd_int32, false, order_c);
+    y2 = array_create(1, m_2_shape, nd_int32, false, order_c);
+    memcpy(x1.raw_data, m_1, x1.buffer_size);
+    memcpy(x2.raw_data, m_2, x2.buffer_size);
+    memcpy(y1.raw_data, m_3, y1.buffer_size);
+    memcpy(y2.raw_data, m_4, y2.buffer_size);
+    numpy_mod_int64(&x1, x1, x2);
+    my_assert(x1.nd_int64[0], (int64_t)2, "testing the modulo of a negative int64");
+    my_assert(x1.nd_int64[1], (int64_t)-2, "testing the modulo by a negative int64");
+    my_assert(x1.nd_int64[2], (int64_t)0, "testing the modulo of INT64_MIN by -1");
+    my_assert(x1.nd_int64[3], (int64_t)0, "testing the modulo of an int64 by zero");
+    my_assert(x1.nd_int64[4], (int64_t)0, "testing the broadcast modulo of int64");
+    numpy_mod_int32(&y1, y1, y2);
+    my_assert(y1.nd_int32[0], 2, "testing the modulo of a negative int32");
+    my_assert(y1.nd_int32[1], -2, "testing the modulo by a negative int32");
+    my_assert(y1.nd_int32[2], 0, "testing the modulo of INT32_MIN by -1");
+    my_assert(y1.nd_int32[4], 1, "testing the broadcast modulo of int32");
+    numpy_sign_int64(&x2, x2);
+    my_assert(x2.nd_int64[1], (int64_t)-1, "testing the sign of an int64 array");
+    my_assert(x2.nd_int64[3], (int64_t)0, "testing the sign of an int64 array");
+    free_array(&x1);
+    free_array(&x2);
+    free_array(&y1);
+    free_array(&y2);
+    return (0);
+}
+
+int32_t test_numpy_gcd_lcm_int64(void)
+{
+    int64_t m_1[] = {12, -12, 0, 0, 1 << 20, 17, 3 * 5 * 7 * 11};
+    int64_t m_2[] = {18, 18, 5, 0, 1 << 12, 5, -5 * 11 * 13};
+    int64_t m_1_shape[] = {7};
+    t_ndarray x1;
+    t_ndarray x2;
+    t_ndarray out;
+
+    x1 = array_create(1, m_1_shape, nd_int64, false, order_c);
+    x2 = array_create(1, m_1_shape, nd_int64, false, order_c);
+    out = array_create(1, m_1_shape, nd_int64, false, order_c);
+    memcpy(x1.raw_data, m_1, x1.buffer_size);
+    memcpy(x2.raw_data, m_2, x2.buffer_size);
+    numpy_gcd_int64(&out, x1, x2);
+    my_assert(out.nd_int64[0], (int64_t)6, "testing the gcd of int64");
+    my_assert(out.nd_int64[1], (int64_t)6, "testing that the gcd is positive");
+    my_assert(out.nd_int64[2], (int64_t)5, "testing the gcd with zero");
+    my_assert(out.nd_int64[3], (int64_t)0, "testing the gcd of zeros");
+    my_assert(out.nd_int64[4], (int64_t)1 << 12, "testing the gcd of powers of 2");
+    my_assert(out.nd_int64[5], (int64_t)1, "testing the gcd of coprime int64");
+    my_assert(out.nd_int64[6], (int64_t)55, "testing the gcd of a negative int64");
+    numpy_lcm_int64(&out, x1, x2);
+    my_assert(out.nd_int64[1], (int64_t)36, "testing that the lcm is positive");
+    my_assert(out.nd_int64[3], (int64_t)0, "testing the lcm of zeros");
+    my_assert(out.nd_int64[6], (int64_t)15015, "testing the lcm of a negative int64");
+    free_array(&x1);
+    free_array(&x2);
+    free_array(&out);
+    return (0);
+}
+
+int32_t test_numpy_matmul_float64_mixed_order(void)
+{
+    int64_t a_shape[] = {37, 300};
+    int64_t b_shape[] = {300, 29};
+    int64_t c_shape[] = {37, 29};
+    t_ndarray a;
+    t_ndarray b;
+    t_ndarray c;
+    double   expected;
+    int32_t  close;
+
+    a = array_create(2, a_shape, nd_double, false, order_c);
+    b = array_create(2, b_shape, nd_double, false, order_f);
+    c = array_create(2, c_shape, nd_double, false, order_c);
+    for (int64_t i = 0; i < a.length; i++)
+        a.nd_double[i] = (i % 17) * 0.25 - 2.;
+    for (int64_t i = 0; i < b.length; i++)
+        b.nd_double[i] = (i % 13) * 0.5 - 3.;
+    numpy_matmul_float64(&c, a, b);
+    close = 1;
+    for (int64_t i = 0; i < 37; i++)
+    {
+        for (int64_t j = 0; j < 29; j++)
+        {
+            expected = 0.;
+            for (int64_t l = 0; l < 300; l++)
+                expected += GET_ELEMENT(a, nd_double, i, l) * GET_ELEMENT(b, nd_double, l, j);
+            close &= fabs(GET_ELEMENT(c, nd_double, i, j) - expected) <= 1e-12 * (1. + fabs(expected));
+        }
+    }
+    my_assert(close, 1, "testing the product of a C-ordered and an F-ordered matrix");
+    free_array(&a);
+    free_array(&b);
+    free_array(&c);
+    return (0);
+}
+
+/* 1 if c = a @ b for three float64 matrices of any layout */
+static int32_t matmul_float64_is_close(t_ndarray c, t_ndarray a, t_ndarray b)
+{
+    double  expected;
+    int32_t close;
+
+    close = 1;
+    for (int64_t i = 0; i < c.shape[0]; i++)
+    {
+        for (int64_t j = 0; j < c.shape[1]; j++)
+        {
+            expected = 0.;
+            for (int64_t l = 0; l < a.shape[1]; l++)
+                expected += GET_ELEMENT(a, nd_double, i, l) * GET_ELEMENT(b, nd_double, l, j);
+            close &= fabs(GET_ELEMENT(c, nd_double, i, j) - expected) <= 1e-12 * (1. + fabs(expected));
+        }
+    }
+    return (close);
+}
+
+int32_t test_numpy_matmul_float64_layouts(void)
+{
+    int64_t a_shape[] = {41, 300};
+    int64_t b_shape[] = {300, 270};
+    int64_t c_shape[] = {41, 270};
+    int64_t big_shape[] = {82, 600};
+    int64_t big_b_shape[] = {600, 82};
+    t_ndarray a;
+    t_ndarray b;
+    t_ndarray c;
+    t_ndarray big_a;
+    t_ndarray big_b;
+    t_ndarray big_c;
+    t_ndarray va;
+    t_ndarray vb;
+    t_ndarray vc;
+
+    /* F @ C -> F, larger than the blocks of the inner and of the column dimensions */
+    a = array_create(2, a_shape, nd_double, false, order_f);
+    b = array_create(2, b_shape, nd_double, false, order_c);
+    c = array_create(2, c_shape, nd_double, false, order_f);
+    for (int64_t i = 0; i < a.length; i++)
+        a.nd_double[i] = (i % 19) * 0.25 - 2.;
+    for (int64_t i = 0; i < b.length; i++)
+        b.nd_double[i] = (i % 11) * 0.5 - 2.5;
+    numpy_matmul_float64(&c, a, b);
+    my_assert(matmul_float64_is_close(c, a, b), 1, "testing the product of an F-ordered and a C-ordered matrix in order F");
+
+    /* strided views of a C-ordered and of an F-ordered matrix */
+    big_a = array_create(2, big_shape, nd_double, false, order_c);
+    big_b = array_create(2, big_b_shape, nd_double, false, order_f);
+    for (int64_t i = 0; i < big_a.length; i++)
+    {
+        big_a.nd_double[i] = (i % 23) * 0.125 - 1.;
+        big_b.nd_double[i] = (i % 7) * 0.5 - 1.5;
+    }
+    /* va = big_a[::2, 1:301], vb = big_b[1::8, ::2] */
+    va = array_slicing(big_a, 2, new_slice(0, 82, 2, RANGE), new_slice(1, 301, 1, RANGE));
+    vb = array_slicing(big_b, 2, new_slice(1, 600, 8, RANGE), new_slice(0, 82, 2, RANGE));
+    numpy_matmul_float64(&c, va, b);
+    my_assert(matmul_float64_is_close(c, va, b), 1, "testing the product of a strided view and a C-ordered matrix in order F");
+
+    /* vb is 75 x 41, the product is written in a strided view of a C-ordered matrix */
+    big_c = array_create(2, big_shape, nd_double, false, order_c);
+    vc = array_slicing(big_c, 2, new_slice(0, 82, 2, RANGE), new_slice(0, 123, 3, RANGE));
+    free_pointer(&va);
+    va = array_slicing(big_a, 2, new_slice(0, 82, 2, RANGE), new_slice(0, 75, 1, RANGE));
+    numpy_matmul_float64(&vc, va, vb);
+    my_assert(matmul_float64_is_close(vc, va, vb), 1, "testing the product of strided views written in a strided view");
+
+    free_pointer(&va);
+    free_pointer(&vb);
+    free_pointer(&vc);
+    free_array(&a);
+    free_array(&b);
+    free_array(&big_a);
+    free_array(&big_b);
+    free_array(&big_c);
+    return (0);
+}
+
+int32_t test_numpy_matmul_int64_vector(void)
+{
+    int64_t a_shape[] = {5, 3};
+    int64_t x_shape[] = {3};
+    int64_t y_shape[] = {5};
+    int64_t a_data[] = {1, 2, 3,
+                        4, 5, 6,
+                        7, 8, 9,
+                        10, 11, 12,
+                        13, 14, 15};
+    int64_t x_data[] = {1, -1, 2};
+    t_ndarray a;
+    t_ndarray x;
+    t_ndarray y;
+    t_ndarray z;
+
+    a = array_create(2, a_shape, nd_int64, false, order_c);
+    x = array_create(1, x_shape, nd_int64, false, order_c);
+    y = array_create(1, y_shape, nd_int64, false, order_c);
+    z = array_create(1, x_shape, nd_int64, false, order_c);
+    memcpy(a.raw_data, a_data, sizeof(a_data));
+    memcpy(x.raw_data, x_data, sizeof(x_data));
+    numpy_matmul_int64(&y, a, x);
+    my_assert(y.nd_int64[0], (int64_t)5, "testing the product of a matrix and a vector");
+    my_assert(y.nd_int64[4], (int64_t)29, "testing the product of a matrix and a vector");
+    numpy_matmul_int64(&z, y, a);
+    my_assert(z.nd_int64[0], (int64_t)775, "testing the product of a vector and a matrix");
+    my_assert(z.nd_int64[2], (int64_t)945, "testing the product of a vector and a matrix");
+    my_assert(numpy_dot_int64(x, x), (int64_t)6, "testing the inner product of two vectors");
+    free_array(&a);
+    free_array(&x);
+    free_array(&y);
+    free_array(&z);
+    return (0);
+}
+
+int32_t test_numpy_matmul_complex128_view(void)
+{
+    int64_t a_shape[] = {4, 6};
+    int64_t c_shape[] = {3, 3};
+    t_ndarray a;
+    t_ndarray v;
+    t_ndarray c;
+    double complex expected;
+
+    a = array_create(2, a_shape, nd_cdouble, false, order_c);
+    for (int64_t i = 0; i < a.length; i++)
+        a.nd_cdouble[i] = i + (i % 3) * I;
+    /* v = a[1:, ::2] is a 3x3 view with non unit strides */
+    v = array_slicing(a, 2, new_slice(1, 4, 1, RANGE), new_slice(0, 6, 2, RANGE));
+    c = array_create(2, c_shape, nd_cdouble, false, order_f);
+    numpy_matmul_complex128(&c, v, v);
+    expected = 0.;
+    for (int64_t l = 0; l < 3; l++)
+        expected += GET_ELEMENT(v, nd_cdouble, 2, l) * GET_ELEMENT(v, nd_cdouble, l, 1);
+    my_assert(GET_ELEMENT(c, nd_cdouble, 2, 1), expected, "testing the product of strided complex views");
+    free_array(&c);
+    free_pointer(&v);
+    free_array(&a);
+    return (0);
+}
+
+
+int32_t test_random_seed(void)
+{
+    int64_t m_1_shape[] = {100};
+    t_ndarray x;
+    t_ndarray y;
+    int32_t  same;
+    double   first;
+
+    x = array_create(1, m_1_shape, nd_double, false, order_c);
+    y = array_create(1, m_1_shape, nd_double, false, order_c);
+    pyc_random_seed(1234);
+    first = pyc_random_uniform();
+    pyc_random_fill_normal(x, 0., 1.);
+    pyc_random_seed(1234);
+    my_assert(pyc_random_uniform(), first, "testing that the seed gives the same numbers");
+    pyc_random_fill_normal(y, 0., 1.);
+    same = 1;
+    for (int64_t i = 0; i < x.length; i++)
+        same &= x.nd_double[i] == y.nd_double[i];
+    my_assert(same, 1, "testing that the seed gives the same array");
+    pyc_random_seed(4321);
+    my_assert(pyc_random_uniform() != first, 1, "testing that another seed gives other numbers");
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+int32_t test_random_fill_uniform(void)
+{
+    int64_t m_1_shape[] = {100000};
+    t_ndarray x;
+    int32_t  in_range;
+    double   mean;
+
+    x = array_create(1, m_1_shape, nd_double, false, order_c);
+    pyc_random_seed(42);
+    pyc_random_fill_uniform(x);
+    in_range = 1;
+    mean = 0.;
+    for (int64_t i = 0; i < x.length; i++)
+    {
+        in_range &= x.nd_double[i] >= 0. && x.nd_double[i] < 1.;
+        mean += x.nd_double[i];
+    }
+    mean /= x.length;
+    my_assert(in_range, 1, "testing that the uniform numbers are in [0, 1)");
+    my_assert(fabs(mean - 0.5) < 0.01, 1, "testing the mean of the uniform distribution");
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_random_fill_randint(void)
+{
+    int64_t m_1_shape[] = {70000};
+    t_ndarray x;
+    int64_t  counts[7] = {0};
+    int32_t  in_range;
+    int32_t  uniform;
+
+    x = array_create(1, m_1_shape, nd_int64, false, order_c);
+    pyc_random_seed(42);
+    pyc_random_fill_randint(x, -3, 4);
+    in_range = 1;
+    for (int64_t i = 0; i < x.length; i++)
+    {
+        in_range &= x.nd_int64[i] >= -3 && x.nd_int64[i] < 4;
+        if (x.nd_int64[i] >= -3 && x.nd_int64[i] < 4)
+            counts[x.nd_int64[i] + 3]++;
+    }
+    my_assert(in_range, 1, "testing that the integers are in [low, high)");
+    uniform = 1;
+    for (int32_t i = 0; i < 7; i++)
+        uniform &= counts[i] > 9500 && counts[i] < 10500;
+    my_assert(uniform, 1, "testing that each integer is drawn as often");
+    my_assert(pyc_random_randint(5, 6), (int64_t)5, "testing an interval containing one integer");
+    free_array(&x);
+    return (0);
+}
+
+int32_t test_random_fill_normal(void)
+{
+    int64_t m_1_shape[] = {200000};
+    t_ndarray x;
+    double   mean;
+    double   var;
+    int64_t  tail;
+
+    x = array_create(1, m_1_shape, nd_double, false, order_c);
+    pyc_random_seed(42);
+    pyc_random_fill_normal(x, 1., 2.);
+    mean = 0.;
+    for (int64_t i = 0; i < x.length; i++)
+        mean += x.nd_double[i];
+    mean /= x.length;
+    var = 0.;
+    tail = 0;
+    for (int64_t i = 0; i < x.length; i++)
+    {
+        var += (x.nd_double[i] - mean) * (x.nd_double[i] - mean);
+        tail += fabs(x.nd_double[i] - 1.) > 6.;
+    }
+    var /= x.length;
+    my_assert(fabs(mean - 1.) < 0.02, 1, "testing the mean of the normal distribution");
+    my_assert(fabs(var - 4.) < 0.05, 1, "testing the variance of the normal distribution");
+    /* P(|X| > 3 sigma) = 0.0027 */
+    my_assert(tail > 400 && tail < 680, 1, "testing the tails of the normal distribution");
+    free_array(&x);
+    return (0);
+}
+int32_t test_random_errors(void)
+{
+    t_ndarray   x = array_create(1, (int64_t[]){10}, nd_int64, false, order_c);
+    t_ndarray   y = array_create(1, (int64_t[]){10}, nd_double, false, order_c);
+
+    pyc_random_randint(5, 5);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of randint with high <= low");
+    pyc_clear_error();
+    pyc_random_fill_randint(x, 3, 1);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of an array of randint with high <= low");
+    pyc_clear_error();
+    pyc_random_fill_normal(y, 0., -1.);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of normal with scale < 0");
+    pyc_clear_error();
+    pyc_random_fill_uniform(x);
+    my_assert((int64_t)pyc_error_kind(), (int64_t)error_value, "testing the error of uniform for an array of integers");
+    pyc_clear_error();
+    pyc_random_fill_normal(y, 0., 0.);
+    my_assert((int64_t)pyc_error_occurred(), (int64_t)0, "testing normal with scale = 0");
+    free_array(&x);
+    free_array(&y);
+    return (0);
+}
+
+static int64_t profiled_factorial(int64_t n)
+{
+    PYC_PROFILE_FUNCTION("test.profiled_factorial");
+    return n <= 1 ? 1 : n * profiled_factorial(n - 1);
+}
+
+int32_t test_profile_timer(void)
+{
+    t_pyc_timer *timer;
+
+    pyc_profile_reset();
+    my_assert(profiled_factorial(4), (int64_t)24, "testing the result of an instrumented function");
+    for (timer = pyc_profile_timers(); timer != NULL; timer = timer->next)
+        if (strcmp(timer->name, "test.profiled_factorial") == 0)
+            break;
+    my_assert((int32_t)(timer != NULL), (int32_t)1, "testing the registration of a timer");
+    my_assert(timer->calls, (int64_t)4, "testing the calls counted by a timer (with recursion)");
+    my_assert((int32_t)(timer->ticks > 0), (int32_t)1, "testing the time measured by a timer");
+    my_assert((int32_t)(pyc_profile_seconds_per_tick() > 0), (int32_t)1, "testing the duration of a tick");
+    profiled_factorial(1);
+    my_assert(timer->calls, (int64_t)5, "testing the registration of a timer only once");
+    pyc_profile_reset();
+    my_assert(timer->calls, (int64_t)0, "testing the reset of a timer");
+    return (0);
+}
+
+int32_t test_profile_allocations(void)
+{
+    t_pyc_allocation_stats stats;
+
+    pyc_profile_reset();
+    pyc_profile_allocation(100);
+    pyc_profile_allocation(50);
+    pyc_profile_deallocation(100);
+    stats = pyc_profile_allocations();
+    my_assert(stats.allocations, (int64_t)2, "testing the number of allocations");
+    my_assert(stats.deallocations, (int64_t)1, "testing the number of deallocations");
+    my_assert(stats.allocated_bytes, (int64_t)150, "testing the allocated bytes");
+    my_assert(stats.live_bytes, (int64_t)50, "testing the bytes which are still allocated");
+    my_assert(stats.peak_bytes, (int64_t)150, "testing the peak of the allocated bytes");
+    pyc_profile_deallocation(50);
+    pyc_profile_reset();
+    stats = pyc_profile_allocations();
+    my_assert(stats.allocations, (int64_t)0, "testing the reset of the allocations");
+    my_assert(stats.peak_bytes, (int64_t)0, "testing the reset of the peak");
+    return (0);
+}
+
+int32_t test_device_copies(void)
+{
+    t_ndarray x = array_create(1, (int64_t[]){8}, nd_int64, false, order_c);
+    t_ndarray v;
+
+    for (int64_t i = 0; i < 8; i++)
+        x.nd_int64[i] = i;
+    /* the data stays on the device between the compute regions */
+    for (int32_t step = 0; step < 2; step++)
+    {
+        array_device_map(&x);
+        #pragma acc parallel loop present(x)
+        for (int64_t i = 0; i < 8; i++)
+            x.nd_int64[i] *= 2;
+        array_device_unmap(&x, true);
+    }
+    v = array_slicing(x, 1, new_slice(2, 8, 3, RANGE));
+    array_host_sync(v);
+    my_assert(GET_ELEMENT(v, nd_int64, 1), (int64_t)20, "testing the data copied back to the host after the compute regions");
+#ifdef _OPENACC
+    my_assert((int64_t)(v.device == x.device), (int64_t)1, "testing that the views share the device copy of the array");
+#else
+    my_assert((int64_t)(x.device == NULL), (int64_t)1, "testing that the arrays have no device copy without OpenACC");
+#endif
+    free_pointer(&v);
+    free_array(&x);
+    my_assert((int64_t)(x.device == NULL), (int64_t)1, "testing the release of the device copy");
+    return (0);
+}
+
 int32_t main(void)
 {
     /* indexing tests */
@@ -1428,6 +2697,58 @@ int32_t main(void)
     test_array_zeros_int32();
     test_array_zeros_double();
     test_array_zeros_cdouble();
+    /* reduction tests */
+    test_numpy_sum_int64();
+    test_numpy_sum_float32_accuracy();
+    test_numpy_amax_double();
+    test_numpy_amax_cdouble();
+    test_numpy_amax_empty();
+    test_numpy_sum_axis_int64();
+    test_numpy_sum_axis_double_3d();
+    test_numpy_amax_axis_int64_view();
+    test_numpy_sum_axis_large();
+    test_slicing_metadata_reuse();
+#if !defined(_WIN32)
+    test_slicing_metadata_threads();
+#endif
+    test_array_copy_data_order_c_to_f();
+    test_array_copy_data_view_cast();
+    test_array_copy_data_offset();
+    test_large_array_sizes();
+    test_stack_array_buffer();
+    test_stack_array_heap_fallback();
+    test_array_load_npy();
+    test_array_load_npy_copy_on_write();
+    test_array_memmap();
+    test_array_file_errors();
+#if !defined(_WIN32)
+    test_array_memmap_threads();
+#endif
+    test_array_create_alignment();
+    test_large_array_reductions();
+    /* ufunc tests */
+    test_numpy_exp_float64();
+    test_numpy_sin_float64_view();
+    test_numpy_add_float64_broadcast();
+    test_numpy_divide_float32_order_f();
+    test_numpy_mod_float64();
+    test_numpy_mod_int_broadcast();
+    test_numpy_gcd_lcm_int64();
+    /* matrix product tests */
+    test_numpy_matmul_float64_mixed_order();
+    test_numpy_matmul_float64_layouts();
+    test_numpy_matmul_int64_vector();
+    test_numpy_matmul_complex128_view();
+    /* random tests */
+    test_random_seed();
+    test_random_fill_uniform();
+    test_random_fill_randint();
+    test_random_fill_normal();
+    test_random_errors();
+    /* profiling tests */
+    test_profile_timer();
+    test_profile_allocations();
+    test_device_copies();
 
     // /*************ORDER F**********************/
 
@@ -1454,5 +2775,8 @@ int32_t main(void)
     test_array_fill_int8_order_f();
     test_array_fill_double_order_f();
     test_array_fill_cdouble_order_f();
+    /* reduction tests */
+    test_numpy_sum_int32_order_f();
+    test_numpy_sum_axis_int32_order_f();
     return (0);
 }
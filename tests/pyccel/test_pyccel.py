@@ -527,6 +527,41 @@ def test_folder_imports(language):
 
     compare_pyth_fort_output(pyth_out, fort_out)
 
+#------------------------------------------------------------------------------
+@pytest.mark.parametrize( 'language', (
+        pytest.param("fortran", marks = pytest.mark.fortran),
+        pytest.param("c", marks = pytest.mark.c),
+    )
+)
+def test_incremental_compilation(language, tmp_path):
+    shutil.copyfile(get_abs_path("scripts/funcs.py"), tmp_path / "funcs.py")
+    cmd = [shutil.which("pyccel"), "funcs.py", f"--language={language}", "--verbose", "-j", "2"]
+
+    def run_pyccel():
+        p = subprocess.run(cmd, stdout=subprocess.PIPE, universal_newlines=True, cwd=tmp_path, check=True)
+        return p.stdout
+
+    assert "is up to date" not in run_pyccel()
+    # Nothing has changed so no object is compiled again
+    out = run_pyccel()
+    assert "funcs.o is up to date" in out
+    assert " -c " not in out
+
+    with open(tmp_path / "funcs.py", "a", encoding="utf-8") as f:
+        f.write("\ndef new_func(a : int):\n    return a + 1\n")
+    out = run_pyccel()
+    assert "funcs.o is up to date" not in out
+
+#------------------------------------------------------------------------------
+@pytest.mark.parametrize( 'runtime', ('static', 'shared'))
+@pytest.mark.c
+def test_stdlib_runtime(runtime, tmp_path, monkeypatch):
+    monkeypatch.setenv('PYCCEL_RUNTIME_DIR', str(tmp_path / 'runtime'))
+    pyccel_test("scripts/arrays_view.py", language = 'c',
+            pyccel_commands = f"--stdlib-runtime={runtime}")
+    assert any(f.startswith('libpyccel_stdlib_') for d in os.listdir(tmp_path / 'runtime')
+                for f in os.listdir(tmp_path / 'runtime' / d))
+
 #------------------------------------------------------------------------------
 @pytest.mark.xdist_incompatible
 def test_funcs(language):
@@ -1190,3 +1225,57 @@ def test_time_execution_flag():
     for l in result_lines[1:-1]:
         assert ' : ' in l
 
+#------------------------------------------------------------------------------
+def test_export_timings(tmp_path):
+    test_file  = get_abs_path("scripts/runtest_funcs.py")
+
+    cwd = get_abs_path("scripts")
+
+    json_file = str(tmp_path / 'timings.json')
+    cmd = [shutil.which("pyccel"), test_file, "--language=c", f"--export-timings={json_file}"]
+    subprocess.run(cmd, cwd=cwd, check=True)
+
+    with open(json_file, 'r', encoding='utf-8') as f:
+        timings = json.load(f)
+    module, = timings['spans']
+    assert module['category'] == 'module'
+    assert module['name'] == 'runtest_funcs'
+    stages = [s['name'] for s in module['children'] if s['category'] == 'stage']
+    assert 'Syntactic Stage' in stages
+    assert 'Semantic Stage' in stages
+    semantic = next(s for s in module['children'] if s['name'] == 'Semantic Stage')
+    functions = [f['name'] for s in semantic['children'] for f in s['children'] if f['category'] == 'function']
+    assert 'add2' in functions
+
+    trace_file = str(tmp_path / 'timings.trace.json')
+    cmd = [shutil.which("pyccel"), test_file, "--language=c", f"--export-timings={trace_file}",
+            "--timings-format=chrome"]
+    subprocess.run(cmd, cwd=cwd, check=True)
+
+    with open(trace_file, 'r', encoding='utf-8') as f:
+        trace = json.load(f)
+    categories = {e.get('cat') for e in trace['traceEvents']}
+    assert {'module', 'stage', 'subprocess'} <= categories
+
+
+#------------------------------------------------------------------------------
+def test_roofline_flag(tmp_path):
+    test_file  = get_abs_path("scripts/runtest_funcs.py")
+
+    cwd = get_abs_path("scripts")
+
+    profile_file = str(tmp_path / 'machine.json')
+    with open(profile_file, 'w', encoding='utf-8') as f:
+        json.dump({'name' : 'test machine', 'peak_gflops' : 10, 'bandwidth_gbs' : 5}, f)
+
+    cmd = [shutil.which("pyccel"), test_file, "--language=c", "-t", f"--roofline={profile_file}"]
+    with subprocess.Popen(cmd, universal_newlines=True, cwd=cwd,
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE) as p:
+        result, _ = p.communicate()
+
+    result_lines = result.split('\n')
+    assert result_lines[0] == 'Roofline report of runtest_funcs.py'
+    assert 'test machine' in result_lines[1]
+    assert 'ridge point 2 FLOP/B' in result_lines[1]
+    functions = [l.split()[0] for l in result_lines[4:] if l]
+    assert functions[:2] == ['add2', 'sum_to_n*']
@@ -0,0 +1,9 @@
+# pylint: disable=missing-function-docstring, missing-module-docstring
+import numpy as np
+from pyccel.decorators import nogil
+
+counts = np.zeros(4, dtype=int)
+
+@nogil
+def count(i : int):
+    counts[i] += 1